@@ -0,0 +1,216 @@
+//
+// Class AliMixEventCache
+//
+// AliMixEventCache keeps compact copies of the last events of every
+// event pool bin in memory
+//
+
+#include "AliLog.h"
+
+#include "AliMixEventReducer.h"
+#include "AliMixEventCache.h"
+
+ClassImp(AliMixEventCache)
+
+//_________________________________________________________________________________________________
+AliMixEventCache::AliMixEventCache(const char *name, const char *title) : TNamed(name, title),
+   fReducer(0),
+   fMaxMemory(0),
+   fDepth(1),
+   fBins(),
+   fNext(),
+   fOrder(),
+   fStamp(0),
+   fMemory(0),
+   fMaxMemoryUsed(0),
+   fNHits(0),
+   fNMisses(0),
+   fNEvictedDepth(0),
+   fNEvictedMemory(0)
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+AliMixEventCache::~AliMixEventCache()
+{
+   //
+   // Destructor
+   //
+   Clear();
+   delete fReducer;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::SetReducer(AliMixEventReducer *reducer)
+{
+   //
+   // Sets reducer (cache takes ownership); cached events are dropped
+   //
+   if (reducer == fReducer) return;
+   Clear();
+   delete fReducer;
+   fReducer = reducer;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::SetDepth(Int_t depth)
+{
+   //
+   // Sets number of events kept per bin; cached events are dropped
+   //
+   if (depth < 1) depth = 1;
+   if (depth == fDepth) return;
+   Clear();
+   fDepth = depth;
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventCache::Reduce(AliVEvent *ev)
+{
+   //
+   // Returns new compact copy of event which is not stored (owned by caller)
+   //
+   if (!fReducer) fReducer = new AliMixEventReducer();
+   return fReducer->Reduce(ev);
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventCache::Add(Int_t bin, Long64_t entry, AliVEvent *ev)
+{
+   //
+   // Stores compact copy of event as entry of bin, overwriting the oldest
+   // event of the bin and evicting the oldest events of all bins when the
+   // memory limit is exceeded. Returns stored copy
+   //
+   if (bin < 0 || entry < 0 || !ev) return 0;
+   if (bin >= (Int_t) fBins.size()) {
+      fBins.resize(bin + 1);
+      fNext.resize(bin + 1, 0);
+   }
+   std::vector<Slot> &ring = fBins[bin];
+   if (ring.empty()) {
+      Slot empty = { -1, 0, 0, 0 };
+      ring.assign(fDepth, empty);
+   }
+
+   Int_t iSlot = fNext[bin];
+   Slot &slot = ring[iSlot];
+   if (slot.fEvent) {
+      FreeSlot(slot);
+      fNEvictedDepth++;
+   }
+   slot.fEvent = Reduce(ev);
+   if (!slot.fEvent) return 0;
+   slot.fEntry = entry;
+   slot.fSize = fReducer->GetSize(slot.fEvent);
+   slot.fStamp = ++fStamp;
+   fMemory += slot.fSize;
+   fNext[bin] = (iSlot + 1) % fDepth;
+
+   SlotRef ref = { bin, iSlot, slot.fStamp };
+   fOrder.push_back(ref);
+
+   while (fMaxMemory > 0 && fMemory > fMaxMemory) {
+      if (!EvictOldest()) break;
+   }
+   if (fMemory > fMaxMemoryUsed) fMaxMemoryUsed = fMemory;
+
+   // drop references to overwritten slots once they dominate
+   if (fOrder.size() > 2 * fBins.size() * fDepth + 64) {
+      std::deque<SlotRef> order;
+      for (UInt_t i = 0; i < fOrder.size(); i++) {
+         const SlotRef &r = fOrder[i];
+         const Slot &s = fBins[r.fBin][r.fSlot];
+         if (s.fEvent && s.fStamp == r.fStamp) order.push_back(r);
+      }
+      fOrder.swap(order);
+   }
+   return slot.fEvent;
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventCache::Find(Int_t bin, Long64_t entry)
+{
+   //
+   // Returns compact copy of entry in bin (0 if it is not in cache)
+   //
+   if (bin >= 0 && bin < (Int_t) fBins.size()) {
+      std::vector<Slot> &ring = fBins[bin];
+      for (UInt_t i = 0; i < ring.size(); i++) {
+         if (ring[i].fEvent && ring[i].fEntry == entry) {
+            fNHits++;
+            return ring[i].fEvent;
+         }
+      }
+   }
+   fNMisses++;
+   return 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::Clear(Option_t *)
+{
+   //
+   // Deletes all cached events (statistics are kept)
+   //
+   for (UInt_t b = 0; b < fBins.size(); b++) {
+      for (UInt_t i = 0; i < fBins[b].size(); i++) FreeSlot(fBins[b][i]);
+   }
+   fBins.clear();
+   fNext.clear();
+   fOrder.clear();
+   fMemory = 0;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::FreeSlot(Slot &slot)
+{
+   //
+   // Deletes event in slot
+   //
+   if (!slot.fEvent) return;
+   fMemory -= slot.fSize;
+   delete slot.fEvent;
+   slot.fEvent = 0;
+   slot.fEntry = -1;
+   slot.fSize = 0;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventCache::EvictOldest()
+{
+   //
+   // Evicts oldest cached event, except the one added last
+   //
+   while (!fOrder.empty()) {
+      const SlotRef ref = fOrder.front();
+      Slot &slot = fBins[ref.fBin][ref.fSlot];
+      if (!slot.fEvent || slot.fStamp != ref.fStamp) {
+         // slot was overwritten in the meantime
+         fOrder.pop_front();
+         continue;
+      }
+      if (slot.fStamp == fStamp) return kFALSE;
+      fOrder.pop_front();
+      FreeSlot(slot);
+      fNEvictedMemory++;
+      return kTRUE;
+   }
+   return kFALSE;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventCache::Print(const Option_t *option) const
+{
+   //
+   // Prints usefull information
+   //
+   AliInfo(Form("Depth %d, bins %d, memory %lld B (max %lld B, limit %lld B)",
+                fDepth, (Int_t) fBins.size(), fMemory, fMaxMemoryUsed, fMaxMemory));
+   AliInfo(Form("Hits %lld, misses %lld, evicted %lld (ring buffer full) %lld (memory limit)",
+                fNHits, fNMisses, fNEvictedDepth, fNEvictedMemory));
+   if (fReducer) fReducer->Print(option);
+}
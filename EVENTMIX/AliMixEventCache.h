@@ -0,0 +1,93 @@
+//
+// Class AliMixEventCache
+//
+// AliMixEventCache keeps compact copies (see AliMixEventReducer) of the
+// last events of every event pool bin in memory, so that
+// AliMixInputEventHandler can hand them to UserExecMix without reading
+// the mixing partners from the input chain again.
+//
+// Every bin holds a ring buffer of the last GetDepth() events; the oldest
+// events of all bins are evicted when the estimated memory exceeds
+// SetMaxMemory(). The estimate comes from AliMixEventReducer::GetSize(),
+// so the limit is approximate, leave some margin to the available memory.
+// Hits, misses and evictions are counted (see Print()).
+//
+
+#ifndef ALIMIXEVENTCACHE_H
+#define ALIMIXEVENTCACHE_H
+
+#include <vector>
+#include <deque>
+
+#include <TNamed.h>
+
+class AliVEvent;
+class AliMixEventReducer;
+class AliMixEventCache : public TNamed {
+public:
+   AliMixEventCache(const char *name = "mixEventCache", const char *title = "Mix event cache");
+   virtual ~AliMixEventCache();
+
+   // reducer is owned by the cache (default AliMixEventReducer keeping all event list objects)
+   void                SetReducer(AliMixEventReducer *reducer);
+   AliMixEventReducer *GetReducer() const { return fReducer; }
+   void                SetMaxMemory(Long64_t bytes) { fMaxMemory = bytes; }
+   Long64_t            GetMaxMemory() const { return fMaxMemory; }
+   void                SetDepth(Int_t depth);
+   Int_t               GetDepth() const { return fDepth; }
+
+   // stores compact copy of event as entry of bin; returns stored copy
+   TObject            *Add(Int_t bin, Long64_t entry, AliVEvent *ev);
+   // returns compact copy of entry in bin (0 if it is not in cache)
+   TObject            *Find(Int_t bin, Long64_t entry);
+   // returns new compact copy of event which is not stored (owned by caller)
+   TObject            *Reduce(AliVEvent *ev);
+   void                Clear(Option_t *option = "");
+
+   Long64_t            GetMemory() const { return fMemory; }
+   Long64_t            GetNHits() const { return fNHits; }
+   Long64_t            GetNMisses() const { return fNMisses; }
+   Long64_t            GetNEvictedDepth() const { return fNEvictedDepth; }
+   Long64_t            GetNEvictedMemory() const { return fNEvictedMemory; }
+
+   virtual void        Print(const Option_t *option = "") const;
+
+private:
+
+   struct Slot {
+      Long64_t  fEntry;                // entry in chain (-1 = empty)
+      Long64_t  fSize;                 // estimated memory in bytes
+      ULong64_t fStamp;                // insertion number
+      TObject  *fEvent;                // compact copy of event
+   };
+   struct SlotRef {
+      Int_t     fBin;                  // bin
+      Int_t     fSlot;                 // slot in bin
+      ULong64_t fStamp;                // insertion number of slot when it was filled
+   };
+
+   void                FreeSlot(Slot &slot);
+   Bool_t              EvictOldest();
+
+   AliMixEventReducer *fReducer;       // reducer making compact copies
+   Long64_t            fMaxMemory;     // memory limit in bytes (0 = no limit)
+   Int_t               fDepth;         // number of events kept per bin
+
+   std::vector< std::vector<Slot> > fBins;  //! ring buffer of every bin
+   std::vector<Int_t>  fNext;               //! next slot to fill in every bin
+   std::deque<SlotRef> fOrder;              //! filled slots in insertion order
+   ULong64_t           fStamp;              //! insertion counter
+   Long64_t            fMemory;             //! estimated memory in use
+   Long64_t            fMaxMemoryUsed;      //! maximum of fMemory
+   Long64_t            fNHits;              //! number of found entries
+   Long64_t            fNMisses;            //! number of entries not in cache
+   Long64_t            fNEvictedDepth;      //! entries overwritten in full ring buffer
+   Long64_t            fNEvictedMemory;     //! entries evicted because of memory limit
+
+   AliMixEventCache(const AliMixEventCache &obj);
+   AliMixEventCache &operator=(const AliMixEventCache &obj);
+
+   ClassDef(AliMixEventCache, 1)
+};
+
+#endif
@@ -8,6 +8,10 @@
 //          Martin Vala (martin.vala@cern.ch)
 //
 
+#include <algorithm>
+
+#include <TMath.h>
+
 #include "AliLog.h"
 #include "AliESDEvent.h"
 #include "AliAODEvent.h"
@@ -27,7 +31,9 @@ AliMixEventCutObj::AliMixEventCutObj(AliMixEventCutObj::EEPAxis_t type, Float_t
    fCutMax(max),
    fCutStep(step),
    fCutSmallVal(0),
-   fCurrentVal(min)
+   fCurrentVal(min),
+   fBinLow(),
+   fBinHigh()
 {
    //
    // Default constructor
@@ -45,7 +51,9 @@ AliMixEventCutObj::AliMixEventCutObj(const AliMixEventCutObj &obj) : TObject(obj
    fCutMax(obj.fCutMax),
    fCutStep(obj.fCutStep),
    fCutSmallVal(obj.fCutSmallVal),
-   fCurrentVal(obj.fCurrentVal)
+   fCurrentVal(obj.fCurrentVal),
+   fBinLow(obj.fBinLow),
+   fBinHigh(obj.fBinHigh)
 {
    //
    // Copy constructor
@@ -69,6 +77,8 @@ AliMixEventCutObj &AliMixEventCutObj::operator=(const AliMixEventCutObj &obj)
       fCutStep = obj.fCutStep;
       fCutSmallVal = obj.fCutSmallVal;
       fCurrentVal = obj.fCurrentVal;
+      fBinLow = obj.fBinLow;
+      fBinHigh = obj.fBinHigh;
 //       fNoMore = obj.fNoMore;
    }
    return *this;
@@ -130,6 +140,22 @@ Int_t AliMixEventCutObj::GetNumberOfBins() const
    return (Int_t)((fCutMax - fCutMin) / fCutStep);
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventCutObj::InitBinning()
+{
+   //
+   // Precomputes bin edges, so that GetBinNumber does not have to loop
+   // over bins. Edges are accumulated exactly as in the loop of GetBinNumber
+   //
+   fBinLow.clear();
+   fBinHigh.clear();
+   if (fCutStep < 1e-5) return;
+   for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) {
+      fBinLow.push_back(iCurrent);
+      fBinHigh.push_back(iCurrent + fCutStep - fCutSmallVal);
+   }
+}
+
 //_________________________________________________________________________________________________
 Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
 {
@@ -137,6 +163,14 @@ Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
    // Returns bin (index) number in current cut.
    // Returns -1 in case of out of range
    //
+   if (!fBinLow.empty()) {
+      // last bin starting below num; the bin before can overlap it by rounding
+      Int_t last = (Int_t)(std::upper_bound(fBinLow.begin(), fBinLow.end(), num) - fBinLow.begin()) - 1;
+      for (Int_t i = TMath::Max(last - 1, 0); i <= last; i++) {
+         if ((num >= fBinLow[i]) && (num < fBinHigh[i])) return i + 1;
+      }
+      return -1;
+   }
    Int_t binNum = 0;
    for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) {
       binNum++;
@@ -11,6 +11,8 @@
 #ifndef ALIMIXEVENTCUTOBJ_H
 #define ALIMIXEVENTCUTOBJ_H
 
+#include <vector>
+
 #include <TObject.h>
 #include <TString.h>
 
@@ -43,6 +45,8 @@ public:
    Float_t     GetStep() const { return fCutStep; }
    Short_t     GetType() const { return fCutType; }
    Int_t       GetBinNumber(Float_t num) const;
+   void        InitBinning();
+   Int_t       GetNumberOfBinEdges() const { return (Int_t) fBinLow.size(); }
    Int_t       GetIndex(AliVEvent *ev);
    Double_t    GetValue(AliVEvent *ev);
    Double_t    GetValue(AliESDEvent *ev);
@@ -64,6 +68,9 @@ private:
 
    Float_t     fCurrentVal;    // current value
 
+   std::vector<Float_t> fBinLow;  //! lower edges of bins (see InitBinning)
+   std::vector<Float_t> fBinHigh; //! upper edges of bins (see InitBinning)
+
    ClassDef(AliMixEventCutObj, 3)
 };
 
@@ -23,7 +23,10 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
    fListOfEventCuts(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fCuts(),
+   fCutNBins(),
+   fBinStride()
 {
    //
    // Default constructor.
@@ -37,7 +40,10 @@ AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEventCuts(obj.fListOfEventCuts),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fCuts(),
+   fCutNBins(),
+   fBinStride()
 {
    //
    // Copy constructor
@@ -59,6 +65,10 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      // bin index is rebuilt for new cuts
+      fCuts.clear();
+      fCutNBins.clear();
+      fBinStride.clear();
    }
    return *this;
 }
@@ -111,10 +121,35 @@ Int_t AliMixEventPool::Init()
    fBinNumber++;
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
    AddEntryList();
+   InitBinIndex();
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventPool::InitBinIndex()
+{
+   //
+   // Precomputes number of bins and stride of every cut, so that the
+   // entry list of an event is found without loops over bins or
+   // allocations. Lookups do not change the pool afterwards
+   //
+   fCuts.clear();
+   fCutNBins.clear();
+   fBinStride.clear();
+   Int_t stride = 1;
+   for (Int_t i = 0; i < fListOfEventCuts.GetEntriesFast(); i++) {
+      AliMixEventCutObj *cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      cut->InitBinning();
+      fCuts.push_back(cut);
+      fCutNBins.push_back(cut->GetNumberOfBinEdges());
+      fBinStride.push_back(stride);
+      stride *= cut->GetNumberOfBinEdges();
+   }
+   if (stride != fListOfEntryList.GetEntriesFast())
+      AliDebug(AliLog::kDebug, Form("%d bins but %d entry lists", stride, fListOfEntryList.GetEntriesFast()));
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
 {
@@ -167,21 +202,27 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
    //
    // Adds entry to correct entry list
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
    AliDebug(AliLog::kDebug + 5, Form("AddEntry(%lld,%p)", entry, (void *)ev));
    if (entry < 0) {
       AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added !!!", entry));
       return kFALSE;
    }
-   Int_t idEntryList = -1;
-   TEntryList *el =  FindEntryList(ev, idEntryList);
+   return AddEntry(entry, FindEntryListId(ev));
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventPool::AddEntry(Long64_t entry, Int_t idEntryList)
+{
+   //
+   // Adds entry to entry list idEntryList (as returned by FindEntryList)
+   //
+   TEntryList *el = (entry >= 0 && idEntryList > 0) ? (TEntryList *) fListOfEntryList.At(idEntryList - 1) : 0;
    if (el) {
       el->Enter(entry);
       AliDebug(AliLog::kDebug, Form("Entry %lld was added with idEntryList %d !!!", entry, idEntryList));
       return kTRUE;
    }
    AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added !!!", entry));
-   AliDebug(AliLog::kDebug + 5, "->");
    return kFALSE;
 }
 
@@ -191,36 +232,68 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
    //
    // Find entrlist in list of entrlist
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
-   Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
-   AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
-         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
-      }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
-   }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
-   AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
-   // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
-   AliDebug(AliLog::kDebug + 5, "->");
+   Int_t id = FindEntryListId(ev);
+   AliDebug(AliLog::kDebug, Form("idEntryList %d", id - 1));
+   if (id < 0) return 0;
+   idEntryList = id;
    return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
 }
 
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::FindEntryListId(AliVEvent *ev)
+{
+   //
+   // Returns id of entry list of event (index + 1), -1 if any cut value
+   // is out of range. Bins of cut i are at stride fBinStride[i]
+   //
+   if (fCuts.size() != (UInt_t) fListOfEventCuts.GetEntriesFast()) InitBinIndex();
+   if (fCuts.empty()) return -1;
+   Int_t index = 0;
+   for (UInt_t i = 0; i < fCuts.size(); i++) {
+      Int_t bin = fCuts[i]->GetIndex(ev);
+      if (bin < 1 || bin > fCutNBins[i]) return -1;
+      index += (bin - 1) * fBinStride[i];
+   }
+   return index + 1;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::FindEntryListId(const Double_t *values)
+{
+   //
+   // Returns id of entry list for given cut values (one per cut, in order of cuts)
+   //
+   if (fCuts.size() != (UInt_t) fListOfEventCuts.GetEntriesFast()) InitBinIndex();
+   if (fCuts.empty()) return -1;
+   Int_t index = 0;
+   for (UInt_t i = 0; i < fCuts.size(); i++) {
+      Int_t bin = fCuts[i]->GetBinNumber(values[i]);
+      if (bin < 1 || bin > fCutNBins[i]) return -1;
+      index += (bin - 1) * fBinStride[i];
+   }
+   return index + 1;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventPool::FindEntryListIds(Int_t nEvents, AliVEvent **events, Int_t *idEntryLists)
+{
+   //
+   // Fills entry list ids of nEvents events
+   //
+   for (Int_t i = 0; i < nEvents; i++) idEntryLists[i] = FindEntryListId(events[i]);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventPool::FindEntryListIds(Int_t nEvents, const Double_t *values, Int_t *idEntryLists)
+{
+   //
+   // Fills entry list ids of nEvents events from their cut values
+   // (values[iEvent * number of cuts + iCut])
+   //
+   Int_t nCuts = fListOfEventCuts.GetEntriesFast();
+   for (Int_t i = 0; i < nEvents; i++) idEntryLists[i] = FindEntryListId(values + i * nCuts);
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index)
 {
@@ -241,51 +314,26 @@ void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t
 Bool_t AliMixEventPool::SetCutValuesFromBinIndex(Int_t index)
 {
    //
-   // Sets cut value from bin index
+   // Sets cut value from bin index, the inverse of FindEntryListId
+   // (index = id - 1, same number of bins and strides)
    //
+   if (fCuts.size() != (UInt_t) fListOfEventCuts.GetEntriesFast()) InitBinIndex();
+   if (fCuts.empty()) return kFALSE;
 
-   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
-   Int_t *lenght = new Int_t[numCuts];
-   Int_t *indexes = new Int_t[numCuts];
-   Long64_t timesNum = 1;
-   AliMixEventCutObj *cut;
-   Int_t i = 0, j = 0;
-   for (i = 0; i < numCuts; i++) {
-      cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
-      cut->Reset();
-      lenght[i] = cut->GetNumberOfBins();
-      indexes[i] = 1;
-      timesNum *= lenght[i];
-   }
-
+   Long64_t timesNum = (Long64_t) fBinStride.back() * fCutNBins.back();
    if (index < 0 || index >= timesNum) {
 //       AliError(Form("index=%d is out of range !!!", index));
-      delete [] lenght;
-      delete [] indexes;
       return kFALSE;
    }
 
-   Long64_t indexNum = index;
-   for (i = 0; i < numCuts; i++) {
-      timesNum = 1;
-      for (j = 0; j < numCuts - i - 1; j++) timesNum *= lenght[j];
-      indexNum /= timesNum;
-      indexes[numCuts - i - 1] = indexNum + 1;
-      index -= indexNum * timesNum;
-      indexNum = index;
-   }
-
-   for (i = 0; i < numCuts; i++) {
-      cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
-      for (j = 0; j < indexes[i]; j++) cut->AddStep();
+   for (UInt_t i = 0; i < fCuts.size(); i++) {
+      AliMixEventCutObj *cut = fCuts[i];
+      Int_t bin = (index / fBinStride[i]) % fCutNBins[i] + 1;
+      AliDebug(AliLog::kDebug, Form("indexes[%d]=%d", i, bin));
+      cut->Reset();
+      for (Int_t j = 0; j < bin; j++) cut->AddStep();
       cut->PrintCurrentInterval();
-
    }
 
-   for (i = 0; i < numCuts; i++) AliDebug(AliLog::kDebug, Form("indexes[%d]=%d", i, indexes[i]));
-
-   delete [] lenght;
-   delete [] indexes;
-
    return kTRUE;
 }
@@ -11,6 +11,8 @@
 #ifndef ALIMIXEVENTPOOL_H
 #define ALIMIXEVENTPOOL_H
 
+#include <vector>
+
 #include <TObjArray.h>
 #include <TNamed.h>
 
@@ -33,10 +35,20 @@ public:
    void        CreateEntryListsRecursivly(Int_t index);
    void        SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index);
    TEntryList *AddEntryList();
+   void        InitBinIndex();
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
+   Bool_t      AddEntry(Long64_t entry, Int_t idEntryList);
    TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
 
+   // entry list id (1 = first entry list, -1 = event is out of range)
+   Int_t       FindEntryListId(AliVEvent *ev);
+   // from cut values (one value per cut, in order of cuts)
+   Int_t       FindEntryListId(const Double_t *values);
+   // same for nEvents events; values are stored event by event
+   void        FindEntryListIds(Int_t nEvents, AliVEvent **events, Int_t *idEntryLists);
+   void        FindEntryListIds(Int_t nEvents, const Double_t *values, Int_t *idEntryLists);
+
    void        AddCut(AliMixEventCutObj *cut);
 
    Bool_t      NeedInit() { return (fListOfEntryList.GetEntries() == 0); }
@@ -58,6 +70,10 @@ private:
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
 
+   std::vector<AliMixEventCutObj *> fCuts;  //! cuts in order of fListOfEventCuts
+   std::vector<Int_t> fCutNBins;            //! number of bins of every cut
+   std::vector<Int_t> fBinStride;           //! stride of every cut in entry list index
+
    ClassDef(AliMixEventPool, 1)
 };
 
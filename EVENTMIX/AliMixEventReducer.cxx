@@ -0,0 +1,173 @@
+//
+// Class AliMixEventReducer
+//
+// AliMixEventReducer makes the compact copy of an event which is kept
+// in AliMixEventCache
+//
+
+#include <TList.h>
+#include <TClass.h>
+#include <TBufferFile.h>
+#include <TClonesArray.h>
+#include <TObjString.h>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+
+#include "AliMixEventReducer.h"
+
+ClassImp(AliMixEventReducer)
+
+//_________________________________________________________________________________________________
+AliMixEventReducer::AliMixEventReducer(const char *name, const char *title) : TNamed(name, title),
+   fObjectNames(),
+   fStreamedSize()
+{
+   //
+   // Default constructor.
+   //
+   fObjectNames.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventReducer::AliMixEventReducer(const AliMixEventReducer &obj) : TNamed(obj),
+   fObjectNames(),
+   fStreamedSize()
+{
+   //
+   // Copy constructor
+   //
+   fObjectNames.SetOwner(kTRUE);
+   for (Int_t i = 0; i < obj.fObjectNames.GetEntriesFast(); i++)
+      fObjectNames.Add(obj.fObjectNames.At(i)->Clone());
+}
+
+//_________________________________________________________________________________________________
+AliMixEventReducer &AliMixEventReducer::operator=(const AliMixEventReducer &obj)
+{
+   //
+   // Assigned operator
+   //
+   if (&obj != this) {
+      TNamed::operator=(obj);
+      fObjectNames.Delete();
+      for (Int_t i = 0; i < obj.fObjectNames.GetEntriesFast(); i++)
+         fObjectNames.Add(obj.fObjectNames.At(i)->Clone());
+      fStreamedSize.clear();
+   }
+   return *this;
+}
+
+//_________________________________________________________________________________________________
+AliMixEventReducer::~AliMixEventReducer()
+{
+   //
+   // Destructor
+   //
+   fObjectNames.Delete();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventReducer::AddObject(const char *name)
+{
+   //
+   // Adds name of event list object which is kept
+   //
+   fObjectNames.Add(new TObjString(name));
+}
+
+//_________________________________________________________________________________________________
+TObject *AliMixEventReducer::Reduce(AliVEvent *ev)
+{
+   //
+   // Returns TObjArray (owner) with clones of the selected event list
+   // objects; objects missing in the event are skipped
+   //
+   if (!ev) return 0;
+   TObjArray *reduced = new TObjArray();
+   reduced->SetOwner(kTRUE);
+   if (fObjectNames.GetEntriesFast() == 0) {
+      TList *list = ev->GetList();
+      if (!list) return reduced;
+      TIter next(list);
+      TObject *obj;
+      while ((obj = next())) reduced->Add(obj->Clone());
+      return reduced;
+   }
+   for (Int_t i = 0; i < fObjectNames.GetEntriesFast(); i++) {
+      const char *name = fObjectNames.At(i)->GetName();
+      TObject *obj = ev->FindListObject(name);
+      if (!obj) {
+         AliDebug(AliLog::kDebug + 1, Form("Object '%s' not found in event", name));
+         continue;
+      }
+      reduced->Add(obj->Clone());
+   }
+   return reduced;
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventReducer::GetSize(const TObject *reduced) const
+{
+   //
+   // Returns estimate of memory used by reduced event in bytes.
+   // Class sizes do not count memory allocated by the objects themselves
+   // (arrays, strings, referenced objects), so every object counts with the
+   // streamed size of its class, which is measured only for the first object
+   // of that class (see GetObjectSize), the events are not streamed again.
+   //
+   if (!reduced) return 0;
+   const TObjArray *arr = dynamic_cast<const TObjArray *>(reduced);
+   if (!arr || reduced->IsA() == TClonesArray::Class()) return GetObjectSize(reduced);
+   Long64_t size = reduced->IsA()->Size();
+   for (Int_t i = 0; i < arr->GetEntriesFast(); i++) {
+      const TObject *obj = arr->At(i);
+      if (obj) size += GetObjectSize(obj);
+   }
+   return size;
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventReducer::GetObjectSize(const TObject *obj) const
+{
+   //
+   // Returns estimate of memory used by obj in bytes, for TClonesArrays
+   // the entries count with the streamed size per entry of their class
+   //
+   const TClonesArray *ca = dynamic_cast<const TClonesArray *>(obj);
+   if (!ca || !ca->GetClass()) return GetStreamedSize(obj->IsA(), obj, 1);
+   Int_t n = ca->GetEntriesFast();
+   if (n == 0) return ca->IsA()->Size();
+   return ca->IsA()->Size() + n * GetStreamedSize(ca->GetClass(), ca, n);
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixEventReducer::GetStreamedSize(const TClass *cl, const TObject *obj, Int_t n) const
+{
+   //
+   // Returns streamed bytes per object of class cl (at least the class size).
+   // Measured once by streaming obj, which holds n objects of class cl.
+   //
+   std::map<const TClass *, Long64_t>::const_iterator it = fStreamedSize.find(cl);
+   if (it != fStreamedSize.end()) return it->second;
+   TBufferFile buffer(TBuffer::kWrite);
+   buffer.WriteObject(obj);
+   Long64_t size = buffer.Length() / n;
+   if (size < cl->Size()) size = cl->Size();
+   fStreamedSize[cl] = size;
+   return size;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventReducer::Print(const Option_t *) const
+{
+   //
+   // Prints usefull information
+   //
+   if (fObjectNames.GetEntriesFast() == 0) {
+      AliInfo("Keeping all event list objects");
+      return;
+   }
+   for (Int_t i = 0; i < fObjectNames.GetEntriesFast(); i++)
+      AliInfo(Form("Keeping '%s'", fObjectNames.At(i)->GetName()));
+}
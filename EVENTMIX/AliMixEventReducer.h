@@ -0,0 +1,51 @@
+//
+// Class AliMixEventReducer
+//
+// AliMixEventReducer makes the compact copy of an event which is kept
+// in AliMixEventCache. The default implementation clones the selected
+// objects of the event list (e.g. "tracks", "vertices", "header" for AODs)
+// into an owning TObjArray; users can override Reduce() and GetSize()
+// to store their own compact representation.
+//
+
+#ifndef ALIMIXEVENTREDUCER_H
+#define ALIMIXEVENTREDUCER_H
+
+#include <map>
+
+#include <TNamed.h>
+#include <TObjArray.h>
+
+class TClass;
+class AliVEvent;
+class AliMixEventReducer : public TNamed {
+public:
+   AliMixEventReducer(const char *name = "mixEventReducer", const char *title = "Mix event reducer");
+   AliMixEventReducer(const AliMixEventReducer &obj);
+   AliMixEventReducer &operator= (const AliMixEventReducer &obj);
+   virtual ~AliMixEventReducer();
+
+   // adds name of event list object which is kept (all objects if none is added)
+   void              AddObject(const char *name);
+   const TObjArray  *GetListOfObjectNames() const { return &fObjectNames; }
+
+   // returns new compact copy of event (owned by caller)
+   virtual TObject  *Reduce(AliVEvent *ev);
+   // returns estimate of memory used by compact copy in bytes (streamed size
+   // per object of every class is measured once), override for exact accounting
+   virtual Long64_t  GetSize(const TObject *reduced) const;
+
+   virtual void      Print(const Option_t *option = "") const;
+
+private:
+
+   Long64_t    GetObjectSize(const TObject *obj) const;
+   Long64_t    GetStreamedSize(const TClass *cl, const TObject *obj, Int_t n) const;
+
+   TObjArray   fObjectNames;           // names of event list objects to keep
+   mutable std::map<const TClass *, Long64_t> fStreamedSize; //! streamed bytes per object of class
+
+   ClassDef(AliMixEventReducer, 1)
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventCache.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -33,6 +34,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fEventPool(0),
    fNumberMixed(0),
    fMixNumber(mixNum),
+   fEventCache(0),
    fUseDefautProcess(kFALSE),
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
@@ -43,12 +45,15 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fCachedMixEvents(),
+   fUncachedMixEvents()
 {
    //
    // Default constructor.
    //
    AliDebug(AliLog::kDebug + 10, "<-");
+   fUncachedMixEvents.SetOwner(kTRUE);
    SetMixNumber(mixNum);
    AliDebug(AliLog::kDebug + 10, "->");
 }
@@ -59,6 +64,7 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   fUncachedMixEvents.Delete();
 }
 
 //_____________________________________________________________________________
@@ -112,6 +118,12 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
       ih->SetParentHandler(this);
    }
 
+   // cache has to keep main event and all its mixing partners in every bin
+   if (fEventCache) {
+      Int_t depth = (fBufferSize > 1 ? fBufferSize : 2 * fMixNumber + 2) + 1;
+      if (fEventCache->GetDepth() < depth) fEventCache->SetDepth(depth);
+   }
+
    AliDebug(AliLog::kDebug + 5, Form("->"));
    return kTRUE;
 }
@@ -229,6 +241,9 @@ Bool_t AliMixInputEventHandler::MixStd()
    // check for PhysSelection
    if (!IsEventCurrentSelected()) return kFALSE;
 
+   // without event pool all events are in one bin
+   CacheMainEvent(0, fEntryCounter, inEvHMain->GetEvent());
+
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -245,7 +260,6 @@ Bool_t AliMixInputEventHandler::MixStd()
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
    fNumberMixed = 0;
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    for (counter = 0; counter < mixNum; counter++) {
@@ -253,12 +267,11 @@ Bool_t AliMixInputEventHandler::MixStd()
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
       if (entryMix < 0) break;
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         PrepareMixEntry(0, 0, entryMixReal, te, entryMix);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
@@ -297,8 +310,6 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
-   // fills entry
-   if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
@@ -307,6 +318,9 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    TEntryList *el = 0;
    Int_t idEntryList = -1;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   // fills entry (bin is looked up only once)
+   if (el) fEventPool->AddEntry(currentMainEntry, idEntryList);
+   CacheMainEvent(el ? idEntryList : -1, currentMainEntry, inEvHMain->GetEvent());
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -328,7 +342,6 @@ Bool_t AliMixInputEventHandler::MixBuffer()
       }
    }
 
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    AliInputEventHandler *eh = 0;
@@ -348,14 +361,13 @@ Bool_t AliMixInputEventHandler::MixBuffer()
          break;
       }
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(counter);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
          AliDebug(AliLog::kDebug + 3, Form("Preparing InputEventHandler(%d)", counter));
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(counter), fAnalysisType);
+         PrepareMixEntry(counter, idEntryList, entryMixReal, te, entryMix);
          fNumberMixed++;
       }
       counter++;
@@ -398,7 +410,6 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
-   if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
@@ -407,6 +418,9 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Int_t idEntryList = -1;
    TEntryList *el = 0;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   // fills entry (bin is looked up only once)
+   if (el) fEventPool->AddEntry(currentMainEntry, idEntryList);
+   CacheMainEvent(el ? idEntryList : -1, currentMainEntry, inEvHMain->GetEvent());
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -452,10 +466,8 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    if (fDoMixExtra) {
       if (elNum <= 2 * fMixNumber + 1) mixNum = elNum + 1;
    }
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
-   mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
    // fills num for main events
    for (counter = 0; counter < mixNum; counter++) {
       fCurrentMixEntry.Reset();
@@ -471,7 +483,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          AliError("te is null. this is error. tell to developer (#2)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         PrepareMixEntry(0, idEntryList, entryMixReal, te, entryMix);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
@@ -518,6 +530,44 @@ void AliMixInputEventHandler::AddInputEventHandler(AliVEventHandler *)
    AliWarning("Use AliMixEventInputHandler::SetInputHandlerForMixing instead. Exiting ...");
 }
 
+//_____________________________________________________________________________
+void AliMixInputEventHandler::CacheMainEvent(Int_t idEntryList, Long64_t entryMain, AliVEvent *ev)
+{
+   //
+   // Forgets mixed events of previous main event and stores compact copy
+   // of main event in event cache (only if idEntryList >= 0)
+   //
+   if (!fEventCache) return;
+   fCachedMixEvents.Clear();
+   fUncachedMixEvents.Delete();
+   if (idEntryList < 0) return;
+   fEventCache->Add(idEntryList, entryMain, ev);
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::PrepareMixEntry(Int_t idHandler, Int_t idEntryList, Long64_t entryMix, TChainElement *te, Long64_t entryInTree)
+{
+   //
+   // Prepares mixed event for input handler idHandler. With event cache
+   // the compact copy of entryMix is taken from cache and the chain is read
+   // only if it was evicted
+   //
+   AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(idHandler);
+   AliInputEventHandler *eh = (AliInputEventHandler *)InputEventHandler(idHandler);
+   if (!fEventCache) {
+      if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryInTree, eh, fAnalysisType);
+      return;
+   }
+   TObject *cached = fEventCache->Find(idEntryList, entryMix);
+   if (!cached) {
+      AliDebug(AliLog::kDebug + 1, Form("Entry %lld (bin %d) not in event cache, reading it from chain", entryMix, idEntryList));
+      mihi->PrepareEntry(te, entryInTree, eh, fAnalysisType);
+      cached = fEventCache->Reduce(eh->GetEvent());
+      if (cached) fUncachedMixEvents.Add(cached);
+   }
+   fCachedMixEvents.AddAtAndExpand(cached, idHandler);
+}
+
 //_____________________________________________________________________________
 void AliMixInputEventHandler::UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed)
 {
@@ -21,6 +21,7 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventCache;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -44,6 +45,11 @@ public:
    void                    SetEventPool(AliMixEventPool *const evPool) { fEventPool = evPool; }
 
    AliMixEventPool        *GetEventPool() const { return fEventPool; }
+   // keeps mixing partners in memory instead of reading them from the chain again
+   void                    SetEventCache(AliMixEventCache *const cache) { fEventCache = cache; }
+   AliMixEventCache       *GetEventCache() const { return fEventCache; }
+   // compact copy of mixed event id (event cache mode only, see AliMixEventReducer)
+   TObject                *GetCachedMixEvent(Int_t id = 0) const { return fCachedMixEvents.At(id); }
    Int_t                   BufferSize() const { return fBufferSize; }
    Int_t                   NumberMixedTimes() const { return fNumberMixed; }
    Int_t                   MixNumber() const { return fMixNumber; }
@@ -82,6 +88,7 @@ protected:
    AliMixEventPool        *fEventPool;             // event pool
    Int_t                   fNumberMixed;           // number of mixed events with current event
    Int_t                   fMixNumber;             // user's mix number request
+   AliMixEventCache       *fEventCache;            // cache of compact events (0 = mixed events are read from chain)
 
 private:
 
@@ -99,18 +106,22 @@ private:
 
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
+   TObjArray fCachedMixEvents;     //! compact copies of mixed events currently used (event cache mode)
+   TObjArray fUncachedMixEvents;   //! compact copies of mixed events which were not in cache (owner)
 
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
 
+   void                    CacheMainEvent(Int_t idEntryList, Long64_t entryMain, AliVEvent *ev);
+   void                    PrepareMixEntry(Int_t idHandler, Int_t idEntryList, Long64_t entryMix, TChainElement *te, Long64_t entryInTree);
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
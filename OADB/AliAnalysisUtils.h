@@ -49,6 +49,10 @@ class AliAnalysisUtils : public TObject {
   void SetMaxPlpChi2MV(Float_t maxPlpChi2MV) { fMaxPlpChi2MV = maxPlpChi2MV;}
   void SetMinWDistMV(Float_t minWDistMV) { fMinWDistMV = minWDistMV;}
   void SetCheckPlpFromDifferentBCMV(Bool_t checkPlpFromDifferentBCMV) { fCheckPlpFromDifferentBCMV = checkPlpFromDifferentBCMV;}
+  Int_t   GetMinPlpContribMV() const { return fMinPlpContribMV; }
+  Float_t GetMaxPlpChi2MV() const { return fMaxPlpChi2MV; }
+  Float_t GetMinWDistMV() const { return fMinWDistMV; }
+  Bool_t  GetCheckPlpFromDifferentBCMV() const { return fCheckPlpFromDifferentBCMV; }
   //SPD Pileup slection
   void SetMinPlpContribSPD(Int_t minPlpContribSPD) { fMinPlpContribSPD = minPlpContribSPD;}
   void SetMinPlpZdistSPD(Float_t minPlpZdistSPD) { fMinPlpZdistSPD = minPlpZdistSPD;}
@@ -60,6 +64,8 @@ class AliAnalysisUtils : public TObject {
   // SPD cluster-vs-tracklet cut
   void SetASPDCvsTCut(Float_t a) { fASPDCvsTCut = a; }
   void SetBSPDCvsTCut(Float_t b) { fBSPDCvsTCut = b; }
+  Float_t GetASPDCvsTCut() const { return fASPDCvsTCut; }
+  Float_t GetBSPDCvsTCut() const { return fBSPDCvsTCut; }
   
   //multiplicity selection in pp
   Float_t GetMultiplicityPercentile(AliVEvent *event, TString lMethod = "V0M", Bool_t lEmbedEventSelection = kTRUE);
@@ -29,8 +29,25 @@ using std::vector;
 #include <AliESDEvent.h>
 
 ClassImp(AliEventCutsContainer);
+ClassImp(AliEventCutsSharedDecisions);
 ClassImp(AliEventCuts);
 
+namespace {
+  /// FNV-1a hash of the bytes of v, combined into h
+  template<typename T> void HashCombine(unsigned long &h, const T &v) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&v);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      h ^= bytes[i];
+      h *= 1099511628211ul;
+    }
+  }
+
+  void HashCombine(unsigned long &h, const string &str) {
+    for (char c : str) HashCombine(h,c);
+    HashCombine(h,str.size());
+  }
+}
+
 
 
 /// Standard constructor with null selection
@@ -89,6 +106,9 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fOverrideAutoTriggerMask{false},
   fOverrideAutoPileUpCuts{false},
   fMultSelectionEvCuts{false},  
+  fShareDecision{false},
+  fNtrkl{0},
+  fDeltaVtz{0.},
   fCutStats{nullptr},
   fCutStatsAfterTrigger{nullptr},
   fCutStatsAfterMultSelection{nullptr},
@@ -131,6 +151,107 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     AddQAplotsToList();
   }
 
+  /// Decisions are only shared within an analysis train, where the event is identified
+  /// by the entry of the analysis manager (see GetEventId)
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!fShareDecision || !mgr || mgr->GetCurrentEntry() < 0) {
+    ComputeDecision(ev);
+  } else {
+    /// The decisions are attached to the event, in the same way as the AliEventCutsContainer
+    AliEventCutsSharedDecisions* shared = static_cast<AliEventCutsSharedDecisions*>(ev->FindListObject("AliEventCutsSharedDecisions"));
+    if (!shared) {
+      shared = new AliEventCutsSharedDecisions;
+      ev->AddObject(shared);
+    }
+    const unsigned long evid = GetEventId(ev);
+    if (shared->fEventId != evid) {
+      shared->fEventId = evid;
+      shared->fDecisions.clear();
+    }
+    const unsigned long hash = ConfigurationHash();
+    auto decision = std::find_if(shared->fDecisions.begin(), shared->fDecisions.end(),
+        [hash](const AliEventCutsSharedDecisions::Decision& d) { return d.fHash == hash; });
+    if (decision != shared->fDecisions.end()) {
+      fFlag = decision->fFlag;
+      fCentPercentiles[0] = decision->fCentPercentiles[0];
+      fCentPercentiles[1] = decision->fCentPercentiles[1];
+      fNtrkl = decision->fNtrkl;
+      fDeltaVtz = decision->fDeltaVtz;
+      fPrimaryVertex = decision->fPrimaryVertex;
+      fContainer = decision->fContainer;
+      if (fUseMultiplicityDependentPileUpCuts) {
+        if (fNtrkl < 20) fSPDpileupMinContributors = 3;
+        else if (fNtrkl < 50) fSPDpileupMinContributors = 4;
+        else fSPDpileupMinContributors = 5;
+      }
+    } else {
+      ComputeDecision(ev);
+      AliEventCutsSharedDecisions::Decision d;
+      d.fHash = hash;
+      d.fFlag = fFlag;
+      d.fCentPercentiles[0] = fCentPercentiles[0];
+      d.fCentPercentiles[1] = fCentPercentiles[1];
+      d.fNtrkl = fNtrkl;
+      d.fDeltaVtz = fDeltaVtz;
+      d.fPrimaryVertex = fPrimaryVertex;
+      d.fContainer = fContainer;
+      shared->fDecisions.push_back(d);
+    }
+  }
+
+  const bool allcuts = fFlag & BIT(kAllCuts);
+  if (fCutStats) {
+    for (int iCut = kNoCuts; iCut <= kAllCuts; ++iCut) {
+      if (TESTBIT(fFlag,iCut)) {
+        fCutStats->Fill(iCut);
+        if (TESTBIT(fFlag,kTrigger)) {
+          fCutStatsAfterTrigger->Fill(iCut);
+        }
+        if (TESTBIT(fFlag,kMultiplicity)) {
+          fCutStatsAfterMultSelection->Fill(iCut);
+        }
+      }
+    }
+  }
+
+  /// Filling normalisation histogram
+  array <NormMask,4> norm_masks {
+    kAnyEvent,
+    kPassesNonVertexRelatedSelections,
+    kHasReconstructedVertex,
+    kPassesAllCuts
+  };
+  for (int iC = 0; iC < 4; ++iC) {
+    if (CheckNormalisationMask(norm_masks[iC])) {
+      if (fNormalisationHist) {
+        fNormalisationHist->Fill(iC);
+      }
+    }
+  }
+
+  /// Filling the monitoring histograms (first iteration always filled, second iteration only for selected events.
+  for (int befaft = 0; befaft < 2; ++befaft) {
+    if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
+    if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
+    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],fNtrkl);
+    if (fVtz[befaft]) fVtz[befaft]->Fill(fPrimaryVertex->GetZ());
+    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(fDeltaVtz);
+    if (fUseVariablesCorrelationCuts) {
+      if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
+      if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
+      if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
+      if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(fNtrkl,fContainer.fMultTrkTPC);
+      if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
+    }
+    if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
+  }
+
+  return true;
+}
+
+/// Evaluate all the cuts on the event, setting fFlag and the quantities used to fill the QA histograms
+///
+void AliEventCuts::ComputeDecision(AliVEvent *ev) {
   /// Event selection flag, as soon as the event does not pass one cut this becomes false.
   fFlag = BIT(kNoCuts);
 
@@ -174,6 +295,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   double errTot = TMath::Sqrt(covTrc[5]+covSPD[5]);
   double errTrc = bool(fFlag & kVertexTracks) ? TMath::Sqrt(covTrc[5]) : 1.;
   double nsigTot = TMath::Abs(dz) / errTot, nsigTrc = TMath::Abs(dz) / errTrc;
+  fDeltaVtz = dz;
   if (
       (TMath::Abs(dz) <= fMaxDeltaSpdTrackAbsolute && nsigTot <= fMaxDeltaSpdTrackNsigmaSPD && nsigTrc <= fMaxDeltaSpdTrackNsigmaTrack) && // discrepancy track-SPD vertex
       (!vtSPD->IsFromVertexerZ() || TMath::Sqrt(covSPD[5]) <= fMaxResolutionSPDvertex)
@@ -183,6 +305,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   /// Pile-up rejection
   AliVMultiplicity* mult = ev->GetMultiplicity();
   const int ntrkl = mult->GetNumberOfTracklets();
+  fNtrkl = ntrkl;
   if (fUseMultiplicityDependentPileUpCuts) {
     if (ntrkl < 20) fSPDpileupMinContributors = 3;
     else if (ntrkl < 50) fSPDpileupMinContributors = 4;
@@ -246,57 +369,88 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   } else fFlag |= BIT(kCorrelations);
 
   /// Ignore SPD/tracks vertex position and reconstruction individual flags
-  bool allcuts = CheckNormalisationMask(kPassesAllCuts);
-  if (allcuts) {
+  if (CheckNormalisationMask(kPassesAllCuts)) {
     fFlag |= BIT(kAllCuts);
   }
-  if (fCutStats) {
-    for (int iCut = kNoCuts; iCut <= kAllCuts; ++iCut) {
-      if (TESTBIT(fFlag,iCut)) {
-        fCutStats->Fill(iCut);
-        if (TESTBIT(fFlag,kTrigger)) {
-          fCutStatsAfterTrigger->Fill(iCut);
-        }
-        if (TESTBIT(fFlag,kMultiplicity)) {
-          fCutStatsAfterMultSelection->Fill(iCut);
-        }
-      }
-    }
-  }
-
-  /// Filling normalisation histogram
-  array <NormMask,4> norm_masks {
-    kAnyEvent,
-    kPassesNonVertexRelatedSelections,
-    kHasReconstructedVertex,
-    kPassesAllCuts
-  };
-  for (int iC = 0; iC < 4; ++iC) {
-    if (CheckNormalisationMask(norm_masks[iC])) {
-      if (fNormalisationHist) {
-        fNormalisationHist->Fill(iC);
-      }
-    }
-  }
+}
 
-  /// Filling the monitoring histograms (first iteration always filled, second iteration only for selected events.
-  for (int befaft = 0; befaft < 2; ++befaft) {
-    if (fCentrality[befaft]) fCentrality[befaft]->Fill(fCentPercentiles[0]);
-    if (fEstimCorrelation[befaft]) fEstimCorrelation[befaft]->Fill(fCentPercentiles[1],fCentPercentiles[0]);
-    if (fMultCentCorrelation[befaft]) fMultCentCorrelation[befaft]->Fill(fCentPercentiles[0],ntrkl);
-    if (fVtz[befaft]) fVtz[befaft]->Fill(vtx->GetZ());
-    if (fDeltaTrackSPDvtz[befaft]) fDeltaTrackSPDvtz[befaft]->Fill(dz);
-    if (fUseVariablesCorrelationCuts) {
-      if (fTOFvsFB32[befaft]) fTOFvsFB32[befaft]->Fill(fContainer.fMultTrkFB32,fContainer.fMultTrkFB32TOF);
-      if (fTPCvsAll[befaft])  fTPCvsAll[befaft]->Fill(fContainer.fMultTrkTPC,float(fContainer.fMultESD) - fESDvsTPConlyLinearCut[1] * fContainer.fMultTrkTPC);
-      if (fMultvsV0M[befaft]) fMultvsV0M[befaft]->Fill(GetCentrality(),fContainer.fMultTrkFB32Acc);
-      if (fTPCvsTrkl[befaft]) fTPCvsTrkl[befaft]->Fill(ntrkl,fContainer.fMultTrkTPC);
-      if (fVZEROvsTPCout[befaft]) fVZEROvsTPCout[befaft]->Fill(fContainer.fMultTrkTPCout,fContainer.fMultVZERO);
-    }
-    if (!allcuts) return false; /// Do not fill the "after" histograms if the event does not pass the cuts.
-  }
+/// Identifier of the event, used to recognise the event in the objects attached to it.
+/// Within an analysis train the event is identified by the entry of the analysis manager,
+/// as the bunch crossing, orbit and period numbers are not filled in MC (and the time
+/// stamp has a resolution of one second). Without analysis manager the bunch crossing,
+/// orbit and period numbers are used.
+///
+unsigned long AliEventCuts::GetEventId(AliVEvent *ev) {
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  if (mgr && mgr->GetCurrentEntry() >= 0)
+    return (unsigned long)(mgr->GetCurrentEntry()) + 1ul;
+  return ((unsigned long)(ev->GetPeriodNumber()) << 36) | ((unsigned long)(ev->GetOrbitNumber()) << 12) |
+    (ev->GetBunchCrossNumber() & 0xfff);
+}
 
-  return true;
+/// Hash of all the settings entering the event selection: instances with the same hash
+/// take the same decision on the same event.
+///
+unsigned long AliEventCuts::ConfigurationHash() const {
+  unsigned long h = 14695981039346656037ul;
+  HashCombine(h,fMC);
+  HashCombine(h,fRequireTrackVertex);
+  HashCombine(h,fMinVtz);
+  HashCombine(h,fMaxVtz);
+  HashCombine(h,fMaxDeltaSpdTrackAbsolute);
+  HashCombine(h,fMaxDeltaSpdTrackNsigmaSPD);
+  HashCombine(h,fMaxDeltaSpdTrackNsigmaTrack);
+  HashCombine(h,fMaxResolutionSPDvertex);
+  HashCombine(h,fCheckAODvertex);
+  HashCombine(h,fRejectDAQincomplete);
+  HashCombine(h,fRequiredSolenoidPolarity);
+  /// With the multiplicity dependent pile-up cuts fSPDpileupMinContributors is set event by event
+  HashCombine(h,fUseMultiplicityDependentPileUpCuts);
+  if (!fUseMultiplicityDependentPileUpCuts) HashCombine(h,fSPDpileupMinContributors);
+  HashCombine(h,fSPDpileupMinZdist);
+  HashCombine(h,fSPDpileupNsigmaZdist);
+  HashCombine(h,fSPDpileupNsigmaDiamXY);
+  HashCombine(h,fSPDpileupNsigmaDiamZ);
+  HashCombine(h,fTrackletBGcut);
+  if (fTrackletBGcut) {
+    HashCombine(h,fUtils.GetASPDCvsTCut());
+    HashCombine(h,fUtils.GetBSPDCvsTCut());
+  }
+  HashCombine(h,fPileUpCutMV);
+  if (fPileUpCutMV) {
+    HashCombine(h,fUtils.GetMinPlpContribMV());
+    HashCombine(h,fUtils.GetMaxPlpChi2MV());
+    HashCombine(h,fUtils.GetMinWDistMV());
+    HashCombine(h,fUtils.GetCheckPlpFromDifferentBCMV());
+  }
+  HashCombine(h,fCentralityFramework);
+  HashCombine(h,fMinCentrality);
+  HashCombine(h,fMaxCentrality);
+  HashCombine(h,fCentEstimators[0]);
+  HashCombine(h,fCentEstimators[1]);
+  HashCombine(h,fMultSelectionEvCuts);
+  HashCombine(h,fSelectInelGt0);
+  HashCombine(h,fUseVariablesCorrelationCuts);
+  HashCombine(h,fUseEstimatorsCorrelationCut);
+  HashCombine(h,fUseStrongVarCorrelationCut);
+  HashCombine(h,fEstimatorsCorrelationCoef);
+  HashCombine(h,fEstimatorsSigmaPars);
+  HashCombine(h,fDeltaEstimatorNsigma);
+  HashCombine(h,fTOFvsFB32correlationPars);
+  HashCombine(h,fTOFvsFB32sigmaPars);
+  HashCombine(h,fTOFvsFB32nSigmaCut);
+  HashCombine(h,fESDvsTPConlyLinearCut);
+  HashCombine(h,fFB128vsTrklLinearCut);
+  HashCombine(h,fVZEROvsTPCoutPolCut);
+  HashCombine(h,bool(fMultiplicityV0McorrCut));
+  if (fMultiplicityV0McorrCut) {
+    HashCombine(h,string(fMultiplicityV0McorrCut->GetTitle()));
+    for (int iP = 0; iP < fMultiplicityV0McorrCut->GetNpar(); ++iP)
+      HashCombine(h,fMultiplicityV0McorrCut->GetParameter(iP));
+  }
+  HashCombine(h,fRequireExactTriggerMask);
+  HashCombine(h,fTriggerMask);
+  return h;
 }
 
 void AliEventCuts::AddQAplotsToList(TList *qaList, bool addCorrelationPlots) {
@@ -462,7 +616,7 @@ string AliEventCuts::GetCentralityEstimator (unsigned int estimator) const {
 void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
   AliEventCutsContainer* tmp_cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
   if (tmp_cont) {
-    unsigned long evid = ((unsigned long)(ev->GetBunchCrossNumber()) << 32) + ev->GetTimeStamp();
+    unsigned long evid = GetEventId(ev);
     fNewEvent = (tmp_cont->fEventId != evid);
     tmp_cont->fEventId = evid;
 
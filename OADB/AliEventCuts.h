@@ -7,6 +7,7 @@
 #include <cmath>
 #include <string>
 using std::string;
+#include <vector>
 
 #include "AliVEvent.h"
 #include "AliAnalysisUtils.h"
@@ -41,6 +42,29 @@ class AliEventCutsContainer : public TNamed {
   ClassDef(AliEventCutsContainer,2)
 };
 
+/// Decisions of the AliEventCuts with shared selection (see AliEventCuts::UseSharedDecision)
+/// for the current event, identified by the hash of the cut configuration.
+class AliEventCutsSharedDecisions : public TNamed {
+  public:
+    AliEventCutsSharedDecisions() : TNamed("AliEventCutsSharedDecisions","AliEventCutsSharedDecisions"),
+    fEventId(0u),
+    fDecisions() {}
+
+    struct Decision {
+      unsigned long fHash;
+      unsigned long fFlag;
+      float fCentPercentiles[2];
+      int fNtrkl;
+      double fDeltaVtz;
+      AliVVertex* fPrimaryVertex;
+      AliEventCutsContainer fContainer;
+    };
+
+    unsigned long fEventId;
+    std::vector<Decision> fDecisions; //!<!
+  ClassDef(AliEventCutsSharedDecisions,1)
+};
+
 class AliEventCuts : public TList {
   public:
     AliEventCuts(bool savePlots = false);
@@ -85,6 +109,9 @@ class AliEventCuts : public TList {
     void   SetupRun1pA(int iPeriod);
     void   SetupRun2pA(int iPeriod);
     void   UseMultSelectionEventSelection(bool useIt = true);
+    /// Reuse the decision of another AliEventCuts with the same settings that already processed the current event.
+    /// The QA histograms of each instance are still filled. Only effective when the events are read by the analysis manager.
+    void   UseSharedDecision(bool useIt = true) { fShareDecision = useIt; }
 
     static bool GoodPrimaryAODVertex(AliVEvent *ev);
 
@@ -158,6 +185,9 @@ class AliEventCuts : public TList {
     AliEventCuts operator=(const AliEventCuts& copy);
     void          AutomaticSetup (AliVEvent *ev);
     void          ComputeTrackMultiplicity(AliVEvent *ev);
+    void          ComputeDecision(AliVEvent *ev);
+    unsigned long ConfigurationHash() const;
+    static unsigned long GetEventId(AliVEvent *ev);
     template<typename F> F PolN(F x, F* coef, int n);
 
     bool          fManualMode;                    ///< if true the cuts are not loaded automatically looking at the run number
@@ -175,6 +205,10 @@ class AliEventCuts : public TList {
     bool          fOverrideAutoTriggerMask;       ///<  If true the trigger mask chosen by the user is not overridden by the Automatic Setup
     bool          fOverrideAutoPileUpCuts;        ///<  If true the pile-up cuts are defined by the user.
     bool          fMultSelectionEvCuts;           ///< Enable/Disable the event selection applied in the AliMultSelection framework
+    bool          fShareDecision;                 ///< If true the decision is shared with the other AliEventCuts with the same settings
+
+    int           fNtrkl;                         //!<! Number of SPD tracklets of the current event
+    double        fDeltaVtz;                      //!<! Difference between the track and the SPD vertex z of the current event
     
     /// The following pointers are used to avoid the intense usage of FindObject. The objects pointed are owned by (TList*)this.
     TH1D* fCutStats;               //!<! Cuts statistics: every column keeps track of how many times a cut is passed independently from the other cuts.
@@ -196,7 +230,7 @@ class AliEventCuts : public TList {
     AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
     AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
 
-    ClassDef(AliEventCuts,6)
+    ClassDef(AliEventCuts,7)
 };
 
 template<typename F> F AliEventCuts::PolN(F x,F* coef, int n) {
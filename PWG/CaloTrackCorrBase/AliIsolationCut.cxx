@@ -14,6 +14,7 @@
  **************************************************************************/
 
 // --- ROOT system ---
+#include <algorithm>
 #include <TObjArray.h>
 
 // --- AliRoot system ---
@@ -54,7 +55,17 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fProfileCandidate(0x0),
+fProfileEta(),
+fProfilePhi(),
+fProfilePt(),
+fProfileRad(),
+fProfileIsTrack(),
+fProfileConeRad(),
+fProfileConeSumTrack(),
+fProfileConeSumCluster(),
+fProfileConePtLead()
 {
   InitParameters();
 }
@@ -392,6 +403,112 @@ void AliIsolationCut::InitParameters()
   fDistMinToTrigger = -1.; // no effect
 }
 
+//________________________________________________________________________________
+/// Get the kinematics of a track or mixed event track around the candidate.
+/// \return kFALSE if the track is a daughter of the candidate or of unknown type.
+/// Phi is returned in [0,2pi].
+//________________________________________________________________________________
+Bool_t AliIsolationCut::GetTrackKinematics(TObject * obj, AliCaloTrackReader * reader,
+                                           AliCaloTrackParticleCorrelation * pCandidate,
+                                           Float_t & pt, Float_t & eta, Float_t & phi)
+{
+  AliVTrack* track = dynamic_cast<AliVTrack*>(obj) ;
+  
+  if(track)
+  {
+    // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
+    // do not count the candidate or the daughters of the candidate
+    // in the isolation conte
+    if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
+    {
+      Int_t  trackID   = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
+      
+      for(Int_t i = 0; i < 4; i++)
+      {
+        if( trackID == pCandidate->GetTrackLabel(i) ) return kFALSE;
+      }
+    }
+    
+    fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+    pt  = fTrackVector.Pt();
+    eta = fTrackVector.Eta();
+    phi = fTrackVector.Phi() ;
+  }
+  else
+  {// Mixed event stored in AliCaloTrackParticles
+    AliCaloTrackParticle * trackmix = dynamic_cast<AliCaloTrackParticle*>(obj) ;
+    if(!trackmix)
+    {
+      AliWarning("Wrong track data type, continue");
+      return kFALSE;
+    }
+    
+    pt  = trackmix->Pt();
+    eta = trackmix->Eta();
+    phi = trackmix->Phi() ;
+  }
+  
+  if ( phi < 0 ) phi+=TMath::TwoPi();
+  
+  return kTRUE;
+}
+
+//________________________________________________________________________________
+/// Get the kinematics of a cluster or mixed event cluster around the candidate.
+/// \return kFALSE if the cluster is part of the candidate, is track matched
+/// and must be rejected, or is of unknown type. Phi is returned in [0,2pi].
+//________________________________________________________________________________
+Bool_t AliIsolationCut::GetClusterKinematics(TObject * obj, AliCaloTrackReader * reader, AliCaloPID * pid,
+                                             AliCaloTrackParticleCorrelation * pCandidate,
+                                             Float_t & pt, Float_t & eta, Float_t & phi)
+{
+  AliVCluster * calo = dynamic_cast<AliVCluster *>(obj) ;
+  
+  if(calo)
+  {
+    // Get the index where the cluster comes, to retrieve the corresponding vertex
+    Int_t evtIndex = 0 ;
+    if (reader->GetMixedEvent())
+      evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+    
+    
+    // Do not count the candidate (photon or pi0) or the daughters of the candidate
+    if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
+       calo->GetID() == pCandidate->GetCaloLabel(1)   ) return kFALSE ;
+    
+    // Skip matched clusters with tracks in case of neutral+charged analysis
+    if(fIsTMClusterInConeRejected)
+    {
+      if( fPartInCone == kNeutralAndCharged &&
+         pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) return kFALSE ;
+    }
+    
+    // Assume that come from vertex in straight line
+    calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+    
+    pt  = fMomentum.Pt()  ;
+    eta = fMomentum.Eta() ;
+    phi = fMomentum.Phi() ;
+  }
+  else
+  {// Mixed event stored in AliCaloTrackParticles
+    AliCaloTrackParticle * calomix = dynamic_cast<AliCaloTrackParticle*>(obj) ;
+    if(!calomix)
+    {
+      AliWarning("Wrong calo data type, continue");
+      return kFALSE;
+    }
+    
+    pt  = calomix->Pt();
+    eta = calomix->Eta();
+    phi = calomix->Phi() ;
+  }
+  
+  if( phi < 0 ) phi+=TMath::TwoPi();
+  
+  return kTRUE;
+}
+
 //________________________________________________________________________________
 /// Declare a candidate particle isolated depending on the
 /// cluster or track particle multiplicity and/or momentum.
@@ -464,47 +581,10 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
     {
       AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
       
-      if(track)
-      {
-        // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
-        // do not count the candidate or the daughters of the candidate
-        // in the isolation conte
-        if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS ) // make sure conversions are tagged as kCTS!!!
-        {
-          Int_t  trackID   = reader->GetTrackID(track) ; // needed instead of track->GetID() since AOD needs some manipulations
-          Bool_t contained = kFALSE;
-          
-          for(Int_t i = 0; i < 4; i++) 
-          {
-            if( trackID == pCandidate->GetTrackLabel(i) ) contained = kTRUE;
-          }
-          
-          if ( contained ) continue ;
-        }
-        
-        fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
-        pt  = fTrackVector.Pt();
-        eta = fTrackVector.Eta();
-        phi = fTrackVector.Phi() ;
-      }
-      else
-      {// Mixed event stored in AliCaloTrackParticles
-        AliCaloTrackParticle * trackmix = dynamic_cast<AliCaloTrackParticle*>(plCTS->At(ipr)) ;
-        if(!trackmix)
-        {
-          AliWarning("Wrong track data type, continue");
-          continue;
-        }
-        
-        pt  = trackmix->Pt();
-        eta = trackmix->Eta();
-        phi = trackmix->Phi() ;
-      }
+      if( !GetTrackKinematics(plCTS->At(ipr), reader, pCandidate, pt, eta, phi) ) continue ;
       
       // ** Calculate distance between candidate and tracks **
       
-      if ( phi < 0 ) phi+=TMath::TwoPi();
-      
       rad = Radius(etaC, phiC, eta, phi);
       
       // ** Exclude tracks too close to the candidate, inactive by default **
@@ -610,50 +690,10 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
     {
       AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
       
-      if(calo)
-      {
-        // Get the index where the cluster comes, to retrieve the corresponding vertex
-        Int_t evtIndex = 0 ;
-        if (reader->GetMixedEvent())
-          evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
-        
-        
-        // Do not count the candidate (photon or pi0) or the daughters of the candidate
-        if(calo->GetID() == pCandidate->GetCaloLabel(0) ||
-           calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
-        
-        // Skip matched clusters with tracks in case of neutral+charged analysis
-        if(fIsTMClusterInConeRejected)
-        {
-          if( fPartInCone == kNeutralAndCharged &&
-             pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
-        }
-        
-        // Assume that come from vertex in straight line
-        calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
-        
-        pt  = fMomentum.Pt()  ;
-        eta = fMomentum.Eta() ;
-        phi = fMomentum.Phi() ;
-      }
-      else
-      {// Mixed event stored in AliCaloTrackParticles
-        AliCaloTrackParticle * calomix = dynamic_cast<AliCaloTrackParticle*>(plNe->At(ipr)) ;
-        if(!calomix)
-        {
-          AliWarning("Wrong calo data type, continue");
-          continue;
-        }
-        
-        pt  = calomix->Pt();
-        eta = calomix->Eta();
-        phi = calomix->Phi() ;
-      }
+      if( !GetClusterKinematics(plNe->At(ipr), reader, pid, pCandidate, pt, eta, phi) ) continue ;
       
       // ** Calculate distance between candidate and tracks **
       
-      if( phi < 0 ) phi+=TMath::TwoPi();
-      
       rad = Radius(etaC, phiC, eta, phi);
       
       // ** Exclude clusters too close to the candidate, inactive by default **
@@ -762,6 +802,243 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
     if(reftracks)	  pCandidate->AddObjArray(reftracks);
   }
   
+  CheckIsolation(reader, pCandidate, ptC, etaC, phiC,
+                 coneptsumCluster, coneptsumTrack,
+                 phiBandPtSumTrack, etaBandPtSumTrack,
+                 phiBandPtSumCluster, etaBandPtSumCluster,
+                 n, nfrac, coneptsum, ptLead, isolated);
+}
+
+//________________________________________________________________________________
+/// Store the tracks and clusters around the candidate, selected as in MakeIsolationCut(),
+/// with their distance to the candidate. The same side particles are sorted by distance
+/// and their cumulated pT sums and leading pT kept, so that MakeIsolationCutFromConeProfile()
+/// can be called afterwards for any cone size and threshold without looping again on the
+/// input lists. The profile does not depend on the cone size and thresholds, only on the
+/// type of particles in cone, the track matching rejection and the minimum distance to trigger.
+///
+/// \param plCTS: List of tracks.
+/// \param plNe: List of clusters.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+/// \param pCandidate: Kinematics and + of candidate particle for isolation.
+//________________________________________________________________________________
+void  AliIsolationCut::FillConeProfile(TObjArray * plCTS,
+                                       TObjArray * plNe,
+                                       AliCaloTrackReader * reader,
+                                       AliCaloPID * pid,
+                                       AliCaloTrackParticleCorrelation  *pCandidate)
+{
+  fProfileCandidate = pCandidate;
+  
+  fProfileEta    .clear();
+  fProfilePhi    .clear();
+  fProfilePt     .clear();
+  fProfileRad    .clear();
+  fProfileIsTrack.clear();
+  
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Float_t pt     = -100. ;
+  Float_t eta    = -100. ;
+  Float_t phi    = -100. ;
+  Float_t rad    = -100. ;
+  
+  if(plCTS &&
+     (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
+  {
+    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    {
+      if( !GetTrackKinematics(plCTS->At(ipr), reader, pCandidate, pt, eta, phi) ) continue ;
+      
+      rad = Radius(etaC, phiC, eta, phi);
+      
+      if(rad < fDistMinToTrigger) continue ;
+      
+      fProfileEta    .push_back(eta);
+      fProfilePhi    .push_back(phi);
+      fProfilePt     .push_back(pt);
+      fProfileRad    .push_back(rad);
+      fProfileIsTrack.push_back(kTRUE);
+    }
+  }
+  
+  if(plNe &&
+     (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
+  {
+    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    {
+      if( !GetClusterKinematics(plNe->At(ipr), reader, pid, pCandidate, pt, eta, phi) ) continue ;
+      
+      rad = Radius(etaC, phiC, eta, phi);
+      
+      if(rad < fDistMinToTrigger) continue ;
+      
+      fProfileEta    .push_back(eta);
+      fProfilePhi    .push_back(phi);
+      fProfilePt     .push_back(pt);
+      fProfileRad    .push_back(rad);
+      fProfileIsTrack.push_back(kFALSE);
+    }
+  }
+  
+  // Sort the same side particles by distance to the candidate and
+  // cumulate their pT, entry i covers the particles closer than fProfileConeRad[i]
+  std::vector< std::pair<Float_t,Int_t> > sameSide;
+  sameSide.reserve(fProfileRad.size());
+  for(UInt_t ip = 0; ip < fProfileRad.size(); ip++)
+  {
+    if(TMath::Abs(fProfilePhi[ip]-phiC) > TMath::PiOver2()) continue ;
+    
+    sameSide.push_back(std::make_pair(fProfileRad[ip], (Int_t) ip));
+  }
+  
+  std::sort(sameSide.begin(), sameSide.end());
+  
+  fProfileConeRad       .resize(sameSide.size());
+  fProfileConeSumTrack  .resize(sameSide.size()+1);
+  fProfileConeSumCluster.resize(sameSide.size()+1);
+  fProfileConePtLead    .resize(sameSide.size()+1);
+  
+  fProfileConeSumTrack  [0] = 0;
+  fProfileConeSumCluster[0] = 0;
+  fProfileConePtLead    [0] = 0;
+  
+  for(UInt_t is = 0; is < sameSide.size(); is++)
+  {
+    Int_t ip = sameSide[is].second;
+    
+    fProfileConeRad[is] = sameSide[is].first;
+    
+    fProfileConeSumTrack  [is+1] = fProfileConeSumTrack  [is] + (  fProfileIsTrack[ip] ? fProfilePt[ip] : 0 );
+    fProfileConeSumCluster[is+1] = fProfileConeSumCluster[is] + ( !fProfileIsTrack[ip] ? fProfilePt[ip] : 0 );
+    fProfileConePtLead    [is+1] = TMath::Max(fProfileConePtLead[is], fProfilePt[ip]);
+  }
+  
+  AliDebug(1,Form("Candidate pT %2.2f, eta %2.2f, phi %2.2f, %d particles in profile, %d at the same side",
+                  pCandidate->Pt(), etaC, phiC*TMath::RadToDeg(), (Int_t) fProfileRad.size(), (Int_t) sameSide.size()));
+}
+
+//________________________________________________________________________________
+/// Same as MakeIsolationCut() with bFillAOD false, for the current cone size and
+/// thresholds, but using the particles stored by the last FillConeProfile() call
+/// for this candidate. The cone sums and leading pT are obtained from a binary
+/// search on the sorted distances, the UE bands are only summed for kSumBkgSubIC.
+///
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pCandidate: Kinematics and + of candidate particle for isolation.
+/// \param n: number of tracks/clusters above threshold in cone, output.
+/// \param nfrac: 1 if fraction pT cluster-track / pT trigger in cone avobe threshold, output.
+/// \param coneptsum: total momentum energy in cone (track+cluster), output.
+/// \param ptLead: momentum of leading cluster or track in cone, output.
+/// \param isolated: final bool with decission on isolation of candidate particle.
+//________________________________________________________________________________
+void  AliIsolationCut::MakeIsolationCutFromConeProfile(AliCaloTrackReader * reader,
+                                                       AliCaloTrackParticleCorrelation  *pCandidate,
+                                                       Int_t   & n,
+                                                       Int_t   & nfrac,
+                                                       Float_t & coneptsum, Float_t & ptLead,
+                                                       Bool_t  & isolated)
+{
+  n         = 0 ;
+  nfrac     = 0 ;
+  isolated  = kFALSE;
+  
+  if(pCandidate != fProfileCandidate)
+  {
+    AliWarning("Cone profile not filled for this candidate, call FillConeProfile() first");
+    return;
+  }
+  
+  Float_t ptC   = pCandidate->Pt() ;
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  // Same side particles with rad < fConeSize
+  Int_t nInCone = std::lower_bound(fProfileConeRad.begin(), fProfileConeRad.end(), fConeSize) - fProfileConeRad.begin();
+  
+  Float_t coneptsumTrack   = fProfileConeSumTrack  [nInCone];
+  Float_t coneptsumCluster = fProfileConeSumCluster[nInCone];
+  
+  if( ptLead < fProfileConePtLead[nInCone] ) ptLead = fProfileConePtLead[nInCone];
+  
+  // ** For the background out of cone **
+  
+  Float_t  etaBandPtSumTrack   = 0;
+  Float_t  phiBandPtSumTrack   = 0;
+  Float_t  etaBandPtSumCluster = 0;
+  Float_t  phiBandPtSumCluster = 0;
+  
+  if( fICMethod == kSumBkgSubIC )
+  {
+    for(UInt_t ip = 0; ip < fProfileRad.size(); ip++)
+    {
+      if(fProfileRad[ip] <= fConeSize) continue ;
+      
+      Float_t pt  = fProfilePt [ip];
+      Float_t eta = fProfileEta[ip];
+      Float_t phi = fProfilePhi[ip];
+      
+      if(fProfileIsTrack[ip])
+      {
+        if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumTrack += pt;
+        if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumTrack += pt;
+      }
+      else
+      {
+        if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSumCluster += pt;
+        if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSumCluster += pt;
+      }
+    }
+  }
+  
+  AliDebug(1,Form("Candidate pT %2.2f, cone %1.2f, thres %2.2f, %d particles in cone",
+                  ptC, fConeSize, fPtThreshold, nInCone));
+  
+  CheckIsolation(reader, pCandidate, ptC, etaC, phiC,
+                 coneptsumCluster, coneptsumTrack,
+                 phiBandPtSumTrack, etaBandPtSumTrack,
+                 phiBandPtSumCluster, etaBandPtSumCluster,
+                 n, nfrac, coneptsum, ptLead, isolated);
+}
+
+//_________________________________________________________________________________________________
+/// Apply the isolation criteria of the selected method to the cone sums and leading pT
+/// of a candidate, filled either by MakeIsolationCut() or by MakeIsolationCutFromConeProfile().
+/// \param reader: pointer to AliCaloTrackReader. Needed for UE normalization and cell density.
+/// \param pCandidate: pointer to AliCaloTrackParticleCorrelation candidate.
+/// \param ptC: candidate transverse momentum.
+/// \param etaC: candidate pseudorapidity.
+/// \param phiC: candidate azimuthal angle, in [0,2pi].
+/// \param coneptsumCluster: sum of pT of clusters in cone.
+/// \param coneptsumTrack: sum of pT of tracks in cone.
+/// \param phiBandPtSumTrack: sum of pT of tracks in phi band.
+/// \param etaBandPtSumTrack: sum of pT of tracks in eta band.
+/// \param phiBandPtSumCluster: sum of pT of clusters in phi band.
+/// \param etaBandPtSumCluster: sum of pT of clusters in eta band.
+/// \param n: number of particles in cone above threshold (0 or 1).
+/// \param nfrac: number of particles in cone above fraction threshold (0 or 1).
+/// \param coneptsum: total sum of pT in cone (UE subtracted for kSumBkgSubIC).
+/// \param ptLead: pT of leading particle in cone.
+/// \param isolated: final isolation decision.
+//_________________________________________________________________________________________________
+void AliIsolationCut::CheckIsolation(AliCaloTrackReader * reader,
+                                     AliCaloTrackParticleCorrelation * pCandidate,
+                                     Float_t ptC, Float_t etaC, Float_t phiC,
+                                     Float_t coneptsumCluster,    Float_t coneptsumTrack,
+                                     Float_t phiBandPtSumTrack,   Float_t etaBandPtSumTrack,
+                                     Float_t phiBandPtSumCluster, Float_t etaBandPtSumCluster,
+                                     Int_t   & n, Int_t & nfrac,
+                                     Float_t & coneptsum, Float_t ptLead,
+                                     Bool_t  & isolated)
+{
+  n         = 0 ;
+  nfrac     = 0 ;
+  isolated  = kFALSE;
+  
   coneptsum = coneptsumCluster + coneptsumTrack;
   
   // *Now*, just check the leading particle in the cone if the threshold is passed
@@ -19,6 +19,7 @@
 //_________________________________________________________________________
 
 // --- ROOT system ---
+#include <vector>
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
@@ -59,6 +60,17 @@ class AliIsolationCut : public TObject {
                               AliCaloTrackParticleCorrelation  * pCandidate, TString aodObjArrayName,
                               Int_t &n, Int_t & nfrac, Float_t &ptSum, Float_t &ptLead, Bool_t & isolated) ;
 
+  // Several cones and thresholds from a single pass on the particles
+
+  void       FillConeProfile(TObjArray * plCTS, TObjArray * plNe,
+                             AliCaloTrackReader * reader,
+                             AliCaloPID * pid,
+                             AliCaloTrackParticleCorrelation  * pCandidate) ;
+
+  void       MakeIsolationCutFromConeProfile(AliCaloTrackReader * reader,
+                                             AliCaloTrackParticleCorrelation  * pCandidate,
+                                             Int_t &n, Int_t & nfrac, Float_t &ptSum, Float_t &ptLead, Bool_t & isolated) ;
+
   void       Print(const Option_t * opt) const ;
 
   Float_t    Radius(Float_t etaCandidate, Float_t phiCandidate, Float_t eta, Float_t phi) const ;
@@ -112,6 +124,23 @@ class AliIsolationCut : public TObject {
     
  private:
 
+  Bool_t     GetTrackKinematics  (TObject * obj, AliCaloTrackReader * reader,
+                                  AliCaloTrackParticleCorrelation * pCandidate,
+                                  Float_t & pt, Float_t & eta, Float_t & phi) ;
+
+  Bool_t     GetClusterKinematics(TObject * obj, AliCaloTrackReader * reader, AliCaloPID * pid,
+                                  AliCaloTrackParticleCorrelation * pCandidate,
+                                  Float_t & pt, Float_t & eta, Float_t & phi) ;
+
+  void       CheckIsolation(AliCaloTrackReader * reader,
+                            AliCaloTrackParticleCorrelation * pCandidate,
+                            Float_t ptC, Float_t etaC, Float_t phiC,
+                            Float_t coneptsumCluster,    Float_t coneptsumTrack,
+                            Float_t phiBandPtSumTrack,   Float_t etaBandPtSumTrack,
+                            Float_t phiBandPtSumCluster, Float_t etaBandPtSumCluster,
+                            Int_t & n, Int_t & nfrac, Float_t & coneptsum, Float_t ptLead,
+                            Bool_t & isolated) ;
+
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -140,6 +169,26 @@ class AliIsolationCut : public TObject {
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  AliCaloTrackParticleCorrelation * fProfileCandidate; //!<! Candidate of the last FillConeProfile() call.
+
+  std::vector<Float_t>  fProfileEta;           //!<! Eta of the selected particles around the candidate.
+
+  std::vector<Float_t>  fProfilePhi;           //!<! Phi of the selected particles around the candidate.
+
+  std::vector<Float_t>  fProfilePt;            //!<! pT of the selected particles around the candidate.
+
+  std::vector<Float_t>  fProfileRad;           //!<! Distance to the candidate of the selected particles.
+
+  std::vector<Bool_t>   fProfileIsTrack;       //!<! Selected particle is a track, else a cluster.
+
+  std::vector<Float_t>  fProfileConeRad;       //!<! Distance of the same side particles, sorted.
+
+  std::vector<Double_t> fProfileConeSumTrack;  //!<! Sum pT of tracks closer than fProfileConeRad[i].
+
+  std::vector<Double_t> fProfileConeSumCluster;//!<! Sum pT of clusters closer than fProfileConeRad[i].
+
+  std::vector<Float_t>  fProfileConePtLead;    //!<! Leading pT of particles closer than fProfileConeRad[i].
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -0,0 +1,66 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// Task filling the NanoAOD track array with AliVTrack views on the
+// columnar track storage, see header for details
+
+#include "TClonesArray.h"
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliNanoAODColumns.h"
+
+#include "AliAnalysisTaskNanoAODColumnReader.h"
+
+ClassImp(AliAnalysisTaskNanoAODColumnReader)
+
+//________________________________________________________________________
+AliAnalysisTaskNanoAODColumnReader::AliAnalysisTaskNanoAODColumnReader()
+  : AliAnalysisTaskSE(),
+  fTrackArrayName("tracks"),
+  fColumnsName(AliNanoAODColumns::StdBranchName())
+{
+  // Dummy constructor ALWAYS needed for I/O.
+}
+
+//________________________________________________________________________
+AliAnalysisTaskNanoAODColumnReader::AliAnalysisTaskNanoAODColumnReader(const char *name)
+  : AliAnalysisTaskSE(name),
+  fTrackArrayName("tracks"),
+  fColumnsName(AliNanoAODColumns::StdBranchName())
+{
+  // Constructor
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskNanoAODColumnReader::UserExec(Option_t *)
+{
+  // Fills the track array with one view per stored track
+
+  AliVEvent *event = InputEvent();
+  if (!event) return;
+
+  AliNanoAODColumns *columns = dynamic_cast<AliNanoAODColumns*>(event->FindListObject(fColumnsName));
+  if (!columns) {
+    AliFatal(Form("No %s in the event: not a columnar NanoAOD", fColumnsName.Data()));
+    return;
+  }
+  TClonesArray *tracks = dynamic_cast<TClonesArray*>(event->FindListObject(fTrackArrayName));
+  if (!tracks) {
+    AliFatal(Form("No track array %s in the event", fTrackArrayName.Data()));
+    return;
+  }
+  columns->FillTracks(tracks);
+}
@@ -0,0 +1,41 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* AliAnalysisTaskNanoAODColumnReader.h
+ *
+ * Makes NanoAODs written in the columnar layout (AliNanoAODColumns,
+ * see AliAnalysisTaskNanoAODFilter::SetColumnar) readable by tasks
+ * running on AliVTrack: for each event the (empty) track array is
+ * filled with AliNanoAODColumnTrack views on the columns.
+ * Has to be added before the tasks reading the tracks.
+ */
+#ifndef ALIANALYSISTASKNANOAODCOLUMNREADER_H
+#define ALIANALYSISTASKNANOAODCOLUMNREADER_H
+
+#ifndef ALIANALYSISTASKSE_H
+#include "AliAnalysisTaskSE.h"
+#endif
+
+class AliAnalysisTaskNanoAODColumnReader : public AliAnalysisTaskSE {
+public:
+  AliAnalysisTaskNanoAODColumnReader();
+  AliAnalysisTaskNanoAODColumnReader(const char *name);
+  virtual ~AliAnalysisTaskNanoAODColumnReader() {}
+
+  virtual void UserCreateOutputObjects() {}
+  virtual void UserExec(Option_t *option);
+
+  void SetTrackArrayName(TString name) {fTrackArrayName=name;}
+  void SetColumnsName(TString name) {fColumnsName=name;}
+
+private:
+  TString fTrackArrayName; // name of the track array filled with the views
+  TString fColumnsName; // name of the AliNanoAODColumns object
+
+  AliAnalysisTaskNanoAODColumnReader(const AliAnalysisTaskNanoAODColumnReader&); // not implemented
+  AliAnalysisTaskNanoAODColumnReader& operator=(const AliAnalysisTaskNanoAODColumnReader&); // not implemented
+
+  ClassDef(AliAnalysisTaskNanoAODColumnReader, 1); // fills NanoAOD track views from the columnar layout
+};
+
+#endif
@@ -40,6 +40,7 @@
 #include "AliESDtrack.h"
 #include "AliAODHandler.h"
 #include "AliNanoAODReplicator.h"
+#include "AliNanoAODColumns.h"
 #include "AliNanoAODTrackMapping.h"
 
 using std::cout;
@@ -63,7 +64,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fSaveAODZDC(kFALSE),
   fSaveVzero(kFALSE),
   fInputArrayName(""),
-  fOutputArrayName("")
+  fOutputArrayName(""),
+  fColumnar(kFALSE)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -83,7 +85,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fSaveAODZDC(kFALSE),
    fSaveVzero(kFALSE),
    fInputArrayName(""),
-   fOutputArrayName("")
+   fOutputArrayName(""),
+   fColumnar(kFALSE)
 
 {
   // Constructor
@@ -143,6 +146,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   if (fVarListHeader_fTC) rep->SetVarListHeaderStringVariable(fVarListHeader_fTC);
   if (!fInputArrayName.IsNull()) rep->SetInputArrayName(fInputArrayName);
   if (!fOutputArrayName.IsNull()) rep->SetOutputArrayName(fOutputArrayName);
+  if (fColumnar) rep->SetColumnar();
 
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
 
@@ -151,6 +155,7 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
   ext->FilterBranch("tracks",rep);
   ext->FilterBranch("vertices",rep);  
   ext->FilterBranch("header",rep);  
+  if (fColumnar) ext->FilterBranch(AliNanoAODColumns::StdBranchName(),rep);
             
   if ( fMCMode > 0 ) 
     {
@@ -59,6 +59,7 @@ public:
 
   void SetInputArrayName(TString name) {fInputArrayName=name;}
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
+  void SetColumnar(Bool_t b = kTRUE) {fColumnar=b;}
 
 private:
   Int_t fMCMode; // true if processing monte carlo. if > 1 not all MC particles are filtered
@@ -77,11 +78,12 @@ private:
 
   TString fInputArrayName; // name of TObjectArray of Tracks
   TString fOutputArrayName; // name of TObjectArray of AliNanoAODTracks
+  Bool_t fColumnar; // if kTRUE the tracks are written in the columnar layout (AliNanoAODColumns)
 
   AliAnalysisTaskNanoAODFilter(const AliAnalysisTaskNanoAODFilter&); // not implemented
   AliAnalysisTaskNanoAODFilter& operator=(const AliAnalysisTaskNanoAODFilter&); // not implemented
 
-  ClassDef(AliAnalysisTaskNanoAODFilter, 4); // example of analysis
+  ClassDef(AliAnalysisTaskNanoAODFilter, 5); // example of analysis
 };
 
 #endif
@@ -0,0 +1,204 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     AliVTrack adapter for the columnar NanoAOD layout
+//     See header for details
+//-------------------------------------------------------------------------
+
+#include <TVector3.h>
+#include "AliLog.h"
+#include "AliExternalTrackParam.h"
+#include "AliVVertex.h"
+#include "AliDetectorPID.h"
+#include "AliNanoAODTrackMapping.h"
+
+#include "AliNanoAODColumnTrack.h"
+
+ClassImp(AliNanoAODColumnTrack)
+
+//______________________________________________________________________________
+AliNanoAODColumnTrack::AliNanoAODColumnTrack() :
+  AliVTrack(),
+  fColumns(0),
+  fIndex(-1)
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnTrack::AliNanoAODColumnTrack(const AliNanoAODColumns *columns, Int_t index) :
+  AliVTrack(),
+  fColumns(columns),
+  fIndex(index)
+{
+  // constructor: view on track index of columns
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnTrack::AliNanoAODColumnTrack(const AliNanoAODColumnTrack &trk) :
+  AliVTrack(trk),
+  fColumns(trk.fColumns),
+  fIndex(trk.fIndex)
+{
+  // copy constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumnTrack &AliNanoAODColumnTrack::operator=(const AliNanoAODColumnTrack &trk)
+{
+  // assignment operator
+  if (this != &trk) {
+    AliVTrack::operator=(trk);
+    fColumns = trk.fColumns;
+    fIndex   = trk.fIndex;
+  }
+  return *this;
+}
+
+//______________________________________________________________________________
+Double_t AliNanoAODColumnTrack::Y(Double_t m) const
+{
+  // Returns the rapidity of a particle of a given mass.
+
+  if (m >= 0.) { // mass makes sense
+    Double_t e = E(m);
+    Double_t pz = Pz();
+    if (e>=0 && e!=pz) { // energy was positive (e.g. not -999.) and not equal to pz
+      return 0.5*TMath::Log((e+pz)/(e-pz));
+    } else { // energy not known or equal to pz
+      return -999.;
+    }
+  } else { // pid unknown
+    return -999.;
+  }
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnTrack::PropagateToDCA(const AliVVertex *vtx,
+    Double_t b, Double_t maxd, Double_t dz[2], Double_t covar[3])
+{
+  // compute impact parameters to the vertex vtx and their covariance matrix
+  // b is the Bz, needed to propagate correctly the track to vertex
+  // The view is read only: unlike AliNanoAODTrack, the track position
+  // and momentum are not updated after the propagation.
+  // return kFALSE is something went wrong
+
+  // allowed only for tracks inside the beam pipe
+  Double_t posx = Get(AliNanoAODColumns::kPosX);
+  Double_t posy = Get(AliNanoAODColumns::kPosY);
+  if (posx*posx + posy*posy > 3.*3.) { // outside beampipe radius
+    AliError("This method can be used only for propagation inside the beam pipe");
+    return kFALSE;
+  }
+
+  // convert to AliExternalTrackParam
+  AliExternalTrackParam etp; etp.CopyFromVTrack(this);
+
+  // propagate
+  return etp.PropagateToDCA(vtx,b,maxd,dz,covar);
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnTrack::GetXYZAt(Double_t x, Double_t b, Double_t *r) const
+{
+  //---------------------------------------------------------------------
+  // This function returns the global track position extrapolated to
+  // the radial position "x" (cm) in the magnetic field "b" (kG)
+  //---------------------------------------------------------------------
+
+  //conversion of track parameter representation is
+  //based on the implementation of AliExternalTrackParam::Set(...)
+  //maybe some of this code can be moved to AliVTrack to avoid code duplication
+  const double kSafe = 1e-5;
+  Double_t alpha=0.0;
+  Double_t radPos2 = Get(AliNanoAODColumns::kPosX)*Get(AliNanoAODColumns::kPosX)+Get(AliNanoAODColumns::kPosY)*Get(AliNanoAODColumns::kPosY);
+  Double_t radMax  = 45.; // approximately ITS outer radius
+  if (radPos2 < radMax*radMax) { // inside the ITS     
+    alpha = TMath::ATan2(Py(),Px());
+  } else { // outside the ITS
+    Float_t phiPos = TMath::Pi()+TMath::ATan2(-Get(AliNanoAODColumns::kPosY), -Get(AliNanoAODColumns::kPosX));
+     alpha = 
+     TMath::DegToRad()*(20*((((Int_t)(phiPos*TMath::RadToDeg()))/20))+10);
+  }
+  //
+  Double_t cs=TMath::Cos(alpha), sn=TMath::Sin(alpha);
+  // protection:  avoid alpha being too close to 0 or +-pi/2
+  if (TMath::Abs(sn)<kSafe) {
+    alpha = kSafe;
+    cs=TMath::Cos(alpha);
+    sn=TMath::Sin(alpha);
+  }
+  else if (cs<kSafe) {
+    alpha -= TMath::Sign(kSafe, alpha);
+    cs=TMath::Cos(alpha);
+    sn=TMath::Sin(alpha);    
+  }
+  
+  // Get the vertex of origin and the momentum
+  TVector3 ver(Get(AliNanoAODColumns::kPosX), Get(AliNanoAODColumns::kPosY), Get(AliNanoAODColumns::kPosZ));
+  TVector3 mom(Px(),Py(),Pz());
+  //
+  // avoid momenta along axis
+  if (TMath::Abs(mom[0])<kSafe) mom[0] = TMath::Sign(kSafe*TMath::Abs(mom[1]), mom[0]);
+  if (TMath::Abs(mom[1])<kSafe) mom[1] = TMath::Sign(kSafe*TMath::Abs(mom[0]), mom[1]);
+
+  // Rotate to the local coordinate system
+  ver.RotateZ(-alpha);
+  mom.RotateZ(-alpha);
+
+  Double_t param0 = ver.Y();
+  Double_t param1 = ver.Z();
+  Double_t param2 = TMath::Sin(mom.Phi());
+  Double_t param3 = mom.Pz()/mom.Pt();
+  Double_t param4 = TMath::Sign(1/mom.Pt(),(Double_t)Charge());
+
+  //calculate the propagated coordinates
+  //this is based on AliExternalTrackParam::GetXYZAt(Double_t x, Double_t b, Double_t *r)
+  Double_t dx=x-ver.X();
+  if(TMath::Abs(dx)<=kAlmost0) return GetXYZ(r);
+
+  Double_t f1=param2;
+  Double_t f2=f1 + dx*param4*b*kB2C;
+
+  if (TMath::Abs(f1) >= kAlmost1) return kFALSE;
+  if (TMath::Abs(f2) >= kAlmost1) return kFALSE;
+  
+  Double_t r1=TMath::Sqrt((1.-f1)*(1.+f1)), r2=TMath::Sqrt((1.-f2)*(1.+f2));
+  r[0] = x;
+  r[1] = param0 + dx*(f1+f2)/(r1+r2);
+  r[2] = param1 + dx*(r2 + f2*(f1+f2)/(r1+r2))*param3;//Thanks to Andrea & Peter
+
+  return Local2GlobalPosition(r,alpha);
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODColumnTrack::GetCovarianceXYZPxPyPz(Double_t cv[21]) const
+{
+  // covariance matrix, slots resolved by AliNanoAODColumns::SetMapping
+  for (Int_t i=0; i<21; i++) cv[i] = Get(AliNanoAODColumns::EVariable(AliNanoAODColumns::kCovMat0 + i));
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumnTrack::Print(Option_t * /* option */) const
+{
+  // prints information about AliNanoAODColumnTrack
+  AliNanoAODTrackMapping *mapping = AliNanoAODTrackMapping::GetInstance();
+  printf("Track %d: label %d, charge %d\n", fIndex, GetLabel(), Charge());
+  for (Int_t index = 0; index<mapping->GetSize(); index++) {
+    printf(" - [%2.2d] %-10s : %f\n", index, mapping->GetVarName(index), GetVar(index));
+  }
+}
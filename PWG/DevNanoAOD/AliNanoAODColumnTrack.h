@@ -0,0 +1,179 @@
+#ifndef AliNanoAODColumnTrack_H
+#define AliNanoAODColumnTrack_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     AliVTrack adapter for the columnar NanoAOD layout
+//     A lightweight view on one row of AliNanoAODColumns, filled by
+//     AliNanoAODColumns::FillTracks. It offers the same accessors as
+//     AliNanoAODTrack, so that existing tasks running on AliVTrack can
+//     read the columnar layout unchanged; the variable slots are those
+//     resolved by AliNanoAODColumns::SetMapping, no mapping lookup is
+//     done per call.
+//     The view is read only and not meant to be written to file.
+//     Attempts to use a variable which was not stored produce an AliFatal
+//-------------------------------------------------------------------------
+
+#include "AliVTrack.h"
+#include "AliNanoAODColumns.h"
+
+class AliVVertex;
+class AliDetectorPID;
+class AliExternalTrackParam;
+
+class AliNanoAODColumnTrack : public AliVTrack {
+
+public:
+
+  using TObject::ClassName;
+
+  AliNanoAODColumnTrack();
+  AliNanoAODColumnTrack(const AliNanoAODColumns *columns, Int_t index);
+  virtual ~AliNanoAODColumnTrack() {}
+  AliNanoAODColumnTrack(const AliNanoAODColumnTrack &trk);
+  AliNanoAODColumnTrack &operator=(const AliNanoAODColumnTrack &trk);
+
+  const AliNanoAODColumns *GetColumns() const { return fColumns; }
+  Int_t    GetIndex() const { return fIndex; }
+  Double_t GetVar(Int_t var) const { return fColumns->GetVar(fIndex, var); }
+
+  // kinematics
+  virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
+  virtual Double_t Phi()       const { return Get(AliNanoAODColumns::kPhi); }
+  virtual Double_t Theta()     const { return Get(AliNanoAODColumns::kTheta); }
+
+  virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
+  virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
+  virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
+  virtual Double_t Pt() const { return Get(AliNanoAODColumns::kPt); }
+  virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
+  virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
+
+  // the production vertex is not stored in the columnar layout
+  virtual Double_t Xv() const { return -999.; }
+  virtual Double_t Yv() const { return -999.; }
+  virtual Double_t Zv() const { return -999.; }
+  virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0] = Xv(); x[1] = Yv(); x[2] = Zv(); return kTRUE; }
+
+  Double_t Chi2perNDF()  const { return Get(AliNanoAODColumns::kChi2PerNDF); }
+  UShort_t GetTPCNcls()  const { return Get(AliNanoAODColumns::kTPCncls); }
+
+  virtual Double_t M() const { AliFatal("Not Implemented"); return -1; }
+  virtual Double_t E() const { AliFatal("Not Implemented"); return -1; }
+  Double_t E(Double_t m) const { return TMath::Sqrt(P()*P() + m*m); }
+  virtual Double_t Y() const { AliFatal("Not Implemented"); return -1; }
+  Double_t Y(Double_t m) const;
+
+  virtual Double_t Eta() const { return -TMath::Log(TMath::Tan(0.5 * Theta())); }
+  virtual Short_t  Charge() const { return fColumns->GetCharge(fIndex); }
+  virtual Double_t GetSign() const { return Charge(); }
+  virtual Bool_t   PropagateToDCA(const AliVVertex *vtx,
+                                  Double_t b, Double_t maxd, Double_t dz[2], Double_t covar[3]);
+
+  ULong_t GetStatus() const { AliFatal("Not implemented"); return 0; }
+  Int_t   GetID() const { return (Int_t)Get(AliNanoAODColumns::kID); }
+  Int_t   GetLabel() const { return fColumns->GetLabel(fIndex); }
+
+  template <typename T> void GetP(T *p) const {
+    p[0]=Pt(); p[1]=Phi(); p[2]=Theta();}
+  Bool_t GetPxPyPz(Double_t *p) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
+
+  template <typename T> Bool_t GetPosition(T *x) const {
+    x[0]=Get(AliNanoAODColumns::kPosX); x[1]=Get(AliNanoAODColumns::kPosY); x[2]=Get(AliNanoAODColumns::kPosZ);
+    return kFALSE; }
+  Bool_t GetXYZ(Double_t *p) const { return GetPosition(p); }
+  Bool_t GetXYZAt(Double_t x, Double_t b, Double_t *r) const;
+  Bool_t GetCovarianceXYZPxPyPz(Double_t cv[21]) const;
+
+  Bool_t IsMuonTrack() const { return Get(AliNanoAODColumns::kIsMuonTrack) == 1; }
+
+  Double_t XAtDCA() const { return Get(AliNanoAODColumns::kPosDCAx); }
+  Double_t YAtDCA() const { return Get(AliNanoAODColumns::kPosDCAy); }
+  Double_t ZAtDCA() const { return IsMuonTrack() ? Get(AliNanoAODColumns::kPosZ) : -999.; }
+  Bool_t   XYZAtDCA(Double_t x[3]) const { x[0] = XAtDCA(); x[1] = YAtDCA(); x[2] = ZAtDCA(); return kTRUE; }
+  Double_t DCA() const { return IsMuonTrack() ? TMath::Sqrt(XAtDCA()*XAtDCA() + YAtDCA()*YAtDCA()) : -999.; }
+
+  Double_t PxAtDCA() const { return Get(AliNanoAODColumns::kPDCAx); }
+  Double_t PyAtDCA() const { return Get(AliNanoAODColumns::kPDCAy); }
+  Double_t PzAtDCA() const { return Get(AliNanoAODColumns::kPDCAz); }
+  Double_t PAtDCA() const { return TMath::Sqrt(PxAtDCA()*PxAtDCA() + PyAtDCA()*PyAtDCA() + PzAtDCA()*PzAtDCA()); }
+  Bool_t   PxPyPzAtDCA(Double_t p[3]) const { p[0] = PxAtDCA(); p[1] = PyAtDCA(); p[2] = PzAtDCA(); return kTRUE; }
+
+  Double_t GetRAtAbsorberEnd() const { return Get(AliNanoAODColumns::kRAtAbsorberEnd); }
+
+  UChar_t  GetITSClusterMap() const { AliFatal("Not Implemented"); return 0; }
+
+  Bool_t   TestFilterBit(UInt_t filterBit) const { return (Bool_t) ((filterBit & GetFilterMap()) != 0); }
+  UInt_t   GetFilterMap() const { return UInt_t(Get(AliNanoAODColumns::kFilterMap)); }
+
+  Float_t  GetTPCClusterInfo(Int_t /*nNeighbours=3*/, Int_t /*type=0*/, Int_t /*row0=0*/, Int_t /*row1=159*/, Int_t /*type*/=0) const { AliFatal("Not Implemented"); return 0; }
+
+  UShort_t GetTPCNclsF() const { return Get(AliNanoAODColumns::kTPCnclsF); }
+  UShort_t GetTPCnclsS() const { return Get(AliNanoAODColumns::kTPCnclsS); }
+  UShort_t GetTPCNCrossedRows() const { return Get(AliNanoAODColumns::kTPCNCrossedRows); }
+  Float_t  GetTPCFoundFraction() const { return GetTPCNCrossedRows()>0 ? float(GetTPCNcls())/GetTPCNCrossedRows() : 0; }
+
+  Double_t GetTrackPhiOnEMCal() const { return Get(AliNanoAODColumns::kTrackPhiOnEMCal); }
+  Double_t GetTrackEtaOnEMCal() const { return Get(AliNanoAODColumns::kTrackEtaOnEMCal); }
+  Double_t GetTrackPtOnEMCal() const  { return Get(AliNanoAODColumns::kTrackPtOnEMCal); }
+  Double_t GetTrackPOnEMCal() const { return TMath::Abs(GetTrackEtaOnEMCal()) < 1 ? GetTrackPtOnEMCal()*TMath::CosH(GetTrackEtaOnEMCal()) : -999; }
+
+  // pid signal interface
+  Double_t GetITSsignal()       const { return Get(AliNanoAODColumns::kITSsignal); }
+  Double_t GetTPCsignal()       const { return Get(AliNanoAODColumns::kTPCsignal); }
+  Double_t GetTPCsignalTunedOnData() const { return Get(AliNanoAODColumns::kTPCsignalTuned); }
+  UShort_t GetTPCsignalN()      const { return Get(AliNanoAODColumns::kTPCsignalN); }
+  Double_t GetTPCmomentum()     const { return Get(AliNanoAODColumns::kTPCmomentum); }
+  Double_t GetTPCTgl()          const { return Get(AliNanoAODColumns::kTPCTgl); }
+  Double_t GetTOFsignal()       const { return Get(AliNanoAODColumns::kTOFsignal); }
+  Double_t GetIntegratedLength() const { AliFatal("Not implemented"); return 0; }
+  Double_t GetTOFsignalTunedOnData() const { return Get(AliNanoAODColumns::kTOFsignalTuned); }
+  Double_t GetHMPIDsignal()     const { return Get(AliNanoAODColumns::kHMPIDsignal); }
+  Double_t GetHMPIDoccupancy()  const { return Get(AliNanoAODColumns::kHMPIDoccupancy); }
+
+  virtual void GetIntegratedTimes(Double_t */*times*/, Int_t) const { AliFatal("Not implemented"); return; }
+
+  Int_t    GetTOFBunchCrossing(Double_t /*b=0*/, Bool_t /*tpcPIDonly=kFALSE*/) const { AliFatal("Not Implemented"); return 0; }
+  UChar_t  GetTRDncls(Int_t /*layer*/) const { AliFatal("Not Implemented"); return 0; }
+  Double_t GetTRDslice(Int_t /*plane*/, Int_t /*slice*/) const { AliFatal("Not Implemented"); return 0; }
+  Double_t GetTRDmomentum(Int_t /*plane*/, Double_t */*sp*/=0x0) const { AliFatal("Not Implemented"); return 0; }
+
+  Double_t GetTRDsignal()         const { return Get(AliNanoAODColumns::kTRDsignal); }
+  Double_t GetTRDchi2()           const { return Get(AliNanoAODColumns::kTRDChi2); }
+  UChar_t  GetTRDncls()           const { return GetTRDncls(-1); }
+  Int_t    GetNumberOfTRDslices() const { return Get(AliNanoAODColumns::kTRDnSlices); }
+
+  void     Print(const Option_t *opt = "") const;
+
+  Int_t    PdgCode() const { return 0; }
+
+  //  needed to inherit from VTrack, but not implemented
+  virtual void  SetDetectorPID(const AliDetectorPID */*pid*/) { AliFatal("Not Implemented"); return; }
+  virtual const AliDetectorPID* GetDetectorPID() const { AliFatal("Not Implemented"); return 0; }
+  virtual UChar_t  GetTRDntrackletsPID() const { AliFatal("Not Implemented"); return 0; }
+  virtual void     GetHMPIDpid(Double_t */*p*/) const { AliFatal("Not Implemented"); return; }
+  virtual Double_t GetBz() const { AliFatal("Not Implemented"); return 0; }
+  virtual void     GetBxByBz(Double_t [3]/*b[3]*/) const { AliFatal("Not Implemented"); return; }
+  virtual const    AliExternalTrackParam * GetOuterParam() const { AliFatal("Not Implemented"); return 0; }
+  virtual const    AliExternalTrackParam * GetInnerParam() const { AliFatal("Not Implemented"); return 0; }
+  virtual Int_t    GetNcls(Int_t /*idet*/) const { AliFatal("Not Implemented"); return 0; }
+  virtual const Double_t *PID() const { AliFatal("Not Implemented"); return 0; }
+
+private:
+
+  // value of a variable with a dedicated accessor, fatal if it was not stored
+  Double_t Get(AliNanoAODColumns::EVariable v) const {
+    Int_t var = AliNanoAODColumns::GetVarIndex(v);
+    if (var < 0) { AliFatal(Form("Variable %d not stored", (Int_t)v)); return 0; }
+    return fColumns->GetVar(fIndex, var);
+  }
+
+  const AliNanoAODColumns *fColumns; //! columns this track is a view on
+  Int_t                    fIndex;   //! row of this track in fColumns
+
+  ClassDef(AliNanoAODColumnTrack, 1);
+};
+
+#endif
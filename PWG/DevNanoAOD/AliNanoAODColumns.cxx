@@ -0,0 +1,335 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Columnar NanoAOD track storage
+//     One contiguous array per variable, see header for details
+//-------------------------------------------------------------------------
+
+#include <TBuffer.h>
+#include <TClonesArray.h>
+#include <TString.h>
+#include "AliLog.h"
+
+#include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackMapping.h"
+#include "AliNanoAODColumnTrack.h"
+#include "AliNanoAODColumns.h"
+
+ClassImp(AliNanoAODColumns)
+
+Int_t               AliNanoAODColumns::fgMappingSize = -1;
+std::vector<TString> AliNanoAODColumns::fgVarNames;
+Int_t               AliNanoAODColumns::fgNColumns[AliNanoAODColumns::kNoColumn] = { 0, 0, 0 };
+std::vector<Char_t> AliNanoAODColumns::fgVarType;
+std::vector<Int_t>  AliNanoAODColumns::fgVarColumn;
+Int_t               AliNanoAODColumns::fgKnownVar[AliNanoAODColumns::kNVariables];
+
+//______________________________________________________________________________
+AliNanoAODColumns::AliNanoAODColumns() :
+  TNamed(StdBranchName(), "NanoAOD track columns"),
+  fNTracks(0),
+  fNFloatColumns(0),
+  fNShortColumns(0),
+  fNIntColumns(0),
+  fNFloats(0),
+  fNShorts(0),
+  fNInts(0),
+  fFloats(0),
+  fShorts(0),
+  fInts(0),
+  fLabels(0),
+  fCharges(0),
+  fFloatCapacity(0),
+  fShortCapacity(0),
+  fIntCapacity(0),
+  fTrackCapacity(0)
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumns::AliNanoAODColumns(const char *name) :
+  TNamed(name, "NanoAOD track columns"),
+  fNTracks(0),
+  fNFloatColumns(0),
+  fNShortColumns(0),
+  fNIntColumns(0),
+  fNFloats(0),
+  fNShorts(0),
+  fNInts(0),
+  fFloats(0),
+  fShorts(0),
+  fInts(0),
+  fLabels(0),
+  fCharges(0),
+  fFloatCapacity(0),
+  fShortCapacity(0),
+  fIntCapacity(0),
+  fTrackCapacity(0)
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODColumns::~AliNanoAODColumns()
+{
+  // destructor
+  Free();
+}
+
+//______________________________________________________________________________
+AliNanoAODColumns::AliNanoAODColumns(const AliNanoAODColumns &obj) :
+  TNamed(obj),
+  fNTracks(0),
+  fNFloatColumns(0),
+  fNShortColumns(0),
+  fNIntColumns(0),
+  fNFloats(0),
+  fNShorts(0),
+  fNInts(0),
+  fFloats(0),
+  fShorts(0),
+  fInts(0),
+  fLabels(0),
+  fCharges(0),
+  fFloatCapacity(0),
+  fShortCapacity(0),
+  fIntCapacity(0),
+  fTrackCapacity(0)
+{
+  // copy constructor
+  *this = obj;
+}
+
+//______________________________________________________________________________
+AliNanoAODColumns &AliNanoAODColumns::operator=(const AliNanoAODColumns &obj)
+{
+  // assignment operator
+  if (&obj == this) return *this;
+  TNamed::operator=(obj);
+  Allocate(obj.fNTracks, obj.fNFloatColumns, obj.fNShortColumns, obj.fNIntColumns);
+  for (Int_t i = 0; i < fNFloats; i++) fFloats[i] = obj.fFloats[i];
+  for (Int_t i = 0; i < fNShorts; i++) fShorts[i] = obj.fShorts[i];
+  for (Int_t i = 0; i < fNInts;   i++) fInts[i]   = obj.fInts[i];
+  for (Int_t i = 0; i < fNTracks; i++) {
+    fLabels[i]  = obj.fLabels[i];
+    fCharges[i] = obj.fCharges[i];
+  }
+  return *this;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::Clear(Option_t * /*opt*/)
+{
+  // removes all tracks, the arrays are kept for the next event
+  fNTracks = fNFloats = fNShorts = fNInts = 0;
+  fNFloatColumns = fNShortColumns = fNIntColumns = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::Streamer(TBuffer &R__b)
+{
+  // Stream an object of class AliNanoAODColumns. When reading, the
+  // arrays are allocated with exactly the streamed sizes, the
+  // capacities are set accordingly.
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliNanoAODColumns::Class(), this);
+    fFloatCapacity = fNFloats;
+    fShortCapacity = fNShorts;
+    fIntCapacity   = fNInts;
+    fTrackCapacity = fNTracks;
+  } else {
+    R__b.WriteClassBuffer(AliNanoAODColumns::Class(), this);
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::SetMapping(const AliNanoAODTrackMapping *mapping)
+{
+  // Resolves the column of each variable of the mapping. Called when
+  // the mapping is loaded (writing: Reset, reading: FillTracks); it
+  // only does work if the variables of the mapping changed.
+  if (!mapping) {
+    AliFatalClass("No NanoAOD track mapping");
+    return;
+  }
+  Int_t size = mapping->GetSize();
+  if (size == fgMappingSize) {
+    Int_t var = 0;
+    while (var < size && fgVarNames[var] == mapping->GetVarName(var)) var++;
+    if (var == size) return;
+  }
+
+  fgMappingSize = size;
+  fgVarNames.resize(size);
+  fgVarType.assign(size, kFloatColumn);
+  fgVarColumn.assign(size, -1);
+  for (Int_t t = 0; t < kNoColumn; t++) fgNColumns[t] = 0;
+  for (Int_t v = 0; v < kNVariables; v++) fgKnownVar[v] = -1;
+
+  // names as used by the AliNanoAODTrack constructor, in the order of EVariable
+  static const char *kNames[kCovMat0] = {
+    "pt", "phi", "theta", "chi2perNDF", "posx", "posy", "posz",
+    "posDCAx", "posDCAy", "pDCAx", "pDCAy", "pDCAz", "RAtAbsorberEnd",
+    "TPCncls", "TPCnclsF", "TPCnclsS", "TPCNCrossedRows",
+    "TrackPhiOnEMCal", "TrackEtaOnEMCal", "TrackPtOnEMCal",
+    "ITSsignal", "TPCsignal", "TPCsignalTuned", "TPCsignalN", "TPCmomentum", "TPCTgl",
+    "TOFsignal", "TOFsignalTuned", "HMPIDsignal", "HMPIDoccupancy",
+    "TRDsignal", "TRDChi2", "TRDnSlices", "IsMuonTrack", "FilterMap", "id"
+  };
+
+  for (Int_t var = 0; var < size; var++) {
+    TString name = mapping->GetVarName(var);
+    fgVarNames[var] = name;
+    for (Int_t v = 0; v < kCovMat0; v++) {
+      if (name != kNames[v]) continue;
+      fgKnownVar[v] = var;
+      if (v >= kTPCncls && v <= kTPCNCrossedRows) fgVarType[var] = kShortColumn;
+      else if (v == kTPCsignalN || v == kTRDnSlices || v == kIsMuonTrack) fgVarType[var] = kShortColumn;
+      else if (v == kFilterMap || v == kID) fgVarType[var] = kIntColumn;
+      break;
+    }
+    if (name == "covmat0") {
+      for (Int_t i = 0; i < 21; i++) fgKnownVar[kCovMat0 + i] = mapping->GetCovMat(i);
+    }
+    fgVarColumn[var] = fgNColumns[(Int_t)fgVarType[var]]++;
+  }
+
+  AliDebugClass(1, Form("Resolved %d variables: %d float, %d short, %d int columns",
+                        size, fgNColumns[kFloatColumn], fgNColumns[kShortColumn], fgNColumns[kIntColumn]));
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::Allocate(Int_t ntracks, Int_t nfloat, Int_t nshort, Int_t nint)
+{
+  // allocates the columns for ntracks tracks; the arrays are only
+  // reallocated if they are too small
+  if (ntracks * nfloat > fFloatCapacity) { delete [] fFloats; fFloatCapacity = ntracks * nfloat; fFloats = new Float_t[fFloatCapacity]; }
+  if (ntracks * nshort > fShortCapacity) { delete [] fShorts; fShortCapacity = ntracks * nshort; fShorts = new Short_t[fShortCapacity]; }
+  if (ntracks * nint > fIntCapacity)     { delete [] fInts;   fIntCapacity   = ntracks * nint;   fInts   = new Int_t[fIntCapacity]; }
+  if (ntracks > fTrackCapacity) {
+    delete [] fLabels;  fLabels  = new Int_t[ntracks];
+    delete [] fCharges; fCharges = new Char_t[ntracks];
+    fTrackCapacity = ntracks;
+  }
+  fNTracks       = ntracks;
+  fNFloatColumns = nfloat;
+  fNShortColumns = nshort;
+  fNIntColumns   = nint;
+  fNFloats       = ntracks * nfloat;
+  fNShorts       = ntracks * nshort;
+  fNInts         = ntracks * nint;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::Free()
+{
+  // deletes the columns
+  delete [] fFloats;  fFloats  = 0;
+  delete [] fShorts;  fShorts  = 0;
+  delete [] fInts;    fInts    = 0;
+  delete [] fLabels;  fLabels  = 0;
+  delete [] fCharges; fCharges = 0;
+  fNTracks = fNFloats = fNShorts = fNInts = 0;
+  fNFloatColumns = fNShortColumns = fNIntColumns = 0;
+  fFloatCapacity = fShortCapacity = fIntCapacity = fTrackCapacity = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::Reset(Int_t ntracks)
+{
+  // prepares the columns for ntracks tracks of the current mapping
+  SetMapping(AliNanoAODTrackMapping::GetInstance());
+  Allocate(ntracks, fgNColumns[kFloatColumn], fgNColumns[kShortColumn], fgNColumns[kIntColumn]);
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::SetVar(Int_t itrack, Int_t var, Double_t value)
+{
+  // sets variable var (index in the mapping) of track itrack
+  Int_t col = GetColumn(var);
+  if (col < 0) {
+    AliFatal(Form("Variable %d not in mapping", var));
+    return;
+  }
+  switch (fgVarType[var]) {
+  case kShortColumn: fShorts[col * fNTracks + itrack] = (Short_t)value; break;
+  case kIntColumn:
+    // the filter map is unsigned, its bit pattern is stored
+    if (var == fgKnownVar[kFilterMap]) fInts[col * fNTracks + itrack] = (Int_t)(UInt_t)value;
+    else fInts[col * fNTracks + itrack] = (Int_t)value;
+    break;
+  default:           fFloats[col * fNTracks + itrack] = (Float_t)value; break;
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::SetTrack(Int_t itrack, const AliNanoAODTrack &track)
+{
+  // copies all variables, the label and the charge of track into row itrack
+  for (Int_t var = 0; var < fgMappingSize; var++) SetVar(itrack, var, track.GetVar(var));
+  fLabels[itrack]  = track.GetLabel();
+  fCharges[itrack] = (Char_t)track.Charge();
+}
+
+//______________________________________________________________________________
+Double_t AliNanoAODColumns::GetVar(Int_t itrack, Int_t var) const
+{
+  // returns variable var (index in the mapping) of track itrack
+  Int_t col = GetColumn(var);
+  if (col < 0) {
+    AliFatal(Form("Variable %d not in mapping", var));
+    return 0;
+  }
+  switch (fgVarType[var]) {
+  case kShortColumn: return fShorts[col * fNTracks + itrack];
+  case kIntColumn:
+    if (var == fgKnownVar[kFilterMap]) return (UInt_t)fInts[col * fNTracks + itrack];
+    return fInts[col * fNTracks + itrack];
+  default:           return fFloats[col * fNTracks + itrack];
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::FillTracks(TClonesArray *tracks) const
+{
+  // Fills tracks with one AliNanoAODColumnTrack per stored track, so that
+  // tasks reading AliVTrack can run on the columnar layout
+  if (!tracks) return;
+  SetMapping(AliNanoAODTrackMapping::GetInstance());
+  if (fNFloatColumns != fgNColumns[kFloatColumn] || fNShortColumns != fgNColumns[kShortColumn] ||
+      fNIntColumns != fgNColumns[kIntColumn]) {
+    AliFatal(Form("Columns (%d float, %d short, %d int) do not match the track mapping",
+                  fNFloatColumns, fNShortColumns, fNIntColumns));
+    return;
+  }
+  tracks->Clear("C");
+  for (Int_t i = 0; i < fNTracks; i++) new ((*tracks)[i]) AliNanoAODColumnTrack(this, i);
+}
+
+//______________________________________________________________________________
+void AliNanoAODColumns::Print(Option_t * /*opt*/) const
+{
+  // prints the content of the columns
+  AliNanoAODTrackMapping *mapping = AliNanoAODTrackMapping::GetInstance();
+  Printf("%s: %d tracks, %d float, %d short, %d int columns", GetName(), fNTracks,
+         fNFloatColumns, fNShortColumns, fNIntColumns);
+  for (Int_t i = 0; i < fNTracks; i++) {
+    Printf(" Track %d: label %d, charge %d", i, fLabels[i], fCharges[i]);
+    for (Int_t var = 0; var < fgMappingSize; var++)
+      Printf(" - [%2.2d] %-10s : %f", var, mapping->GetVarName(var), GetVar(i, var));
+  }
+}
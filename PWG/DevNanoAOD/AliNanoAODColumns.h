@@ -0,0 +1,128 @@
+#ifndef AliNanoAODColumns_H
+#define AliNanoAODColumns_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Columnar NanoAOD track storage
+//     Stores the variables of all NanoAOD tracks of an event as one
+//     contiguous array per variable (column), instead of one
+//     AliNanoAODTrack with a Double_t array per track.
+//     Integer-like variables (cluster counts, number of slices, muon
+//     flag) are stored as Short_t, the filter map (its UInt_t bit
+//     pattern) and the track ID as Int_t, all other variables
+//     (including custom "cst" variables and the covariance matrix) as
+//     Float_t.
+//
+//     The column of each variable follows from the
+//     AliNanoAODTrackMapping; it is resolved once, when the mapping is
+//     loaded (SetMapping), so that the accessors do not need to look
+//     up the mapping. Tracks are read through AliNanoAODColumnTrack,
+//     an AliVTrack adapter (see FillTracks).
+//     Clear() keeps the arrays, so that they are reused by the next
+//     event as long as they are large enough.
+//-------------------------------------------------------------------------
+
+#include <vector>
+
+#include "TNamed.h"
+#include "TString.h"
+
+class TClonesArray;
+class AliNanoAODTrack;
+class AliNanoAODTrackMapping;
+
+class AliNanoAODColumns : public TNamed {
+
+public:
+
+  enum EColumnType { kFloatColumn = 0, kShortColumn, kIntColumn, kNoColumn };
+
+  // variables with a dedicated accessor in AliNanoAODColumnTrack
+  enum EVariable {
+    kPt = 0, kPhi, kTheta, kChi2PerNDF, kPosX, kPosY, kPosZ,
+    kPosDCAx, kPosDCAy, kPDCAx, kPDCAy, kPDCAz, kRAtAbsorberEnd,
+    kTPCncls, kTPCnclsF, kTPCnclsS, kTPCNCrossedRows,
+    kTrackPhiOnEMCal, kTrackEtaOnEMCal, kTrackPtOnEMCal,
+    kITSsignal, kTPCsignal, kTPCsignalTuned, kTPCsignalN, kTPCmomentum, kTPCTgl,
+    kTOFsignal, kTOFsignalTuned, kHMPIDsignal, kHMPIDoccupancy,
+    kTRDsignal, kTRDChi2, kTRDnSlices, kIsMuonTrack, kFilterMap, kID,
+    kCovMat0, kNVariables = kCovMat0 + 21
+  };
+
+  static const char *StdBranchName() { return "nanoTrackColumns"; }
+
+  AliNanoAODColumns();
+  AliNanoAODColumns(const char *name);
+  virtual ~AliNanoAODColumns();
+  AliNanoAODColumns(const AliNanoAODColumns &obj);
+  AliNanoAODColumns &operator=(const AliNanoAODColumns &obj);
+
+  virtual void Clear(Option_t *opt = "");
+
+  // layout, resolved once per mapping
+  static void        SetMapping(const AliNanoAODTrackMapping *mapping);
+  static Bool_t      IsMappingSet() { return fgMappingSize >= 0; }
+  static Int_t       GetColumnType(Int_t var) { return (var >= 0 && var < (Int_t)fgVarType.size()) ? fgVarType[var] : kNoColumn; }
+  static Int_t       GetColumn(Int_t var) { return (var >= 0 && var < (Int_t)fgVarColumn.size()) ? fgVarColumn[var] : -1; }
+  static Int_t       GetVarIndex(EVariable v) { return fgKnownVar[v]; }
+
+  // writing
+  void               Reset(Int_t ntracks);
+  void               SetTrack(Int_t itrack, const AliNanoAODTrack &track);
+  void               SetVar(Int_t itrack, Int_t var, Double_t value);
+  void               SetLabel(Int_t itrack, Int_t label) { fLabels[itrack] = label; }
+  void               SetCharge(Int_t itrack, Short_t charge) { fCharges[itrack] = (Char_t)charge; }
+
+  // reading
+  Int_t              GetNTracks() const { return fNTracks; }
+  Double_t           GetVar(Int_t itrack, Int_t var) const;
+  Double_t           GetVar(Int_t itrack, EVariable v) const { return GetVar(itrack, fgKnownVar[v]); }
+  Float_t            GetFloat(Int_t column, Int_t itrack) const { return fFloats[column * fNTracks + itrack]; }
+  Short_t            GetShort(Int_t column, Int_t itrack) const { return fShorts[column * fNTracks + itrack]; }
+  Int_t              GetInt(Int_t column, Int_t itrack) const { return fInts[column * fNTracks + itrack]; }
+  const Float_t     *GetFloatColumn(Int_t column) const { return fFloats + column * fNTracks; }
+  const Short_t     *GetShortColumn(Int_t column) const { return fShorts + column * fNTracks; }
+  const Int_t       *GetIntColumn(Int_t column) const { return fInts + column * fNTracks; }
+  Int_t              GetLabel(Int_t itrack) const { return fLabels[itrack]; }
+  Short_t            GetCharge(Int_t itrack) const { return fCharges[itrack]; }
+
+  // fills tracks (TClonesArray of AliNanoAODColumnTrack) with one adapter per track
+  void               FillTracks(TClonesArray *tracks) const;
+
+  virtual void       Print(Option_t *opt = "") const;
+
+private:
+
+  void               Allocate(Int_t ntracks, Int_t nfloat, Int_t nshort, Int_t nint);
+  void               Free();
+
+  Int_t              fNTracks;        // number of tracks
+  Int_t              fNFloatColumns;  // number of Float_t columns
+  Int_t              fNShortColumns;  // number of Short_t columns
+  Int_t              fNIntColumns;    // number of Int_t columns
+  Int_t              fNFloats;        // size of fFloats
+  Int_t              fNShorts;        // size of fShorts
+  Int_t              fNInts;          // size of fInts
+  Float_t           *fFloats;         //[fNFloats] Float_t columns, one after the other
+  Short_t           *fShorts;         //[fNShorts] Short_t columns, one after the other
+  Int_t             *fInts;           //[fNInts] Int_t columns, one after the other
+  Int_t             *fLabels;         //[fNTracks] track labels
+  Char_t            *fCharges;        //[fNTracks] track charges
+  Int_t              fFloatCapacity;  //! allocated size of fFloats
+  Int_t              fShortCapacity;  //! allocated size of fShorts
+  Int_t              fIntCapacity;    //! allocated size of fInts
+  Int_t              fTrackCapacity;  //! allocated size of fLabels and fCharges
+
+  static Int_t                fgMappingSize;           // size of the mapping the layout was resolved for (-1 = none)
+  static std::vector<TString> fgVarNames;              // variable names of the mapping the layout was resolved for
+  static Int_t                fgNColumns[kNoColumn];   // number of columns of each type
+  static std::vector<Char_t>  fgVarType;               // column type of each variable of the mapping
+  static std::vector<Int_t>   fgVarColumn;             // column of each variable of the mapping
+  static Int_t                fgKnownVar[kNVariables]; // mapping index of the variables with dedicated accessors (-1 = not stored)
+
+  ClassDef(AliNanoAODColumns, 1);
+};
+
+#endif
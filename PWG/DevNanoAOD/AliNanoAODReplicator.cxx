@@ -53,6 +53,7 @@ class AliAODRecoDecay;
 #include "TObjArray.h"
 #include "AliAnalysisFilter.h"
 #include "AliNanoAODTrack.h"
+#include "AliNanoAODColumns.h"
 
 #include <TFile.h>
 #include <TDatabasePDG.h>
@@ -103,7 +104,10 @@ AliAODBranchReplicator(),
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
-  fVarListHeader_fTC(""){
+  fVarListHeader_fTC(""),
+  fColumnar(kFALSE),
+  fColumns(0x0),
+  fSelectedTracks(){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file
   }
 
@@ -134,7 +138,10 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fSaveVzero(0),
   fInputArrayName(""),
   fOutputArrayName("tracks"),
-  fVarListHeader_fTC("")
+  fVarListHeader_fTC(""),
+  fColumnar(kFALSE),
+  fColumns(0x0),
+  fSelectedTracks()
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -237,7 +244,8 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
   //  std::cout << "MC Mode: " << fMCMode << ", Tracks " << fTracks->GetEntries() << std::endl;
   
-  if ( fMCMode>=2 && !fTracks->GetEntries() ) {
+  Int_t nTracksOut = fColumnar ? fColumns->GetNTracks() : fTracks->GetEntries();
+  if ( fMCMode>=2 && !nTracksOut ) {
     return;
   }
   // for fMCMode==1 we only copy MC information for events where there's at least one muon track
@@ -276,12 +284,9 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
       } 
 
       // loop on (kept) tracks to find their ancestors
-      TIter nextTRACK(fTracks);
-      AliNanoAODTrack* track;
-    
-      while ( ( track = static_cast<AliNanoAODTrack*>(nextTRACK()) ) )
+      for (Int_t itrack = 0; itrack < nTracksOut; itrack++)
 	{
-	  Int_t label = TMath::Abs(track->GetLabel()); 
+	  Int_t label = TMath::Abs(fColumnar ? fColumns->GetLabel(itrack) : static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(itrack))->GetLabel());
       
 	  while ( label >= 0 ) 
 	    {
@@ -390,15 +395,20 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
     
       // now remap the tracks...
     
-      TIter nextTrack(fTracks);
-      AliNanoAODTrack* t;
-      //      std::cout << "Remapping tracks" << std::endl;
+      if (fColumnar) {
+	for (Int_t itrack = 0; itrack < nTracksOut; itrack++)
+	  fColumns->SetLabel(itrack, GetNewLabel(fColumns->GetLabel(itrack)));
+      } else {
+	TIter nextTrack(fTracks);
+	AliNanoAODTrack* t;
+	//      std::cout << "Remapping tracks" << std::endl;
     
-      while ( ( t = dynamic_cast<AliNanoAODTrack*>(nextTrack()) ) )
-	{
+	while ( ( t = dynamic_cast<AliNanoAODTrack*>(nextTrack()) ) )
+	  {
 	  
-	  t->SetLabel(GetNewLabel(t->GetLabel()));
-	}
+	    t->SetLabel(GetNewLabel(t->GetLabel()));
+	  }
+      }
     
     } // closes fMCMode == 1
   else if ( mcParticles ) 
@@ -435,10 +445,17 @@ TList* AliNanoAODReplicator::GetList() const
       fList = new TList;
       fList->SetOwner(kTRUE);
 
-      fTracks = new TClonesArray("AliNanoAODTrack");
+      // in columnar mode the track array stays empty in the file; it is
+      // filled with AliNanoAODColumnTrack views when reading (see AliNanoAODColumns::FillTracks)
+      fTracks = new TClonesArray(fColumnar ? "AliNanoAODColumnTrack" : "AliNanoAODTrack");
       fTracks->SetName(fOutputArrayName.Data()); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fTracks);
 
+      if (fColumnar) {
+        fColumns = new AliNanoAODColumns(AliNanoAODColumns::StdBranchName());
+        fList->Add(fColumns);
+      }
+
       fHeader = new AliNanoAODHeader(fNumberOfHeaderParam, fNumberOfHeaderParamInt);
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fHeader);    
@@ -485,6 +502,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
 
   fTracks->Clear("C");			
+  if (fColumnar) fColumns->Clear();
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -521,6 +539,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
 
   if(entries<=0) return;
 
+  fSelectedTracks.clear();
   for(Int_t j=0; j<entries; j++){
     AliVTrack *track = 0x0;
     if (particleArray) track = (AliVTrack*)particleArray->At(j);
@@ -529,10 +548,27 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     AliAODTrack *aodtrack =(AliAODTrack*)track;// FIXME DYNAMIC CAST?
     if(fTrackCut && !fTrackCut->IsSelected(aodtrack)) continue;
 
+    if (fColumnar) {
+      fSelectedTracks.push_back(aodtrack);
+      continue;
+    }
+
     AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fVarList);
 
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
   }  
+
+  if (fColumnar) {
+    // the number of tracks has to be known to lay out the columns; the
+    // values go through an AliNanoAODTrack, so that custom setters work unchanged
+    ntracks = (Int_t)fSelectedTracks.size();
+    fColumns->Reset(ntracks);
+    for (Int_t j = 0; j < ntracks; j++) {
+      AliNanoAODTrack special(fSelectedTracks[j], fVarList);
+      if(fCustomSetter) fCustomSetter->SetNanoAODTrack(fSelectedTracks[j], &special);
+      fColumns->SetTrack(j, special);
+    }
+  }
   //----------------------------------------------------------
   
   TIter nextV(source.GetVertices());
@@ -566,7 +602,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
   
   AliDebug(1,Form("input mu tracks=%d tracks=%d vertices=%d",
-                  input,fTracks->GetEntries(),fVertices->GetEntries())); 
+                  input,ntracks,fVertices->GetEntries())); 
   
   
   // Finally, deal with MC information, if needed
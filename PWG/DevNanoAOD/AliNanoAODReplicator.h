@@ -15,6 +15,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 /* #ifndef AliAOD3LH_H */
 /* #include "AliAOD3LH.h" */
@@ -57,6 +58,7 @@ class AliNanoAODTrack;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 class AliAODZDC;
+class AliNanoAODColumns;
 
 class TH1F;
 
@@ -101,6 +103,10 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void SetInputArrayName(TString name) {fInputArrayName=name;}
   void SetOutputArrayName(TString name) {fOutputArrayName=name;}
 
+  // store the tracks in AliNanoAODColumns (one array per variable) instead of AliNanoAODTrack
+  void SetColumnar(Bool_t b = kTRUE) { fColumnar = b; }
+  Bool_t GetColumnar() const { return fColumnar; }
+
   void SetVarListHeaderStringVariable(TString var) {fVarListHeader_fTC=var;}
     
  private:
@@ -146,13 +152,17 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   TString fInputArrayName; // name of array if tracks are stored in a TObjectArray
   TString fOutputArrayName; // name of the output array, where the NanoAODTracks are stored
+
+  Bool_t fColumnar; // if kTRUE the tracks are stored in fColumns, fTracks stays empty
+  mutable AliNanoAODColumns* fColumns; //! internal columnar track storage
+  std::vector<AliAODTrack*> fSelectedTracks; //! tracks selected in the current event (columnar mode)
  private:
 
 
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
 
-  ClassDef(AliNanoAODReplicator,4) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,5) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
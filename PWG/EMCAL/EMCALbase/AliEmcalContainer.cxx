@@ -55,6 +55,11 @@ AliEmcalContainer::AliEmcalContainer():
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fCacheAccepted(kFALSE),
+  fAcceptCacheValid(kFALSE),
+  fAcceptCacheNEntries(0),
+  fAcceptCacheIndices(),
+  fAcceptCacheMomenta(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -92,6 +97,11 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fCacheAccepted(kFALSE),
+  fAcceptCacheValid(kFALSE),
+  fAcceptCacheNEntries(0),
+  fAcceptCacheIndices(),
+  fAcceptCacheMomenta(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -176,6 +186,7 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
   }
 
   fLabelMap = dynamic_cast<AliNamedArrayI*>(event->FindListObject(fClArrayName + "_Map"));
+  InvalidateAcceptCache();
 }
 
 /**
@@ -184,6 +195,8 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
  */
 void AliEmcalContainer::NextEvent(const AliVEvent * event)
 {
+  InvalidateAcceptCache();
+
   // Get the right event (either the current event of the embedded event)
   event = AliEmcalContainerUtils::GetEvent(event, fIsEmbedding);
 
@@ -197,6 +210,9 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
  * @return Number of accepted events in the container
  */
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  const std::vector<Int_t> *cached = GetCachedAcceptIndices();
+  if (cached) return cached->size();
+
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -205,6 +221,47 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+/**
+ * Get the indices of the accepted entries from the cache, filling
+ * the cache (indices and momenta) if it is not valid for the current content
+ * of the container.
+ * @return Indices of the accepted entries (NULL if caching is disabled)
+ */
+const std::vector<Int_t> *AliEmcalContainer::GetCachedAcceptIndices() const
+{
+  if (!fCacheAccepted) return 0;
+
+  if (!fAcceptCacheValid || fAcceptCacheNEntries != GetNEntries()) {
+    fAcceptCacheIndices.clear();
+    fAcceptCacheMomenta.clear();
+    fAcceptCacheNEntries = GetNEntries();
+    for (Int_t index = 0; index < fAcceptCacheNEntries; index++) {
+      UInt_t rejectionReason = 0;
+      if (!AcceptObject(index, rejectionReason)) continue;
+      fAcceptCacheIndices.push_back(index);
+      fAcceptCacheMomenta.push_back(AliTLorentzVector());
+      GetMomentum(fAcceptCacheMomenta.back(), index);
+    }
+    fAcceptCacheValid = kTRUE;
+  }
+  return &fAcceptCacheIndices;
+}
+
+/**
+ * Get the momentum of an accepted entry from the cache.
+ * @param[out] mom Momentum of the entry
+ * @param[in] iacc Position of the entry in the list of accepted entries
+ * @param[in] index Index of the entry in the container
+ * @return kTRUE if the entry is in the cache, kFALSE otherwise
+ */
+Bool_t AliEmcalContainer::GetCachedAcceptMomentum(TLorentzVector &mom, Int_t iacc, Int_t index) const
+{
+  if (!fCacheAccepted || !fAcceptCacheValid || fAcceptCacheNEntries != GetNEntries()) return kFALSE;
+  if (iacc < 0 || iacc >= (Int_t)fAcceptCacheIndices.size() || fAcceptCacheIndices[iacc] != index) return kFALSE;
+  mom = fAcceptCacheMomenta[iacc];
+  return kTRUE;
+}
+
 /**
  * Get the index in the container from a given label
  * @param lab Label to check
@@ -11,9 +11,13 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TClonesArray.h>
 
+#include "AliTLorentzVector.h"
+
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_object<TObject> > AliEmcalIterableContainer;
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_pair<TObject> > AliEmcalIterableMomentumContainer;
@@ -70,6 +74,11 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterabl
  * }
  * ~~~
  *
+ * The accepted entries and their momenta can be cached per event (see SetCacheAcceptedEntries()),
+ * so that repeated iterations over the accepted entries in the same event do not apply the
+ * selection again. The cache is invalidated in NextEvent(), when the content of the underlying
+ * array changes in size and when the kinematic cuts of this base class are changed.
+ *
  * The usage of EMCAL containers is described under \subpage EMCALcontainers
  */
 class AliEmcalContainer : public TObject {
@@ -151,28 +160,33 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  void                        SetCacheAcceptedEntries(Bool_t b)         { fCacheAccepted = b; InvalidateAcceptCache(); }
+  Bool_t                      GetCacheAcceptedEntries() const           { return fCacheAccepted; }
+  void                        InvalidateAcceptCache() const             { fAcceptCacheValid = kFALSE; }
+  const std::vector<Int_t>   *GetCachedAcceptIndices() const;
+  Bool_t                      GetCachedAcceptMomentum(TLorentzVector &mom, Int_t iacc, Int_t index) const;
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
-  void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); }
-  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; }
+  void                        SetVertex(Double_t *vtx)              { memcpy(fVertex, vtx, sizeof(Double_t) * 3); InvalidateAcceptCache(); }
+  void                        SetBitMap(UInt_t m)                   { fBitMap = m                       ; InvalidateAcceptCache(); }
   void                        SetIsParticleLevel(Bool_t b)          { fIsParticleLevel = b              ; }
   void                        SortArray()                           { fClArray->Sort()                  ; }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
   virtual void                NextEvent(const AliVEvent *event);
-  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; }
-  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; }
+  void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; InvalidateAcceptCache(); }
+  void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; InvalidateAcceptCache(); }
   void                        SetMCLabelRange(Int_t min, Int_t max)             { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
-  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; }
-  void                        SetMinE(Double_t min)                     { fMinE   = min ; }
-  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; }
-  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; }
-  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; }
-  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; }
-  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; }
-  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; }
-  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; }
+  void                        SetELimits(Double_t min, Double_t max)    { fMinE   = min ; fMaxE   = max ; InvalidateAcceptCache(); }
+  void                        SetMinE(Double_t min)                     { fMinE   = min ; InvalidateAcceptCache(); }
+  void                        SetMaxE(Double_t max)                     { fMaxE   = max ; InvalidateAcceptCache(); }
+  void                        SetPtLimits(Double_t min, Double_t max)   { fMinPt  = min ; fMaxPt  = max ; InvalidateAcceptCache(); }
+  void                        SetMinPt(Double_t min)                    { fMinPt  = min ; InvalidateAcceptCache(); }
+  void                        SetMaxPt(Double_t max)                    { fMaxPt  = max ; InvalidateAcceptCache(); }
+  void                        SetEtaLimits(Double_t min, Double_t max)  { fMaxEta = max ; fMinEta = min ; InvalidateAcceptCache(); }
+  void                        SetPhiLimits(Double_t min, Double_t max)  { fMaxPhi = max ; fMinPhi = min ; InvalidateAcceptCache(); }
+  void                        SetMassHypothesis(Double_t m)             { fMassHypothesis         = m   ; InvalidateAcceptCache(); }
   void                        SetClassName(const char *clname);
   void                        SetIsEmbedding(Bool_t b)                  { fIsEmbedding = b ; }
   Bool_t                      GetIsEmbedding() const                    { return fIsEmbedding; }
@@ -226,6 +240,11 @@ class AliEmcalContainer : public TObject {
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  Bool_t                      fCacheAccepted;           ///< cache accepted entries and their momenta per event
+  mutable Bool_t              fAcceptCacheValid;        //!<! cache of accepted entries is filled for the current event
+  mutable Int_t               fAcceptCacheNEntries;     //!<! number of entries in the array when the cache was filled
+  mutable std::vector<Int_t>  fAcceptCacheIndices;      //!<! indices of the accepted entries
+  mutable std::vector<AliTLorentzVector> fAcceptCacheMomenta; //!<! momenta of the accepted entries
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -234,7 +253,7 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
   /// \endcond
 };
 #endif
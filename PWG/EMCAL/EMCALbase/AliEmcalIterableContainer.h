@@ -150,7 +150,8 @@ public:
       }
       else {
         this->fCurrentElement.second = (*fkData)[fCurrent];
-        fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
+        if (!fkData->fUseCachedMomenta || !fkData->GetContainer()->GetCachedAcceptMomentum(this->fCurrentElement.first, fCurrent, fkData->GetInternalIndex(fCurrent)))
+          fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
       }
     }
   };
@@ -216,6 +217,7 @@ private:
   const AliEmcalContainer     *fkContainer;         ///< Container to be iterated over
   TArrayI                     fAcceptIndices;       ///< Array of accepted indices
   Bool_t                      fUseAccepted;         ///< Switch between accepted and all objects
+  Bool_t                      fUseCachedMomenta;    ///< Accepted indices taken from the cache of the container, momenta available there as well
 
   inline int GetInternalIndex(int index) const {
     if (fUseAccepted) {
@@ -242,7 +244,8 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT():
   fkContainer(NULL),
   fAcceptIndices(),
-  fUseAccepted(kFALSE)
+  fUseAccepted(kFALSE),
+  fUseCachedMomenta(kFALSE)
 {
 
 }
@@ -250,6 +253,8 @@ AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT():
 /**
  * Standard constructor, to be used by the users. Specifying the type of iteration (all vs. accepted).
  * In case the iterator runs over accepted object, an index map is build inside the constructor.
+ * If the EMCAL container caches its accepted entries (see AliEmcalContainer::SetCacheAcceptedEntries)
+ * the index map and the momenta are taken from the cache.
  * @param[in] cont EMCAL container to iterate over
  * @param[in] useAccept If true accepted objects are used in the iteration, otherwise all objects
  */
@@ -257,9 +262,19 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT(const AliEmcalContainer *cont, bool useAccept):
   fkContainer(cont),
   fAcceptIndices(),
-  fUseAccepted(useAccept)
+  fUseAccepted(useAccept),
+  fUseCachedMomenta(kFALSE)
 {
-  if (fUseAccepted) BuildAcceptIndices();
+  if (fUseAccepted) {
+    const std::vector<Int_t> *cached = fkContainer->GetCachedAcceptIndices();
+    if (cached) {
+      fAcceptIndices.Set(cached->size(), cached->data());
+      fUseCachedMomenta = kTRUE;
+    }
+    else {
+      BuildAcceptIndices();
+    }
+  }
 }
 
 /**
@@ -271,7 +286,8 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT(const AliEmcalIterableContainerT<T, STAR> &ref):
   fkContainer(ref.fkContainer),
   fAcceptIndices(ref.fAcceptIndices),
-  fUseAccepted(ref.fUseAccepted)
+  fUseAccepted(ref.fUseAccepted),
+  fUseCachedMomenta(ref.fUseCachedMomenta)
 {
 
 }
@@ -288,6 +304,7 @@ AliEmcalIterableContainerT<T, STAR> &AliEmcalIterableContainerT<T, STAR>::operat
     fkContainer = ref.fkContainer;
     fAcceptIndices = ref.fAcceptIndices;
     fUseAccepted = ref.fUseAccepted;
+    fUseCachedMomenta = ref.fUseCachedMomenta;
   }
   return *this;
 }
@@ -328,16 +345,17 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 /**
  * Build list of accepted indices inside the container.
  * For this all objects inside the container are checked
- * for being accepted or not.
+ * for being accepted or not (once per object).
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
+  fAcceptIndices.Set(fkContainer->GetNEntries());
   int acceptCounter = 0;
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
     UInt_t rejectionReason = 0;
     if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
   }
+  fAcceptIndices.Set(acceptCounter);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -3,14 +3,22 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <algorithm>
+#include <iostream>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TObjArray.h>
+#include <TRandom3.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
 #include "AliEMCALRecoUtils.h"
 #include "AliESDCaloCluster.h"
 #include "AliAODCaloCluster.h"
+#include "AliAODTrack.h"
 #include "AliVParticle.h"
 #include "AliEmcalParticle.h"
 #include "AliEMCALGeometry.h"
@@ -18,6 +26,7 @@
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionClusterTrackMatcher);
+ClassImp(TestAliEmcalCorrectionClusterTrackMatcher);
 /// \endcond
 
 // Actually registers the class with the base class
@@ -37,6 +46,7 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseDCA(kTRUE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseGridMatching(kTRUE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
@@ -45,6 +55,16 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
+  fGridNEta(0),
+  fGridNPhi(0),
+  fGridEtaMin(0),
+  fGridEtaWidth(0),
+  fGridPhiWidth(0),
+  fGridCellStart(),
+  fGridClusters(),
+  fGridOutside(),
+  fGridClusterCell(),
+  fCandidateClusters(),
   fNMCGenerToAccept(0),
   fMCGenerToAcceptForTrack(1)
 {
@@ -81,6 +101,7 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useGridMatching", fUseGridMatching);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -364,16 +385,33 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
 /**
  * Set the links between tracks and clusters.
+ *
+ * With fUseGridMatching, each track is only compared with the clusters in the neighbouring cells
+ * of the (eta, phi) grid built by BuildClusterGrid(). The candidate clusters are visited in
+ * ascending index order, so the matches (including their order) are the same as when testing
+ * all track-cluster pairs.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
+  const Bool_t useGrid = fUseGridMatching && fMaxDistance > 0;
+
+  if (useGrid) BuildClusterGrid();
 
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fCandidateClusters.clear();
+    if (useGrid) {
+      GetCandidateClusters(track, fCandidateClusters);
+    }
+    else {
+      for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) fCandidateClusters.push_back(icluster);
+    }
+
+    for (UInt_t icand = 0; icand < fCandidateClusters.size(); icand++) {
+      const Int_t icluster = fCandidateClusters[icand];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -410,6 +448,105 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
   }
 }
 
+/**
+ * Sort the clusters into an (eta, phi) grid with cells at least fMaxDistance wide,
+ * using the cluster positions as in GetEtaPhiDiff(). A track can then only be matched
+ * to clusters in its own or in a neighbouring cell.
+ */
+void AliEmcalCorrectionClusterTrackMatcher::BuildClusterGrid()
+{
+  // margin against rounding at the cell edges; the number of cells is limited for very small distances
+  const Double_t cellSize = fMaxDistance * (1 + 1e-6);
+  const Int_t maxCells = 1000;
+
+  fGridClusterCell.assign(fNEmcalClusters, -1);
+  fGridOutside.clear();
+
+  std::vector<Double_t> clusterEta(fNEmcalClusters), clusterPhi(fNEmcalClusters);
+  Double_t etaMin = 0, etaMax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
+    Float_t pos[3] = {0};
+    emcalCluster->GetCluster()->GetPosition(pos);
+    TVector3 cpos(pos);
+    clusterEta[icluster] = cpos.Eta();
+    clusterPhi[icluster] = cpos.Phi();
+    if (!TMath::Finite(clusterEta[icluster]) || !TMath::Finite(clusterPhi[icluster])) {
+      fGridOutside.push_back(icluster);
+      continue;
+    }
+    clusterPhi[icluster] = TVector2::Phi_0_2pi(clusterPhi[icluster]);
+    if (first || clusterEta[icluster] < etaMin) etaMin = clusterEta[icluster];
+    if (first || clusterEta[icluster] > etaMax) etaMax = clusterEta[icluster];
+    first = kFALSE;
+  }
+
+  fGridNPhi = static_cast<Int_t>(TMath::Min(TMath::TwoPi() / cellSize, static_cast<Double_t>(maxCells)));
+  if (fGridNPhi < 3) fGridNPhi = 1;
+  fGridPhiWidth = TMath::TwoPi() / fGridNPhi;
+  fGridEtaMin = etaMin;
+  fGridEtaWidth = TMath::Max(cellSize, (etaMax - etaMin) / (maxCells - 1));
+  fGridNEta = static_cast<Int_t>((etaMax - etaMin) / fGridEtaWidth) + 1;
+
+  // counting sort of the clusters into the cells, keeping the cluster order within a cell
+  const Int_t nCells = fGridNEta * fGridNPhi;
+  fGridCellStart.assign(nCells + 1, 0);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (!TMath::Finite(clusterEta[icluster]) || !TMath::Finite(clusterPhi[icluster])) continue;
+    Int_t ieta = TMath::Min(static_cast<Int_t>((clusterEta[icluster] - fGridEtaMin) / fGridEtaWidth), fGridNEta - 1);
+    Int_t iphi = TMath::Min(static_cast<Int_t>(clusterPhi[icluster] / fGridPhiWidth), fGridNPhi - 1);
+    fGridClusterCell[icluster] = ieta * fGridNPhi + iphi;
+    fGridCellStart[fGridClusterCell[icluster] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fGridCellStart[icell + 1] += fGridCellStart[icell];
+
+  fGridClusters.resize(fGridCellStart[nCells]);
+  std::vector<Int_t> fill(fGridCellStart.begin(), fGridCellStart.end() - 1);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    if (fGridClusterCell[icluster] < 0) continue;
+    fGridClusters[fill[fGridClusterCell[icluster]]++] = icluster;
+  }
+}
+
+/**
+ * Collect, in ascending order, the clusters which can be within fMaxDistance of the track:
+ * those in the 3x3 grid cells around the track position on the EMCal surface and those
+ * without a grid cell. A track without a finite position is tested against all clusters.
+ * @param[in] track Track to be matched
+ * @param[out] candidates Indices of the candidate clusters
+ */
+void AliEmcalCorrectionClusterTrackMatcher::GetCandidateClusters(AliVTrack* track, std::vector<Int_t>& candidates) const
+{
+  candidates = fGridOutside;
+
+  const Double_t eta = track->GetTrackEtaOnEMCal();
+  const Double_t phi = track->GetTrackPhiOnEMCal();
+  if (!TMath::Finite(eta) || !TMath::Finite(phi)) {
+    candidates.clear();
+    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) candidates.push_back(icluster);
+    return;
+  }
+
+  // a track more than one cell away from the grid cannot be matched to any cluster in it
+  const Double_t etaCell = TMath::Floor((eta - fGridEtaMin) / fGridEtaWidth);
+  if (fGridClusters.size() > 0 && etaCell >= -1 && etaCell <= fGridNEta) {
+    const Int_t ieta = static_cast<Int_t>(etaCell);
+    const Int_t iphi = TMath::Min(static_cast<Int_t>(TVector2::Phi_0_2pi(phi) / fGridPhiWidth), fGridNPhi - 1);
+    const Int_t dphiMax = fGridNPhi > 1 ? 1 : 0;
+    for (Int_t jeta = ieta - 1; jeta <= ieta + 1; jeta++) {
+      if (jeta < 0 || jeta >= fGridNEta) continue;
+      for (Int_t dphi = -dphiMax; dphi <= dphiMax; dphi++) {
+        const Int_t jphi = (iphi + dphi + fGridNPhi) % fGridNPhi;
+        const Int_t icell = jeta * fGridNPhi + jphi;
+        for (Int_t i = fGridCellStart[icell]; i < fGridCellStart[icell + 1]; i++) candidates.push_back(fGridClusters[i]);
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
 /**
  * Update clusters with matching info.
  */
@@ -504,3 +641,225 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::IsTrackInEmcalAcceptance(AliVParti
     return kFALSE;
   }
 }
+
+bool TestAliEmcalCorrectionClusterTrackMatcher::RunAllTests() const
+{
+  bool testRandom = TestRandomEvents(),
+       testWrapAround = TestPhiWrapAround(),
+       testEdges = TestCellEdges();
+  return testRandom && testWrapAround && testEdges;
+}
+
+bool TestAliEmcalCorrectionClusterTrackMatcher::TestRandomEvents() const
+{
+  AliInfoStream() << "Running test for random events" << std::endl;
+  const Double_t maxDist[2] = {0.1, 0.025};
+  TRandom3 rnd(1);
+  bool result = true;
+  for (Int_t ievent = 0; ievent < 20; ievent++) {
+    const Double_t dist = maxDist[ievent % 2];
+    const Int_t nclusters = 100 + rnd.Integer(100);
+    std::vector<Double_t> clusterEta, clusterPhi, trackEta, trackPhi;
+    for (Int_t icluster = 0; icluster < nclusters; icluster++) {
+      // EMCal (70%) or DCal acceptance
+      clusterEta.push_back(rnd.Uniform(-0.7, 0.7));
+      clusterPhi.push_back(rnd.Uniform() < 0.7 ? rnd.Uniform(1.40, 3.27) : rnd.Uniform(4.54, 5.70));
+    }
+    for (Int_t itrack = 0; itrack < nclusters; itrack++) {
+      if (itrack % 2) {
+        // close to a cluster
+        Int_t icluster = rnd.Integer(nclusters);
+        trackEta.push_back(clusterEta[icluster] + rnd.Gaus(0, dist));
+        trackPhi.push_back(clusterPhi[icluster] + rnd.Gaus(0, dist));
+      }
+      else {
+        trackEta.push_back(rnd.Uniform(-0.9, 0.9));
+        trackPhi.push_back(rnd.Uniform(0, TMath::TwoPi()));
+      }
+    }
+    TObjArray clusters, tracks;
+    CreateClusters(clusterEta, clusterPhi, clusters);
+    CreateTracks(trackEta, trackPhi, tracks);
+    if (!CompareMatching(clusters, tracks, dist)) {
+      AliErrorStream() << "Matches differ in random event " << ievent << std::endl;
+      result = false;
+    }
+  }
+  return result;
+}
+
+bool TestAliEmcalCorrectionClusterTrackMatcher::TestPhiWrapAround() const
+{
+  AliInfoStream() << "Running test for the phi wrap-around" << std::endl;
+  const Double_t twopi = TMath::TwoPi();
+  std::vector<Double_t> clusterEta = {0.1, 0.12, 0.1, 0.08, 0.1, 0.05},
+                        clusterPhi = {1e-4, 0.02, 0.06, twopi - 1e-4, twopi - 0.03, twopi - 0.08},
+                        trackPhi = {0., 1e-6, 0.01, 0.05, 0.12, twopi - 1e-6, twopi - 0.01, twopi - 0.05, twopi - 0.12, -0.01, twopi + 0.01},
+                        trackEta(trackPhi.size(), 0.1);
+  TObjArray clusters, tracks;
+  CreateClusters(clusterEta, clusterPhi, clusters);
+  CreateTracks(trackEta, trackPhi, tracks);
+
+  // many phi cells, 3 phi cells and a single phi cell
+  const Double_t maxDist[4] = {0.1, 0.05, 2.0, 4.0};
+  bool result = true;
+  for (Int_t idist = 0; idist < 4; idist++) {
+    if (!CompareMatching(clusters, tracks, maxDist[idist])) {
+      AliErrorStream() << "Matches differ at the phi wrap-around for maximum distance " << maxDist[idist] << std::endl;
+      result = false;
+    }
+  }
+  return result;
+}
+
+bool TestAliEmcalCorrectionClusterTrackMatcher::TestCellEdges() const
+{
+  AliInfoStream() << "Running test for tracks on the grid cell edges" << std::endl;
+  const Double_t maxDist = 0.1;
+  std::vector<Double_t> clusterEta, clusterPhi, trackEta, trackPhi;
+  for (Int_t ieta = 0; ieta < 7; ieta++) {
+    for (Int_t iphi = 0; iphi < 11; iphi++) {
+      clusterEta.push_back(-0.6 + 0.2 * ieta + 0.01 * iphi);
+      clusterPhi.push_back(1.4 + 0.17 * iphi);
+    }
+  }
+  TObjArray clusters, tracks;
+  CreateClusters(clusterEta, clusterPhi, clusters);
+
+  // grid geometry for these clusters
+  AliEmcalCorrectionClusterTrackMatcher matcher;
+  matcher.fMaxDistance = maxDist;
+  FillEmcalParticles(matcher, clusters, tracks);
+  matcher.BuildClusterGrid();
+  const Double_t etaMin = matcher.fGridEtaMin, etaWidth = matcher.fGridEtaWidth, phiWidth = matcher.fGridPhiWidth;
+  const Int_t nEta = matcher.fGridNEta;
+  delete matcher.fEmcalTracks;
+  delete matcher.fEmcalClusters;
+  matcher.fEmcalTracks = matcher.fEmcalClusters = 0;
+
+  // tracks on the cell edges (including one cell outside of the grid) and next to them
+  const Double_t offsets[3] = {-1e-9, 0., 1e-9};
+  const Int_t phiEdgeMin = static_cast<Int_t>(1.2 / phiWidth), phiEdgeMax = static_cast<Int_t>(3.4 / phiWidth) + 1;
+  for (Int_t ieta = -1; ieta <= nEta + 1; ieta++) {
+    for (Int_t iphi = phiEdgeMin; iphi <= phiEdgeMax; iphi++) {
+      for (Int_t ioffset = 0; ioffset < 3; ioffset++) {
+        trackEta.push_back(etaMin + ieta * etaWidth + offsets[ioffset]);
+        trackPhi.push_back(iphi * phiWidth);
+        trackEta.push_back(etaMin + ieta * etaWidth);
+        trackPhi.push_back(iphi * phiWidth + offsets[ioffset]);
+      }
+    }
+  }
+
+  // tracks at the maximum distance from a cluster, using the cluster position as in the matcher
+  for (Int_t icluster = 0; icluster < clusters.GetEntriesFast(); icluster++) {
+    Float_t pos[3] = {0};
+    static_cast<AliVCluster*>(clusters.At(icluster))->GetPosition(pos);
+    TVector3 cpos(pos);
+    trackEta.push_back(cpos.Eta() + maxDist);
+    trackPhi.push_back(cpos.Phi());
+    trackEta.push_back(cpos.Eta());
+    trackPhi.push_back(cpos.Phi() - maxDist);
+  }
+  CreateTracks(trackEta, trackPhi, tracks);
+
+  if (!CompareMatching(clusters, tracks, maxDist)) {
+    AliErrorStream() << "Matches differ for tracks on the grid cell edges" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void TestAliEmcalCorrectionClusterTrackMatcher::CreateClusters(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, TObjArray &clusters) const
+{
+  const Double_t radius = 440.;
+  clusters.SetOwner(kTRUE);
+  for (UInt_t icluster = 0; icluster < eta.size(); icluster++) {
+    Float_t pos[3] = {static_cast<Float_t>(radius * TMath::Cos(phi[icluster])),
+                      static_cast<Float_t>(radius * TMath::Sin(phi[icluster])),
+                      static_cast<Float_t>(radius * TMath::SinH(eta[icluster]))};
+    AliAODCaloCluster *cluster = new AliAODCaloCluster;
+    cluster->SetPosition(pos);
+    cluster->SetE(1.);
+    clusters.Add(cluster);
+  }
+}
+
+void TestAliEmcalCorrectionClusterTrackMatcher::CreateTracks(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, TObjArray &tracks) const
+{
+  tracks.SetOwner(kTRUE);
+  for (UInt_t itrack = 0; itrack < eta.size(); itrack++) {
+    AliAODTrack *track = new AliAODTrack;
+    track->SetTrackPhiEtaPtOnEMCal(phi[itrack], eta[itrack], 1.);
+    tracks.Add(track);
+  }
+}
+
+void TestAliEmcalCorrectionClusterTrackMatcher::FillEmcalParticles(AliEmcalCorrectionClusterTrackMatcher &matcher, const TObjArray &clusters, const TObjArray &tracks) const
+{
+  if (!matcher.fEmcalTracks) matcher.fEmcalTracks = new TClonesArray("AliEmcalParticle");
+  if (!matcher.fEmcalClusters) matcher.fEmcalClusters = new TClonesArray("AliEmcalParticle");
+  matcher.fEmcalTracks->Delete();
+  matcher.fEmcalClusters->Delete();
+  matcher.fNEmcalTracks = 0;
+  matcher.fNEmcalClusters = 0;
+
+  for (Int_t icluster = 0; icluster < clusters.GetEntriesFast(); icluster++) {
+    AliEmcalParticle* emcalCluster = new ((*matcher.fEmcalClusters)[matcher.fNEmcalClusters]) AliEmcalParticle(static_cast<AliVCluster*>(clusters.At(icluster)), icluster);
+    emcalCluster->SetMatchedPtr(matcher.fEmcalTracks);
+    matcher.fNEmcalClusters++;
+  }
+  for (Int_t itrack = 0; itrack < tracks.GetEntriesFast(); itrack++) {
+    AliEmcalParticle* emcalTrack = new ((*matcher.fEmcalTracks)[matcher.fNEmcalTracks]) AliEmcalParticle(static_cast<AliVTrack*>(tracks.At(itrack)), itrack);
+    emcalTrack->SetMatchedPtr(matcher.fEmcalClusters);
+    matcher.fNEmcalTracks++;
+  }
+}
+
+void TestAliEmcalCorrectionClusterTrackMatcher::RunMatching(AliEmcalCorrectionClusterTrackMatcher &matcher, const TObjArray &clusters, const TObjArray &tracks, bool useGrid,
+                                                            std::vector<Int_t> &ids, std::vector<Double_t> &distances) const
+{
+  matcher.fUseGridMatching = useGrid;
+  FillEmcalParticles(matcher, clusters, tracks);
+  matcher.DoMatching();
+
+  ids.clear();
+  distances.clear();
+  TClonesArray *particles[2] = {matcher.fEmcalTracks, matcher.fEmcalClusters};
+  for (Int_t iarray = 0; iarray < 2; iarray++) {
+    for (Int_t ipart = 0; ipart < particles[iarray]->GetEntriesFast(); ipart++) {
+      AliEmcalParticle *part = static_cast<AliEmcalParticle*>(particles[iarray]->At(ipart));
+      ids.push_back(part->GetNumberOfMatchedObj());
+      for (UShort_t imatch = 0; imatch < part->GetNumberOfMatchedObj(); imatch++) {
+        ids.push_back(part->GetMatchedObjId(imatch));
+        distances.push_back(part->GetMatchedObjDistance(imatch));
+      }
+    }
+  }
+}
+
+bool TestAliEmcalCorrectionClusterTrackMatcher::CompareMatching(const TObjArray &clusters, const TObjArray &tracks, Double_t maxDist) const
+{
+  AliEmcalCorrectionClusterTrackMatcher matcher;
+  matcher.fCreateHisto = kFALSE;
+  matcher.fMaxDistance = maxDist;
+
+  std::vector<Int_t> gridIds, allPairsIds;
+  std::vector<Double_t> gridDistances, allPairsDistances;
+  RunMatching(matcher, clusters, tracks, true, gridIds, gridDistances);
+  RunMatching(matcher, clusters, tracks, false, allPairsIds, allPairsDistances);
+  delete matcher.fEmcalTracks;
+  delete matcher.fEmcalClusters;
+  matcher.fEmcalTracks = matcher.fEmcalClusters = 0;
+
+  if (allPairsDistances.empty()) {
+    // all test cases are built with matching track-cluster pairs
+    AliErrorStream() << "No track matched to any cluster" << std::endl;
+    return false;
+  }
+  if (gridIds != allPairsIds || gridDistances != allPairsDistances) {
+    AliErrorStream() << "Grid matching: " << gridDistances.size() << " matches, all pairs: " << allPairsDistances.size() << " matches" << std::endl;
+    return false;
+  }
+  return true;
+}
@@ -1,6 +1,8 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
@@ -9,6 +11,7 @@
 
 class TH1;
 class TClonesArray;
+class TObjArray;
 
 class AliVParticle;
 
@@ -45,6 +48,11 @@ class AliVParticle;
  ~~~
  (again assuming that the task is derived from AliAnalysisTaskEmcal or AliAnalysisTaskEmcalJet).
  *
+ * To avoid testing all track-cluster pairs, the clusters are sorted into an (eta, phi) grid with cells of at least
+ * the maximum matching distance, and each track is only compared with the clusters of the neighbouring cells
+ * (configuration "useGridMatching"). The matches are the same as with the all-pairs loop (see
+ * TestAliEmcalCorrectionClusterTrackMatcher).
+ *
  * Based on code in AliEmcalClusTrackMatcherTask. 
  *
  * @author Constantin Loizides, LBNL, AliEmcalClusTrackMatcherTask
@@ -69,6 +77,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Int_t         GetMomBin(Double_t p) const;
   void          GenerateEmcalParticles();
   void          DoMatching();
+  void          BuildClusterGrid();
+  void          GetCandidateClusters(AliVTrack* track, std::vector<Int_t>& candidates) const;
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
@@ -87,6 +97,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseDCA;                ///< Use DCA as starting point for track propagation, rather than primary vertex
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fUseGridMatching;       ///< only test clusters in neighbouring cells of an (eta, phi) grid for each track
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -102,12 +113,25 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[10][9][2]; //!<!dphi distribution
+
+  Int_t                 fGridNEta;           //!<!number of eta cells of the cluster grid
+  Int_t                 fGridNPhi;           //!<!number of phi cells of the cluster grid
+  Double_t              fGridEtaMin;         //!<!lower eta edge of the cluster grid
+  Double_t              fGridEtaWidth;       //!<!eta width of a grid cell
+  Double_t              fGridPhiWidth;       //!<!phi width of a grid cell
+  std::vector<Int_t>    fGridCellStart;      //!<!first entry of each cell in fGridClusters (one more entry than cells)
+  std::vector<Int_t>    fGridClusters;       //!<!cluster indices sorted by cell, ascending within a cell
+  std::vector<Int_t>    fGridOutside;        //!<!clusters without a finite position, tested with every track
+  std::vector<Int_t>    fGridClusterCell;    //!<!cell of each cluster (-1 if none)
+  std::vector<Int_t>    fCandidateClusters;  //!<!candidate clusters of the current track
   
   Int_t      fNMCGenerToAccept;          ///<  Number of MC generators that should not be included in analysis
   TString    fMCGenerToAccept[5];        ///<  List with name of generators that should not be included
   Bool_t     fMCGenerToAcceptForTrack;   ///<  Activate the removal of tracks entering the track matching that come from a particular generator
   
 private:
+  friend class TestAliEmcalCorrectionClusterTrackMatcher;
+
   AliEmcalCorrectionClusterTrackMatcher(const AliEmcalCorrectionClusterTrackMatcher &);               // Not implemented
   AliEmcalCorrectionClusterTrackMatcher &operator=(const AliEmcalCorrectionClusterTrackMatcher &);    // Not implemented
 
@@ -115,7 +139,115 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 4); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
+  /// \endcond
+};
+
+/**
+ * @class TestAliEmcalCorrectionClusterTrackMatcher
+ * @ingroup EMCALCOREFW
+ * @brief Unit test for the grid matching of AliEmcalCorrectionClusterTrackMatcher
+ *
+ * Synthetic clusters (positions on the EMCal surface) and tracks (eta, phi on the EMCal surface)
+ * are matched once with the (eta, phi) grid and once testing all track-cluster pairs. For every
+ * track and every cluster the matched objects and their distances must be identical, in the same
+ * order. Tested are
+ * - random events in the EMCal and DCal acceptance
+ * - clusters and tracks around the phi wrap-around at 0 / 2pi
+ * - tracks on the edges of the grid cells and at exactly the maximum distance from a cluster
+ */
+class TestAliEmcalCorrectionClusterTrackMatcher : public TObject {
+public:
+  /**
+   * @brief Constructor
+   */
+  TestAliEmcalCorrectionClusterTrackMatcher() : TObject() {}
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~TestAliEmcalCorrectionClusterTrackMatcher() {}
+
+  /**
+   * @brief Run all unit tests for the grid matching
+   * @return True if all tests passed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Test random events with clusters in the EMCal and DCal acceptance
+   *
+   * Half of the tracks are placed close to a cluster, the other half randomly.
+   * @return True if the matches are identical in all events
+   */
+  bool TestRandomEvents() const;
+
+  /**
+   * @brief Test clusters and tracks close to phi = 0 and phi = 2pi
+   *
+   * Tested for distances with many phi cells, with 3 phi cells and with a single phi cell.
+   * @return True if the matches are identical for all distances
+   */
+  bool TestPhiWrapAround() const;
+
+  /**
+   * @brief Test tracks on the edges of the grid cells
+   *
+   * Tracks are placed on (and just next to) the cell edges in eta and phi, one cell outside
+   * of the grid, and at exactly the maximum distance from a cluster.
+   * @return True if the matches are identical
+   */
+  bool TestCellEdges() const;
+
+protected:
+
+  /**
+   * @brief Create AOD clusters on the EMCal surface
+   * @param[in] eta Pseudorapidity of the clusters
+   * @param[in] phi Azimuth of the clusters
+   * @param[out] clusters Array owning the clusters
+   */
+  void CreateClusters(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, TObjArray &clusters) const;
+
+  /**
+   * @brief Create AOD tracks propagated to the EMCal surface
+   * @param[in] eta Pseudorapidity on the EMCal surface
+   * @param[in] phi Azimuth on the EMCal surface
+   * @param[out] tracks Array owning the tracks
+   */
+  void CreateTracks(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, TObjArray &tracks) const;
+
+  /**
+   * @brief Create the AliEmcalParticles of the matcher (as in GenerateEmcalParticles, without containers)
+   * @param[in,out] matcher Matcher to be tested
+   * @param[in] clusters Clusters to be matched
+   * @param[in] tracks Tracks to be matched
+   */
+  void FillEmcalParticles(AliEmcalCorrectionClusterTrackMatcher &matcher, const TObjArray &clusters, const TObjArray &tracks) const;
+
+  /**
+   * @brief Run the matching and collect the matched objects of all tracks and clusters
+   * @param[in,out] matcher Matcher to be tested
+   * @param[in] clusters Clusters to be matched
+   * @param[in] tracks Tracks to be matched
+   * @param[in] useGrid If true the grid matching is used, otherwise all pairs are tested
+   * @param[out] ids Number of matches followed by the matched ids, for every track and cluster
+   * @param[out] distances Distances of the matched objects, in the same order
+   */
+  void RunMatching(AliEmcalCorrectionClusterTrackMatcher &matcher, const TObjArray &clusters, const TObjArray &tracks, bool useGrid,
+                   std::vector<Int_t> &ids, std::vector<Double_t> &distances) const;
+
+  /**
+   * @brief Compare the grid matching with testing all track-cluster pairs
+   * @param[in] clusters Clusters to be matched
+   * @param[in] tracks Tracks to be matched
+   * @param[in] maxDist Maximum matching distance
+   * @return True if the matched objects and distances are identical
+   */
+  bool CompareMatching(const TObjArray &clusters, const TObjArray &tracks, Double_t maxDist) const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalCorrectionClusterTrackMatcher, 1);
   /// \endcond
 };
 
@@ -32,6 +32,8 @@
 #include "AliEMCALTriggerRawPatch.h"
 #include "AliEmcalTriggerMakerKernel.h"
 #include "AliEmcalTriggerSetupInfo.h"
+#include "AliEmcalTriggerSummedAreaPatchFinder.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
 #include "AliLog.h"
 #include "AliVCaloCells.h"
 #include "AliVCaloTrigger.h"
@@ -50,6 +52,9 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fTriggerBitConfig(nullptr),
   fPatchFinder(nullptr),
   fLevel0PatchFinder(nullptr),
+  fSummedAreaPatchFinder(nullptr),
+  fSummedAreaLevel0PatchFinder(nullptr),
+  fUseSummedAreaPatchFinder(kFALSE),
   fL0MinTime(7),
   fL0MaxTime(10),
   fMinCellAmp(0),
@@ -72,6 +77,9 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fPatchEnergySimpleSmeared(nullptr),
   fLevel0TimeMap(nullptr),
   fTriggerBitMap(nullptr),
+  fTableAmplitudes(nullptr),
+  fTableADCSimple(nullptr),
+  fTableADC(nullptr),
   fADCtoGeV(1.)
 {
   memset(fThresholdConstants, 0, sizeof(Int_t) * 12);
@@ -89,6 +97,11 @@ AliEmcalTriggerMakerKernel::~AliEmcalTriggerMakerKernel() {
   delete fTriggerBitMap;
   delete fPatchFinder;
   delete fLevel0PatchFinder;
+  delete fSummedAreaPatchFinder;
+  delete fSummedAreaLevel0PatchFinder;
+  delete fTableAmplitudes;
+  delete fTableADCSimple;
+  delete fTableADC;
   if(fTriggerBitConfig) delete fTriggerBitConfig;
 }
 
@@ -104,6 +117,9 @@ void AliEmcalTriggerMakerKernel::Init(){
   fPatchADC = new AliEMCALTriggerDataGrid<double>;
   fLevel0TimeMap = new AliEMCALTriggerDataGrid<char>;
   fTriggerBitMap = new AliEMCALTriggerDataGrid<int>;
+  fTableAmplitudes = new AliEmcalTriggerSummedAreaTable;
+  fTableADCSimple = new AliEmcalTriggerSummedAreaTable;
+  fTableADC = new AliEmcalTriggerSummedAreaTable;
 
   // Allocate containers for the ADC values
   int nrows = fGeometry->GetNTotalTRU() * 2;
@@ -128,6 +144,9 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+
+  if (!fSummedAreaPatchFinder) fSummedAreaPatchFinder = new AliEmcalTriggerSummedAreaPatchFinder;
+  fSummedAreaPatchFinder->AddTriggerAlgorithm(rowmin, rowmax, bitmask, patchSize, subregionSize);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -136,6 +155,10 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+
+  if (!fSummedAreaLevel0PatchFinder) fSummedAreaLevel0PatchFinder = new AliEmcalTriggerSummedAreaPatchFinder;
+  fSummedAreaLevel0PatchFinder->ClearTriggerAlgorithms();
+  fSummedAreaLevel0PatchFinder->AddTriggerAlgorithm(rowmin, rowmax, bitmask, patchSize, subregionSize);
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -146,6 +169,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -163,6 +187,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -180,6 +205,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP20158x8()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -197,6 +223,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -212,6 +239,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -227,6 +255,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -242,6 +271,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->ClearTriggerAlgorithms();
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -505,7 +535,14 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
   std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
+  if (fUseSummedAreaPatchFinder) {
+    // Summed-area tables are built once per event and shared between the L1 and L0 patch finders
+    fTableADCSimple->Build(*fPatchADCSimple);
+    if (useL0amp || fSummedAreaLevel0PatchFinder) fTableAmplitudes->Build(*fPatchAmplitudes);
+    if (!useL0amp) fTableADC->Build(*fPatchADC);
+    if (fSummedAreaPatchFinder) patches = fSummedAreaPatchFinder->FindPatches(useL0amp ? *fTableAmplitudes : *fTableADC, *fTableADCSimple);
+  }
+  else if (fPatchFinder) {
     if (useL0amp) {
       patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
     }
@@ -561,7 +598,10 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
 
   // Find Level0 patches
   std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  if (fUseSummedAreaPatchFinder) {
+    if (fSummedAreaLevel0PatchFinder) l0patches = fSummedAreaLevel0PatchFinder->FindPatches(*fTableAmplitudes, *fTableADCSimple);
+  }
+  else if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -24,6 +24,8 @@ class AliEMCALTriggerBitConfig;
 template<class T> class AliEMCALTriggerDataGrid;
 template<class T> class AliEMCALTriggerAlgorithm;
 template<class T> class AliEMCALTriggerPatchFinder;
+class AliEmcalTriggerSummedAreaPatchFinder;
+class AliEmcalTriggerSummedAreaTable;
 
 // To be moved to AliRoot in AliEMCALTriggerConstants.h at the first occasion
 namespace EMCALTrigger {
@@ -370,6 +372,16 @@ public:
    */
   void SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
 
+  /**
+   * @brief Find patches using summed-area tables instead of the AliEMCALTriggerPatchFinder
+   *
+   * The summed-area tables of the data grids are built once per event and shared
+   * between the L1 and L0 patch finders. Patches are identical to the ones obtained
+   * with the AliEMCALTriggerPatchFinder (see AliEmcalTriggerSummedAreaTable).
+   * @param[in] doUse If true the summed-area table patch finders are used
+   */
+  void SetUseSummedAreaPatchFinder(Bool_t doUse = kTRUE) { fUseSummedAreaPatchFinder = doUse; }
+
   /**
    * @brief Set energy-dependent models for gaussian energy smearing
    * @param[in] mean Parameterization of the mean
@@ -480,6 +492,9 @@ protected:
 
   AliEMCALTriggerPatchFinder<double>       *fPatchFinder;                 ///< The actual patch finder
   AliEMCALTriggerAlgorithm<double>         *fLevel0PatchFinder;           ///< Patch finder for Level0 patches
+  AliEmcalTriggerSummedAreaPatchFinder     *fSummedAreaPatchFinder;       ///< Patch finder running on summed-area tables
+  AliEmcalTriggerSummedAreaPatchFinder     *fSummedAreaLevel0PatchFinder; ///< Patch finder for Level0 patches running on summed-area tables
+  Bool_t                                    fUseSummedAreaPatchFinder;    ///< Use the patch finders running on summed-area tables
   Int_t                                     fL0MinTime;                   ///< Minimum L0 time
   Int_t                                     fL0MaxTime;                   ///< Maximum L0 time
   Int_t                                     fMinCellAmp;                  ///< Minimum offline amplitude of the cells used to generate the patches
@@ -506,11 +521,14 @@ protected:
   AliEMCALTriggerDataGrid<double>           *fPatchEnergySimpleSmeared;   //!<! Data grid for smeared energy values from cell energies
   AliEMCALTriggerDataGrid<char>             *fLevel0TimeMap;              //!<! Map needed to store the level0 times
   AliEMCALTriggerDataGrid<int>              *fTriggerBitMap;              //!<! Map of trigger bits
+  AliEmcalTriggerSummedAreaTable            *fTableAmplitudes;            //!<! Summed-area table of the TRU Amplitudes
+  AliEmcalTriggerSummedAreaTable            *fTableADCSimple;             //!<! Summed-area table of the offline ADC values
+  AliEmcalTriggerSummedAreaTable            *fTableADC;                   //!<! Summed-area table of the ADC values
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -171,6 +171,17 @@ public:
     if(fTriggerMaker) fTriggerMaker->SetApplyOnlineBadChannelMaskingToOffline(doApply);
   }
 
+  /**
+   * @brief Find patches using summed-area tables of the data grids
+   *
+   * The summed-area tables are built once per event inside the trigger maker kernel.
+   * The patches are identical to the ones of the default patch finder.
+   * @param[in] doUse If true the summed-area table patch finders are used
+   */
+  void SetUseSummedAreaPatchFinder(Bool_t doUse = kTRUE) {
+    if(fTriggerMaker) fTriggerMaker->SetUseSummedAreaPatchFinder(doUse);
+  }
+
   void SetTriggerThresholdJetLow   ( Int_t a, Int_t b, Int_t c ) {
     if(fTriggerMaker) fTriggerMaker->SetTriggerThresholdJetLow(a, b, c);
   }
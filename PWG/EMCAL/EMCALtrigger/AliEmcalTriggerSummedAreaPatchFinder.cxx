@@ -0,0 +1,178 @@
+/**************************************************************************
+ * Copyright(c) 1998-2015, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <iostream>
+#include <TMath.h>
+#include <TRandom3.h>
+
+#include "AliEMCALTriggerAlgorithm.h"
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEMCALTriggerRawPatch.h"
+#include "AliEmcalTriggerSummedAreaPatchFinder.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
+#include "AliLog.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTriggerSummedAreaPatchFinder)
+ClassImp(TestAliEmcalTriggerSummedAreaPatchFinder)
+/// \endcond
+
+AliEmcalTriggerSummedAreaPatchFinder::AliEmcalTriggerSummedAreaPatchFinder():
+  TObject(),
+  fRowMin(),
+  fRowMax(),
+  fBitMask(),
+  fPatchSize(),
+  fSubregionSize(),
+  fThreshold(0.),
+  fOfflineThreshold(0.)
+{
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::AddTriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize){
+  fRowMin.push_back(rowmin);
+  fRowMax.push_back(rowmax);
+  fBitMask.push_back(bitmask);
+  fPatchSize.push_back(patchSize);
+  fSubregionSize.push_back(subregionSize);
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::ClearTriggerAlgorithms(){
+  fRowMin.clear();
+  fRowMax.clear();
+  fBitMask.clear();
+  fPatchSize.clear();
+  fSubregionSize.clear();
+}
+
+std::vector<AliEMCALTriggerRawPatch> AliEmcalTriggerSummedAreaPatchFinder::FindPatches(const AliEmcalTriggerSummedAreaTable &adc, const AliEmcalTriggerSummedAreaTable &offlineAdc) const {
+  std::vector<AliEMCALTriggerRawPatch> result;
+  for(int ialgo = 0; ialgo < GetNumberOfTriggerAlgorithms(); ialgo++){
+    // same sliding window as in AliEMCALTriggerAlgorithm::FindPatches
+    int patchsize = fPatchSize[ialgo], subregion = fSubregionSize[ialgo];
+    if(subregion <= 0) continue;
+    int rowStartMax = fRowMax[ialgo] - (patchsize - 1), colStartMax = adc.GetNumberOfCols() - patchsize;
+    for(int irow = fRowMin[ialgo]; irow <= rowStartMax; irow += subregion){
+      for(int icol = 0; icol <= colStartMax; icol += subregion){
+        double sumadc = adc.GetWindowSum(icol, irow, patchsize, patchsize),
+               sumofflineAdc = offlineAdc.GetWindowSum(icol, irow, patchsize, patchsize);
+        if(sumadc > fThreshold || sumofflineAdc > fOfflineThreshold){
+          AliEMCALTriggerRawPatch recpatch(icol, irow, patchsize, sumadc, sumofflineAdc);
+          recpatch.SetBitmask(fBitMask[ialgo]);
+          result.push_back(recpatch);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+bool TestAliEmcalTriggerSummedAreaPatchFinder::RunAllTests() const {
+  bool testInteger = TestIntegerGrid(),
+       testFractional = TestFractionalGrid();
+  return testInteger && testFractional;
+}
+
+bool TestAliEmcalTriggerSummedAreaPatchFinder::TestIntegerGrid() const {
+  AliInfoStream() << "Running test for integer online ADC values" << std::endl;
+  TRandom3 rnd(1);
+  // EMCAL and DCAL: 48 columns, 104 rows (same as in the trigger maker kernel)
+  AliEMCALTriggerDataGrid<double> adc, offlineAdc;
+  adc.Allocate(48, 104);
+  offlineAdc.Allocate(48, 104);
+  bool result = true;
+  for(int ievent = 0; ievent < 20; ievent++){
+    FillGrid(adc, rnd, true);
+    FillGrid(offlineAdc, rnd, false);
+    if(!ComparePatches(adc, offlineAdc, true)){
+      AliErrorStream() << "Patches differ in event " << ievent << std::endl;
+      result = false;
+    }
+  }
+  return result;
+}
+
+bool TestAliEmcalTriggerSummedAreaPatchFinder::TestFractionalGrid() const {
+  AliInfoStream() << "Running test for fractional online ADC values" << std::endl;
+  TRandom3 rnd(2);
+  // EMCAL and DCAL: 48 columns, 104 rows (same as in the trigger maker kernel)
+  AliEMCALTriggerDataGrid<double> adc, offlineAdc;
+  adc.Allocate(48, 104);
+  offlineAdc.Allocate(48, 104);
+  bool result = true;
+  for(int ievent = 0; ievent < 20; ievent++){
+    FillGrid(adc, rnd, false);
+    FillGrid(offlineAdc, rnd, false);
+    if(!ComparePatches(adc, offlineAdc, false)){
+      AliErrorStream() << "Patches differ in event " << ievent << std::endl;
+      result = false;
+    }
+  }
+  return result;
+}
+
+void TestAliEmcalTriggerSummedAreaPatchFinder::FillGrid(AliEMCALTriggerDataGrid<double> &grid, TRandom &rnd, bool integer) const {
+  grid.Reset();
+  for(int irow = 0; irow < grid.GetNumberOfRows(); irow++){
+    for(int icol = 0; icol < grid.GetNumberOfCols(); icol++){
+      if(rnd.Uniform() > 0.05) continue;
+      double value = rnd.Uniform(0., 2000.);
+      grid(icol, irow) = integer ? TMath::Floor(value) : value;
+    }
+  }
+}
+
+bool TestAliEmcalTriggerSummedAreaPatchFinder::ComparePatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, bool exact) const {
+  // rowmin, rowmax, bitmask, patch size, subregion size
+  const int kAlgorithms[4][5] = {{0, 63, 1, 2, 1}, {64, 103, 2, 2, 1}, {0, 63, 4, 16, 4}, {64, 103, 8, 8, 4}};
+  AliEmcalTriggerSummedAreaPatchFinder finder;
+  std::vector<AliEMCALTriggerRawPatch> reference;
+  for(int ialgo = 0; ialgo < 4; ialgo++){
+    const int *settings = kAlgorithms[ialgo];
+    AliEMCALTriggerAlgorithm<double> algorithm(settings[0], settings[1], settings[2]);
+    algorithm.SetPatchSize(settings[3]);
+    algorithm.SetSubregionSize(settings[4]);
+    std::vector<AliEMCALTriggerRawPatch> patches = algorithm.FindPatches(adc, offlineAdc);
+    reference.insert(reference.end(), patches.begin(), patches.end());
+    finder.AddTriggerAlgorithm(settings[0], settings[1], settings[2], settings[3], settings[4]);
+  }
+
+  AliEmcalTriggerSummedAreaTable adcTable, offlineAdcTable;
+  adcTable.Build(adc);
+  offlineAdcTable.Build(offlineAdc);
+  if(adcTable.IsExact() != exact){
+    AliErrorStream() << "Summed-area table of the online ADC values " << (exact ? "not exact" : "exact") << std::endl;
+    return false;
+  }
+  std::vector<AliEMCALTriggerRawPatch> patches = finder.FindPatches(adcTable, offlineAdcTable);
+
+  if(patches.size() != reference.size()){
+    AliErrorStream() << "Found " << patches.size() << " patches, expected " << reference.size() << std::endl;
+    return false;
+  }
+  for(std::vector<AliEMCALTriggerRawPatch>::size_type ipatch = 0; ipatch < patches.size(); ipatch++){
+    const AliEMCALTriggerRawPatch &found = patches[ipatch], &expected = reference[ipatch];
+    if(found.GetColStart() != expected.GetColStart() || found.GetRowStart() != expected.GetRowStart() ||
+       found.GetPatchSize() != expected.GetPatchSize() || found.GetBitmask() != expected.GetBitmask() ||
+       found.GetADC() != expected.GetADC() || found.GetOfflineADC() != expected.GetOfflineADC()){
+      AliErrorStream() << "Patch " << ipatch << ": found (" << found.GetColStart() << ", " << found.GetRowStart()
+                       << ", size " << found.GetPatchSize() << ", ADC " << found.GetADC() << ", offline " << found.GetOfflineADC()
+                       << "), expected (" << expected.GetColStart() << ", " << expected.GetRowStart()
+                       << ", size " << expected.GetPatchSize() << ", ADC " << expected.GetADC() << ", offline " << expected.GetOfflineADC()
+                       << ")" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
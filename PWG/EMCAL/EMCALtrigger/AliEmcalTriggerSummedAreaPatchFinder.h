@@ -0,0 +1,165 @@
+#ifndef ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H
+#define ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H
+/* Copyright(c) 1998-2015, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliEMCALTriggerRawPatch;
+class AliEmcalTriggerSummedAreaTable;
+class TRandom;
+template<class T> class AliEMCALTriggerDataGrid;
+
+/**
+ * @class AliEmcalTriggerSummedAreaPatchFinder
+ * @brief Patch finder running on summed-area tables
+ * @ingroup EMCALTRGFW
+ *
+ * Drop-in replacement of the AliEMCALTriggerPatchFinder with its
+ * AliEMCALTriggerAlgorithms, obtaining the patch sums from summed-area
+ * tables (see AliEmcalTriggerSummedAreaTable) instead of from the data
+ * grids. The tables are built once per event and can be shared between
+ * several patch finders. For every trigger algorithm (row range, patch size,
+ * subregion size, bitmask) the same patches, with the same sums and in the
+ * same order, are found as with the AliEMCALTriggerAlgorithm.
+ */
+class AliEmcalTriggerSummedAreaPatchFinder : public TObject {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  AliEmcalTriggerSummedAreaPatchFinder();
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~AliEmcalTriggerSummedAreaPatchFinder() {}
+
+  /**
+   * @brief Add a trigger algorithm
+   * @param[in] rowmin Minimum row value
+   * @param[in] rowmax Maximum row value
+   * @param[in] bitmask Offline bit mask to be applied to the patches
+   * @param[in] patchSize Size of the patches
+   * @param[in] subregionSize Size of the sliding sub region
+   */
+  void AddTriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
+
+  /**
+   * @brief Remove all trigger algorithms
+   */
+  void ClearTriggerAlgorithms();
+
+  /**
+   * @brief Get the number of trigger algorithms
+   * @return Number of trigger algorithms
+   */
+  Int_t GetNumberOfTriggerAlgorithms() const { return fRowMin.size(); }
+
+  /**
+   * @brief Set the thresholds a patch has to exceed to be accepted
+   *
+   * Patches are accepted if either the online or the offline sum
+   * is above threshold (default 0, like in AliEMCALTriggerAlgorithm).
+   * @param[in] threshold Threshold on the online sum
+   * @param[in] offlineThreshold Threshold on the offline sum
+   */
+  void SetThresholds(Double_t threshold, Double_t offlineThreshold) { fThreshold = threshold; fOfflineThreshold = offlineThreshold; }
+
+  /**
+   * @brief Find patches of all trigger algorithms
+   *
+   * Both tables need to be built from grids with the same dimension.
+   * @param[in] adc Summed-area table of the online ADC values (or L0 amplitudes)
+   * @param[in] offlineAdc Summed-area table of the offline ADC values
+   * @return Patches of all trigger algorithms, in the order the algorithms were added
+   */
+  std::vector<AliEMCALTriggerRawPatch> FindPatches(const AliEmcalTriggerSummedAreaTable &adc, const AliEmcalTriggerSummedAreaTable &offlineAdc) const;
+
+protected:
+  std::vector<Int_t>                  fRowMin;             ///< Minimum row of each algorithm
+  std::vector<Int_t>                  fRowMax;             ///< Maximum row of each algorithm
+  std::vector<UInt_t>                 fBitMask;            ///< Bit mask of each algorithm
+  std::vector<Int_t>                  fPatchSize;          ///< Patch size of each algorithm
+  std::vector<Int_t>                  fSubregionSize;      ///< Size of the sliding sub region of each algorithm
+  Double_t                            fThreshold;          ///< Threshold on the online sum
+  Double_t                            fOfflineThreshold;   ///< Threshold on the offline sum
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTriggerSummedAreaPatchFinder, 1);
+  /// \endcond
+};
+
+/**
+ * @class TestAliEmcalTriggerSummedAreaPatchFinder
+ * @brief Unit test for the summed-area table patch finder
+ * @ingroup EMCALTRGFW
+ *
+ * Compares the patches found by the AliEmcalTriggerSummedAreaPatchFinder
+ * with the patches found by AliEMCALTriggerAlgorithms with the same settings
+ * (gamma and jet algorithms in both row ranges of EMCAL and DCAL), on random
+ * grids of the EMCAL/DCAL dimension. The patches need to be identical, in
+ * position, size, bitmask and sums (bit by bit), and in the same order.
+ * Tested are
+ * - integer online ADC values (summed from the table) with fractional offline values
+ * - fractional online and offline values (summed channel by channel)
+ */
+class TestAliEmcalTriggerSummedAreaPatchFinder : public TObject {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  TestAliEmcalTriggerSummedAreaPatchFinder() : TObject() {}
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~TestAliEmcalTriggerSummedAreaPatchFinder() {}
+
+  /**
+   * @brief Run all unit tests for the class AliEmcalTriggerSummedAreaPatchFinder
+   * @return True if all tests passed
+   */
+  bool RunAllTests() const;
+
+  /**
+   * @brief Test grids with integer online ADC values
+   * @return True if the patches are identical for all events
+   */
+  bool TestIntegerGrid() const;
+
+  /**
+   * @brief Test grids with fractional online ADC values
+   * @return True if the patches are identical for all events
+   */
+  bool TestFractionalGrid() const;
+
+protected:
+
+  /**
+   * @brief Fill a grid with random values in about 5% of the channels
+   * @param[in,out] grid Allocated grid to be filled
+   * @param[in] rnd Random generator
+   * @param[in] integer If true only integer values are filled
+   */
+  void FillGrid(AliEMCALTriggerDataGrid<double> &grid, TRandom &rnd, bool integer) const;
+
+  /**
+   * @brief Compare the patches of both patch finders
+   * @param[in] adc Grid with the online ADC values
+   * @param[in] offlineAdc Grid with the offline ADC values
+   * @param[in] exact Expected exactness of the summed-area table of the online ADC values
+   * @return True if the patches are identical
+   */
+  bool ComparePatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, bool exact) const;
+
+  /// \cond CLASSIMP
+  ClassDef(TestAliEmcalTriggerSummedAreaPatchFinder, 1);
+  /// \endcond
+};
+
+#endif
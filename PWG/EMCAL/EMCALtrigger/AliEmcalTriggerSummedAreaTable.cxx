@@ -0,0 +1,116 @@
+/**************************************************************************
+ * Copyright(c) 1998-2015, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTriggerSummedAreaTable)
+/// \endcond
+
+AliEmcalTriggerSummedAreaTable::AliEmcalTriggerSummedAreaTable():
+  TObject(),
+  fNCols(0),
+  fNRows(0),
+  fExact(kTRUE),
+  fValues(),
+  fSums(1, 0.),
+  fCounts(1, 0)
+{
+}
+
+void AliEmcalTriggerSummedAreaTable::Build(const AliEMCALTriggerDataGrid<double> &grid){
+  fNCols = grid.GetNumberOfCols();
+  fNRows = grid.GetNumberOfRows();
+  fValues.resize(fNCols * fNRows);
+  fSums.resize((fNCols + 1) * (fNRows + 1));
+  fCounts.resize((fNCols + 1) * (fNRows + 1));
+
+  // Sums of integers are exact (and independent of the summation order)
+  // as long as all partial sums stay below 2^53
+  const double kMaxExactSum = 9007199254740992.;
+  double abssum = 0;
+  fExact = kTRUE;
+
+  // first row and column of the prefix tables are 0
+  for(int icol = 0; icol <= fNCols; icol++){
+    fSums[CornerIndex(icol, 0)] = 0.;
+    fCounts[CornerIndex(icol, 0)] = 0;
+  }
+  for(int irow = 0; irow < fNRows; irow++){
+    double rowsum = 0;
+    int rowcount = 0;
+    fSums[CornerIndex(0, irow + 1)] = 0.;
+    fCounts[CornerIndex(0, irow + 1)] = 0;
+    for(int icol = 0; icol < fNCols; icol++){
+      double value = grid(icol, irow);
+      fValues[irow * fNCols + icol] = value;
+      if(value != 0.) rowcount++;
+      if(value != std::floor(value)) fExact = kFALSE;
+      abssum += std::fabs(value);
+      rowsum += value;
+      fSums[CornerIndex(icol + 1, irow + 1)] = fSums[CornerIndex(icol + 1, irow)] + rowsum;
+      fCounts[CornerIndex(icol + 1, irow + 1)] = fCounts[CornerIndex(icol + 1, irow)] + rowcount;
+    }
+  }
+  if(!(abssum < kMaxExactSum)) fExact = kFALSE;
+}
+
+void AliEmcalTriggerSummedAreaTable::Clear(Option_t *){
+  fNCols = fNRows = 0;
+  fExact = kTRUE;
+  fValues.clear();
+  fSums.assign(1, 0.);
+  fCounts.assign(1, 0);
+}
+
+Bool_t AliEmcalTriggerSummedAreaTable::ClipWindow(Int_t &colmin, Int_t &rowmin, Int_t &colmax, Int_t &rowmax) const {
+  colmin = std::max(colmin, 0);
+  rowmin = std::max(rowmin, 0);
+  colmax = std::min(colmax, fNCols);
+  rowmax = std::min(rowmax, fNRows);
+  return colmin < colmax && rowmin < rowmax;
+}
+
+Int_t AliEmcalTriggerSummedAreaTable::GetWindowOccupancy(Int_t col, Int_t row, Int_t colsize, Int_t rowsize) const {
+  Int_t colmin = col, rowmin = row, colmax = col + colsize, rowmax = row + rowsize;
+  if(!ClipWindow(colmin, rowmin, colmax, rowmax)) return 0;
+  return fCounts[CornerIndex(colmax, rowmax)] - fCounts[CornerIndex(colmin, rowmax)]
+       - fCounts[CornerIndex(colmax, rowmin)] + fCounts[CornerIndex(colmin, rowmin)];
+}
+
+Double_t AliEmcalTriggerSummedAreaTable::GetWindowSum(Int_t col, Int_t row, Int_t colsize, Int_t rowsize) const {
+  Int_t colmin = col, rowmin = row, colmax = col + colsize, rowmax = row + rowsize;
+  if(!ClipWindow(colmin, rowmin, colmax, rowmax)) return 0.;
+  if(fExact){
+    return fSums[CornerIndex(colmax, rowmax)] - fSums[CornerIndex(colmin, rowmax)]
+         - fSums[CornerIndex(colmax, rowmin)] + fSums[CornerIndex(colmin, rowmin)];
+  }
+
+  // Fractional values: sum the channels in the order of the AliEMCALTriggerAlgorithm
+  // (rows outer, columns inner) in order to get the same rounding. Adding 0 does
+  // not change the sum, therefore empty windows are not summed at all.
+  double sum = 0;
+  if(!GetWindowOccupancy(colmin, rowmin, colmax - colmin, rowmax - rowmin)) return sum;
+  for(int irow = rowmin; irow < rowmax; irow++){
+    const double *rowvalues = &fValues[irow * fNCols];
+    for(int icol = colmin; icol < colmax; icol++){
+      sum += rowvalues[icol];
+    }
+  }
+  return sum;
+}
@@ -0,0 +1,131 @@
+#ifndef ALIEMCALTRIGGERSUMMEDAREATABLE_H
+#define ALIEMCALTRIGGERSUMMEDAREATABLE_H
+/* Copyright(c) 1998-2015, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <TObject.h>
+
+template<class T> class AliEMCALTriggerDataGrid;
+
+/**
+ * @class AliEmcalTriggerSummedAreaTable
+ * @brief Summed-area table (2D prefix sums) of a trigger data grid
+ * @ingroup EMCALTRGFW
+ *
+ * The table is built once per event from a data grid (see Build). Afterwards
+ * the sum over any rectangular window of FastORs, for any patch size, is
+ * obtained from four table entries, instead of summing all channels of the
+ * window again for every patch position, patch size and patch finder.
+ *
+ * Sums from the table are only identical to the sums obtained channel by
+ * channel if all values in the grid are integers and the sum of their
+ * absolute values is below 2^53 (online ADC counts). For grids with
+ * fractional values (offline ADC from cell energies, L0 amplitudes after
+ * pedestal subtraction) the table falls back to summing the channels of
+ * the window in the same order as the AliEMCALTriggerAlgorithm, so that the
+ * rounding is the same. Windows without any non-zero channel are recognized
+ * from a second table counting the occupied channels, so that they still
+ * do not need to be summed.
+ */
+class AliEmcalTriggerSummedAreaTable : public TObject {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  AliEmcalTriggerSummedAreaTable();
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~AliEmcalTriggerSummedAreaTable() {}
+
+  /**
+   * @brief Build the table from a data grid
+   *
+   * Memory is only reallocated if the dimension of the grid changes.
+   * @param[in] grid Data grid the table is built from
+   */
+  void Build(const AliEMCALTriggerDataGrid<double> &grid);
+
+  /**
+   * @brief Reset the table to an empty grid
+   * @param[in] option Not used
+   */
+  virtual void Clear(Option_t *option = "");
+
+  /**
+   * @brief Get the number of columns of the underlying grid
+   * @return Number of columns
+   */
+  Int_t GetNumberOfCols() const { return fNCols; }
+
+  /**
+   * @brief Get the number of rows of the underlying grid
+   * @return Number of rows
+   */
+  Int_t GetNumberOfRows() const { return fNRows; }
+
+  /**
+   * @brief Check whether window sums are obtained in O(1) from the table
+   * @return True if all values are integers and their sums are exact
+   */
+  Bool_t IsExact() const { return fExact; }
+
+  /**
+   * @brief Get the sum over a window of channels
+   *
+   * Channels outside the grid are ignored, as in the AliEMCALTriggerAlgorithm.
+   * @param[in] col Starting column of the window
+   * @param[in] row Starting row of the window
+   * @param[in] colsize Number of columns of the window
+   * @param[in] rowsize Number of rows of the window
+   * @return Sum of the channel values in the window
+   */
+  Double_t GetWindowSum(Int_t col, Int_t row, Int_t colsize, Int_t rowsize) const;
+
+  /**
+   * @brief Get the number of channels with non-zero value in a window
+   * @param[in] col Starting column of the window
+   * @param[in] row Starting row of the window
+   * @param[in] colsize Number of columns of the window
+   * @param[in] rowsize Number of rows of the window
+   * @return Number of occupied channels in the window
+   */
+  Int_t GetWindowOccupancy(Int_t col, Int_t row, Int_t colsize, Int_t rowsize) const;
+
+protected:
+
+  /**
+   * @brief Restrict a window to the grid
+   * @param[in,out] colmin First column of the window
+   * @param[in,out] rowmin First row of the window
+   * @param[in,out] colmax Column behind the last column of the window
+   * @param[in,out] rowmax Row behind the last row of the window
+   * @return False if no channel of the window is inside the grid
+   */
+  Bool_t ClipWindow(Int_t &colmin, Int_t &rowmin, Int_t &colmax, Int_t &rowmax) const;
+
+  /**
+   * @brief Index in the prefix tables of the corner (col, row)
+   * @param[in] col Column of the corner (0 ... number of columns)
+   * @param[in] row Row of the corner (0 ... number of rows)
+   * @return Index in fSums and fCounts
+   */
+  Int_t CornerIndex(Int_t col, Int_t row) const { return row * (fNCols + 1) + col; }
+
+  Int_t                          fNCols;          //!<! Number of columns of the grid
+  Int_t                          fNRows;          //!<! Number of rows of the grid
+  Bool_t                         fExact;          //!<! Window sums from the table are exact
+  std::vector<Double_t>          fValues;         //!<! Channel values, row by row
+  std::vector<Double_t>          fSums;           //!<! Prefix sums, (fNCols + 1) x (fNRows + 1)
+  std::vector<Int_t>             fCounts;         //!<! Prefix counts of occupied channels, (fNCols + 1) x (fNRows + 1)
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTriggerSummedAreaTable, 1);
+  /// \endcond
+};
+
+#endif
@@ -8,6 +8,9 @@
 #pragma link C++ class AliEmcalTriggerMakerKernel+;
 #pragma link C++ class AliEmcalTriggerMakerTask+;
 #pragma link C++ class AliEmcalTriggerSetupInfo+;
+#pragma link C++ class AliEmcalTriggerSummedAreaPatchFinder+;
+#pragma link C++ class AliEmcalTriggerSummedAreaTable+;
+#pragma link C++ class TestAliEmcalTriggerSummedAreaPatchFinder+;
 #pragma link C++ class AliEmcalTriggerQATask+;
 #pragma link C++ class AliEMCALTriggerOfflineQAPP+;
 #pragma link C++ class AliEMCALTriggerOfflineLightQAPP+;
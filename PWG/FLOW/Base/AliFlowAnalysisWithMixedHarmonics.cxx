@@ -90,6 +90,10 @@ fUseParticleWeights(NULL),
 fPhiWeights(NULL),
 fPtWeights(NULL),
 fEtaWeights(NULL),
+fUseTrackArrays(kFALSE),
+fTrackArraysWeights(),
+fTrackArraysQRe(),
+fTrackArraysQIm(),
 fReQnk(NULL),
 fImQnk(NULL),
 fSpk(NULL),
@@ -231,6 +235,14 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
+ // Q_{m*n,k} and S_{p,k} for RPs from the track arrays, the loop over data is then needed only for POIs:
+ Bool_t bQvectorsFromTrackArrays = fUseTrackArrays;
+ if(bQvectorsFromTrackArrays)
+ {
+  this->FillQvectorsFromTrackArrays(anEvent);
+  if(!fEvaluateDifferential3pCorrelator){nPrim = 0;}
+ }
+
  // Start loop over data:
  for(Int_t i=0;i<nPrim;i++) 
  { 
@@ -239,7 +251,7 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
   {
    if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue; // consider only tracks which are either RPs or POIs
    Int_t n = fHarmonic; 
-   if(aftsTrack->InRPSelection()) // checking RP condition:
+   if(!bQvectorsFromTrackArrays && aftsTrack->InRPSelection()) // checking RP condition:
    {    
     dPhi = aftsTrack->Phi();
     dPt  = aftsTrack->Pt();
@@ -438,6 +450,82 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
 
 //================================================================================================================
 
+void AliFlowAnalysisWithMixedHarmonics::FillQvectorsFromTrackArrays(AliFlowEventSimple *anEvent)
+{
+ // Calculate Re[Q_{m*n,k}], Im[Q_{m*n,k}] (m = 1,2,...,6, k = 0,1,2,3) and partially S_{p,k} for RPs in one pass
+ // over the structure-of-arrays view of the event. With a Q-vector cache on the event
+ // (AliFlowEventSimple::SetUseQvectorCache()) the components are shared with the other flow methods.
+ 
+ AliFlowTrackArrays *arrays = anEvent->GetTrackArrays();
+ Int_t nTracks = arrays->GetNumberOfTracks();
+ const Double_t *dPhi = arrays->GetPhi();
+ const Double_t *dPt = arrays->GetPt();
+ const Double_t *dEta = arrays->GetEta();
+ const UInt_t *mask = arrays->GetPOItypeMask();
+ 
+ // Particle weights, which also define the key in the Q-vector cache:
+ const Double_t *weights = NULL;
+ Bool_t bUsePhiWeights = fUsePhiWeights && fPhiWeights && fnBinsPhi;
+ Bool_t bUsePtWeights = fUsePtWeights && fPtWeights && fnBinsPt;
+ Bool_t bUseEtaWeights = fUseEtaWeights && fEtaWeights && fEtaBinWidth;
+ Int_t weightsFlags = 0;
+ if(bUsePhiWeights){weightsFlags |= AliFlowQvectorCache::kPhiWeights;}
+ if(bUsePtWeights){weightsFlags |= AliFlowQvectorCache::kPtWeights;}
+ if(bUseEtaWeights){weightsFlags |= AliFlowQvectorCache::kEtaWeights;}
+ const TObject *weightsKey = weightsFlags ? this : NULL;
+ 
+ // Q_{h*n,k} for h = 0,1,...,6 (h = 0 gives sum_{i} w_{i}^{k} needed for S_{p,k}):
+ fTrackArraysQRe.assign(7*4,0.);
+ fTrackArraysQIm.assign(7*4,0.);
+ AliFlowQvectorCache *cache = anEvent->GetQvectorCache();
+ if(!cache || !cache->GetQvectors(weightsKey,weightsFlags,6,3,&fTrackArraysQRe[0],&fTrackArraysQIm[0],fHarmonic))
+ {
+  if(weightsFlags)
+  {
+   fTrackArraysWeights.resize(nTracks);
+   for(Int_t t=0;t<nTracks;t++)
+   {
+    Double_t w = 1.;
+    if(mask[t] & AliFlowTrackArrays::RPMask())
+    {
+     if(bUsePhiWeights){w *= fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi[t]*fnBinsPhi/TMath::TwoPi())));}
+     if(bUsePtWeights){w *= fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt[t]-fPtMin)/fPtBinWidth)));}
+     if(bUseEtaWeights){w *= fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta[t]-fEtaMin)/fEtaBinWidth)));}
+    }
+    fTrackArraysWeights[t] = w;
+   }
+   if(nTracks>0){weights = &fTrackArraysWeights[0];}
+  }
+  if(cache)
+  {
+   cache->FillQvectors(arrays,weights,weightsKey,weightsFlags,6,3,fHarmonic);
+   cache->GetQvectors(weightsKey,weightsFlags,6,3,&fTrackArraysQRe[0],&fTrackArraysQIm[0],fHarmonic);
+  } else
+    {
+     arrays->FillQvectors(AliFlowTrackArrays::RPMask(),6,3,weights,&fTrackArraysQRe[0],&fTrackArraysQIm[0],fHarmonic);
+    }
+ }
+ for(Int_t m=0;m<6;m++) 
+ {
+  for(Int_t k=0;k<4;k++) 
+  {
+   (*fReQnk)(m,k)+=fTrackArraysQRe[(m+1)*4+k]; 
+   (*fImQnk)(m,k)+=fTrackArraysQIm[(m+1)*4+k]; 
+  } 
+ }
+ // S_{p,k} (final calculation of S_{p,k} follows after the loop over data in Make()):
+ for(Int_t p=0;p<4;p++)
+ {
+  for(Int_t k=0;k<4;k++)
+  {     
+   (*fSpk)(p,k)+=fTrackArraysQRe[k];
+  }
+ } 
+
+} // end of void AliFlowAnalysisWithMixedHarmonics::FillQvectorsFromTrackArrays(AliFlowEventSimple *anEvent)
+
+//================================================================================================================
+
 void AliFlowAnalysisWithMixedHarmonics::Finish()
 {
  // Calculate the final results.
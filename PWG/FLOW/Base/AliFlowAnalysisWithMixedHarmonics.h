@@ -20,6 +20,7 @@
 #ifndef ALIFLOWANALYSISWITHMIXEDHARMONICS_H
 #define ALIFLOWANALYSISWITHMIXEDHARMONICS_H
 
+#include <vector>
 #include "TMatrixD.h"
 
 class TDirectoryFile;
@@ -64,6 +65,7 @@ class AliFlowAnalysisWithMixedHarmonics
   // 2.) Method Make() and methods called within Make():
   virtual void Make(AliFlowEventSimple *anEvent);
   virtual void CheckPointersUsedInMake();
+  virtual void FillQvectorsFromTrackArrays(AliFlowEventSimple *anEvent);
   virtual void Calculate3pCorrelator();
   virtual void Calculate5pCorrelator();
   virtual void CalculateNonIsotropicTerms();
@@ -142,6 +144,8 @@ class AliFlowAnalysisWithMixedHarmonics
   TH1D* GetPtWeights() const {return this->fPtWeights;};
   void SetEtaWeights(TH1D* const histEtaWeights) {this->fEtaWeights = histEtaWeights;};
   TH1D* GetEtaWeights() const {return this->fEtaWeights;};
+  void SetUseTrackArrays(Bool_t const uTA) {this->fUseTrackArrays = uTA;};
+  Bool_t GetUseTrackArrays() const {return this->fUseTrackArrays;};
   void SetProfileList(TList* const plist) {this->fProfileList = plist;}
   TList* GetProfileList() const {return this->fProfileList;}  
   void Set3pCorrelatorPro(TProfile* const s3pPro) {this->f3pCorrelatorPro = s3pPro;};
@@ -269,6 +273,10 @@ class AliFlowAnalysisWithMixedHarmonics
   TH1F *fPhiWeights; // histogram holding phi weights
   TH1D *fPtWeights; // histogram holding phi weights
   TH1D *fEtaWeights; // histogram holding phi weights 
+  Bool_t fUseTrackArrays; // fill Q_{m*n,k} and S_{p,k} for RPs in one vectorized pass over AliFlowEventSimple::GetTrackArrays()
+  std::vector<Double_t> fTrackArraysWeights; //! [track] product of phi, pt and eta weights for RPs in the track arrays
+  std::vector<Double_t> fTrackArraysQRe; //! [m*4+k] Re[Q_{m*n,k}] from the track arrays
+  std::vector<Double_t> fTrackArraysQIm; //! [m*4+k] Im[Q_{m*n,k}] from the track arrays
   
   // 3.) Event-by-event quantities:
   TMatrixD *fReQnk; // fReQ[n][k] = Re[Q_{n,k}] = sum_{i=1}^{M} w_{i}^{k} cos(n*phi_{i})
@@ -64,6 +64,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fUseTrackArrays(kFALSE),
  // 3.) Correlations:
  fCorrelationsList(NULL),
  fCorrelationsFlagsPro(NULL),
@@ -80,6 +81,8 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fCalculateOnlyForSC(kFALSE),
  fCalculateOnlyCos(kFALSE),
  fCalculateOnlySin(kFALSE),
+ fUseCorrelatorDAG(kFALSE),
+ fCorrelatorDAG(NULL),
  // 4.) Event-by-event cumulants:
  fEbECumulantsList(NULL),
  fEbECumulantsFlagsPro(NULL),
@@ -169,6 +172,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fCorrelatorDAG;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -631,6 +635,10 @@ void AliFlowAnalysisWithMultiparticleCorrelations::InitializeArraysForCorrelatio
    fCorrelationsPro[cs][c] = NULL;
   }
  }
+ for(Int_t c=0;c<8;c++) // [1p,2p,...,8p]
+ {
+  fCorrelatorDAGDenominators[c] = -1;
+ }
 
 } // void AliFlowAnalysisWithMultiparticleCorrelations::InitializeArraysForCorrelations()
 
@@ -739,6 +747,32 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateCorrelations(AliFlow
  Double_t dMultRP = fSelectRandomlyRPs ? fnSelectedRandomlyRPs : anEvent->GetNumberOfRPs(); // TBI shall I promote this variable into data member? 
  if(fSkipSomeIntervals){ dMultRP = dMultRP - fNumberOfSkippedRPParticles; }
  
+ if(fUseCorrelatorDAG && fCorrelatorDAG)
+ {
+  this->EvaluateCorrelatorDAG();
+  for(Int_t cs=0;cs<2;cs++) // cos/sin 
+  {
+   if(fCalculateOnlyCos && 1==cs){continue;}
+   else if(fCalculateOnlySin && 0==cs){continue;}
+   for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
+   {
+    if(dMultRP < co+1){break;} // defines min. number of particles in an event for a certain correlator to make sense
+    if(!fCorrelationsPro[cs][co]){continue;}
+    Int_t nBins = (Int_t)fCorrelatorDAGNodes[co].size();
+    if(0==nBins){continue;}
+    Double_t den = fCorrelatorDAG->Re(fCorrelatorDAGDenominators[co]);
+    Double_t weight = den; // TBI: add support for other options for the weight eventually
+    if(!(den>0.)){Warning(sMethodName.Data(),"if(den>0.)"); continue;}
+    for(Int_t b=1;b<=nBins;b++)
+    {
+     Int_t node = fCorrelatorDAGNodes[co][b-1];
+     Double_t num = (0==cs ? fCorrelatorDAG->Re(node) : fCorrelatorDAG->Im(node));
+     fCorrelationsPro[cs][co]->Fill(b-.5,num/den,weight);
+    } // for(Int_t b=1;b<=nBins;b++)
+   } // for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
+  } // for(Int_t cs=0;cs<=1;cs++) // cos/sin 
+ } else
+   {
  for(Int_t cs=0;cs<2;cs++) // cos/sin 
  {
   if(fCalculateOnlyCos && 1==cs){continue;}
@@ -763,6 +797,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateCorrelations(AliFlow
    } // for(Int_t b=1;b<=nBins;b++)
   } // for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
  } // for(Int_t cs=0;cs<=1;cs++) // cos/sin 
+   } // else
 
  // b) Calculate products needed for QC error propagation:
  if(fCalculateQcumulants && fPropagateErrorQC){this->CalculateProductsOfCorrelations(anEvent,fProductsQCPro);}
@@ -774,6 +809,25 @@ void AliFlowAnalysisWithMultiparticleCorrelations::CalculateCorrelations(AliFlow
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithMultiparticleCorrelations::EvaluateCorrelatorDAG()
+{
+ // Copy Q-vector components into the DAG and evaluate all booked correlations in one sweep.
+
+ Int_t maxHarmonic = TMath::Min(fCorrelatorDAG->GetMaxHarmonic(),fMaxHarmonic*fMaxCorrelator);
+ Int_t maxPower = TMath::Min(fCorrelatorDAG->GetMaxPower(),fMaxCorrelator);
+ for(Int_t h=0;h<=maxHarmonic;h++)
+ {
+  for(Int_t wp=0;wp<=maxPower;wp++)
+  {
+   fCorrelatorDAG->SetQvector(h,wp,fQvector[h][wp].Re(),fQvector[h][wp].Im());
+  }
+ }
+ fCorrelatorDAG->Evaluate();
+
+} // void AliFlowAnalysisWithMultiparticleCorrelations::EvaluateCorrelatorDAG()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithMultiparticleCorrelations::CalculateDiffCorrelations(AliFlowEventSimple *anEvent)
 {
  // Calculate differential multi-particle correlations from Q-, p- and q-vector components.
@@ -953,24 +1007,7 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToCorrelation(c
  if(TString(string).BeginsWith("Sin")){bRealPart = kFALSE;}
 
  Int_t n[8] = {0,0,0,0,0,0,0,0}; // harmonics, supporting up to 8p correlations
- UInt_t whichCorr = 0;   
- for(Int_t t=0;t<=TString(string).Length();t++)
- {
-  if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
-  {
-   n[whichCorr] = string[t-1] - '0';
-   if(TString(string[t-2]).EqualTo("-")){n[whichCorr] = -1*n[whichCorr];}
-   if(!(TString(string[t-2]).EqualTo("-") 
-      || TString(string[t-2]).EqualTo(",")
-      || TString(string[t-2]).EqualTo("("))) // TBI relax this eventually to allow two-digits harmonics
-   { 
-    cout<<Form("And the fatal string is... '%s'. Congratulations!!",string)<<endl; 
-    Fatal(sMethodName.Data(),"!(TString(string[t-2]).EqualTo(...");
-   }
-   whichCorr++;
-   if(whichCorr>=9){Fatal(sMethodName.Data(),"whichCorr>=9");} // not supporting corr. beyond 8p 
-  } // if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
- } // for(UInt_t t=0;t<=TString(string).Length();t++)
+ UInt_t whichCorr = (UInt_t)CastStringToHarmonics(string,n);
 
  switch(whichCorr)
  {
@@ -1033,6 +1070,38 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToCorrelation(c
 
 //=======================================================================================================================
 
+Int_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToHarmonics(const char *string, Int_t *n)
+{
+ // Cast string of the generic form Cos/Sin(-n_1,-n_2,...,n_{k-1},n_k) into harmonics n[0],...,n[k-1] and return k.
+ // Array 'n' must have room for 8 entries.
+
+ TString sMethodName = "AliFlowAnalysisWithMultiparticleCorrelations::CastStringToHarmonics(const char *string, Int_t *n)"; 
+
+ Int_t whichCorr = 0;   
+ for(Int_t t=0;t<=TString(string).Length();t++)
+ {
+  if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
+  {
+   if(whichCorr>=8){Fatal(sMethodName.Data(),"whichCorr>=8");} // not supporting corr. beyond 8p 
+   n[whichCorr] = string[t-1] - '0';
+   if(TString(string[t-2]).EqualTo("-")){n[whichCorr] = -1*n[whichCorr];}
+   if(!(TString(string[t-2]).EqualTo("-") 
+      || TString(string[t-2]).EqualTo(",")
+      || TString(string[t-2]).EqualTo("("))) // TBI relax this eventually to allow two-digits harmonics
+   { 
+    cout<<Form("And the fatal string is... '%s'. Congratulations!!",string)<<endl; 
+    Fatal(sMethodName.Data(),"!(TString(string[t-2]).EqualTo(...");
+   }
+   whichCorr++;
+  } // if(TString(string[t]).EqualTo(",") || TString(string[t]).EqualTo(")")) // TBI this is just ugly
+ } // for(UInt_t t=0;t<=TString(string).Length();t++)
+
+ return whichCorr;
+
+} // Int_t AliFlowAnalysisWithMultiparticleCorrelations::CastStringToHarmonics(const char *string, Int_t *n)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithMultiparticleCorrelations::CalculateProductsOfCorrelations(AliFlowEventSimple *anEvent, TProfile2D *profile2D)
 {
  // Calculate products of multi-particle correlations (needed for error propagation).
@@ -1994,6 +2063,14 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 {
  // Fill Q-vector components.
 
+ // RP Q-vector components in a single vectorized pass over the contiguous track arrays:
+ Bool_t bQvectorFromTrackArrays = fUseTrackArrays && !fSelectRandomlyRPs && !fSkipSomeIntervals;
+ if(bQvectorFromTrackArrays)
+ {
+  this->FillQvectorFromTrackArrays(anEvent);
+  if(!fCalculateDiffQvectors){return;}
+ }
+
  Int_t nTracks = anEvent->NumberOfTracks(); // TBI shall I promote this to data member?
  Double_t dPhi = 0., wPhi = 1.; // azimuthal angle and corresponding phi weight
  Double_t dPt = 0., wPt = 1.; // transverse momentum and corresponding pT weight
@@ -2018,7 +2095,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
   if(!(pTrack->InRPSelection() || pTrack->InPOISelection())){printf("\n AAAARGH: pTrack is neither RP nor POI !!!!"); continue;}
 
-  if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
+  if(pTrack->InRPSelection() && !bQvectorFromTrackArrays) // fill Q-vector components only with reference particles
   {
    nCounterRPs++;
    if(fSelectRandomlyRPs && nCounterRPs == fnSelectedRandomlyRPs){break;} // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
@@ -2108,6 +2185,73 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithMultiparticleCorrelations::FillQvectorFromTrackArrays(AliFlowEventSimple *anEvent)
+{
+ // Fill RP Q-vector components for all harmonics and weight powers in one pass over the
+ // structure-of-arrays view of the event (one sincos per track instead of one per component).
+ // With a Q-vector cache on the event (AliFlowEventSimple::SetUseQvectorCache()) the components
+ // are shared with the other flow methods analysing the same event.
+
+ AliFlowTrackArrays *arrays = anEvent->GetTrackArrays();
+ Int_t nTracks = arrays->GetNumberOfTracks();
+ const Double_t *dPhi = arrays->GetPhi();
+ const Double_t *dPt = arrays->GetPt();
+ const Double_t *dEta = arrays->GetEta();
+ const UInt_t *mask = arrays->GetPOItypeMask();
+
+ // Phi, pt and eta weights, which also define the key in the Q-vector cache shared with other methods:
+ const Double_t *weights = NULL;
+ Int_t weightsFlags = 0;
+ if(fUseWeights[0][0]){weightsFlags |= AliFlowQvectorCache::kPhiWeights;}
+ if(fUseWeights[0][1]){weightsFlags |= AliFlowQvectorCache::kPtWeights;}
+ if(fUseWeights[0][2]){weightsFlags |= AliFlowQvectorCache::kEtaWeights;}
+ const TObject *weightsKey = weightsFlags ? this : NULL;
+
+ // Calculate Q-vector components:
+ Int_t nHarmonics = fMaxHarmonic*fMaxCorrelator+1;
+ Int_t nPowers = fMaxCorrelator+1;
+ fTrackArraysQRe.assign(nHarmonics*nPowers,0.);
+ fTrackArraysQIm.assign(nHarmonics*nPowers,0.);
+ AliFlowQvectorCache *cache = anEvent->GetQvectorCache();
+ if(!cache || !cache->GetQvectors(weightsKey,weightsFlags,nHarmonics-1,nPowers-1,&fTrackArraysQRe[0],&fTrackArraysQIm[0]))
+ {
+  if(weightsFlags)
+  {
+   fTrackArraysWeights.resize(nTracks);
+   for(Int_t t=0;t<nTracks;t++)
+   {
+    Double_t wPhi = 1., wPt = 1., wEta = 1.;
+    if(mask[t] & AliFlowTrackArrays::RPMask())
+    {
+     if(fUseWeights[0][0]){wPhi = Weight(dPhi[t],"RP","phi");} // corresponding phi weight
+     if(fUseWeights[0][1]){wPt = Weight(dPt[t],"RP","pt");} // corresponding pT weight
+     if(fUseWeights[0][2]){wEta = Weight(dEta[t],"RP","eta");} // corresponding eta weight
+    }
+    fTrackArraysWeights[t] = wPhi*wPt*wEta;
+   }
+   if(nTracks>0){weights = &fTrackArraysWeights[0];}
+  }
+  if(cache)
+  {
+   cache->FillQvectors(arrays,weights,weightsKey,weightsFlags,nHarmonics-1,nPowers-1);
+   cache->GetQvectors(weightsKey,weightsFlags,nHarmonics-1,nPowers-1,&fTrackArraysQRe[0],&fTrackArraysQIm[0]);
+  } else
+    {
+     arrays->FillQvectors(AliFlowTrackArrays::RPMask(),nHarmonics-1,nPowers-1,weights,&fTrackArraysQRe[0],&fTrackArraysQIm[0]);
+    }
+ }
+ for(Int_t h=0;h<nHarmonics;h++)
+ {
+  for(Int_t wp=0;wp<nPowers;wp++) // weight power
+  {
+   fQvector[h][wp] += TComplex(fTrackArraysQRe[h*nPowers+wp],fTrackArraysQIm[h*nPowers+wp]);
+  }
+ }
+
+} // void AliFlowAnalysisWithMultiparticleCorrelations::FillQvectorFromTrackArrays(AliFlowEventSimple *anEvent)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithMultiparticleCorrelations::CrossCheckSettings()
 {
  // Cross-check all initial settings in this method. 
@@ -2914,10 +3058,48 @@ void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelations
  } 
  cout<<"    Booked.                                           "<<endl; // TBI 
 
+ // c) Book the DAG of shared Q-vector sub-expressions for all booked correlations:
+ if(fUseCorrelatorDAG){this->BookCorrelatorDAG();}
+
 } // end of void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelations()
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithMultiparticleCorrelations::BookCorrelatorDAG()
+{
+ // Expand all correlations booked in fCorrelationsPro[2][8] into a single DAG, in which each distinct
+ // product of Q-vectors (e.g. the denominator 'number of combinations', shared by all correlations of
+ // the same order) is booked only once. Cos and sin terms are real and imaginary part of the same node.
+
+ TString sMethodName = "void AliFlowAnalysisWithMultiparticleCorrelations::BookCorrelatorDAG()";
+
+ delete fCorrelatorDAG;
+ fCorrelatorDAG = new AliFlowCorrelatorDAG(fMaxHarmonic*fMaxCorrelator,fMaxCorrelator);
+
+ Int_t n[8] = {0,0,0,0,0,0,0,0}; // harmonics, supporting up to 8p correlations
+ Int_t zero[8] = {0,0,0,0,0,0,0,0}; // harmonics of the 'number of combinations'
+ for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
+ {
+  fCorrelatorDAGNodes[co].clear();
+  fCorrelatorDAGDenominators[co] = -1;
+  TProfile *pro = fCorrelationsPro[0][co] ? fCorrelationsPro[0][co] : fCorrelationsPro[1][co]; // same labels for cos and sin
+  if(!pro){continue;}
+  for(Int_t b=1;b<=pro->GetNbinsX();b++)
+  {
+   TString sBinLabel = pro->GetXaxis()->GetBinLabel(b);
+   if(sBinLabel.EqualTo("")){break;} 
+   if(co+1 != CastStringToHarmonics(sBinLabel.Data(),n)){Fatal(sMethodName.Data(),"co+1 != CastStringToHarmonics(...), label = %s",sBinLabel.Data());}
+   fCorrelatorDAGNodes[co].push_back(fCorrelatorDAG->Book(co+1,n));
+  }
+  if(fCorrelatorDAGNodes[co].size()>0){fCorrelatorDAGDenominators[co] = fCorrelatorDAG->Book(co+1,zero);}
+ } // for(Int_t co=0;co<8;co++) // correlator order (TBI hardwired 8) 
+
+ cout<<Form(" => Booked %d shared sub-expressions for all correlations.",fCorrelatorDAG->GetNumberOfNodes())<<endl;
+
+} // void AliFlowAnalysisWithMultiparticleCorrelations::BookCorrelatorDAG()
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForDiffCorrelations()
 {
  // Book all the stuff for differential correlations.
@@ -28,8 +28,10 @@
 #include "TArrayI.h"
 #include "TGraphErrors.h"
 #include "TStopwatch.h"
+#include <vector>
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowCorrelatorDAG.h"
 
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
@@ -65,6 +67,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
    virtual void BookEverythingForQvector();
    virtual void BookEverythingForWeights();
    virtual void BookEverythingForCorrelations();
+   virtual void BookCorrelatorDAG();
    virtual void BookEverythingForEbECumulants();
    virtual void BookEverythingForNestedLoops();
    virtual void BookEverythingForStandardCandles();
@@ -80,7 +83,9 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
    virtual void DetermineRandomIndices(AliFlowEventSimple *anEvent);
    virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
    virtual void FillQvector(AliFlowEventSimple *anEvent);
+   virtual void FillQvectorFromTrackArrays(AliFlowEventSimple *anEvent);
    virtual void CalculateCorrelations(AliFlowEventSimple *anEvent);
+   virtual void EvaluateCorrelatorDAG();
    virtual void CalculateDiffCorrelations(AliFlowEventSimple *anEvent);
    virtual void CalculateEbECumulants(AliFlowEventSimple *anEvent);
    virtual void CalculateSymmetryPlanes(AliFlowEventSimple *anEvent);
@@ -160,6 +165,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t GetCalculateQvector() const {return this->fCalculateQvector;};
   void SetCalculateDiffQvectors(Bool_t cdqv) {this->fCalculateDiffQvectors = cdqv;};
   Bool_t GetCalculateDiffQvectors() const {return this->fCalculateDiffQvectors;};
+  void SetUseTrackArrays(Bool_t uta) {this->fUseTrackArrays = uta;};
+  Bool_t GetUseTrackArrays() const {return this->fUseTrackArrays;};
 
   //  5.3.) Correlations:
   void SetCorrelationsList(TList* const cl) {this->fCorrelationsList = cl;};
@@ -188,6 +195,9 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t GetCalculateOnlyCos() const {return this->fCalculateOnlyCos;};
   void SetCalculateOnlySin(Bool_t cos) {this->fCalculateOnlySin = cos;};
   Bool_t GetCalculateOnlySin() const {return this->fCalculateOnlySin;};
+  void SetUseCorrelatorDAG(Bool_t ucd) {this->fUseCorrelatorDAG = ucd;};
+  Bool_t GetUseCorrelatorDAG() const {return this->fUseCorrelatorDAG;};
+  AliFlowCorrelatorDAG* GetCorrelatorDAG() const {return this->fCorrelatorDAG;};
 
   //  5.4.) Event-by-event cumulants:
   void SetEbECumulantsList(TList* const ebecl) {this->fEbECumulantsList = ebecl;};
@@ -313,6 +323,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   virtual TComplex FourDiff(Int_t n1, Int_t n2, Int_t n3, Int_t n4);
   virtual Double_t Weight(const Double_t &value, const char *type, const char *variable); // value, [RP,POI], [phi,pt,eta]
   virtual Double_t CastStringToCorrelation(const char *string, Bool_t numerator);
+  virtual Int_t CastStringToHarmonics(const char *string, Int_t *n);
   virtual Double_t Covariance(const char *x, const char *y, TProfile2D *profile2D, Bool_t bUnbiasedEstimator = kFALSE);
   virtual TComplex Recursion(Int_t n, Int_t* harmonic, Int_t mult = 1, Int_t skip = 0); // Credits: Kristjan Gulbrandsen (gulbrand@nbi.dk) 
   virtual void CalculateProductsOfCorrelations(AliFlowEventSimple *anEvent, TProfile2D *profile2D);
@@ -385,6 +396,10 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
+  Bool_t fUseTrackArrays;        // fill RP Q-vector components in one vectorized pass over AliFlowEventSimple::GetTrackArrays()
+  std::vector<Double_t> fTrackArraysWeights; //! [track] product of phi, pt and eta weights for RPs in the track arrays
+  std::vector<Double_t> fTrackArraysQRe;     //! [h*(fMaxCorrelator+1)+wp] Re of Q-vector components from the track arrays
+  std::vector<Double_t> fTrackArraysQIm;     //! [h*(fMaxCorrelator+1)+wp] Im of Q-vector components from the track arrays
 
   // 3.) Correlations:
   TList *fCorrelationsList;           // list to hold all correlations objects
@@ -403,6 +418,10 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Bool_t fCalculateOnlyForSC;         // calculate only correlations needed for 'standard candles'
   Bool_t fCalculateOnlyCos;           // calculate only 'cos' correlations
   Bool_t fCalculateOnlySin;           // calculate only 'sin' correlations
+  Bool_t fUseCorrelatorDAG;           // evaluate all booked correlations in one sweep over shared Q-vector sub-expressions
+  AliFlowCorrelatorDAG *fCorrelatorDAG;        //! all booked correlations as a DAG of shared sub-expressions
+  std::vector<Int_t> fCorrelatorDAGNodes[8];   //! [1p,2p,...,8p][bin-1] DAG node of the correlation booked in that bin
+  Int_t fCorrelatorDAGDenominators[8];         //! [1p,2p,...,8p] DAG node of the corresponding 'number of combinations'
 
   // 4.) Event-by-event cumulants:
   TList *fEbECumulantsList;         // list to hold all e-b-e cumulants objects
@@ -476,7 +495,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
@@ -41,6 +41,7 @@
 #include "TPaveLabel.h"
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowQvectorCache.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
@@ -106,6 +107,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fUsePtWeights(kFALSE),
  fUseEtaWeights(kFALSE),
  fUseTrackWeights(kFALSE),
+ fUseTrackArrays(kFALSE),
  fUseParticleWeights(NULL),
  fPhiWeights(NULL),
  fPtWeights(NULL),
@@ -376,7 +378,11 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
+ //    (Q_{n,k} and S_{p,k} for RPs can be obtained instead in one vectorized pass over the contiguous track arrays)
+ Bool_t bQvectorsFromTrackArrays = fUseTrackArrays && !(fExactNoRPs > 0);
+ if(bQvectorsFromTrackArrays){this->FillQvectorsFromTrackArrays(anEvent);}
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
+ if(bQvectorsFromTrackArrays && !(fCalculateDiffFlow || fCalculate2DDiffFlow)){nPrim = 0;} // nothing else to be done in the loop
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
  for(Int_t i=0;i<nPrim;i++) 
@@ -409,6 +415,8 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     {
      wTrack = aftsTrack->Weight(); 
     }
+    if(!bQvectorsFromTrackArrays)
+    {
     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
     for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
     {
@@ -426,6 +434,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
       (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
      }
     } 
+    } // end of if(!bQvectorsFromTrackArrays)
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
@@ -700,6 +709,86 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
 
 //=======================================================================================================================
 
+void AliFlowAnalysisWithQCumulants::FillQvectorsFromTrackArrays(AliFlowEventSimple *anEvent)
+{
+ // Calculate Re[Q_{m*n,k}], Im[Q_{m*n,k}] (m = 1,2,...,12, k = 0,1,...,8) and S_{p,k} for RPs in one pass
+ // over the structure-of-arrays view of the event (one sincos per track instead of one per component).
+ // If the event carries a Q-vector cache (AliFlowEventSimple::SetUseQvectorCache()), the components
+ // are taken from there when another method has already computed them, and stored there otherwise.
+ 
+ AliFlowTrackArrays *arrays = anEvent->GetTrackArrays();
+ Int_t nTracks = arrays->GetNumberOfTracks();
+ const Double_t *dPhi = arrays->GetPhi();
+ const Double_t *dPt = arrays->GetPt();
+ const Double_t *dEta = arrays->GetEta();
+ const Double_t *wTrack = arrays->GetWeight();
+ const UInt_t *mask = arrays->GetPOItypeMask();
+ 
+ // Particle and track weights, which also define the key in the Q-vector cache shared with other methods:
+ const Double_t *weights = NULL;
+ Bool_t bUsePhiWeights = fUsePhiWeights && fPhiWeights && fnBinsPhi;
+ Bool_t bUsePtWeights = fUsePtWeights && fPtWeights && fnBinsPt;
+ Bool_t bUseEtaWeights = fUseEtaWeights && fEtaWeights && fEtaBinWidth;
+ Int_t weightsFlags = 0;
+ if(bUsePhiWeights){weightsFlags |= AliFlowQvectorCache::kPhiWeights;}
+ if(bUsePtWeights){weightsFlags |= AliFlowQvectorCache::kPtWeights;}
+ if(bUseEtaWeights){weightsFlags |= AliFlowQvectorCache::kEtaWeights;}
+ if(fUseTrackWeights){weightsFlags |= AliFlowQvectorCache::kTrackWeights;}
+ const TObject *weightsKey = (bUsePhiWeights || bUsePtWeights || bUseEtaWeights) ? this : NULL;
+ 
+ // Q_{h*n,k} for h = 0,1,...,12 (h = 0 gives sum_{i} w_{i}^{k} needed for S_{p,k}):
+ fTrackArraysQRe.assign(13*9,0.);
+ fTrackArraysQIm.assign(13*9,0.);
+ AliFlowQvectorCache *cache = anEvent->GetQvectorCache();
+ if(!cache || !cache->GetQvectors(weightsKey,weightsFlags,12,8,&fTrackArraysQRe[0],&fTrackArraysQIm[0],fHarmonic))
+ {
+  if(weightsFlags)
+  {
+   fTrackArraysWeights.resize(nTracks);
+   for(Int_t t=0;t<nTracks;t++)
+   {
+    Double_t w = 1.;
+    if(mask[t] & AliFlowTrackArrays::RPMask())
+    {
+     if(bUsePhiWeights){w *= fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi[t]*fnBinsPhi/TMath::TwoPi())));}
+     if(bUsePtWeights){w *= fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt[t]-fPtMin)/fPtBinWidth)));}
+     if(bUseEtaWeights){w *= fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta[t]-fEtaMin)/fEtaBinWidth)));}
+     if(fUseTrackWeights){w *= wTrack[t];}
+    }
+    fTrackArraysWeights[t] = w;
+   }
+   if(nTracks>0){weights = &fTrackArraysWeights[0];}
+  }
+  if(cache)
+  {
+   cache->FillQvectors(arrays,weights,weightsKey,weightsFlags,12,8,fHarmonic);
+   cache->GetQvectors(weightsKey,weightsFlags,12,8,&fTrackArraysQRe[0],&fTrackArraysQIm[0],fHarmonic);
+  } else
+    {
+     arrays->FillQvectors(AliFlowTrackArrays::RPMask(),12,8,weights,&fTrackArraysQRe[0],&fTrackArraysQIm[0],fHarmonic);
+    }
+ }
+ for(Int_t m=0;m<12;m++) 
+ {
+  for(Int_t k=0;k<9;k++) 
+  {
+   (*fReQ)(m,k)+=fTrackArraysQRe[(m+1)*9+k]; 
+   (*fImQ)(m,k)+=fTrackArraysQIm[(m+1)*9+k]; 
+  } 
+ }
+ // S_{p,k} (Remark: final calculation of S_{p,k} follows after the loop over data in Make()):
+ for(Int_t p=0;p<8;p++)
+ {
+  for(Int_t k=0;k<9;k++)
+  {     
+   (*fSpk)(p,k)+=fTrackArraysQRe[k];
+  }
+ } 
+
+} // end of void AliFlowAnalysisWithQCumulants::FillQvectorsFromTrackArrays(AliFlowEventSimple *anEvent)
+
+//=======================================================================================================================
+
 void AliFlowAnalysisWithQCumulants::Finish()
 {
  // Calculate the final results.
@@ -14,6 +14,7 @@
 #ifndef ALIFLOWANALYSISWITHQCUMULANTS_H
 #define ALIFLOWANALYSISWITHQCUMULANTS_H
 
+#include <vector>
 #include "TMatrixD.h"
 #include "TH2D.h"
 #include "TRandom3.h"
@@ -81,6 +82,7 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillAverageMultiplicities(Int_t nRP);
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
+    virtual void FillQvectorsFromTrackArrays(AliFlowEventSimple *anEvent);
     virtual void ResetEventByEventQuantities();
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
@@ -238,6 +240,8 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t GetUseEtaWeights() const {return this->fUseEtaWeights;};
   void SetUseTrackWeights(Bool_t const uTrackW) {this->fUseTrackWeights = uTrackW;};
   Bool_t GetUseTrackWeights() const {return this->fUseTrackWeights;};
+  void SetUseTrackArrays(Bool_t const uTA) {this->fUseTrackArrays = uTA;};
+  Bool_t GetUseTrackArrays() const {return this->fUseTrackArrays;};
   void SetUseParticleWeights(TProfile* const uPW) {this->fUseParticleWeights = uPW;};
   TProfile* GetUseParticleWeights() const {return this->fUseParticleWeights;};
   void SetPhiWeights(TH1F* const histPhiWeights) {this->fPhiWeights = histPhiWeights;};
@@ -594,6 +598,10 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t fUsePtWeights; // use pt weights
   Bool_t fUseEtaWeights; // use eta weights
   Bool_t fUseTrackWeights; // use track weights (e.g. VZERO sector weights)
+  Bool_t fUseTrackArrays; // fill Q_{m*n,k} and S_{p,k} for RPs in one vectorized pass over AliFlowEventSimple::GetTrackArrays()
+  std::vector<Double_t> fTrackArraysWeights; //! [track] product of all particle and track weights for RPs in the track arrays
+  std::vector<Double_t> fTrackArraysQRe; //! [m*9+k] Re[Q_{m*n,k}] from the track arrays
+  std::vector<Double_t> fTrackArraysQIm; //! [m*9+k] Im[Q_{m*n,k}] from the track arrays
   TProfile *fUseParticleWeights; // profile with three bins to hold values of fUsePhiWeights, fUsePtWeights and fUseEtaWeights
   TH1F *fPhiWeights; // histogram holding phi weights
   TH1D *fPtWeights; // histogram holding phi weights
@@ -847,7 +855,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 5);
 
 };
 
@@ -0,0 +1,276 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+ /************************************
+ * generic multi-particle correlators *
+ * evaluated as a shared DAG of       *
+ * Q-vector sub-expressions           *
+ ************************************/
+
+// Generic weighted correlator of the multiset S = {(n_1,p_1),...,(n_k,p_k)} of harmonics and weight powers
+// satisfies (see Bilandzic et al, PRC 89 (2014) 064904, and the recursion by K. Gulbrandsen):
+//
+//   C(S u {(n,p)}) = Q(n,p)*C(S) - sum_{j in S} C(S with (n_j,p_j) -> (n_j+n,p_j+p)) ,  C({}) = 1
+//
+// C(S) is symmetric in its arguments, hence every sub-correlator is identified by its sorted multiset.
+// All correlators booked with Book() are expanded once into a DAG in which each distinct sub-correlator
+// appears exactly once, with children always preceding their parents. The per-event cost is then a single
+// forward sweep over flat arrays, irrespective of how many booked correlators share a given sub-expression.
+
+#define AliFlowCorrelatorDAG_cxx
+
+#include <algorithm>
+#include "TError.h"
+#include "TMath.h"
+#include "AliFlowCorrelatorDAG.h"
+
+ClassImp(AliFlowCorrelatorDAG)
+
+//=======================================================================================================================
+
+AliFlowCorrelatorDAG::AliFlowCorrelatorDAG():
+ fMaxHarmonic(0),
+ fMaxPower(0),
+ fQRe(),
+ fQIm(),
+ fNodes(),
+ fNodeQ(),
+ fNodeChild(),
+ fNodeFirstTerm(1,0),
+ fTermNode(),
+ fTermCoefficient(),
+ fRe(),
+ fIm()
+{
+ // Default constructor.
+
+} // AliFlowCorrelatorDAG::AliFlowCorrelatorDAG()
+
+//=======================================================================================================================
+
+AliFlowCorrelatorDAG::AliFlowCorrelatorDAG(Int_t maxHarmonic, Int_t maxPower):
+ fMaxHarmonic(0),
+ fMaxPower(0),
+ fQRe(),
+ fQIm(),
+ fNodes(),
+ fNodeQ(),
+ fNodeChild(),
+ fNodeFirstTerm(1,0),
+ fTermNode(),
+ fTermCoefficient(),
+ fRe(),
+ fIm()
+{
+ // Constructor. 'maxHarmonic' and 'maxPower' define the range of Q-vectors Q(n,p) which can be set,
+ // i.e. |n| <= maxHarmonic and 0 <= p <= maxPower.
+
+ SetQvectorRange(maxHarmonic,maxPower);
+
+} // AliFlowCorrelatorDAG::AliFlowCorrelatorDAG(Int_t maxHarmonic, Int_t maxPower)
+
+//=======================================================================================================================
+
+AliFlowCorrelatorDAG::~AliFlowCorrelatorDAG()
+{
+ // Destructor.
+
+} // AliFlowCorrelatorDAG::~AliFlowCorrelatorDAG()
+
+//=======================================================================================================================
+
+void AliFlowCorrelatorDAG::SetQvectorRange(Int_t maxHarmonic, Int_t maxPower)
+{
+ // Define the range of Q-vectors. Changing the range invalidates everything booked so far.
+
+ if(maxHarmonic<0 || maxPower<1){Fatal("AliFlowCorrelatorDAG::SetQvectorRange(Int_t maxHarmonic, Int_t maxPower)","maxHarmonic = %d, maxPower = %d",maxHarmonic,maxPower);}
+
+ Clear();
+ fMaxHarmonic = maxHarmonic;
+ fMaxPower = maxPower;
+ fQRe.assign((2*fMaxHarmonic+1)*(fMaxPower+1),0.);
+ fQIm.assign((2*fMaxHarmonic+1)*(fMaxPower+1),0.);
+
+} // void AliFlowCorrelatorDAG::SetQvectorRange(Int_t maxHarmonic, Int_t maxPower)
+
+//=======================================================================================================================
+
+void AliFlowCorrelatorDAG::Clear()
+{
+ // Forget all booked correlators.
+
+ fNodes.clear();
+ fNodeQ.clear();
+ fNodeChild.clear();
+ fNodeFirstTerm.assign(1,0);
+ fTermNode.clear();
+ fTermCoefficient.clear();
+ fRe.clear();
+ fIm.clear();
+
+} // void AliFlowCorrelatorDAG::Clear()
+
+//=======================================================================================================================
+
+Int_t AliFlowCorrelatorDAG::Book(Int_t n, const Int_t *harmonics)
+{
+ // Book generic n-particle correlator <exp[i(n1*phi1+...+nn*phin)]> (unit power for each particle) and
+ // return the index of the node holding it. Booking the same set of harmonics again, in any order,
+ // returns the same node.
+
+ if(n<1 || n>fMaxPower){Fatal("AliFlowCorrelatorDAG::Book(Int_t n, const Int_t *harmonics)","n = %d, fMaxPower = %d",n,fMaxPower);}
+
+ Int_t sum = 0;
+ std::vector<std::pair<Int_t,Int_t> > particles;
+ for(Int_t i=0;i<n;i++)
+ {
+  particles.push_back(std::make_pair(harmonics[i],1));
+  sum += TMath::Abs(harmonics[i]);
+ }
+ if(sum>fMaxHarmonic){Fatal("AliFlowCorrelatorDAG::Book(Int_t n, const Int_t *harmonics)","sum of |harmonics| = %d, fMaxHarmonic = %d",sum,fMaxHarmonic);}
+ std::sort(particles.begin(),particles.end());
+
+ std::vector<Int_t> key;
+ for(Int_t i=0;i<n;i++)
+ {
+  key.push_back(particles[i].first);
+  key.push_back(particles[i].second);
+ }
+
+ return BookNode(key);
+
+} // Int_t AliFlowCorrelatorDAG::Book(Int_t n, const Int_t *harmonics)
+
+//=======================================================================================================================
+
+Int_t AliFlowCorrelatorDAG::BookNode(std::vector<Int_t> &key)
+{
+ // Return the node for the sorted multiset 'key', booking it and all its sub-correlators if needed.
+
+ std::map<std::vector<Int_t>,Int_t>::const_iterator found = fNodes.find(key);
+ if(found != fNodes.end()){return found->second;}
+
+ // Peel off the last particle (n,p): C(S u {(n,p)}) = Q(n,p)*C(S) - sum_j C(S_j):
+ Int_t nParticles = (Int_t)key.size()/2;
+ Int_t nLast = key[2*nParticles-2];
+ Int_t pLast = key[2*nParticles-1];
+ std::vector<Int_t> rest(key.begin(),key.end()-2);
+ Int_t child = -1;
+ if(nParticles>1){child = BookNode(rest);}
+
+ // Book all subtracted sub-correlators first, merging identical ones:
+ std::vector<Int_t> terms;
+ std::vector<Double_t> coefficients;
+ for(Int_t j=0;j<nParticles-1;j++)
+ {
+  std::vector<std::pair<Int_t,Int_t> > merged;
+  for(Int_t i=0;i<nParticles-1;i++)
+  {
+   if(i==j){merged.push_back(std::make_pair(rest[2*i]+nLast,rest[2*i+1]+pLast));}
+   else{merged.push_back(std::make_pair(rest[2*i],rest[2*i+1]));}
+  }
+  std::sort(merged.begin(),merged.end());
+  std::vector<Int_t> mergedKey;
+  for(UInt_t i=0;i<merged.size();i++)
+  {
+   mergedKey.push_back(merged[i].first);
+   mergedKey.push_back(merged[i].second);
+  }
+  Int_t term = BookNode(mergedKey);
+  std::vector<Int_t>::iterator it = std::find(terms.begin(),terms.end(),term);
+  if(it == terms.end())
+  {
+   terms.push_back(term);
+   coefficients.push_back(1.);
+  } else
+    {
+     coefficients[it-terms.begin()] += 1.;
+    }
+ } // for(Int_t j=0;j<nParticles-1;j++)
+
+ // Only now append this node, so that children always precede their parents:
+ Int_t node = (Int_t)fNodeQ.size();
+ fNodeQ.push_back(QIndex(nLast,pLast));
+ fNodeChild.push_back(child);
+ for(UInt_t t=0;t<terms.size();t++)
+ {
+  fTermNode.push_back(terms[t]);
+  fTermCoefficient.push_back(coefficients[t]);
+ }
+ fNodeFirstTerm.push_back((Int_t)fTermNode.size());
+ fRe.push_back(0.);
+ fIm.push_back(0.);
+ fNodes[key] = node;
+
+ return node;
+
+} // Int_t AliFlowCorrelatorDAG::BookNode(std::vector<Int_t> &key)
+
+//=======================================================================================================================
+
+void AliFlowCorrelatorDAG::SetQvector(Int_t n, Int_t p, Double_t re, Double_t im)
+{
+ // Set Q-vector component Q(n,p), and by using Q{-n,p} = Q{n,p}^* also Q(-n,p).
+
+ fQRe[QIndex(n,p)] = re;
+ fQIm[QIndex(n,p)] = im;
+ fQRe[QIndex(-n,p)] = re;
+ fQIm[QIndex(-n,p)] = -im;
+
+} // void AliFlowCorrelatorDAG::SetQvector(Int_t n, Int_t p, Double_t re, Double_t im)
+
+//=======================================================================================================================
+
+void AliFlowCorrelatorDAG::ResetQvector()
+{
+ // Reset all Q-vector components.
+
+ std::fill(fQRe.begin(),fQRe.end(),0.);
+ std::fill(fQIm.begin(),fQIm.end(),0.);
+
+} // void AliFlowCorrelatorDAG::ResetQvector()
+
+//=======================================================================================================================
+
+void AliFlowCorrelatorDAG::Evaluate()
+{
+ // Evaluate all booked correlators for the current Q-vectors in a single forward sweep.
+
+ const Int_t nNodes = (Int_t)fNodeQ.size();
+ const Double_t *qRe = fQRe.empty() ? 0 : &fQRe[0];
+ const Double_t *qIm = fQIm.empty() ? 0 : &fQIm[0];
+ for(Int_t node=0;node<nNodes;node++)
+ {
+  const Int_t q = fNodeQ[node];
+  const Int_t child = fNodeChild[node];
+  Double_t re = qRe[q];
+  Double_t im = qIm[q];
+  if(child>=0)
+  {
+   const Double_t cRe = fRe[child];
+   const Double_t cIm = fIm[child];
+   re = qRe[q]*cRe - qIm[q]*cIm;
+   im = qRe[q]*cIm + qIm[q]*cRe;
+  }
+  for(Int_t t=fNodeFirstTerm[node];t<fNodeFirstTerm[node+1];t++)
+  {
+   re -= fTermCoefficient[t]*fRe[fTermNode[t]];
+   im -= fTermCoefficient[t]*fIm[fTermNode[t]];
+  }
+  fRe[node] = re;
+  fIm[node] = im;
+ } // for(Int_t node=0;node<nNodes;node++)
+
+} // void AliFlowCorrelatorDAG::Evaluate()
@@ -0,0 +1,70 @@
+/*
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.
+ * See cxx source for full Copyright notice
+ * $Id$
+ */
+
+ /************************************
+ * generic multi-particle correlators *
+ * evaluated as a shared DAG of       *
+ * Q-vector sub-expressions           *
+ ************************************/
+
+#ifndef ALIFLOWCORRELATORDAG_H
+#define ALIFLOWCORRELATORDAG_H
+
+#include <map>
+#include <vector>
+#include "Rtypes.h"
+
+class AliFlowCorrelatorDAG{
+ public:
+  AliFlowCorrelatorDAG();
+  AliFlowCorrelatorDAG(Int_t maxHarmonic, Int_t maxPower);
+  virtual ~AliFlowCorrelatorDAG();
+
+  // Booking (done once, typically in Init()):
+  void SetQvectorRange(Int_t maxHarmonic, Int_t maxPower);
+  virtual void Clear();
+  Int_t Book(Int_t n, const Int_t *harmonics); // returns the node holding the generic n-p correlator <exp[i(n1*phi1+...+nn*phin)]>
+
+  // Per-event evaluation:
+  void SetQvector(Int_t n, Int_t p, Double_t re, Double_t im); // n >= 0, Q{-n,p} = Q{n,p}^* is set automatically
+  void ResetQvector();
+  void Evaluate();
+  Double_t Re(Int_t node) const {return fRe[node];};
+  Double_t Im(Int_t node) const {return fIm[node];};
+
+  // Getters:
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;};
+  Int_t GetMaxPower() const {return fMaxPower;};
+  Int_t GetNumberOfNodes() const {return (Int_t)fNodeQ.size();};
+  Int_t GetNumberOfTerms() const {return (Int_t)fTermNode.size();};
+
+ private:
+  AliFlowCorrelatorDAG(const AliFlowCorrelatorDAG& dag);
+  AliFlowCorrelatorDAG& operator=(const AliFlowCorrelatorDAG& dag);
+
+  Int_t QIndex(Int_t n, Int_t p) const {return (n+fMaxHarmonic)*(fMaxPower+1)+p;};
+  Int_t BookNode(std::vector<Int_t> &key); // key = sorted (harmonic,power) pairs, flattened
+
+  Int_t fMaxHarmonic;                         // largest |harmonic| of a single Q-vector entering the DAG
+  Int_t fMaxPower;                            // largest weight power of a single Q-vector entering the DAG
+  std::vector<Double_t> fQRe;                 // Q-vector components, real part [(n+fMaxHarmonic)*(fMaxPower+1)+p]
+  std::vector<Double_t> fQIm;                 // Q-vector components, imaginary part [(n+fMaxHarmonic)*(fMaxPower+1)+p]
+  std::map<std::vector<Int_t>,Int_t> fNodes;  // canonical (harmonic,power) multiset => node index
+  std::vector<Int_t> fNodeQ;                  // [node] index of the Q-vector multiplying the sub-correlator
+  std::vector<Int_t> fNodeChild;              // [node] sub-correlator without the last particle (-1 = empty set, i.e. 1)
+  std::vector<Int_t> fNodeFirstTerm;          // [node] first subtracted term, terms of node are [fNodeFirstTerm[node],fNodeFirstTerm[node+1])
+  std::vector<Int_t> fTermNode;               // [term] node which is subtracted
+  std::vector<Double_t> fTermCoefficient;     // [term] how many times it is subtracted
+  std::vector<Double_t> fRe;                  // [node] evaluated value, real part
+  std::vector<Double_t> fIm;                  // [node] evaluated value, imaginary part
+
+  ClassDef(AliFlowCorrelatorDAG,1);
+
+};
+
+//================================================================================================================
+
+#endif
@@ -75,6 +75,8 @@ AliFlowEventSimple::AliFlowEventSimple():
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(NULL),
+  fTrackArrays(NULL),
+  fQvectorCache(NULL),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -134,6 +136,8 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(new TObjArray()),
+  fTrackArrays(NULL),
+  fQvectorCache(NULL),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -195,6 +199,8 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fShuffledIndexes(NULL),
   fShuffleTracks(anEvent.fShuffleTracks),
   fMothersCollection(new TObjArray()),
+  fTrackArrays(NULL),
+  fQvectorCache(NULL),
   fCentrality(anEvent.fCentrality),
   fCentralityCL1(anEvent.fCentralityCL1),
   fNITSCL1(anEvent.fNITSCL1),
@@ -306,6 +312,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  InvalidateTrackArrays();
   return *this;
 }
 
@@ -321,6 +328,8 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fMCReactionPlaneAngleWrap;
   delete fShuffledIndexes;
   delete fMothersCollection;
+  delete fTrackArrays;
+  delete fQvectorCache;
   delete [] fNumberOfPOIs;
 }
 
@@ -411,6 +420,7 @@ void AliFlowEventSimple::Generate(Int_t nParticles,
     fMCReactionPlaneAngleIsSet=kTRUE;
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //-----------------------------------------------------------------------
@@ -472,6 +482,66 @@ void AliFlowEventSimple::TrackAdded()
     delete [] fShuffledIndexes;
     fShuffledIndexes=NULL;
   }
+  InvalidateTrackArrays();
+}
+
+//-----------------------------------------------------------------------
+AliFlowTrackArrays* AliFlowEventSimple::GetTrackArrays()
+{
+  //return the structure-of-arrays view of the tracks, (re)built if the event changed since;
+  //code which modifies tracks directly via GetTrack() has to call InvalidateTrackArrays()
+  if (!fTrackArrays) fTrackArrays = new AliFlowTrackArrays();
+  if (!fTrackArrays->IsValid()) fTrackArrays->Fill(this);
+  return fTrackArrays;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::SetUseQvectorCache(Bool_t b)
+{
+  //share Q-vectors between the flow methods analysing this event: GetQ() and Get2Qsub() without
+  //weight histograms and the track-arrays paths of the Q-cumulant, mixed harmonics and
+  //multiparticle correlations methods look up (and fill) the cache instead of looping over tracks;
+  //the cache is cleared together with the track arrays whenever the event changes
+  if (b && !fQvectorCache) fQvectorCache = new AliFlowQvectorCache();
+  if (!b)
+  {
+    delete fQvectorCache;
+    fQvectorCache = NULL;
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::FillQvectorCache(Int_t maxHarmonic)
+{
+  //precompute the RP Q-vectors Q_n (n = 0..maxHarmonic, track weights applied) of the full event and of
+  //both subevents in one pass each, i.e. everything GetQ() and Get2Qsub() without weight histograms return
+  if (!fQvectorCache || maxHarmonic<1) return;
+  AliFlowTrackArrays* arrays = GetTrackArrays();
+  for (Int_t s=-1; s<2; s++)
+  {
+    fQvectorCache->FillQvectors(arrays,arrays->GetWeight(),NULL,AliFlowQvectorCache::kTrackWeights,maxHarmonic,1,1,s);
+  }
+}
+
+//-----------------------------------------------------------------------
+Bool_t AliFlowEventSimple::GetCachedQ(Int_t n, Int_t subevent, AliFlowVector& vQ)
+{
+  //RP Q-vector in harmonic n with track weights only, from the Q-vector cache (computed and stored on a miss)
+  if (!fQvectorCache || n<1) return kFALSE;
+  Double_t qRe[4] = {0.,0.,0.,0.}; //[h*2+p], h = 0,1 (in units of n), p = 0,1
+  Double_t qIm[4] = {0.,0.,0.,0.};
+  if (!fQvectorCache->GetQvectors(NULL,AliFlowQvectorCache::kTrackWeights,1,1,qRe,qIm,n,subevent))
+  {
+    AliFlowTrackArrays* arrays = GetTrackArrays();
+    fQvectorCache->FillQvectors(arrays,arrays->GetWeight(),NULL,AliFlowQvectorCache::kTrackWeights,1,1,n,subevent);
+    fQvectorCache->GetQvectors(NULL,AliFlowQvectorCache::kTrackWeights,1,1,qRe,qIm,n,subevent);
+  }
+  vQ.Set(qRe[3],qIm[3]);
+  vQ.SetMult(qRe[1]);
+  vQ.SetHarmonic(n);
+  vQ.SetPOItype(AliFlowTrackSimple::kRP);
+  vQ.SetSubeventNumber(subevent);
+  return kTRUE;
 }
 
 //-----------------------------------------------------------------------
@@ -498,6 +568,12 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
   AliFlowVector vQ;
   vQ.Set(0.,0.);
 
+  // without weight histograms the Q-vector can be shared with the other flow methods:
+  if(fQvectorCache && !(weightsList && (usePhiWeights || usePtWeights || useEtaWeights)))
+  {
+    if(GetCachedQ(n,-1,vQ)) return vQ;
+  }
+
   Int_t iOrder = n;
   Double_t sumOfWeights = 0.;
   Double_t dPhi = 0.;
@@ -615,6 +691,12 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
   Double_t dQX = 0.;
   Double_t dQY = 0.;
 
+  // without weight histograms the Q-vectors can be shared with the other flow methods:
+  if(fQvectorCache && !(weightsList && (usePhiWeights || usePtWeights || useEtaWeights)))
+  {
+    if(GetCachedQ(n,0,Qarray[0]) && GetCachedQ(n,1,Qarray[1])) return;
+  }
+
   Int_t iOrder = n;
   Double_t sumOfWeights = 0.;
   Double_t dPhi = 0.;
@@ -881,6 +963,8 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fShuffledIndexes(NULL),
   fShuffleTracks(kFALSE),
   fMothersCollection(new TObjArray()),
+  fTrackArrays(NULL),
+  fQvectorCache(NULL),
   fCentrality(-1.),
   fCentralityCL1(-1.),
   fNITSCL1(-1.),
@@ -968,6 +1052,7 @@ void AliFlowEventSimple::CloneTracks(Int_t n)
     }
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -980,6 +1065,7 @@ void AliFlowEventSimple::ResolutionPt(Double_t res)
     if (track) track->ResolutionPt(res);
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -998,6 +1084,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
     if (eta >= etaMinA && eta <= etaMaxA) track->SetForSubevent(0);
     if (eta >= etaMinB && eta <= etaMaxB) track->SetForSubevent(1);
   }
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1013,6 +1100,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
     if (charge<0) track->SetForSubevent(0);
     if (charge>0) track->SetForSubevent(1);
   }
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1030,6 +1118,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
     }
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1047,6 +1136,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
     }
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1064,6 +1154,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
     }
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1081,6 +1172,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
     }
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1098,6 +1190,7 @@ void AliFlowEventSimple::AddV5( Double_t v5 )
     }
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1111,6 +1204,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
     if (track) track->AddFlow(v1,v2,v3,v4,v5,rp1,rp2,rp3,rp4,rp5,fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1123,6 +1217,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
     if (track) track->AddFlow(v1,v2,v3,v4,v5,fMCReactionPlaneAngle, fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1137,6 +1232,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
     track->AddV2(v2, fMCReactionPlaneAngle, fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1151,6 +1247,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
     track->AddV2(v2, fMCReactionPlaneAngle, fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1173,6 +1270,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1195,6 +1293,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1227,6 +1326,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  InvalidateTrackArrays();
 }
 
 //_____________________________________________________________________________
@@ -1244,6 +1344,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateTrackArrays();
   return ncleaned;
 }
 
@@ -1283,4 +1384,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateTrackArrays();
 }
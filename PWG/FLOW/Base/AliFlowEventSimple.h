@@ -20,6 +20,8 @@
 #include "TParameter.h"
 #include "TMath.h"
 #include "AliFlowVector.h"
+#include "AliFlowTrackArrays.h"
+#include "AliFlowQvectorCache.h"
 class TTree;
 class TF1;
 class TF2;
@@ -116,6 +118,12 @@ class AliFlowEventSimple: public TObject {
   void AddTrack( AliFlowTrackSimple* track );
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
+  AliFlowTrackArrays* GetTrackArrays();
+  void InvalidateTrackArrays()                      { if (fTrackArrays) fTrackArrays->Invalidate();
+                                                      if (fQvectorCache) fQvectorCache->Clear(); }
+  void SetUseQvectorCache(Bool_t b=kTRUE);
+  AliFlowQvectorCache* GetQvectorCache() const      { return fQvectorCache; }
+  void FillQvectorCache(Int_t maxHarmonic);
 
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
@@ -160,6 +168,7 @@ class AliFlowEventSimple: public TObject {
                          Double_t phiMax=TMath::TwoPi(),
                          Double_t etaMin=-1.0,
                          Double_t etaMax= 1.0 );
+  Bool_t GetCachedQ(Int_t n, Int_t subevent, AliFlowVector& vQ);
 
   //data members
   TObjArray*              fTrackCollection;           //-> collection of tracks
@@ -186,6 +195,8 @@ class AliFlowEventSimple: public TObject {
   Int_t*                  fShuffledIndexes;           //! placeholder for randomized indexes
   Bool_t                  fShuffleTracks;             // do we shuffle tracks on get?
   TObjArray*              fMothersCollection;         //!cache the particles with daughters
+  AliFlowTrackArrays*     fTrackArrays;               //!contiguous copy of the track kinematics, built on demand
+  AliFlowQvectorCache*    fQvectorCache;              //!Q-vectors shared by all flow methods, NULL if not used
   Double_t                fCentrality;                // centrality
   Double_t                fCentralityCL1;             // centrality (CL1)
   Double_t                fNITSCL1;                   // number of clusters in ITS layer 1
@@ -0,0 +1,297 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*****************************************************************
+  AliFlowQvectorCache: per-event store of RP Q-vector tables,
+  so that several flow methods running on the same
+  AliFlowEventSimple compute each Q-vector only once.
+
+  A table holds Q_{h*step,p} for h = 0..maxHarmonic and
+  p = 0..maxPower in the layout of AliFlowTrackArrays::FillQvectors
+  and is identified by the weights which went into it (weights
+  object and EWeights flags), the subevent and the harmonic step.
+  A request is served by any table of the same weights and
+  subevent which contains all requested components, e.g. Q_{2h}
+  from a table filled with step 1.
+  The weights object stands for the set of weight histograms
+  (typically the analysis object owning them, NULL if none) and
+  is compared by address only.
+*****************************************************************/
+
+#include "AliFlowTrackArrays.h"
+#include "AliFlowQvectorCache.h"
+
+ClassImp(AliFlowQvectorCache)
+
+//-----------------------------------------------------------------------
+AliFlowQvectorCache::AliFlowQvectorCache():
+  fTableWeights(),
+  fTableFlags(),
+  fTableSubevent(),
+  fTableStep(),
+  fTableMaxHarmonic(),
+  fTableMaxPower(),
+  fTableOffset(),
+  fQRe(),
+  fQIm()
+{
+  //constructor
+}
+
+//-----------------------------------------------------------------------
+AliFlowQvectorCache::~AliFlowQvectorCache()
+{
+  //destructor
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQvectorCache::Clear()
+{
+  //forget all tables (the event changed); storage is kept for the next event
+  fTableWeights.clear();
+  fTableFlags.clear();
+  fTableSubevent.clear();
+  fTableStep.clear();
+  fTableMaxHarmonic.clear();
+  fTableMaxPower.clear();
+  fTableOffset.clear();
+  fQRe.clear();
+  fQIm.clear();
+}
+
+//-----------------------------------------------------------------------
+Bool_t AliFlowQvectorCache::GetQvectors(const TObject* weights, Int_t weightsFlags,
+                                        Int_t maxHarmonic, Int_t maxPower, Double_t* qRe, Double_t* qIm,
+                                        Int_t harmonicStep, Int_t subevent) const
+{
+  //add to qRe/qIm[h*(maxPower+1)+p] the cached components Q_{h*harmonicStep,p},
+  //h = 0..maxHarmonic, p = 0..maxPower (same layout as AliFlowTrackArrays::FillQvectors);
+  //returns kFALSE and leaves qRe/qIm untouched if no table contains all of them
+  if (harmonicStep<=0) return kFALSE;
+  for (UInt_t t=0; t<fTableOffset.size(); t++)
+  {
+    if (fTableWeights[t]!=(ULong_t)weights || fTableFlags[t]!=weightsFlags) continue;
+    if (fTableSubevent[t]!=subevent) continue;
+    if (harmonicStep%fTableStep[t]) continue;
+    Int_t stride = harmonicStep/fTableStep[t];
+    if (maxHarmonic*stride>fTableMaxHarmonic[t] || maxPower>fTableMaxPower[t]) continue;
+
+    Int_t nPowers = maxPower+1;
+    Int_t nTablePowers = fTableMaxPower[t]+1;
+    const Double_t* re = &fQRe[fTableOffset[t]];
+    const Double_t* im = &fQIm[fTableOffset[t]];
+    for (Int_t h=0; h<=maxHarmonic; h++)
+    {
+      for (Int_t p=0; p<nPowers; p++)
+      {
+        qRe[h*nPowers+p] += re[h*stride*nTablePowers+p];
+        qIm[h*nPowers+p] += im[h*stride*nTablePowers+p];
+      }
+    }
+    return kTRUE;
+  }
+  return kFALSE;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQvectorCache::FillQvectors(const AliFlowTrackArrays* arrays, const Double_t* trackWeights,
+                                       const TObject* weights, Int_t weightsFlags,
+                                       Int_t maxHarmonic, Int_t maxPower,
+                                       Int_t harmonicStep, Int_t subevent)
+{
+  //compute a new table of RP Q-vectors from the track arrays and store it under the given key;
+  //trackWeights (NULL = unit weights) have to correspond to weights and weightsFlags
+  if (harmonicStep<=0) return;
+  Int_t offset = (Int_t)fQRe.size();
+  Int_t nComponents = (maxHarmonic+1)*(maxPower+1);
+  fQRe.resize(offset+nComponents,0.);
+  fQIm.resize(offset+nComponents,0.);
+  arrays->FillQvectors(AliFlowTrackArrays::RPMask(),maxHarmonic,maxPower,trackWeights,
+                       &fQRe[offset],&fQIm[offset],harmonicStep,subevent);
+  fTableWeights.push_back((ULong_t)weights);
+  fTableFlags.push_back(weightsFlags);
+  fTableSubevent.push_back(subevent);
+  fTableStep.push_back(harmonicStep);
+  fTableMaxHarmonic.push_back(maxHarmonic);
+  fTableMaxPower.push_back(maxPower);
+  fTableOffset.push_back(offset);
+}
+
+//=======================================================================
+// TestAliFlowQvectorCache
+//=======================================================================
+
+#include <iostream>
+#include "TMath.h"
+#include "TF1.h"
+#include "TRandom.h"
+#include "AliFlowVector.h"
+#include "AliFlowTrackSimple.h"
+#include "AliFlowEventSimple.h"
+
+ClassImp(TestAliFlowQvectorCache)
+
+namespace {
+  //direct RP Q-vector of harmonic n (track weights, subevent -1 = all RPs), without any cache
+  void DirectQ(AliFlowEventSimple* event, Int_t n, Int_t subevent, Double_t& qx, Double_t& qy, Double_t& mult)
+  {
+    qx = qy = mult = 0.;
+    for (Int_t i=0; i<event->NumberOfTracks(); i++)
+    {
+      AliFlowTrackSimple* track = event->GetTrack(i);
+      if (!track || !track->InRPSelection()) continue;
+      if (subevent>=0 && !track->InSubevent(subevent)) continue;
+      qx += track->Weight()*TMath::Cos(n*track->Phi());
+      qy += track->Weight()*TMath::Sin(n*track->Phi());
+      mult += track->Weight();
+    }
+  }
+
+  Bool_t SameQ(const AliFlowVector& q, Double_t qx, Double_t qy, Double_t mult)
+  {
+    const Double_t kTolerance = 1e-9;
+    Double_t scale = TMath::Max(1.,mult);
+    return TMath::Abs(q.X()-qx)<kTolerance*scale && TMath::Abs(q.Y()-qy)<kTolerance*scale
+        && TMath::Abs(q.GetMult()-mult)<kTolerance*scale;
+  }
+}
+
+//-----------------------------------------------------------------------
+Bool_t TestAliFlowQvectorCache::RunAllTests() const
+{
+  //run all tests (all of them, also if one fails)
+  Bool_t afterburners = TestAfterburners();
+  Bool_t addTracks = TestAddTracks();
+  Bool_t subevents = TestSubevents();
+  return afterburners && addTracks && subevents;
+}
+
+//-----------------------------------------------------------------------
+AliFlowEventSimple* TestAliFlowQvectorCache::MakeEvent() const
+{
+  //toy event with 500 RPs, subevents in eta and the Q-vector cache switched on
+  gRandom->SetSeed(4711);
+  AliFlowEventSimple* event = new AliFlowEventSimple(500,AliFlowEventSimple::kGenerate);
+  for (Int_t i=0; i<event->NumberOfTracks(); i++) event->GetTrack(i)->SetForRPSelection(kTRUE);
+  event->TagSubeventsInEta(-1.,0.,0.,1.);
+  event->SetUseQvectorCache(kTRUE);
+  return event;
+}
+
+//-----------------------------------------------------------------------
+Bool_t TestAliFlowQvectorCache::CompareQ(AliFlowEventSimple* event, const char* step) const
+{
+  //GetQ() (served from the cache) has to agree with the Q-vector computed from the tracks
+  Bool_t result = kTRUE;
+  for (Int_t n=1; n<=4; n++)
+  {
+    AliFlowVector q = event->GetQ(n);
+    Double_t qx, qy, mult;
+    DirectQ(event,n,-1,qx,qy,mult);
+    if (!SameQ(q,qx,qy,mult))
+    {
+      std::cout << "TestAliFlowQvectorCache: stale Q_" << n << " after " << step
+                << ": (" << q.X() << "," << q.Y() << ") instead of (" << qx << "," << qy << ")" << std::endl;
+      result = kFALSE;
+    }
+  }
+  return result;
+}
+
+//-----------------------------------------------------------------------
+Bool_t TestAliFlowQvectorCache::Compare2Qsub(AliFlowEventSimple* event, const char* step) const
+{
+  //Get2Qsub() (served from the cache) has to agree with the subevent Q-vectors computed from the tracks
+  Bool_t result = kTRUE;
+  for (Int_t n=1; n<=4; n++)
+  {
+    AliFlowVector qsub[2];
+    event->Get2Qsub(qsub,n);
+    for (Int_t s=0; s<2; s++)
+    {
+      Double_t qx, qy, mult;
+      DirectQ(event,n,s,qx,qy,mult);
+      if (!SameQ(qsub[s],qx,qy,mult))
+      {
+        std::cout << "TestAliFlowQvectorCache: stale subevent " << s << " Q_" << n << " after " << step << std::endl;
+        result = kFALSE;
+      }
+    }
+  }
+  return result;
+}
+
+//-----------------------------------------------------------------------
+Bool_t TestAliFlowQvectorCache::TestAfterburners() const
+{
+  //toy-MC flow and resolution afterburners applied after the cache was filled
+  AliFlowEventSimple* event = MakeEvent();
+  Bool_t result = CompareQ(event,"filling");
+  event->AddV2(0.1);
+  result = CompareQ(event,"AddV2(Double_t)") && result;
+  event->AddV1(0.05);
+  event->AddV3(0.05);
+  event->AddV4(0.02);
+  event->AddV5(0.01);
+  result = CompareQ(event,"AddV1/3/4/5") && result;
+  event->AddFlow(0.01,0.05,0.03,0.02,0.01);
+  result = CompareQ(event,"AddFlow") && result;
+  event->AddFlow(0.01,0.05,0.03,0.02,0.01,0.1,0.2,0.3,0.4,0.5);
+  result = CompareQ(event,"AddFlow(rp)") && result;
+  event->AddV2(AliFlowEventSimple::SimplePtDepV2());
+  result = CompareQ(event,"AddV2(TF1*)") && result;
+  event->AddV2(AliFlowEventSimple::SimplePtEtaDepV2());
+  result = CompareQ(event,"AddV2(TF2*)") && result;
+  event->ResolutionPt(0.1);
+  event->AddV2(AliFlowEventSimple::SimplePtDepV2());
+  result = CompareQ(event,"ResolutionPt") && result;
+  delete event;
+  return result;
+}
+
+//-----------------------------------------------------------------------
+Bool_t TestAliFlowQvectorCache::TestAddTracks() const
+{
+  //tracks added or cloned after the cache was filled
+  AliFlowEventSimple* event = MakeEvent();
+  Bool_t result = CompareQ(event,"filling");
+  event->CloneTracks(1);
+  result = CompareQ(event,"CloneTracks") && result;
+  AliFlowTrackSimple* track = new AliFlowTrackSimple();
+  track->SetPhi(1.);
+  track->SetEta(0.5);
+  track->SetPt(1.);
+  track->SetForRPSelection(kTRUE);
+  event->AddTrack(track);
+  result = CompareQ(event,"AddTrack") && result;
+  event->ClearFast();
+  result = CompareQ(event,"ClearFast") && result;
+  delete event;
+  return result;
+}
+
+//-----------------------------------------------------------------------
+Bool_t TestAliFlowQvectorCache::TestSubevents() const
+{
+  //subevents retagged after the cache was filled
+  AliFlowEventSimple* event = MakeEvent();
+  Bool_t result = Compare2Qsub(event,"filling");
+  event->AddV2(0.1);
+  result = Compare2Qsub(event,"AddV2(Double_t)") && result;
+  event->TagSubeventsByCharge();
+  result = Compare2Qsub(event,"TagSubeventsByCharge") && result;
+  delete event;
+  return result;
+}
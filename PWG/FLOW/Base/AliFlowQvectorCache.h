@@ -0,0 +1,92 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+/*****************************************************************
+  AliFlowQvectorCache: per-event store of RP Q-vector tables,
+  so that several flow methods running on the same
+  AliFlowEventSimple compute each Q-vector only once
+*****************************************************************/
+
+#ifndef ALIFLOWQVECTORCACHE_H
+#define ALIFLOWQVECTORCACHE_H
+
+#include <vector>
+#include "Rtypes.h"
+
+class TObject;
+class AliFlowTrackArrays;
+
+class AliFlowQvectorCache {
+
+ public:
+
+  enum EWeights { kPhiWeights   = BIT(0),  // phi weights from the weights object
+                  kPtWeights    = BIT(1),  // pt weights from the weights object
+                  kEtaWeights   = BIT(2),  // eta weights from the weights object
+                  kTrackWeights = BIT(3)   // AliFlowTrackSimple::Weight()
+  };
+
+  AliFlowQvectorCache();
+  virtual ~AliFlowQvectorCache();
+
+  void     Clear();
+  Int_t    GetNumberOfTables() const                  { return (Int_t)fTableOffset.size(); }
+
+  Bool_t GetQvectors(const TObject* weights, Int_t weightsFlags,
+                     Int_t maxHarmonic, Int_t maxPower, Double_t* qRe, Double_t* qIm,
+                     Int_t harmonicStep=1, Int_t subevent=-1) const;
+  void   FillQvectors(const AliFlowTrackArrays* arrays, const Double_t* trackWeights,
+                      const TObject* weights, Int_t weightsFlags,
+                      Int_t maxHarmonic, Int_t maxPower,
+                      Int_t harmonicStep=1, Int_t subevent=-1);
+
+ private:
+
+  AliFlowQvectorCache(const AliFlowQvectorCache& cache);
+  AliFlowQvectorCache& operator=(const AliFlowQvectorCache& cache);
+
+  std::vector<ULong_t>    fTableWeights;      // [table] address of the weights object (0 = no weight histograms)
+  std::vector<Int_t>      fTableFlags;        // [table] which weights went into the table (EWeights)
+  std::vector<Int_t>      fTableSubevent;     // [table] subevent (-1 = all RPs)
+  std::vector<Int_t>      fTableStep;         // [table] harmonic step
+  std::vector<Int_t>      fTableMaxHarmonic;  // [table] largest harmonic, in units of the step
+  std::vector<Int_t>      fTableMaxPower;     // [table] largest weight power
+  std::vector<Int_t>      fTableOffset;       // [table] first component in fQRe/fQIm
+  std::vector<Double_t>   fQRe;               // Q-vector components of all tables, real part
+  std::vector<Double_t>   fQIm;               // Q-vector components of all tables, imaginary part
+
+  ClassDef(AliFlowQvectorCache,1)
+};
+
+/*****************************************************************
+  TestAliFlowQvectorCache: unit test checking that Q-vectors
+  served from the cache of an AliFlowEventSimple follow changes
+  of its tracks (toy-MC afterburners, cloned or added tracks,
+  retagged subevents), see test/TestAliFlowQvectorCache.C
+*****************************************************************/
+
+class AliFlowEventSimple;
+
+class TestAliFlowQvectorCache {
+
+ public:
+
+  TestAliFlowQvectorCache() {}
+  virtual ~TestAliFlowQvectorCache() {}
+
+  Bool_t RunAllTests() const;
+  Bool_t TestAfterburners() const;
+  Bool_t TestAddTracks() const;
+  Bool_t TestSubevents() const;
+
+ private:
+
+  AliFlowEventSimple* MakeEvent() const;
+  Bool_t CompareQ(AliFlowEventSimple* event, const char* step) const;
+  Bool_t Compare2Qsub(AliFlowEventSimple* event, const char* step) const;
+
+  ClassDef(TestAliFlowQvectorCache,0)
+};
+
+#endif
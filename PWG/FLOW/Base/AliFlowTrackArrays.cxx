@@ -0,0 +1,166 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*****************************************************************
+  AliFlowTrackArrays: structure-of-arrays view of the tracks of
+  an AliFlowEventSimple (phi, pt, eta, weight and selection bits
+  in contiguous arrays) and a single-pass kernel which fills
+  Q-vectors for all harmonics and weight powers at once
+*****************************************************************/
+
+#include "TMath.h"
+#include "TBits.h"
+#include "AliFlowTrackSimple.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowTrackArrays.h"
+
+ClassImp(AliFlowTrackArrays)
+
+//-----------------------------------------------------------------------
+AliFlowTrackArrays::AliFlowTrackArrays():
+  fValid(kFALSE),
+  fNumberOfTracks(0),
+  fPhi(),
+  fPt(),
+  fEta(),
+  fWeight(),
+  fPOItypeMask(),
+  fSubeventMask()
+{
+  //constructor
+}
+
+//-----------------------------------------------------------------------
+AliFlowTrackArrays::~AliFlowTrackArrays()
+{
+  //destructor
+}
+
+//-----------------------------------------------------------------------
+void AliFlowTrackArrays::Fill(AliFlowEventSimple* event)
+{
+  //copy the kinematics and selection bits of all tracks of the event into contiguous arrays;
+  //storage is reused from event to event
+  fNumberOfTracks = 0;
+  Int_t nTracks = event->NumberOfTracks();
+  if ((Int_t)fPhi.size() < nTracks)
+  {
+    fPhi.resize(nTracks);
+    fPt.resize(nTracks);
+    fEta.resize(nTracks);
+    fWeight.resize(nTracks);
+    fPOItypeMask.resize(nTracks);
+    fSubeventMask.resize(nTracks);
+  }
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    AliFlowTrackSimple* track = event->GetTrack(i);
+    if (!track) continue;
+    UInt_t poiTypeMask = 0;
+    const TBits* bits = track->GetPOItype();
+    UInt_t nBits = TMath::Min(bits->GetNbits(),(UInt_t)32);
+    for (UInt_t b=0; b<nBits; b++)
+    {
+      if (bits->TestBitNumber(b)) poiTypeMask |= (1u<<b);
+    }
+    if (!poiTypeMask) continue; //dead track
+    UInt_t subeventMask = 0;
+    if (track->InSubevent(0)) subeventMask |= (1u<<0);
+    if (track->InSubevent(1)) subeventMask |= (1u<<1);
+    fPhi[fNumberOfTracks] = track->Phi();
+    fPt[fNumberOfTracks] = track->Pt();
+    fEta[fNumberOfTracks] = track->Eta();
+    fWeight[fNumberOfTracks] = track->Weight();
+    fPOItypeMask[fNumberOfTracks] = poiTypeMask;
+    fSubeventMask[fNumberOfTracks] = subeventMask;
+    fNumberOfTracks++;
+  }
+  fValid = kTRUE;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowTrackArrays::FillQvectors(UInt_t poiTypeMask, Int_t maxHarmonic, Int_t maxPower,
+                                      const Double_t* trackWeights, Double_t* qRe, Double_t* qIm,
+                                      Int_t harmonicStep, Int_t subevent) const
+{
+  //add to qRe/qIm[h*(maxPower+1)+p] the components of
+  //  Q_{h*harmonicStep,p} = sum_i w_i^p exp(i*h*harmonicStep*phi_i),  h = 0..maxHarmonic, p = 0..maxPower
+  //for all tracks matching any bit of poiTypeMask (and in the given subevent, if subevent >= 0).
+  //trackWeights is indexed like the arrays (NULL means unit weights).
+  //Tracks are processed in fixed-size blocks: cos/sin of the higher harmonics are obtained by
+  //rotation, cos((h+1)x) = cos(hx)cos(x)-sin(hx)sin(x), and the weight powers by repeated
+  //multiplication, so each track costs one sincos and the inner loops over the block lanes are
+  //plain multiply-adds which the compiler vectorizes.
+  const Int_t kBlock = 16;
+  const Int_t nPowers = maxPower+1;
+  Double_t cos1[kBlock], sin1[kBlock], cosH[kBlock], sinH[kBlock];
+  std::vector<Double_t> powers(trackWeights ? nPowers*kBlock : kBlock);
+  Double_t* wPow = &powers[0]; //[p*kBlock+lane]
+  Int_t lane = 0;
+  for (Int_t i=0; i<=fNumberOfTracks; i++)
+  {
+    if (i<fNumberOfTracks)
+    {
+      if (!(fPOItypeMask[i] & poiTypeMask)) continue;
+      if (subevent>=0 && !(fSubeventMask[i] & (1u<<subevent))) continue;
+      Double_t x = harmonicStep*fPhi[i];
+      cos1[lane] = TMath::Cos(x);
+      sin1[lane] = TMath::Sin(x);
+      if (trackWeights)
+      {
+        Double_t w = trackWeights[i];
+        wPow[lane] = 1.;
+        for (Int_t p=1; p<nPowers; p++) wPow[p*kBlock+lane] = wPow[(p-1)*kBlock+lane]*w;
+      }
+      else
+      {
+        wPow[lane] = 1.;
+      }
+      lane++;
+      if (lane<kBlock) continue;
+    }
+    if (!lane) break;
+
+    //process the block
+    for (Int_t l=0; l<lane; l++) { cosH[l] = 1.; sinH[l] = 0.; }
+    for (Int_t h=0; h<=maxHarmonic; h++)
+    {
+      if (trackWeights)
+      {
+        for (Int_t p=0; p<nPowers; p++)
+        {
+          const Double_t* w = wPow+p*kBlock;
+          Double_t re = 0., im = 0.;
+          for (Int_t l=0; l<lane; l++) { re += w[l]*cosH[l]; im += w[l]*sinH[l]; }
+          qRe[h*nPowers+p] += re;
+          qIm[h*nPowers+p] += im;
+        }
+      }
+      else
+      {
+        Double_t re = 0., im = 0.;
+        for (Int_t l=0; l<lane; l++) { re += cosH[l]; im += sinH[l]; }
+        for (Int_t p=0; p<nPowers; p++) { qRe[h*nPowers+p] += re; qIm[h*nPowers+p] += im; }
+      }
+      for (Int_t l=0; l<lane; l++)
+      {
+        Double_t c = cosH[l]*cos1[l]-sinH[l]*sin1[l];
+        sinH[l] = sinH[l]*cos1[l]+cosH[l]*sin1[l];
+        cosH[l] = c;
+      }
+    }
+    lane = 0;
+  }
+}
@@ -0,0 +1,63 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+/*****************************************************************
+  AliFlowTrackArrays: structure-of-arrays view of the tracks of
+  an AliFlowEventSimple (phi, pt, eta, weight and selection bits
+  in contiguous arrays) and a single-pass kernel which fills
+  Q-vectors for all harmonics and weight powers at once
+*****************************************************************/
+
+#ifndef ALIFLOWTRACKARRAYS_H
+#define ALIFLOWTRACKARRAYS_H
+
+#include <vector>
+#include "Rtypes.h"
+
+class AliFlowEventSimple;
+
+class AliFlowTrackArrays {
+
+ public:
+
+  AliFlowTrackArrays();
+  virtual ~AliFlowTrackArrays();
+
+  void     Fill(AliFlowEventSimple* event);
+  void     Invalidate()                               { fValid = kFALSE; }
+  Bool_t   IsValid() const                            { return fValid; }
+
+  Int_t    GetNumberOfTracks() const                  { return fNumberOfTracks; }
+  const Double_t* GetPhi() const                      { return fNumberOfTracks ? &fPhi[0] : 0; }
+  const Double_t* GetPt() const                       { return fNumberOfTracks ? &fPt[0] : 0; }
+  const Double_t* GetEta() const                      { return fNumberOfTracks ? &fEta[0] : 0; }
+  const Double_t* GetWeight() const                   { return fNumberOfTracks ? &fWeight[0] : 0; }
+  const UInt_t*   GetPOItypeMask() const              { return fNumberOfTracks ? &fPOItypeMask[0] : 0; }
+  const UInt_t*   GetSubeventMask() const             { return fNumberOfTracks ? &fSubeventMask[0] : 0; }
+
+  static UInt_t RPMask()                              { return 1u<<0; }
+  static UInt_t POIMask(Int_t poiType=1)              { return 1u<<poiType; }
+
+  void FillQvectors(UInt_t poiTypeMask, Int_t maxHarmonic, Int_t maxPower,
+                    const Double_t* trackWeights, Double_t* qRe, Double_t* qIm,
+                    Int_t harmonicStep=1, Int_t subevent=-1) const;
+
+ private:
+
+  AliFlowTrackArrays(const AliFlowTrackArrays& arrays);
+  AliFlowTrackArrays& operator=(const AliFlowTrackArrays& arrays);
+
+  Bool_t                  fValid;            // arrays reflect the current content of the event
+  Int_t                   fNumberOfTracks;   // number of tracks
+  std::vector<Double_t>   fPhi;              // [track] azimuthal angle
+  std::vector<Double_t>   fPt;               // [track] transverse momentum
+  std::vector<Double_t>   fEta;              // [track] pseudorapidity
+  std::vector<Double_t>   fWeight;           // [track] track weight
+  std::vector<UInt_t>     fPOItypeMask;      // [track] bit i set if track is of POI type i (bit 0 = RP)
+  std::vector<UInt_t>     fSubeventMask;     // [track] bit i set if track is in subevent i
+
+  ClassDef(AliFlowTrackArrays,1)
+};
+
+#endif
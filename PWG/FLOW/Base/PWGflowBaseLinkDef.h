@@ -9,6 +9,9 @@
 
 #pragma link C++ class AliFlowVector+;
 #pragma link C++ class AliFlowTrackSimple+;
+#pragma link C++ class AliFlowTrackArrays+;
+#pragma link C++ class AliFlowQvectorCache+;
+#pragma link C++ class TestAliFlowQvectorCache+;
 #pragma link C++ class AliFlowEventSimple+;
 
 #pragma link C++ class AliStarTrack+;
@@ -43,6 +46,7 @@
 #pragma link C++ class AliFlowAnalysisWithMixedHarmonics+;
 #pragma link C++ class AliFlowAnalysisWithNestedLoops+;
 #pragma link C++ class AliFlowOnTheFlyEventGenerator+;
+#pragma link C++ class AliFlowCorrelatorDAG+;
 #pragma link C++ class AliFlowAnalysisWithMultiparticleCorrelations+;
 
 #endif
@@ -138,6 +138,7 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent() :
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
+  fQvectorCacheMaxHarmonic(0),
   fMyTRandom3(NULL)
 {
   // Constructor
@@ -200,6 +201,7 @@ AliAnalysisTaskFlowEvent::AliAnalysisTaskFlowEvent(const char *name, TString RPt
   fDifferentialV2(0),
   fFlowEvent(NULL),
   fShuffleTracks(kFALSE),
+  fQvectorCacheMaxHarmonic(0),
   fMyTRandom3(NULL)
 {
   // Constructor
@@ -584,6 +586,13 @@ void AliAnalysisTaskFlowEvent::UserExec(Option_t *)
   // associate the mother particles to their daughters in the flow event (if any)
   fFlowEvent->FindDaughters();
 
+  // compute the RP Q-vectors once for all flow methods attached to this event
+  if (fQvectorCacheMaxHarmonic>0)
+  {
+    fFlowEvent->SetUseQvectorCache(kTRUE);
+    fFlowEvent->FillQvectorCache(fQvectorCacheMaxHarmonic);
+  }
+
   //fListHistos->Print();
   //fOutputFile->WriteObject(fFlowEvent,"myFlowEventSimple");
   PostData(1,fFlowEvent);
@@ -71,6 +71,7 @@ fUseParticleWeights(useParticleWeights),
 fUsePhiWeights(kFALSE),
 fUsePtWeights(kFALSE),
 fUseEtaWeights(kFALSE),
+fUseTrackArrays(kFALSE),
 fRejectPileUp(kFALSE),
 fRejectPileUpTight(kFALSE),
 fWeightsList(NULL)
@@ -112,6 +113,7 @@ fUseParticleWeights(kFALSE),
 fUsePhiWeights(kFALSE),
 fUsePtWeights(kFALSE),
 fUseEtaWeights(kFALSE),
+fUseTrackArrays(kFALSE),
 fRejectPileUp(kFALSE),
 fRejectPileUpTight(kFALSE),
 fWeightsList(NULL)
@@ -147,6 +149,7 @@ void AliAnalysisTaskMixedHarmonics::UserCreateOutputObjects()
  fMH->SetPrintOnTheScreen(fPrintOnTheScreen); 
  fMH->SetCalculateVsM(fCalculateVsM); 
  fMH->SetShowBinLabelsVsM(fShowBinLabelsVsM);
+ fMH->SetUseTrackArrays(fUseTrackArrays);
  if(fUseParticleWeights)
  {
   // Pass the flags to class:
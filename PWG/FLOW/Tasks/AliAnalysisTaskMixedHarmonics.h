@@ -70,6 +70,8 @@ class AliAnalysisTaskMixedHarmonics : public AliAnalysisTaskSE{
   Bool_t GetUsePtWeights() const {return this->fUsePtWeights;};
   void SetUseEtaWeights(Bool_t const uEtaW) {this->fUseEtaWeights = uEtaW;};
   Bool_t GetUseEtaWeights() const {return this->fUseEtaWeights;};
+  void SetUseTrackArrays(Bool_t const uTA) {this->fUseTrackArrays = uTA;};
+  Bool_t GetUseTrackArrays() const {return this->fUseTrackArrays;};
  
   void  SetRejectPileUp(Bool_t  pileup) {this->fRejectPileUp = pileup;}
   void  SetRejectPileUpTight(Bool_t pileupT) {this->fRejectPileUpTight = pileupT;}
@@ -106,6 +108,7 @@ class AliAnalysisTaskMixedHarmonics : public AliAnalysisTaskSE{
   Bool_t fUsePhiWeights; // use phi weights
   Bool_t fUsePtWeights; // use pt weights
   Bool_t fUseEtaWeights; // use eta weights  
+  Bool_t fUseTrackArrays; // fill RP Q-vectors from the track arrays (and the Q-vector cache) of the flow event
 
   Bool_t   fRejectPileUp; //
   Bool_t   fRejectPileUpTight; //
@@ -116,7 +119,7 @@ class AliAnalysisTaskMixedHarmonics : public AliAnalysisTaskSE{
 
 
 
-  ClassDef(AliAnalysisTaskMixedHarmonics, 1); 
+  ClassDef(AliAnalysisTaskMixedHarmonics, 2); 
 };
 
 //================================================================================================================
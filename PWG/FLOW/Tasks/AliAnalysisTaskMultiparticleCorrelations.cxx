@@ -54,6 +54,7 @@ AliAnalysisTaskMultiparticleCorrelations::AliAnalysisTaskMultiparticleCorrelatio
  fFillMultCorrelationsHist(kFALSE),
  fSkipSomeIntervals(kFALSE),
  fCalculateQvector(kFALSE),
+ fUseTrackArrays(kFALSE),
  fCalculateDiffQvectors(kFALSE),
  fProduction(""),
  fCalculateCorrelations(kFALSE),
@@ -186,6 +187,7 @@ AliAnalysisTaskMultiparticleCorrelations::AliAnalysisTaskMultiparticleCorrelatio
  fFillMultCorrelationsHist(kFALSE),
  fSkipSomeIntervals(kFALSE),
  fCalculateQvector(kFALSE),
+ fUseTrackArrays(kFALSE),
  fCalculateDiffQvectors(kFALSE),
  fProduction(""),
  fCalculateCorrelations(kFALSE),
@@ -311,6 +313,7 @@ void AliAnalysisTaskMultiparticleCorrelations::UserCreateOutputObjects()
  fMPC->SetFillMultDistributionsHist(fFillMultDistributionsHist);
  fMPC->SetFillMultCorrelationsHist(fFillMultCorrelationsHist);
  fMPC->SetCalculateQvector(fCalculateQvector);
+ fMPC->SetUseTrackArrays(fUseTrackArrays);
  fMPC->SetCalculateDiffQvectors(fCalculateDiffQvectors);
  fMPC->SetCalculateCorrelations(fCalculateCorrelations);
  fMPC->SetCalculateIsotropic(fCalculateIsotropic);
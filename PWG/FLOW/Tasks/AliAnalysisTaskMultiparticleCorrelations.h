@@ -70,6 +70,8 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   // Q-vectors:
   void SetCalculateQvector(Bool_t cqv) {this->fCalculateQvector = cqv;};
   Bool_t GetCalculateQvector() const {return this->fCalculateQvector;};
+  void SetUseTrackArrays(Bool_t uta) {this->fUseTrackArrays = uta;};
+  Bool_t GetUseTrackArrays() const {return this->fUseTrackArrays;};
   void SetCalculateDiffQvectors(Bool_t cdqv) {this->fCalculateDiffQvectors = cdqv;};
   Bool_t GetCalculateDiffQvectors() const {return this->fCalculateDiffQvectors;};
 
@@ -197,6 +199,7 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
 
   // Q-vectors:
   Bool_t fCalculateQvector;      // to calculate or not to calculate Q-vector components, that's a Boolean...
+  Bool_t fUseTrackArrays;        // fill RP Q-vector components from the track arrays (and the Q-vector cache) of the flow event
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...
 
   // Weights:
@@ -249,7 +252,7 @@ class AliAnalysisTaskMultiparticleCorrelations : public AliAnalysisTaskSE{
   // Eta gaps:
   Bool_t fCalculateEtaGaps; // calculate correlations with eta gaps
 
-  ClassDef(AliAnalysisTaskMultiparticleCorrelations,6);
+  ClassDef(AliAnalysisTaskMultiparticleCorrelations,7);
 
 };
 
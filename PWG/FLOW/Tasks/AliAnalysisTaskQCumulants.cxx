@@ -78,6 +78,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
  fUsePtWeights(kFALSE),
  fUseEtaWeights(kFALSE),
  fUseTrackWeights(kFALSE),
+ fUseTrackArrays(kFALSE),
  fWeightsList(NULL),
  fMultiplicityWeight(NULL),
  fMultiplicityIs(AliFlowCommonConstants::kRP),
@@ -176,6 +177,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants():
  fUsePtWeights(kFALSE),
  fUseEtaWeights(kFALSE),
  fUseTrackWeights(kFALSE),
+ fUseTrackArrays(kFALSE),
  fWeightsList(NULL),
  fMultiplicityWeight(NULL),
  fMultiplicityIs(AliFlowCommonConstants::kRP),
@@ -256,6 +258,7 @@ void AliAnalysisTaskQCumulants::UserCreateOutputObjects()
  fQC->SetnBinsMult(fnBinsMult);
  fQC->SetMinMult(fMinMult);
  fQC->SetMaxMult(fMaxMult);
+ fQC->SetUseTrackArrays(fUseTrackArrays);
  // Particle weights:
  if(fUseParticleWeights)
  {
@@ -104,6 +104,8 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t GetUseEtaWeights() const {return this->fUseEtaWeights;};
   void SetUseTrackWeights(Bool_t const uTrackW) {this->fUseTrackWeights = uTrackW;};
   Bool_t GetUseTrackWeights() const {return this->fUseTrackWeights;};
+  void SetUseTrackArrays(Bool_t const uTA) {this->fUseTrackArrays = uTA;};
+  Bool_t GetUseTrackArrays() const {return this->fUseTrackArrays;};
   // Event weights:
   void SetMultiplicityWeight(const char *multiplicityWeight) {*this->fMultiplicityWeight = multiplicityWeight;};
   void SetMultiplicityIs(AliFlowCommonConstants::ERefMultSource mi) {this->fMultiplicityIs = mi;};
@@ -175,6 +177,7 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fUsePtWeights;               // use pt weights
   Bool_t fUseEtaWeights;              // use eta weights  
   Bool_t fUseTrackWeights;            // use track weights (e.g. VZERO sector weights)  
+  Bool_t fUseTrackArrays;             // fill RP Q-vectors from the track arrays (and the Q-vector cache) of the flow event
   TList *fWeightsList;                // list with weights
   // Event weights:
   TString *fMultiplicityWeight;       // event-by-event weights for multiparticle correlations ("combinations","unit" or "multiplicity")  
@@ -192,7 +195,7 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fUseBootstrapVsM; // use bootstrap to estimate statistical spread for results vs M
   Int_t fnSubsamples; // number of subsamples (SS), by default 10
   
-  ClassDef(AliAnalysisTaskQCumulants, 2); 
+  ClassDef(AliAnalysisTaskQCumulants, 3); 
 };
 
 //================================================================================================================
@@ -852,6 +852,7 @@ void AliFlowEvent::FindDaughters(Bool_t keepDaughtersInRPselection)
       }
     }
   }
+  InvalidateTrackArrays();
 }
 
 //-----------------------------------------------------------------------
@@ -1011,6 +1012,7 @@ void AliFlowEvent::Fill( AliFlowTrackCuts* rpCuts,
       if (pTrack->GetNDaughters()>0) fMothersCollection->Add(pTrack);
     }
   }
+  InvalidateTrackArrays();
 }
 
 //-----------------------------------------------------------------------
@@ -1022,6 +1024,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
   {
     fMothersCollection->Add(pTrack);
   }
+  InvalidateTrackArrays();
   return;
 }
 
@@ -1039,6 +1042,7 @@ AliFlowTrack* AliFlowEvent::ReuseTrack(Int_t i)
     pTrack = new AliFlowTrack();
     fTrackCollection->AddAtAndExpand(pTrack,i);
   }
+  InvalidateTrackArrays();
   return pTrack;
 }
 
@@ -22,10 +22,14 @@
 //  update:      You Zhou, Nikhef, yzhou@nikhef.nl
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <Riostream.h>
 #include <TMath.h>
 #include <TEllipse.h>
 #include <TRandom.h>
+#include <TRandom3.h>
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TNtuple.h>
@@ -172,7 +176,20 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fNThreads(0),
+  fSeed(0),
+  fRandom(0),
+  fSigFlucX(),
+  fSigFlucCdf(),
+  fXA(),
+  fYA(),
+  fD2A(),
+  fNCollA(),
+  fXB(),
+  fYB(),
+  fD2B(),
+  fNCollB()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +339,20 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fNThreads(in.fNThreads),
+  fSeed(in.fSeed),
+  fRandom(0),
+  fSigFlucX(),
+  fSigFlucCdf(),
+  fXA(),
+  fYA(),
+  fD2A(),
+  fNCollA(),
+  fXB(),
+  fYB(),
+  fD2B(),
+  fNCollB()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,21 +483,45 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fNThreads=in.fNThreads;
+  fSeed=in.fSeed;
   return *this;
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::InitSigFluc()
+{
+  // create the parameterization for fluctuating sigNN
+  if (fSigFluc) return;
+  fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+  fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+  cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::GetRandomSigNN()
+{
+  // fluctuating sigNN: from fSigFluc with gRandom, or from the
+  // tabulated fSigFluc if a random generator was set
+  if (!fRandom) return fSigFluc->GetRandom();
+  if (fSigFlucCdf.empty()) AliGlauberNucleus::Tabulate(fSigFluc,fSigFlucX,fSigFlucCdf);
+  return AliGlauberNucleus::GetRandomTabulated(fSigFlucX,fSigFlucCdf,fRandom->Rndm());
+}
+
+//______________________________________________________________________________
+TRandom *AliGlauberMC::GetRandom() const
+{
+  // random generator used for this instance
+  return fRandom ? fRandom : gRandom;
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc)
+    InitSigFluc();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
@@ -480,7 +534,7 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(GetRandomSigNN());
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
@@ -493,52 +547,95 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(GetRandomSigNN());
   }
 
   if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
+    InitSigFluc();
+    fXSect = GetRandomSigNN();
   }
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
 
+  // copy the transverse positions into contiguous arrays, so that
+  // the collision loop below runs over plain arrays without getters;
+  // with fluctuating sigNN the distance of a pair is the one of
+  // the nucleon with the larger cross section
+  fXA.resize(fAN);
+  fYA.resize(fAN);
+  fD2A.resize(fAN);
+  fNCollA.assign(fAN,0);
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    fXA[j]  = nucleonA->GetX();
+    fYA[j]  = nucleonA->GetY();
+    fD2A[j] = fDoFluc ? nucleonA->GetSigNN()/(TMath::Pi()*10) : d2;
+  }
+  fXB.resize(fBN);
+  fYB.resize(fBN);
+  fD2B.resize(fBN);
+  fNCollB.assign(fBN,0);
+  for (Int_t i = 0; i<fBN; i++)
+  {
+    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+    fXB[i]  = nucleonB->GetX();
+    fYB[i]  = nucleonB->GetY();
+    fD2B[i] = fDoFluc ? nucleonB->GetSigNN()/(TMath::Pi()*10) : d2;
+  }
+
   Double_t bNN   = 0;
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
+  const Double_t *xA  = fAN ? &fXA[0]     : 0;
+  const Double_t *yA  = fAN ? &fYA[0]     : 0;
+  const Double_t *d2A = fAN ? &fD2A[0]    : 0;
+  Int_t          *nA  = fAN ? &fNCollA[0] : 0;
+
   // for each of the A nucleons in nucleus B
   for (Int_t i = 0; i<fBN; i++)
   {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+    const Double_t xB  = fXB[i];
+    const Double_t yB  = fYB[i];
+    const Double_t d2B = fD2B[i];
+    Int_t nB  = 0;
+    Int_t nHC = 0;
+    // branch-free, the sum of distances keeps the order of the pairs
     for (Int_t j = 0 ; j < fAN ; j++)
     {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
+      Double_t dx  = xB-xA[j];
+      Double_t dy  = yB-yA[j];
       Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
-      }
-      if (dij < d2)
-      {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
-      }
+      Double_t d2ij = d2A[j] > d2B ? d2A[j] : d2B;
+      Int_t coll  = dij < d2ij;
+      nA[j] += coll;
+      nB    += coll;
+      nHC   += coll & (dij < d2ij/4);
+      bNN   += coll ? dij : 0.;
     }
+    fNCollB[i] = nB;
+    Nco   += nB;
+    Ncohc += nHC;
+  }
+
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    if (fNCollA[j])
+      ((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j)))->SetNColl(fNCollA[j]);
+  }
+  for (Int_t i = 0; i<fBN; i++)
+  {
+    if (fNCollB[i])
+      ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->SetNColl(fNCollB[i]);
   }
 
+  // with fluctuating sigNN the cross section of the last pair is kept, as
+  // in the pair by pair loop
+  if (fDoFluc && fAN>0 && fBN>0)
+    fXSect = TMath::Max(((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(fAN-1)))->GetSigNN(),
+                        ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(fBN-1)))->GetSigNN());
+
   if (Nco>0) {
     fNcollw = Ncohc;
     fBNN = bNN/Nco;
@@ -1267,7 +1364,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1375,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=GetRandom()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1405,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1603,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*GetRandom()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1682,17 +1779,95 @@ Double_t AliGlauberMC::GetPsi4m2() const
 }
 */
 //______________________________________________________________________________
-void AliGlauberMC::Run(Int_t nevents)
+void AliGlauberMC::CreateNtuple()
 {
-  //example run
-  cout << "Generating " << nevents << " events..." << endl;
+  //create the ntuple for results
+  if (fnt) return;
   TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
   TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
-  if (fnt == 0)
+  fnt = new TNtuple(name,title,
+                    "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
+  fnt->SetDirectory(0);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::GetNtupleValues(Float_t *v) const
+{
+  //fill the 48 ntuple values of the current event
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
+  {
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
+  }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::Run(Int_t nevents)
+{
+  //example run; with a thread count or a seed set (SetNThreads, SetSeed)
+  //the events are generated by RunThreads, otherwise on this thread with gRandom
+  cout << "Generating " << nevents << " events..." << endl;
+  CreateNtuple();
+  if (fNThreads>0 || fSeed>0)
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
-    fnt->SetDirectory(0);
+    RunThreads(nevents);
+    return;
   }
   Int_t q = 0;
   Int_t u = 0;
@@ -1707,67 +1882,7 @@ void AliGlauberMC::Run(Int_t nevents)
 
     q++;
     Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
-    {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
-    }
-    else
-    {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
-    }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
+    GetNtupleValues(v);
 
     //always at the end
     fnt->Fill(v);
@@ -1777,6 +1892,173 @@ void AliGlauberMC::Run(Int_t nevents)
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
 
+//______________________________________________________________________________
+AliGlauberMC *AliGlauberMC::MakeWorker() const
+{
+  //new generator with the settings of this one, for one thread of RunThreads;
+  //the functions used for sampling are created and tabulated here, so that
+  //the worker does not touch ROOT objects while it runs
+  AliGlauberMC *w = new AliGlauberMC(fANucleus.GetName(),fBNucleus.GetName(),fXSect);
+  w->fANucleus.SetMinDist(fANucleus.GetMinDist());
+  w->fBNucleus.SetMinDist(fBNucleus.GetMinDist());
+  w->fANucleus.SetR(fANucleus.GetR());
+  w->fBNucleus.SetR(fBNucleus.GetR());
+  w->fANucleus.SetA(fANucleus.GetA());
+  w->fBNucleus.SetA(fBNucleus.GetA());
+  w->fANucleus.SetW(fANucleus.GetW());
+  w->fBNucleus.SetW(fBNucleus.GetW());
+  w->fANucleus.TabulateFunction();
+  w->fBNucleus.TabulateFunction();
+  w->fBMin=fBMin;
+  w->fBMax=fBMax;
+  memcpy(w->fdNdEtaParam,fdNdEtaParam,sizeof(fdNdEtaParam));
+  w->fMultType=fMultType;
+  w->fX=fX;
+  w->fNpp=fNpp;
+  w->fDoPartProd=fDoPartProd;
+  w->fDoFluc=fDoFluc;
+  w->fOmega=fOmega;
+  w->fSig0=fSig0;
+  w->fLambda=fLambda;
+  if (fDoFluc)
+  {
+    w->InitSigFluc();
+    AliGlauberNucleus::Tabulate(w->fSigFluc,w->fSigFlucX,w->fSigFlucCdf);
+  }
+  return w;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunThreads(Int_t nevents)
+{
+  //run on fNThreads threads: the events are generated in blocks with
+  //their own random stream, seeded from fSeed (from gRandom if 0), and
+  //filled into the ntuple in block order, so that the output only depends
+  //on the seed and not on the number of threads; with fNThreads<2 the
+  //blocks are generated on the calling thread, with the same random streams.
+  //Finished blocks are kept in a ring of 2*nthreads buffers until all
+  //earlier blocks are filled, so memory does not grow with nevents
+  const Int_t kBlock = 1000;
+  Int_t nblocks = (nevents+kBlock-1)/kBlock;
+  Int_t nthreads = TMath::Min(TMath::Max(fNThreads,1),nblocks);
+  Int_t nslots = 2*nthreads;
+
+  std::vector<UInt_t> seeds(nblocks);
+  TRandom3 seeder(fSeed>0 ? fSeed : gRandom->Integer(kMaxUInt-1)+1);
+  for (Int_t b = 0; b<nblocks; b++)
+    seeds[b] = seeder.Integer(kMaxUInt-1)+1;
+
+  std::vector<AliGlauberMC*> workers(nthreads);
+  std::vector<TRandom3*> randoms(nthreads);
+  for (Int_t t = 0; t<nthreads; t++)
+  {
+    workers[t] = MakeWorker();
+    randoms[t] = new TRandom3(seeds[t]);
+    workers[t]->SetRandom(randoms[t]);
+    //allocate the nucleons before the threads start
+    workers[t]->fANucleus.ThrowNucleons();
+    workers[t]->fBNucleus.ThrowNucleons();
+  }
+
+  std::vector< std::vector<Float_t> > values(nslots);
+  std::vector<Int_t> discarded(nslots,0);
+  std::vector<Bool_t> done(nslots,kFALSE);
+  for (Int_t s = 0; s<nslots; s++)
+    values[s].reserve(kBlock*48);
+  auto runBlock = [&] (Int_t t, Int_t b) {
+    AliGlauberMC *w = workers[t];
+    Int_t s = b%nslots;
+    randoms[t]->SetSeed(seeds[b]);
+    Int_t first = b*kBlock;
+    Int_t last  = TMath::Min(first+kBlock,nevents);
+    Float_t v[48];
+    for (Int_t i = first; i<last; i++)
+    {
+      if(!w->NextEvent())
+      {
+        discarded[s]++;
+        continue;
+      }
+      w->GetNtupleValues(v);
+      values[s].insert(values[s].end(),v,v+48);
+    }
+  };
+
+  Int_t q = 0;
+  Int_t u = 0;
+  auto fillBlock = [&] (Int_t b) {
+    Int_t s = b%nslots;
+    for (UInt_t k = 0; k<values[s].size(); k += 48)
+      fnt->Fill(&values[s][k]);
+    q += values[s].size()/48;
+    u += discarded[s];
+    values[s].clear();
+    discarded[s] = 0;
+  };
+
+  if (nthreads==1)
+  {
+    for (Int_t b = 0; b<nblocks; b++)
+    {
+      runBlock(0,b);
+      fillBlock(b);
+    }
+  }
+  else
+  {
+    //block b waits for its slot until block b-nslots is filled, the
+    //calling thread fills the blocks into the ntuple in order
+    std::mutex mutex;
+    std::condition_variable cond;
+    Int_t nfilled = 0;
+    auto runBlocks = [&] (Int_t t) {
+      for (Int_t b = t; b<nblocks; b += nthreads)
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cond.wait(lock,[&] {return b<nfilled+nslots;});
+        }
+        runBlock(t,b);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          done[b%nslots] = kTRUE;
+        }
+        cond.notify_all();
+      }
+    };
+    std::vector<std::thread> threads;
+    for (Int_t t = 0; t<nthreads; t++)
+      threads.push_back(std::thread(runBlocks,t));
+    for (Int_t b = 0; b<nblocks; b++)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock,[&] {return done[b%nslots];});
+      }
+      fillBlock(b);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        done[b%nslots] = kFALSE;
+        nfilled++;
+      }
+      cond.notify_all();
+    }
+    for (Int_t t = 0; t<nthreads; t++)
+      threads[t].join();
+  }
+
+  for (Int_t t = 0; t<nthreads; t++)
+  {
+    AliGlauberMC *w = workers[t];
+    fEvents      += w->fEvents;
+    fTotalEvents += w->fTotalEvents;
+    if (w->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = w->fMaxNpartFound;
+    delete w;
+    delete randoms[t];
+  }
+  std::cout << "Generating Event # " << nevents << " on " << nthreads << " threads... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      const Option_t *sysA,
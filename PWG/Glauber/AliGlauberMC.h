@@ -16,9 +16,11 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
 
 using std::cout;
 using std::endl;
@@ -100,6 +102,11 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   void   SetNThreads(Int_t n)        {fNThreads = n;}
+   void   SetSeed(UInt_t seed)        {fSeed = seed;}
+   void   SetRandom(TRandom *rnd)     {fRandom = rnd; fANucleus.SetRandom(rnd); fBNucleus.SetRandom(rnd);}
+   Int_t  GetNThreads()         const {return fNThreads;}
+   UInt_t GetSeed()             const {return fSeed;}
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -251,9 +258,29 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Int_t        fNThreads;       //number of threads used by Run (0 = serial with gRandom, calling thread if <2)
+   UInt_t       fSeed;           //seed of the random streams of Run (0 = from gRandom)
+   TRandom     *fRandom;         //!random generator (gRandom if not set)
+   std::vector<Double_t> fSigFlucX;   //!tabulated fSigFluc, used with fRandom
+   std::vector<Double_t> fSigFlucCdf; //!normalised integral of fSigFluc up to fSigFlucX
+   std::vector<Double_t> fXA;    //!x of nucleons in nucleus A, for the collision loop
+   std::vector<Double_t> fYA;    //!y of nucleons in nucleus A
+   std::vector<Double_t> fD2A;   //!interaction distance^2 of nucleons in nucleus A
+   std::vector<Int_t>    fNCollA;//!number of collisions of nucleons in nucleus A
+   std::vector<Double_t> fXB;    //!x of nucleons in nucleus B
+   std::vector<Double_t> fYB;    //!y of nucleons in nucleus B
+   std::vector<Double_t> fD2B;   //!interaction distance^2 of nucleons in nucleus B
+   std::vector<Int_t>    fNCollB;//!number of collisions of nucleons in nucleus B
    Bool_t       CalcResults(Double_t bgen);
+   void         InitSigFluc();
+   Double_t     GetRandomSigNN();
+   TRandom     *GetRandom()      const;
+   void         CreateNtuple();
+   void         GetNtupleValues(Float_t *v) const;
+   void         RunThreads(Int_t nevents);
+   AliGlauberMC *MakeWorker()    const;
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
@@ -43,6 +43,7 @@ public:
    void       Reset()              {fNColl=0;}
    void       SetInNucleusA()      {fInNucleusA=1;}
    void       SetInNucleusB()      {fInNucleusA=0;}
+   void       SetNColl(Int_t n)    {fNColl=n;}
    void       SetSigNN(Double_t s) {fSigNN=s;}
    void       SetXYZ(Double_t x, Double_t y, Double_t z) {fX=x; fY=y; fZ=z;}
 
@@ -23,6 +23,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <Riostream.h>
 #include <TMath.h>
 #include <TEllipse.h>
@@ -49,7 +50,10 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(NULL),
+  fTableR(),
+  fTableCdf()
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -77,7 +81,10 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fF(in.fF),
   fTrials(in.fTrials),
   fFunction(in.fFunction),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(NULL),
+  fTableR(in.fTableR),
+  fTableCdf(in.fTableCdf)
 {
   //copy ctor
   if (in.fNucleons)
@@ -97,6 +104,8 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fF=in.fF;
   fTrials=in.fTrials;
   fFunction=in.fFunction;
+  fTableR=in.fTableR;
+  fTableCdf=in.fTableCdf;
   delete fNucleons;
   fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
   fNucleons->SetOwner();
@@ -177,6 +186,7 @@ void AliGlauberNucleus::Lookup(Option_t* name)
 void AliGlauberNucleus::SetR(Double_t ir)
 {
    fR = ir;
+   fTableCdf.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -195,6 +205,7 @@ void AliGlauberNucleus::SetR(Double_t ir)
 void AliGlauberNucleus::SetA(Double_t ia)
 {
    fA = ia;
+   fTableCdf.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -212,6 +223,7 @@ void AliGlauberNucleus::SetA(Double_t ia)
 void AliGlauberNucleus::SetW(Double_t iw)
 {
    fW = iw;
+   fTableCdf.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -225,6 +237,70 @@ void AliGlauberNucleus::SetW(Double_t iw)
    }
 }
 
+//______________________________________________________________________________
+void AliGlauberNucleus::TabulateFunction()
+{
+   // tabulate rho(r) for GetRandomR with fRandom; has to be called
+   // before the nucleus is used from another thread than the one
+   // which owns fFunction
+   Tabulate(fFunction,fTableR,fTableCdf);
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::Tabulate(TF1 *func, std::vector<Double_t> &x, std::vector<Double_t> &cdf)
+{
+   // tabulate the normalised integral of func in its range (midpoint rule),
+   // to sample it with GetRandomTabulated without using func itself
+   const Int_t nbins = 2000;
+   x.clear();
+   cdf.clear();
+   if (!func) return;
+   Double_t xmin = func->GetXmin();
+   Double_t dx   = (func->GetXmax()-xmin)/nbins;
+   x.resize(nbins+1);
+   cdf.resize(nbins+1);
+   x[0]   = xmin;
+   cdf[0] = 0;
+   for (Int_t i = 1; i<=nbins; i++) {
+      Double_t f = func->Eval(xmin+(i-0.5)*dx);
+      if (!(f>0)) f = 0; // also catches nan
+      x[i]   = xmin+i*dx;
+      cdf[i] = cdf[i-1]+f*dx;
+   }
+   if (cdf[nbins]<=0) {
+      x.clear();
+      cdf.clear();
+      return;
+   }
+   for (Int_t i = 1; i<=nbins; i++)
+      cdf[i] /= cdf[nbins];
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::GetRandomTabulated(const std::vector<Double_t> &x, const std::vector<Double_t> &cdf, Double_t u)
+{
+   // return x distributed as the function tabulated by Tabulate,
+   // for u uniform in [0,1], interpolating linearly inside the bins
+   Int_t n = cdf.size();
+   if (n<2) return 0;
+   Int_t i = std::upper_bound(cdf.begin(),cdf.end(),u)-cdf.begin()-1;
+   if (i<0)   i = 0;
+   if (i>n-2) i = n-2;
+   Double_t dc = cdf[i+1]-cdf[i];
+   if (dc<=0) return x[i];
+   return x[i]+(x[i+1]-x[i])*(u-cdf[i])/dc;
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::GetRandomR()
+{
+   // radius distributed as rho(r): from fFunction with gRandom, or
+   // from the tabulated fFunction if a random generator was set
+   if (!fRandom) return fFunction->GetRandom();
+   if (fTableCdf.empty()) TabulateFunction();
+   return GetRandomTabulated(fTableR,fTableCdf,fRandom->Rndm());
+}
+
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
@@ -238,6 +314,7 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    } 
    
    fTrials = 0;
+   TRandom *rnd = fRandom ? fRandom : gRandom;
 
    Double_t sumx=0;       
    Double_t sumy=0;       
@@ -246,9 +323,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = GetRandomR()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -270,9 +347,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = GetRandomR();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
@@ -15,9 +15,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 //class TNamed;
+#include <vector>
 #include <TNamed.h>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +32,12 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TRandom*   fRandom;     //!Random generator for ThrowNucleons (gRandom if not set)
+   std::vector<Double_t> fTableR;   //!Radii of tabulated rho(r), used with fRandom
+   std::vector<Double_t> fTableCdf; //!Normalised integral of rho(r) up to fTableR
 
    void       Lookup(Option_t* name);
+   Double_t   GetRandomR();
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -45,6 +51,7 @@ public:
    Double_t   GetR()             const {return fR;}
    Double_t   GetA()             const {return fA;}
    Double_t   GetW()             const {return fW;}
+   Double_t   GetMinDist()       const {return fMinDist;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
    void       SetN(Int_t in)           {fN=in;}
@@ -52,8 +59,13 @@ public:
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom *rnd)  {fRandom=rnd;}
+   void       TabulateFunction();
    void       ThrowNucleons(Double_t xshift=0.);
 
+   static void     Tabulate(TF1 *func, std::vector<Double_t> &x, std::vector<Double_t> &cdf);
+   static Double_t GetRandomTabulated(const std::vector<Double_t> &x, const std::vector<Double_t> &cdf, Double_t u);
+
    ClassDef(AliGlauberNucleus,1)
 };
 
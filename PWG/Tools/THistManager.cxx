@@ -21,6 +21,7 @@
 #include <vector>
 #include <TArrayD.h>
 #include <TAxis.h>
+#include <TClass.h>
 #include <TH1.h>
 #include <TH2.h>
 #include <TH3.h>
@@ -425,7 +426,7 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 	  // use bin width as weight
 	  Int_t bin = hist->GetXaxis()->FindBin(x);
 	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins() + 1)
 	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
 	}
 	hist->Fill(x, weight);
@@ -449,7 +450,7 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
 	  // get bin for label
 	  Int_t bin = hist->GetXaxis()->FindBin(label);
 	  // check if not overflow or underflow bin
-	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins())
+	  if(bin != 0 && bin != hist->GetXaxis()->GetNbins() + 1)
 	    weight = 1./hist->GetXaxis()->GetBinWidth(bin);
 	}
   hist->Fill(label, weight);
@@ -471,11 +472,11 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
 	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins() + 1) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
 	}
 	if(optstring.Contains("wy")){
 	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins() + 1) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
 	hist->Fill(x, y, myweight);
 }
@@ -496,13 +497,13 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
 	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins() + 1) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
 	}
 	if(optstring.Contains("wy")){
 	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins() + 1) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
-	hist->Fill(point[0], point[1], weight);
+	hist->Fill(point[0], point[1], myweight);
 }
 
 void THistManager::FillTH2(const char *name, const char *labelX, const char *labelY, double weight, Option_t *opt) {
@@ -520,14 +521,14 @@ void THistManager::FillTH2(const char *name, const char *labelX, const char *lab
   TString optstring(opt);
   Double_t myweight = optstring.Contains("w") ? 1. : weight;
   if(optstring.Contains("wx")){
-    Int_t binx = hist->GetXaxis()->FindBin(labelY);
-    if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+    Int_t binx = hist->GetXaxis()->FindBin(labelX);
+    if(binx != 0 && binx != hist->GetXaxis()->GetNbins() + 1) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
   }
   if(optstring.Contains("wy")){
-    Int_t biny = hist->GetYaxis()->FindBin(labelX);
-    if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+    Int_t biny = hist->GetYaxis()->FindBin(labelY);
+    if(biny != 0 && biny != hist->GetYaxis()->GetNbins() + 1) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
   }
-  hist->Fill(labelX, labelY, weight);
+  hist->Fill(labelX, labelY, myweight);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
@@ -546,17 +547,17 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
 	  Int_t binx = hist->GetXaxis()->FindBin(x);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins() + 1) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
 	}
 	if(optstring.Contains("wy")){
 	  Int_t biny = hist->GetYaxis()->FindBin(y);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins() + 1) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
 	if(optstring.Contains("wz")){
 	  Int_t binz = hist->GetZaxis()->FindBin(z);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins() + 1) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
 	}
-	hist->Fill(x, y, z, weight);
+	hist->Fill(x, y, z, myweight);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
@@ -575,17 +576,17 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
 	  Int_t binx = hist->GetXaxis()->FindBin(point[0]);
-	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins()) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
+	  if(binx != 0 && binx != hist->GetXaxis()->GetNbins() + 1) myweight *= 1./hist->GetXaxis()->GetBinWidth(binx);
 	}
 	if(optstring.Contains("wy")){
 	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
-	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
+	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins() + 1) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
 	if(optstring.Contains("wz")){
 	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
-	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
+	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins() + 1) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
 	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	hist->Fill(point[0], point[1], point[2], myweight);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
@@ -607,11 +608,11 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 	  weighthandler << "w" << iaxis;
 	  if(optstring.Contains(weighthandler.str().c_str())){
 	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins() + 1) myweight *= 1./hist->GetAxis(iaxis)->GetBinWidth(bin);
 	  }
 	}
 
-	hist->Fill(x, weight);
+	hist->Fill(x, myweight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
@@ -625,6 +626,98 @@ void THistManager::FillProfile(const char* name, double x, double y, double weig
   hist->Fill(x, y, weight);
 }
 
+THistHandle<TH1> THistManager::GetTH1Handle(const char *name, Option_t *opt) const {
+  TH1 *hist = dynamic_cast<TH1 *>(FindObjectOrFatal(name, TH1::Class(), "THistManager::GetTH1Handle"));
+  TString optstring(opt);
+  return THistHandle<TH1>(hist, optstring.Contains("w"), optstring.Contains("w") ? 1u : 0u);
+}
+
+THistHandle<TH2> THistManager::GetTH2Handle(const char *name, Option_t *opt) const {
+  TH2 *hist = dynamic_cast<TH2 *>(FindObjectOrFatal(name, TH2::Class(), "THistManager::GetTH2Handle"));
+  TString optstring(opt);
+  unsigned int weightaxes(0);
+  if(optstring.Contains("wx")) weightaxes |= 1u;
+  if(optstring.Contains("wy")) weightaxes |= 1u << 1;
+  return THistHandle<TH2>(hist, optstring.Contains("w"), weightaxes);
+}
+
+THistHandle<TH3> THistManager::GetTH3Handle(const char *name, Option_t *opt) const {
+  TH3 *hist = dynamic_cast<TH3 *>(FindObjectOrFatal(name, TH3::Class(), "THistManager::GetTH3Handle"));
+  TString optstring(opt);
+  unsigned int weightaxes(0);
+  if(optstring.Contains("wx")) weightaxes |= 1u;
+  if(optstring.Contains("wy")) weightaxes |= 1u << 1;
+  if(optstring.Contains("wz")) weightaxes |= 1u << 2;
+  return THistHandle<TH3>(hist, optstring.Contains("w"), weightaxes);
+}
+
+THistHandle<THnSparse> THistManager::GetTHnSparseHandle(const char *name, Option_t *opt) const {
+  THnSparse *hist = dynamic_cast<THnSparse *>(FindObjectOrFatal(name, THnSparse::Class(), "THistManager::GetTHnSparseHandle"));
+  TString optstring(opt);
+  unsigned int weightaxes(0);
+  for(Int_t iaxis = 0; hist && iaxis < hist->GetNdimensions() && iaxis < 32; iaxis++){
+    if(optstring.Contains(Form("w%d", iaxis))) weightaxes |= 1u << iaxis;
+  }
+  return THistHandle<THnSparse>(hist, optstring.Contains("w"), weightaxes);
+}
+
+THistHandle<TProfile> THistManager::GetProfileHandle(const char *name) const {
+  TProfile *hist = dynamic_cast<TProfile *>(FindObjectOrFatal(name, TProfile::Class(), "THistManager::GetProfileHandle"));
+  return THistHandle<TProfile>(hist, false, 0);
+}
+
+void THistManager::FillTH1(const THistHandle<TH1> &handle, double x, double weight) {
+  TH1 *hist = handle.GetHistogram();
+  if(handle.HasBinWidthWeight()) weight = BinWidthWeight(hist->GetXaxis(), x);
+  hist->Fill(x, weight);
+}
+
+void THistManager::FillTH1(const THistHandle<TH1> &handle, const char *label, double weight) {
+  TH1 *hist = handle.GetHistogram();
+  if(handle.HasBinWidthWeight()){
+    Int_t bin = hist->GetXaxis()->FindBin(label);
+    if(bin != 0 && bin != hist->GetXaxis()->GetNbins() + 1)
+      weight = 1./hist->GetXaxis()->GetBinWidth(bin);
+  }
+  hist->Fill(label, weight);
+}
+
+void THistManager::FillTH2(const THistHandle<TH2> &handle, double x, double y, double weight) {
+  TH2 *hist = handle.GetHistogram();
+  if(handle.HasBinWidthWeight()){
+    weight = 1.;
+    if(handle.HasBinWidthWeight(0)) weight *= BinWidthWeight(hist->GetXaxis(), x);
+    if(handle.HasBinWidthWeight(1)) weight *= BinWidthWeight(hist->GetYaxis(), y);
+  }
+  hist->Fill(x, y, weight);
+}
+
+void THistManager::FillTH3(const THistHandle<TH3> &handle, double x, double y, double z, double weight) {
+  TH3 *hist = handle.GetHistogram();
+  if(handle.HasBinWidthWeight()){
+    weight = 1.;
+    if(handle.HasBinWidthWeight(0)) weight *= BinWidthWeight(hist->GetXaxis(), x);
+    if(handle.HasBinWidthWeight(1)) weight *= BinWidthWeight(hist->GetYaxis(), y);
+    if(handle.HasBinWidthWeight(2)) weight *= BinWidthWeight(hist->GetZaxis(), z);
+  }
+  hist->Fill(x, y, z, weight);
+}
+
+void THistManager::FillTHnSparse(const THistHandle<THnSparse> &handle, const double *x, double weight) {
+  THnSparse *hist = handle.GetHistogram();
+  if(handle.HasBinWidthWeight()){
+    weight = 1.;
+    for(Int_t iaxis = 0; iaxis < hist->GetNdimensions() && iaxis < 32; iaxis++){
+      if(handle.HasBinWidthWeight(iaxis)) weight *= BinWidthWeight(hist->GetAxis(iaxis), x[iaxis]);
+    }
+  }
+  hist->Fill(x, weight);
+}
+
+void THistManager::FillProfile(const THistHandle<TProfile> &handle, double x, double y, double weight) {
+  handle.GetHistogram()->Fill(x, y, weight);
+}
+
 TObject *THistManager::FindObject(const char *name) const {
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
@@ -647,6 +740,28 @@ THashList *THistManager::FindGroup(const char *dirname) const {
 	return nullptr;
 }
 
+TObject *THistManager::FindObjectOrFatal(const char *name, TClass *type, const char *caller) const {
+  TString dirname(basename(name)), hname(histname(name));
+  THashList *parent(FindGroup(dirname));
+  if(!parent){
+    Fatal(caller, "Parent group %s does not exist", dirname.Data());
+    return NULL;
+  }
+  TObject *obj = parent->FindObject(hname);
+  if(!obj || !obj->InheritsFrom(type)){
+    Fatal(caller, "Histogram %s of type %s not found in parent group %s", hname.Data(), type->GetName(), dirname.Data());
+    return NULL;
+  }
+  return obj;
+}
+
+double THistManager::BinWidthWeight(TAxis *axis, double x) {
+  Int_t bin = axis->FindBin(x);
+  // check if not overflow or underflow bin
+  if(bin != 0 && bin != axis->GetNbins() + 1) return 1./axis->GetBinWidth(bin);
+  return 1.;
+}
+
 TString THistManager::basename(const TString &path) const {
 	int index = path.Last('/');
 	if(index < 0) return "";  // no directory structure
@@ -1030,6 +1145,158 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandleHistograms(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1", "Test handle fill 1D histogram", 1, 0., 1.);
+    testmgr.CreateTH2("Group2/Test2", "Test handle fill 2D histogram", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Test3", "Test handle fill 3D histogram", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[4] = {1,1,1,1}; double min[4] = {0.,0.,0.,0.}, max[4] = {1.,1.,1.,1.};
+    testmgr.CreateTHnSparse("TestN", "Test handle fill THnSparse", 4, nbins, min, max);
+    testmgr.CreateTProfile("TestProfile", "Test handle fill Profile histogram", 1, 0., 1.);
+
+    THistHandle<TH1> handle1 = testmgr.GetTH1Handle("Group1/Test1");
+    THistHandle<TH2> handle2 = testmgr.GetTH2Handle("Group2/Test2");
+    THistHandle<TH3> handle3 = testmgr.GetTH3Handle("Test3");
+    THistHandle<THnSparse> handleN = testmgr.GetTHnSparseHandle("TestN");
+    THistHandle<TProfile> handleProfile = testmgr.GetProfileHandle("TestProfile");
+
+    // Evaluate test
+    // tell user why test has failed
+    bool success(true);
+    if(handle1.GetHistogram() != testmgr.FindObject("Group1/Test1")){
+      std::cout << "Group1/Test1: Handle does not point to the histogram" << std::endl;
+      success = false;
+    }
+    if(handle2.GetHistogram() != testmgr.FindObject("Group2/Test2")){
+      std::cout << "Group2/Test2: Handle does not point to the histogram" << std::endl;
+      success = false;
+    }
+    if(handle3.GetHistogram() != testmgr.FindObject("Test3")){
+      std::cout << "Test3: Handle does not point to the histogram" << std::endl;
+      success = false;
+    }
+    if(handleN.GetHistogram() != testmgr.FindObject("TestN")){
+      std::cout << "TestN: Handle does not point to the histogram" << std::endl;
+      success = false;
+    }
+    if(handleProfile.GetHistogram() != testmgr.FindObject("TestProfile")){
+      std::cout << "TestProfile: Handle does not point to the histogram" << std::endl;
+      success = false;
+    }
+    if(!success) return 1;
+
+    // mix fills via handle and by name
+    double point[4] = {0.5, 0.5, 0.5, 0.5};
+    for(int i = 0; i < 50; i++){
+      testmgr.FillTH1(handle1, 0.5);
+      testmgr.FillTH1("Group1/Test1", 0.5);
+      testmgr.FillTH2(handle2, 0.5, 0.5);
+      testmgr.FillTH2("Group2/Test2", 0.5, 0.5);
+      testmgr.FillTH3(handle3, 0.5, 0.5, 0.5);
+      testmgr.FillTH3("Test3", 0.5, 0.5, 0.5);
+      testmgr.FillTHnSparse(handleN, point);
+      testmgr.FillTHnSparse("TestN", point);
+      testmgr.FillProfile(handleProfile, 0.5, 1.);
+      testmgr.FillProfile("TestProfile", 0.5, 1.);
+    }
+
+    if(TMath::Abs(handle1.GetHistogram()->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test1: Mismatch in values, expected 100, found " << handle1.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(handle2.GetHistogram()->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group2/Test2: Mismatch in values, expected 100, found " << handle2.GetHistogram()->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(handle3.GetHistogram()->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Test3: Mismatch in values, expected 100, found " << handle3.GetHistogram()->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int index[4] = {1,1,1,1};
+    if(TMath::Abs(handleN.GetHistogram()->GetBinContent(index) - 100) > DBL_EPSILON){
+      std::cout << "TestN: Mismatch in values, expected 100, found " << handleN.GetHistogram()->GetBinContent(index) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(handleProfile.GetHistogram()->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "TestProfile: Mismatch in values, expected 1, found " << handleProfile.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
+  int THistManagerTestSuite::TestFillBinWidthHistograms(){
+    THistManager testmgr("testmgr");
+
+    const char *modes[2] = {"Name", "Handle"};
+    int nbins[3] = {4,4,4}; double min[3] = {0.,0.,0.}, max[3] = {2.,2.,2.};
+    for(int imode = 0; imode < 2; imode++){
+      testmgr.CreateTH2(Form("Test2%s", modes[imode]), "Test bin width fill 2D histogram", 4, 0., 2., 4, 0., 2.);
+      testmgr.CreateTH3(Form("Test3%s", modes[imode]), "Test bin width fill 3D histogram", 4, 0., 2., 4, 0., 2., 4, 0., 2.);
+      testmgr.CreateTHnSparse(Form("TestN%s", modes[imode]), "Test bin width fill THnSparse", 3, nbins, min, max);
+    }
+    THistHandle<TH2> handle2 = testmgr.GetTH2Handle("Test2Handle", "wy");
+    THistHandle<TH3> handle3 = testmgr.GetTH3Handle("Test3Handle", "wxwz");
+    THistHandle<THnSparse> handleN = testmgr.GetTHnSparseHandle("TestNHandle", "w0w2");
+
+    // one fill per bin, the weight is ignored when filling with bin width correction
+    const double values[4] = {0.25, 0.75, 1.25, 1.75};
+    for(int ix = 0; ix < 4; ix++){
+      for(int iy = 0; iy < 4; iy++){
+        for(int iz = 0; iz < 4; iz++){
+          double point[3] = {values[ix], values[iy], values[iz]};
+          if(!iz){
+            testmgr.FillTH2("Test2Name", point, 3., "wy");
+            testmgr.FillTH2(handle2, point[0], point[1], 3.);
+          }
+          if(iz % 2) testmgr.FillTH3("Test3Name", point, 3., "wxwz");
+          else testmgr.FillTH3("Test3Name", point[0], point[1], point[2], 3., "wxwz");
+          testmgr.FillTH3(handle3, point[0], point[1], point[2], 3.);
+          testmgr.FillTHnSparse("TestNName", point, 3., "w0w2");
+          testmgr.FillTHnSparse(handleN, point, 3.);
+        }
+      }
+    }
+
+    // Evaluate test
+    // tell user why test has failed
+    bool success(true);
+    TH2 *named2 = static_cast<TH2 *>(testmgr.FindObject("Test2Name"));
+    TH3 *named3 = static_cast<TH3 *>(testmgr.FindObject("Test3Name"));
+    THnSparse *namedN = static_cast<THnSparse *>(testmgr.FindObject("TestNName"));
+    for(int ix = 1; ix <= 4; ix++){
+      for(int iy = 1; iy <= 4; iy++){
+        for(int iz = 1; iz <= 4; iz++){
+          double expected = 4.;
+          int index[3] = {ix, iy, iz};
+          if(TMath::Abs(named3->GetBinContent(ix, iy, iz) - expected) > DBL_EPSILON ||
+             TMath::Abs(handle3.GetHistogram()->GetBinContent(ix, iy, iz) - expected) > DBL_EPSILON){
+            std::cout << "Test3: Mismatch in bin (" << ix << "," << iy << "," << iz << "), expected " << expected
+                      << ", found " << named3->GetBinContent(ix, iy, iz) << " (name) and "
+                      << handle3.GetHistogram()->GetBinContent(ix, iy, iz) << " (handle)" << std::endl;
+            success = false;
+          }
+          if(TMath::Abs(namedN->GetBinContent(index) - expected) > DBL_EPSILON ||
+             TMath::Abs(handleN.GetHistogram()->GetBinContent(index) - expected) > DBL_EPSILON){
+            std::cout << "TestN: Mismatch in bin (" << ix << "," << iy << "," << iz << "), expected " << expected
+                      << ", found " << namedN->GetBinContent(index) << " (name) and "
+                      << handleN.GetHistogram()->GetBinContent(index) << " (handle)" << std::endl;
+            success = false;
+          }
+        }
+        double expected = 2.;
+        if(TMath::Abs(named2->GetBinContent(ix, iy) - expected) > DBL_EPSILON ||
+           TMath::Abs(handle2.GetHistogram()->GetBinContent(ix, iy) - expected) > DBL_EPSILON){
+          std::cout << "Test2: Mismatch in bin (" << ix << "," << iy << "), expected " << expected
+                    << ", found " << named2->GetBinContent(ix, iy) << " (name) and "
+                    << handle2.GetHistogram()->GetBinContent(ix, iy) << " (handle)" << std::endl;
+          success = false;
+        }
+      }
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -1050,6 +1317,14 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handle" << std::endl;
+    testresult += testsuite.TestFillHandleHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
+    std::cout << "Running test: Fill bin width" << std::endl;
+    testresult += testsuite.TestFillBinWidthHistograms();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1072,4 +1347,14 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandle(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandleHistograms();
+  }
+
+  int TestRunFillBinWidth(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillBinWidthHistograms();
+  }
 }
@@ -11,6 +11,7 @@
 class TArrayD;
 class TAxis;
 class TBinning;
+class TClass;
 class TList;
 class TH1;
 class TH2;
@@ -23,6 +24,66 @@ class TProfile;
  * @brief Histogram manager and components needed to make it work.
  */
 
+/**
+ * @class THistHandle
+ * @brief Typed reference to a histogram inside a THistManager
+ * @ingroup Histmanager
+ *
+ * Handles are obtained from the THistManager (i.e. THistManager::GetTH1Handle)
+ * which resolves the path of the histogram and the fill option once. Filling
+ * via the Fill methods of the THistManager taking the handle does not need
+ * any further lookup. The handle does not own the histogram: it is valid
+ * as long as the histogram manager holding the histogram.
+ */
+template<class HistType>
+class THistHandle {
+public:
+
+  /**
+   * @brief Default constructor, handle not pointing to any histogram
+   */
+  THistHandle(): fHistogram(nullptr), fBinWidthWeight(false), fWeightAxes(0) {}
+
+  /**
+   * @brief Constructor
+   * @param[in] hist Histogram the handle points to
+   * @param[in] binwidthweight If true the weight is corrected for the bin width
+   * @param[in] weightaxes Bitmap of the axes used in the bin width correction
+   */
+  THistHandle(HistType *hist, bool binwidthweight, unsigned int weightaxes):
+    fHistogram(hist), fBinWidthWeight(binwidthweight), fWeightAxes(weightaxes) {}
+
+  /**
+   * @brief Get the histogram the handle points to
+   * @return Histogram (NULL for default-constructed handles)
+   */
+  HistType *GetHistogram() const { return fHistogram; }
+
+  /**
+   * @brief Check whether the handle points to a histogram
+   * @return True if the handle points to a histogram
+   */
+  bool IsValid() const { return fHistogram != nullptr; }
+
+  /**
+   * @brief Check whether the weight is corrected for the bin width
+   * @return True if the fill option contained a bin width correction
+   */
+  bool HasBinWidthWeight() const { return fBinWidthWeight; }
+
+  /**
+   * @brief Check whether the weight is corrected for the bin width in a given axis
+   * @param[in] axis Index of the axis (0 = x, 1 = y, 2 = z)
+   * @return True if the bin width of the axis is used
+   */
+  bool HasBinWidthWeight(int axis) const { return fWeightAxes & (1u << axis); }
+
+private:
+  HistType                    *fHistogram;          ///< Histogram the handle points to (not owned)
+  bool                        fBinWidthWeight;      ///< Correct the weight for the bin width
+  unsigned int                fWeightAxes;          ///< Axes used in the bin width correction
+};
+
 /**
  * @class THistManager
  * @brief Container class for histograms
@@ -82,7 +143,7 @@ class TProfile;
  * with random values of an exponential distribution.
  *
  * ~~~{.cxx}
- * for(auto en : ROOT::TSeqI(0, 10000) {
+ * for(auto en : ROOT::TSeqI(0, 10000)) {
  *   double pt = gRandom->Exp(-1);
  *   mgr.FillTH1("hPt", pt);
  * }
@@ -94,7 +155,34 @@ class TProfile;
  * manager when filling the histogram. For this purpose the Fill methods provide
  * an argument for options. Automatic correction for the bin width is done when
  * specifying the argument *W*, followed by the direction. Adding multiple directions
- * the weight is calculated for all directions at the same time.
+ * the weight is calculated for all directions at the same time. All bins except
+ * the underflow and overflow bins are corrected.
+ *
+ * Change of behavior: before the handle-based fills were introduced, FillTH2 with
+ * a point or with labels, FillTH3 and FillTHnSparse computed the correction but
+ * filled the uncorrected weight (FillTHnSparse even multiplied by the bin width,
+ * FillTH2 with labels took the bins from the wrong labels), and the last bin of
+ * every axis was not corrected in any fill. Outputs filled with bin width
+ * correction before and after this change are therefore not comparable.
+ *
+ * # Filling histograms via handles
+ *
+ * Each named fill has to split the path, find the group and the histogram
+ * and interpret the option string. For histograms filled many times per
+ * event the lookup can be done once (i.e. in UserCreateOutputObjects) by
+ * resolving the histogram into a THistHandle, which is then used in the
+ * corresponding Fill method without any lookup:
+ *
+ * ~~~{.cxx}
+ * THistHandle<TH1> hPt = mgr.GetTH1Handle("hPt");
+ * for(auto en : ROOT::TSeqI(0, 10000)) {
+ *   mgr.FillTH1(hPt, gRandom->Exp(-1));
+ * }
+ * ~~~
+ *
+ * Handle-based and name-based fills act on the same histogram object and
+ * can be mixed freely. The content of the histogram manager (and therefore
+ * merging and output) does not depend on how histograms were filled.
  */
 class THistManager : public TNamed {
 public:
@@ -634,6 +722,102 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * @brief Resolve a 1D histogram within the container into a handle.
+   *
+   * The histogram name also contains the parent group(s)
+   * according to the common group notation. The fill
+   * option (see FillTH1) is interpreted once and applied
+   * in all fills using the handle.
+   * @param[in] name Name of the histogram
+   * @param[in] option Optional filling arguments
+   * @return Handle to the histogram
+   */
+  THistHandle<TH1> GetTH1Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a 2D histogram within the container into a handle.
+   * @param[in] name Name of the histogram
+   * @param[in] option Optional filling arguments
+   * @return Handle to the histogram
+   */
+  THistHandle<TH2> GetTH2Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a 3D histogram within the container into a handle.
+   * @param[in] name Name of the histogram
+   * @param[in] option Optional filling arguments
+   * @return Handle to the histogram
+   */
+  THistHandle<TH3> GetTH3Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a nD histogram within the container into a handle.
+   * @param[in] name Name of the histogram
+   * @param[in] option Optional filling arguments
+   * @return Handle to the histogram
+   */
+  THistHandle<THnSparse> GetTHnSparseHandle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * @brief Resolve a profile histogram within the container into a handle.
+   * @param[in] name Name of the profile histogram
+   * @return Handle to the profile histogram
+   */
+  THistHandle<TProfile> GetProfileHandle(const char *name) const;
+
+  /**
+   * @brief Fill a 1D histogram via its handle.
+   * @param[in] handle Handle to the histogram
+   * @param[in] x x-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH1(const THistHandle<TH1> &handle, double x, double weight = 1.);
+
+  /**
+   * @brief Fill a 1D histogram via its handle using a bin label.
+   * @param[in] handle Handle to the histogram
+   * @param[in] label Label of the bin to fill
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH1(const THistHandle<TH1> &handle, const char *label, double weight = 1.);
+
+  /**
+   * @brief Fill a 2D histogram via its handle.
+   * @param[in] handle Handle to the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH2(const THistHandle<TH2> &handle, double x, double y, double weight = 1.);
+
+  /**
+   * @brief Fill a 3D histogram via its handle.
+   * @param[in] handle Handle to the histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] z z-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTH3(const THistHandle<TH3> &handle, double x, double y, double z, double weight = 1.);
+
+  /**
+   * @brief Fill a nD histogram via its handle.
+   * @param[in] handle Handle to the histogram
+   * @param[in] x coordinates of the data
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillTHnSparse(const THistHandle<THnSparse> &handle, const double *x, double weight = 1.);
+
+  /**
+   * @brief Fill a profile histogram via its handle.
+   * @param[in] handle Handle to the profile histogram
+   * @param[in] x x-coordinate
+   * @param[in] y y-coordinate
+   * @param[in] weight optional weight of the entry (default 1)
+   */
+  void FillProfile(const THistHandle<TProfile> &handle, double x, double y, double weight = 1.);
+
   /**
    * @brief Create forward iterator starting at the beginning of the
    * container
@@ -719,6 +903,23 @@ private:
 	 */
 	TString histname(const TString &path) const;
 
+	/**
+	 * @brief Find a histogram inside the container, aborting if it is not found.
+	 * @param[in] name Name of the histogram, following the common notation
+	 * @param[in] type Class the histogram has to inherit from
+	 * @param[in] caller Name of the calling method (for the error message)
+	 * @return pointer to the histogram
+	 */
+	TObject *FindObjectOrFatal(const char *name, TClass *type, const char *caller) const;
+
+	/**
+	 * @brief Weight correcting for the width of the bin containing x.
+	 * @param[in] axis Axis of the histogram
+	 * @param[in] x Coordinate in the axis
+	 * @return 1 over the bin width (1 for the underflow and the overflow bin)
+	 */
+	static double BinWidthWeight(TAxis *axis, double x);
+
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
 
@@ -762,6 +963,8 @@ namespace TestTHistManager {
  * - Build histrogram in groups
  * - Simple fill
  * - Fill histograms in groups
+ * - Fill histograms via handles
+ * - Fill histograms with bin width correction
  */
 class THistManagerTestSuite {
 public:
@@ -845,6 +1048,36 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether fills via handles are propagated to the histograms
+   * in the histogram manager, also when mixed with fills by name
+   * Relies on: TestBuildSimpleHistograms, TestFillSimpleHistograms
+   *
+   * Creating histograms of all types, with TH1 and TH2 in a group, and with 1 bin per dimension.
+   * Each histogram is filled 50 times via its handle and 50 times by name with the same value.
+   *
+   * Test passed:
+   * - All handles point to the histogram with the given name
+   * - All histograms need to have in its 1 bin the bin content 100 (1 for the profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandleHistograms();
+
+  /**
+   * Purpose of the test: Check the bin width correction of the fills by name and via handles
+   * Relies on: TestFillHandleHistograms
+   *
+   * Creating each of TH2, TH3 and THnSparse twice, with 4 bins of width 0.5 per dimension,
+   * one filled by name and one via its handle, with bin width correction on a subset of the
+   * axes and a weight of 3. Each bin is filled once.
+   *
+   * Test passed:
+   * - The weight is ignored, each bin (including the last one) has the content 2 for
+   *   each corrected axis, for both histograms
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillBinWidthHistograms();
 };
 
 /**
@@ -882,5 +1115,19 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms via handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandle();
+
+/**
+ * Run the test for filling histograms with bin width correction. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillBinWidth();
+
 }
 #endif
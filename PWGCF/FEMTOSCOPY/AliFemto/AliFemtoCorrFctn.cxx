@@ -34,6 +34,19 @@ void AliFemtoCorrFctn::AddMixedPair(AliFemtoPair*)
   cout << "Not implemented" << endl;
 }
 
+void AliFemtoCorrFctn::AddRealPairs(AliFemtoPairBatch* batch)
+{
+  for (int i = 0; i < batch->Size(); i++) {
+    AddRealPair(batch->Pair(i));
+  }
+}
+void AliFemtoCorrFctn::AddMixedPairs(AliFemtoPairBatch* batch)
+{
+  for (int i = 0; i < batch->Size(); i++) {
+    AddMixedPair(batch->Pair(i));
+  }
+}
+
 void AliFemtoCorrFctn::AddFirstParticle(AliFemtoParticle*, bool)
 {
   cout << "Not implemented" << endl;
@@ -11,6 +11,7 @@
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
 #include "AliFemtoPairCut.h"
+#include "AliFemtoPairBatch.h"
 
 /// \class AliFemtoCorrFctn
 /// \brief The pure-virtual base class for correlation functions
@@ -41,6 +42,13 @@ public:
   /// Not Implemented - Add background pair
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  /// Add all pairs of a batch which passed the analysis pair cut
+  /// (batched pair mode of AliFemtoSimpleAnalysis).
+  /// The defaults call AddRealPair/AddMixedPair for each pair; correlation
+  /// functions which only need the batch kinematics may override them.
+  virtual void AddRealPairs(AliFemtoPairBatch* aBatch);
+  virtual void AddMixedPairs(AliFemtoPairBatch* aBatch);
+
   /// Not Implemented - Add pair with optional
   virtual void AddFirstParticle(AliFemtoParticle *particle, bool mixing);
   virtual void AddSecondParticle(AliFemtoParticle *particle);
@@ -57,6 +65,7 @@ public:
   AliFemtoAnalysis* HbtAnalysis(){return fyAnalysis;};
   void SetAnalysis(AliFemtoAnalysis* aAnalysis);
   void SetPairSelectionCut(AliFemtoPairCut* aCut);
+  AliFemtoPairCut* GetPairSelectionCut() const;
 
 protected:
   AliFemtoAnalysis* fyAnalysis; //! link to the analysis
@@ -81,6 +90,11 @@ inline void AliFemtoCorrFctn::SetPairSelectionCut(AliFemtoPairCut* cut)
   fPairCut = cut;
 }
 
+inline AliFemtoPairCut* AliFemtoCorrFctn::GetPairSelectionCut() const
+{
+  return fPairCut;
+}
+
 inline void AliFemtoCorrFctn::EventBegin(const AliFemtoEvent* /* event */)
 { // no-op
 }
@@ -216,6 +216,43 @@ void AliFemtoCorrFctn3DLCMSSym::AddMixedPair(AliFemtoPair* pair)
 
 }
 
+void AliFemtoCorrFctn3DLCMSSym::AddRealPairs(AliFemtoPairBatch* batch)
+{
+  // LCMS components are taken from the batch, the pair frame needs AliFemtoPair
+  if (fPairCut || !fUseLCMS) {
+    AliFemtoCorrFctn::AddRealPairs(batch);
+    return;
+  }
+
+  const Double_t *qinv = batch->QInv(),
+                 *qout = batch->QOutCMS(),
+                *qside = batch->QSideCMS(),
+                *qlong = batch->QLongCMS();
+
+  for (int i = 0; i < batch->Size(); i++) {
+    fNumerator->Fill(qout[i], qside[i], qlong[i], 1.0);
+    fNumeratorW->Fill(qout[i], qside[i], qlong[i], qinv[i]);
+  }
+}
+
+void AliFemtoCorrFctn3DLCMSSym::AddMixedPairs(AliFemtoPairBatch* batch)
+{
+  if (fPairCut || !fUseLCMS) {
+    AliFemtoCorrFctn::AddMixedPairs(batch);
+    return;
+  }
+
+  const Double_t *qinv = batch->QInv(),
+                 *qout = batch->QOutCMS(),
+                *qside = batch->QSideCMS(),
+                *qlong = batch->QLongCMS();
+
+  for (int i = 0; i < batch->Size(); i++) {
+    fDenominator->Fill(qout[i], qside[i], qlong[i], 1.0);
+    fDenominatorW->Fill(qout[i], qside[i], qlong[i], qinv[i]);
+  }
+}
+
 void AliFemtoCorrFctn3DLCMSSym::SetUseLCMS(int aUseLCMS)
 {
   fUseLCMS = aUseLCMS;
@@ -33,6 +33,8 @@ public:
   virtual AliFemtoString Report();
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
+  virtual void AddRealPairs(AliFemtoPairBatch* aBatch);
+  virtual void AddMixedPairs(AliFemtoPairBatch* aBatch);
 
   virtual void Finish();
 
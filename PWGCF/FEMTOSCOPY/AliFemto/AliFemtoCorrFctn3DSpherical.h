@@ -36,6 +36,7 @@ public:
 
   void WriteOutHistos();
   virtual TList* GetOutputList();
+  virtual AliFemtoCorrFctn* Clone();
 
   //  void SetSpecificPairCut(AliFemtoPairCut* aCut);
 
@@ -55,4 +56,9 @@ private:
 
 //inline  void AliFemtoCorrFctn3DSpherical::SetSpecificPairCut(AliFemtoPairCut* pc){fPairCut=pc;}
 
+inline AliFemtoCorrFctn* AliFemtoCorrFctn3DSpherical::Clone()
+{
+  return new AliFemtoCorrFctn3DSpherical(*this);
+}
+
 #endif
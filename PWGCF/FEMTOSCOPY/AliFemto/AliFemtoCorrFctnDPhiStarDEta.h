@@ -34,6 +34,7 @@ public:
 
   void WriteHistos();
   virtual TList* GetOutputList();
+  virtual AliFemtoCorrFctn* Clone();
 
   void SetMinimumRadius(double minrad);
   void SetMagneticFieldSign(int magsign);
@@ -59,6 +60,10 @@ private:
 #endif
 };
 
+inline AliFemtoCorrFctn* AliFemtoCorrFctnDPhiStarDEta::Clone()
+{
+  return new AliFemtoCorrFctnDPhiStarDEta(*this);
+}
 
 #endif
 
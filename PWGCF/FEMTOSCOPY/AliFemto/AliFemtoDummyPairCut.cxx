@@ -33,6 +33,17 @@ bool AliFemtoDummyPairCut::Pass(const AliFemtoPair* /* pair */)
   return true;
 }
 //__________________
+void AliFemtoDummyPairCut::PassBatch(AliFemtoPairBatch* batch, bool fillMonitors)
+{
+  // Pass all pairs - only build AliFemtoPairs if there are monitors to fill
+  if (fillMonitors) {
+    for (int i = 0; i < batch->Size(); i++) {
+      FillCutMonitor(batch->Pair(i), true);
+    }
+  }
+  fNPairsPassed += batch->Size();
+}
+//__________________
 AliFemtoString AliFemtoDummyPairCut::Report()
 {
   // prepare a report from the execution
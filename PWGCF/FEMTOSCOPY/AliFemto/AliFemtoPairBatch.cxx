@@ -0,0 +1,138 @@
+///
+/// \file AliFemtoPairBatch.cxx
+///
+
+#include "AliFemtoPairBatch.h"
+#include "AliFemtoPair.h"
+
+#include <cmath>
+
+AliFemtoParticleBuffer::AliFemtoParticleBuffer():
+  fParticle(),
+  fPx(),
+  fPy(),
+  fPz(),
+  fE()
+{
+  // no-op
+}
+
+void AliFemtoParticleBuffer::Fill(const AliFemtoParticleCollection *collection)
+{
+  // storage is reused from event to event
+  fParticle.clear();
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fE.clear();
+
+  for (const AliFemtoParticle *particle : *collection) {
+    const AliFemtoLorentzVector &p = particle->FourMomentum();
+    fParticle.push_back(particle);
+    fPx.push_back(p.x());
+    fPy.push_back(p.y());
+    fPz.push_back(p.z());
+    fE.push_back(p.t());
+  }
+}
+
+AliFemtoPairBatch::AliFemtoPairBatch():
+  fSize(0),
+  fPair(new AliFemtoPair)
+{
+  // no-op
+}
+
+AliFemtoPairBatch::~AliFemtoPairBatch()
+{
+  delete fPair;
+}
+
+void AliFemtoPairBatch::Add(const AliFemtoParticleBuffer &b1, int i1,
+                            const AliFemtoParticleBuffer &b2, int i2)
+{
+  fTrack1[fSize] = b1.fParticle[i1];
+  fPx1[fSize] = b1.fPx[i1];
+  fPy1[fSize] = b1.fPy[i1];
+  fPz1[fSize] = b1.fPz[i1];
+  fE1[fSize] = b1.fE[i1];
+
+  fTrack2[fSize] = b2.fParticle[i2];
+  fPx2[fSize] = b2.fPx[i2];
+  fPy2[fSize] = b2.fPy[i2];
+  fPz2[fSize] = b2.fPz[i2];
+  fE2[fSize] = b2.fE[i2];
+
+  fPass[fSize] = true;
+  fSize++;
+}
+
+void AliFemtoPairBatch::CalculateKinematics()
+{
+  // Same definitions as AliFemtoPair::QInv, KT, QOutCMS, QSideCMS and
+  // QLongCMS, written as one branch-free loop over the arrays so that the
+  // compiler can vectorize it. The operations are done in the same order
+  // as in AliFemtoPair and AliFmLorentzVector, in order to get the same
+  // rounding.
+  for (int i = 0; i < fSize; i++) {
+    const double dx = fPx1[i] - fPx2[i],
+                 dy = fPy1[i] - fPy2[i],
+                 dz = fPz1[i] - fPz2[i],
+                 dt = fE1[i] - fE2[i];
+
+    const double xt = fPx1[i] + fPx2[i],
+                 yt = fPy1[i] + fPy2[i],
+                 zz = fPz1[i] + fPz2[i],
+                 tt = fE1[i] + fE2[i];
+
+    // qinv = -m(p1 - p2), with m() = -sqrt(-m2) for space-like vectors;
+    // m2 = t*t - (x*x + y*y + z*z) as in AliFmLorentzVector::m2
+    const double m2 = dt * dt - ((dx * dx + dy * dy) + dz * dz);
+    const double absm = std::sqrt(std::fabs(m2));
+    fQInv[i] = (m2 < 0.0) ? absm : -absm;
+
+    const double kt2 = xt * xt + yt * yt;
+    const double k1 = std::sqrt(kt2);
+    fKT[i] = 0.5 * k1;
+
+    // divide (rather than multiply by 1/k1) like QOutCMS and QSideCMS
+    const double safe_k1 = (k1 != 0.0) ? k1 : 1.0;
+    fQOut[i] = (k1 != 0.0) ? (dx * xt + dy * yt) / safe_k1 : 0.0;
+    fQSide[i] = (k1 != 0.0) ? 2.0 * (fPx2[i] * fPy1[i] - fPx1[i] * fPy2[i]) / safe_k1 : 0.0;
+
+    const double beta = zz / tt;
+    const double gamma = 1.0 / std::sqrt((1.0 - beta) * (1.0 + beta));
+    fQLong[i] = gamma * (dz - beta * dt);
+  }
+}
+
+void AliFemtoPairBatch::RemoveFailed()
+{
+  int n = 0;
+  for (int i = 0; i < fSize; i++) {
+    if (!fPass[i]) {
+      continue;
+    }
+    if (n != i) {
+      fTrack1[n] = fTrack1[i];
+      fTrack2[n] = fTrack2[i];
+      fPx1[n] = fPx1[i]; fPy1[n] = fPy1[i]; fPz1[n] = fPz1[i]; fE1[n] = fE1[i];
+      fPx2[n] = fPx2[i]; fPy2[n] = fPy2[i]; fPz2[n] = fPz2[i]; fE2[n] = fE2[i];
+      fQInv[n] = fQInv[i];
+      fKT[n] = fKT[i];
+      fQOut[n] = fQOut[i];
+      fQSide[n] = fQSide[i];
+      fQLong[n] = fQLong[i];
+      fPass[n] = true;
+    }
+    n++;
+  }
+  fSize = n;
+}
+
+AliFemtoPair* AliFemtoPairBatch::Pair(int i)
+{
+  fPair->SetTrack1(fTrack1[i]);
+  fPair->SetTrack2(fTrack2[i]);
+  return fPair;
+}
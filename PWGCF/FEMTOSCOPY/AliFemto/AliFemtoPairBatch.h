@@ -0,0 +1,104 @@
+///
+/// \file AliFemtoPairBatch.h
+///
+/// \class AliFemtoParticleBuffer
+/// \brief Contiguous (structure-of-arrays) copy of the four-momenta of a
+///        particle collection
+///
+/// \class AliFemtoPairBatch
+/// \brief A block of pairs with their kinematics in contiguous arrays
+///
+/// Used by the batched pair mode of AliFemtoSimpleAnalysis: candidate pairs
+/// are gathered from two AliFemtoParticleBuffers into a batch, the common
+/// pair kinematics (qinv, kT and the LCMS Bertsch-Pratt components) are
+/// computed for the whole batch in one loop over plain arrays which the
+/// compiler vectorizes, the pair cut marks passing pairs (PassBatch) and the
+/// correlation functions receive all passing pairs at once
+/// (AddRealPairs/AddMixedPairs).
+///
+/// For code which needs an AliFemtoPair, Pair(i) points a scratch pair owned
+/// by the batch to the i-th pair of particles.
+///
+
+#ifndef ALIFEMTOPAIRBATCH_H
+#define ALIFEMTOPAIRBATCH_H
+
+#include <vector>
+
+#include "AliFemtoParticleCollection.h"
+
+class AliFemtoParticle;
+class AliFemtoPair;
+
+class AliFemtoParticleBuffer {
+public:
+  AliFemtoParticleBuffer();
+
+  /// Copy the four-momenta of all particles of the collection
+  void Fill(const AliFemtoParticleCollection *collection);
+
+  int Size() const { return fParticle.size(); }
+
+  std::vector<const AliFemtoParticle*> fParticle;  ///< particle pointers, in collection order
+  std::vector<double> fPx;                         ///< four-momentum x
+  std::vector<double> fPy;                         ///< four-momentum y
+  std::vector<double> fPz;                         ///< four-momentum z
+  std::vector<double> fE;                          ///< four-momentum t
+};
+
+class AliFemtoPairBatch {
+public:
+  enum { kCapacity = 512 };
+
+  AliFemtoPairBatch();
+  ~AliFemtoPairBatch();
+
+  void Clear() { fSize = 0; }
+  int Size() const { return fSize; }
+  bool Full() const { return fSize == kCapacity; }
+
+  /// Append the pair (particle i1 of b1, particle i2 of b2) - b1 gives Track1
+  void Add(const AliFemtoParticleBuffer &b1, int i1,
+           const AliFemtoParticleBuffer &b2, int i2);
+
+  /// Compute qinv, kT, qout, qside and qlong (LCMS) of all pairs
+  void CalculateKinematics();
+
+  /// Mark pair i as passing or failing the pair cut
+  void SetPass(int i, bool pass) { fPass[i] = pass; }
+
+  /// Drop the pairs which did not pass, keeping the order of the others
+  void RemoveFailed();
+
+  const AliFemtoParticle* Track1(int i) const { return fTrack1[i]; }
+  const AliFemtoParticle* Track2(int i) const { return fTrack2[i]; }
+
+  /// Scratch AliFemtoPair pointing to the particles of the i-th pair
+  AliFemtoPair* Pair(int i);
+
+  /// signed qinv, as AliFemtoPair::QInv()
+  const double* QInv() const { return fQInv; }
+  const double* KT() const { return fKT; }
+  const double* QOutCMS() const { return fQOut; }
+  const double* QSideCMS() const { return fQSide; }
+  const double* QLongCMS() const { return fQLong; }
+
+private:
+  AliFemtoPairBatch(const AliFemtoPairBatch &);
+  AliFemtoPairBatch& operator=(const AliFemtoPairBatch &);
+
+  int fSize;                                   ///< number of pairs in the batch
+  const AliFemtoParticle *fTrack1[kCapacity];  ///< first particle of each pair
+  const AliFemtoParticle *fTrack2[kCapacity];  ///< second particle of each pair
+  double fPx1[kCapacity], fPy1[kCapacity], fPz1[kCapacity], fE1[kCapacity];
+  double fPx2[kCapacity], fPy2[kCapacity], fPz2[kCapacity], fE2[kCapacity];
+  double fQInv[kCapacity];
+  double fKT[kCapacity];
+  double fQOut[kCapacity];
+  double fQSide[kCapacity];
+  double fQLong[kCapacity];
+  bool fPass[kCapacity];
+  AliFemtoPair *fPair;                         ///< scratch pair handed out by Pair()
+};
+
+#endif
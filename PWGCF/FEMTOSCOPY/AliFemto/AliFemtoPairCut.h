@@ -17,6 +17,7 @@ class AliFemtoAnalysis;
 #include "AliFemtoString.h"
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
+#include "AliFemtoPairBatch.h"
 #include "AliFemtoCutMonitorHandler.h"
 #include <TList.h>
 #include <TObjString.h>
@@ -38,6 +39,12 @@ public:
 
   virtual bool Pass(const AliFemtoPair* pair) = 0;  ///< true if pair passes, false if not
 
+  /// Mark the pairs of the batch which pass (batched pair mode of
+  /// AliFemtoSimpleAnalysis), optionally filling the cut monitors.
+  /// The default calls Pass() on each pair; cuts which can work on the
+  /// precomputed batch kinematics may override it.
+  virtual void PassBatch(AliFemtoPairBatch* batch, bool fillMonitors);
+
   virtual AliFemtoString Report() = 0;              ///< user-written method to return string describing cuts
   virtual TList *ListSettings() = 0;                ///< Return a TList of settings
 
@@ -66,6 +73,18 @@ inline AliFemtoPairCut::~AliFemtoPairCut(){ /* no-op */ }
 inline void AliFemtoPairCut::SetAnalysis(AliFemtoAnalysis* analysis) { fyAnalysis = analysis; }
 inline AliFemtoPairCut& AliFemtoPairCut::operator=(const AliFemtoPairCut &aCut) { if (this == &aCut) return *this; fyAnalysis = aCut.fyAnalysis; return *this; }
 
+inline void AliFemtoPairCut::PassBatch(AliFemtoPairBatch* batch, bool fillMonitors)
+{
+  for (int i = 0; i < batch->Size(); i++) {
+    AliFemtoPair *pair = batch->Pair(i);
+    const bool pass = Pass(pair);
+    if (fillMonitors) {
+      FillCutMonitor(pair, pass);
+    }
+    batch->SetPass(i, pass);
+  }
+}
+
 inline void AliFemtoPairCut::EventBegin(const AliFemtoEvent* /* aEvent */ ) { /* no-op */ }
 
 inline void AliFemtoPairCut::EventEnd(const AliFemtoEvent* /* aEvent */ ) { /* no-op */ }
@@ -83,7 +83,7 @@ AliFemtoQinvCorrFctn::AliFemtoQinvCorrFctn(const char* title, const int& nbins,
 
 //____________________________
 AliFemtoQinvCorrFctn::AliFemtoQinvCorrFctn(const AliFemtoQinvCorrFctn& aCorrFctn) :
-  AliFemtoCorrFctn(),
+  AliFemtoCorrFctn(aCorrFctn),
   fNumerator(0),
   fDenominator(0),
   fRatio(0),
@@ -112,8 +112,9 @@ AliFemtoQinvCorrFctn::AliFemtoQinvCorrFctn(const AliFemtoQinvCorrFctn& aCorrFctn
 
   fPairKinematics = aCorrFctn.fPairKinematics;
 
+  // the pair ntuple is not shared - it is deleted in the destructor
   if (aCorrFctn.PairReader)
-    PairReader = (TNtuple*)aCorrFctn.PairReader;
+    PairReader = new TNtuple(aCorrFctn.PairReader->GetName(), aCorrFctn.PairReader->GetTitle(), "px1:py1:pz1:e1:px2:py2:pz2:e2");
 
 }
 //____________________________
@@ -154,8 +155,12 @@ AliFemtoQinvCorrFctn& AliFemtoQinvCorrFctn::operator=(const AliFemtoQinvCorrFctn
 
   fPairKinematics = aCorrFctn.fPairKinematics;
 
+  AliFemtoCorrFctn::operator=(aCorrFctn);
+
+  if (PairReader) delete PairReader;
+  PairReader = 0;
   if (aCorrFctn.PairReader)
-    PairReader = (TNtuple*)aCorrFctn.PairReader;
+    PairReader = new TNtuple(aCorrFctn.PairReader->GetName(), aCorrFctn.PairReader->GetTitle(), "px1:py1:pz1:e1:px2:py2:pz2:e2");
 
   return *this;
 }
@@ -326,6 +331,42 @@ void AliFemtoQinvCorrFctn::AddMixedPair(AliFemtoPair* pair){
   }
 //_______________________________________________________________
 
+}
+//____________________________
+void AliFemtoQinvCorrFctn::AddRealPairs(AliFemtoPairBatch* batch)
+{
+  // add a batch of true pairs - histograms are filled straight from the
+  // batch kinematics unless per-pair information is needed
+  if (fPairCut || fDetaDphiscal) {
+    AliFemtoCorrFctn::AddRealPairs(batch);
+    return;
+  }
+
+  const int n = batch->Size();
+  const double *qinv = batch->QInv();
+  double tQinv[AliFemtoPairBatch::kCapacity];
+  for (int i = 0; i < n; i++) {
+    tQinv[i] = fabs(qinv[i]);
+  }
+  fNumerator->FillN(n, tQinv, nullptr);
+  fkTMonitor->FillN(n, batch->KT(), nullptr);
+}
+//____________________________
+void AliFemtoQinvCorrFctn::AddMixedPairs(AliFemtoPairBatch* batch)
+{
+  // add a batch of mixed (background) pairs
+  if (fPairCut || fDetaDphiscal || fPairKinematics) {
+    AliFemtoCorrFctn::AddMixedPairs(batch);
+    return;
+  }
+
+  const int n = batch->Size();
+  const double *qinv = batch->QInv();
+  double tQinv[AliFemtoPairBatch::kCapacity];
+  for (int i = 0; i < n; i++) {
+    tQinv[i] = fabs(qinv[i]);
+  }
+  fDenominator->FillN(n, tQinv, nullptr);
 }
 //____________________________
 void AliFemtoQinvCorrFctn::Write(){
@@ -67,6 +67,8 @@ public:
   virtual AliFemtoString Report();
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
+  virtual void AddRealPairs(AliFemtoPairBatch* aBatch);
+  virtual void AddMixedPairs(AliFemtoPairBatch* aBatch);
 
   virtual void Finish();
 
@@ -80,6 +82,10 @@ public:
   virtual TList* GetOutputList();
   void Write();
 
+  /// Clone for the mixing threads of AliFemtoSimpleAnalysis. Not possible
+  /// when the pair ntuple is filled, as its entries cannot be merged.
+  virtual AliFemtoCorrFctn* Clone();
+
 private:
   TH1D* fNumerator;          // numerator - real pairs
   TH1D* fDenominator;        // denominator - mixed pairs
@@ -106,5 +112,12 @@ inline  TH1D* AliFemtoQinvCorrFctn::Numerator(){return fNumerator;}
 inline  TH1D* AliFemtoQinvCorrFctn::Denominator(){return fDenominator;}
 inline  TH1D* AliFemtoQinvCorrFctn::Ratio(){return fRatio;}
 
+inline AliFemtoCorrFctn* AliFemtoQinvCorrFctn::Clone()
+{
+  if (fPairKinematics)
+    return 0;
+  return new AliFemtoQinvCorrFctn(*this);
+}
+
 
 #endif
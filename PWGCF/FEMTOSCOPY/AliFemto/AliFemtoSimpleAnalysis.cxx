@@ -10,9 +10,14 @@
 #include "AliFemtoXiTrackCut.h"
 #include "AliFemtoPicoEvent.h"
 
+#include <TH1.h>
+#include <TList.h>
+
 #include <string>
 #include <iostream>
 #include <iterator>
+#include <thread>
+#include <algorithm>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -171,7 +176,12 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fBatchedPairs(kFALSE),
+  fMixingThreads(0),
+  fMixingPairCuts(),
+  fMixingCorrFctns(),
+  fMixingCorrFctnPairCuts()
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -193,7 +203,12 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fBatchedPairs(a.fBatchedPairs),
+  fMixingThreads(a.fMixingThreads),
+  fMixingPairCuts(),
+  fMixingCorrFctns(),
+  fMixingCorrFctnPairCuts()
 {
   /// Copy constructor
 
@@ -285,6 +300,19 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     fSecondParticleCut = nullptr;
   }
 
+  for (auto &cut : fMixingPairCuts) {
+    delete cut;
+  }
+  for (auto &cfs : fMixingCorrFctns) {
+    for (auto &cf : *cfs) {
+      delete cf;
+    }
+    delete cfs;
+  }
+  for (auto &cut : fMixingCorrFctnPairCuts) {
+    delete cut;
+  }
+
   delete fPairCut;
   delete fEventCut;
   delete fFirstParticleCut;
@@ -390,6 +418,8 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fBatchedPairs = aAna.fBatchedPairs;
+  fMixingThreads = aAna.fMixingThreads;
 
   return *this;
 }
@@ -530,21 +560,7 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   }
 
   //---- Make pairs for mixed events, looping over events in mixingBuffer ----//
-  for (auto storedEvent : *fMixingBuffer) {
-
-    // If identical - only mix the first particle collections
-    if (AnalyzeIdenticalParticles()) {
-      MakePairs("mixed", collection1, storedEvent->FirstParticleCollection());
-
-    // If non-identical - mix both combinations of first and second particles
-    } else {
-        MakePairs("mixed", collection1,
-                           storedEvent->SecondParticleCollection());
-
-        MakePairs("mixed", storedEvent->FirstParticleCollection(),
-                           collection2);
-    }
-  }
+  MakeMixedPairs(collection1, collection2);
 
   if (fVerbose) {
     cout << " - mixed done   \n";
@@ -574,6 +590,28 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
 /// specfied, make pairs within first particle collection.
 
   const string type = typeIn;
+  const bool isReal = (type == "real");
+  if (!isReal && type != "mixed") {
+    cout << "Problem with pair type, type = " << type << endl;
+    return;
+  }
+
+  MakePairsWith(isReal, partCollection1, partCollection2, enablePairMonitors,
+                fPairCut, fCorrFctnCollection);
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MakePairsWith(bool isReal,
+                                           AliFemtoParticleCollection *partCollection1,
+                                           AliFemtoParticleCollection *partCollection2,
+                                           Bool_t enablePairMonitors,
+                                           AliFemtoPairCut *pairCut,
+                                           AliFemtoCorrFctnCollection *corrFctns)
+{
+  if (fBatchedPairs) {
+    MakeBatchedPairs(isReal, partCollection1, partCollection2, enablePairMonitors,
+                     pairCut, corrFctns);
+    return;
+  }
 
   //  int swpart = ((long int) partCollection1) % 2;
 
@@ -640,22 +678,20 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
       }
 
       // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
+      bool tmpPassPair = pairCut->Pass(tPair);
 
       // This is a condition for speed reasons
       if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
+        pairCut->FillCutMonitor(tPair, tmpPassPair);
       }
 
       // If pair passes cut, loop over CF's and add pair to real/mixed
       if (tmpPassPair) {
-        for (auto &tCorrFctn : *fCorrFctnCollection) {
-          if (type == "real")
+        for (auto &tCorrFctn : *corrFctns) {
+          if (isReal)
             tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
-            tCorrFctn->AddMixedPair(tPair);
           else
-            cout << "Problem with pair type, type = " << type << endl;
+            tCorrFctn->AddMixedPair(tPair);
         } // loop over corellatoin functions
       }
 
@@ -666,6 +702,254 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   delete tPair;
 }
 //_________________________
+void AliFemtoSimpleAnalysis::MakeBatchedPairs(bool isReal,
+                                              AliFemtoParticleCollection *partCollection1,
+                                              AliFemtoParticleCollection *partCollection2,
+                                              Bool_t enablePairMonitors,
+                                              AliFemtoPairCut *pairCut,
+                                              AliFemtoCorrFctnCollection *corrFctns)
+{
+/// Same pairs, in the same order and with the same Track1/Track2 swapping,
+/// as the pair-by-pair loop of MakePairs, but the four-momenta are first
+/// copied into contiguous buffers and the pairs are processed in blocks
+/// of AliFemtoPairBatch::kCapacity.
+
+  bool swpart = fNeventsProcessed % 2;
+
+  AliFemtoParticleBuffer buffer1, buffer2;
+  buffer1.Fill(partCollection1);
+  if (partCollection2) {
+    buffer2.Fill(partCollection2);
+  }
+
+  AliFemtoPairBatch *batch = new AliFemtoPairBatch;
+
+  const int n1 = buffer1.Size();
+  for (int i = 0; i < n1; i++) {
+    if (partCollection2) {
+      const int n2 = buffer2.Size();
+      for (int j = 0; j < n2; j++) {
+        batch->Add(buffer1, i, buffer2, j);
+        if (batch->Full()) {
+          ProcessPairBatch(isReal, batch, enablePairMonitors, pairCut, corrFctns);
+        }
+      }
+    }
+    else {
+      // Swap between first and second particles to avoid biased ordering
+      for (int j = i + 1; j < n1; j++) {
+        if (swpart) {
+          batch->Add(buffer1, j, buffer1, i);
+        } else {
+          batch->Add(buffer1, i, buffer1, j);
+        }
+        swpart = !swpart;
+        if (batch->Full()) {
+          ProcessPairBatch(isReal, batch, enablePairMonitors, pairCut, corrFctns);
+        }
+      }
+    }
+  }
+  if (batch->Size()) {
+    ProcessPairBatch(isReal, batch, enablePairMonitors, pairCut, corrFctns);
+  }
+
+  delete batch;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ProcessPairBatch(bool isReal,
+                                              AliFemtoPairBatch *batch,
+                                              Bool_t enablePairMonitors,
+                                              AliFemtoPairCut *pairCut,
+                                              AliFemtoCorrFctnCollection *corrFctns)
+{
+  batch->CalculateKinematics();
+
+  pairCut->PassBatch(batch, enablePairMonitors);
+  batch->RemoveFailed();
+
+  if (batch->Size()) {
+    for (auto &tCorrFctn : *corrFctns) {
+      if (isReal)
+        tCorrFctn->AddRealPairs(batch);
+      else
+        tCorrFctn->AddMixedPairs(batch);
+    }
+  }
+
+  batch->Clear();
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MakeMixedPairs(AliFemtoParticleCollection *collection1,
+                                            AliFemtoParticleCollection *collection2)
+{
+/// Pair the collections of the current event with those of every stored
+/// event. With fMixingThreads > 1 the stored events are shared out among
+/// threads, thread t filling its own clones fMixingCorrFctns[t].
+
+  std::vector<std::pair<AliFemtoParticleCollection*, AliFemtoParticleCollection*> > jobs;
+  for (auto storedEvent : *fMixingBuffer) {
+
+    // If identical - only mix the first particle collections
+    if (collection2 == nullptr) {
+      jobs.push_back(std::make_pair(collection1, storedEvent->FirstParticleCollection()));
+
+    // If non-identical - mix both combinations of first and second particles
+    } else {
+      jobs.push_back(std::make_pair(collection1, storedEvent->SecondParticleCollection()));
+      jobs.push_back(std::make_pair(storedEvent->FirstParticleCollection(), collection2));
+    }
+  }
+
+  if (fMixingThreads < 2 || jobs.size() < 2 || !SetupMixingThreads()) {
+    for (auto &job : jobs) {
+      MakePairsWith(false, job.first, job.second, kFALSE, fPairCut, fCorrFctnCollection);
+    }
+    return;
+  }
+
+  const size_t nThreads = std::min(static_cast<size_t>(fMixingThreads), jobs.size());
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nThreads; t++) {
+    threads.push_back(std::thread([this, &jobs, t, nThreads] () {
+      for (size_t j = t; j < jobs.size(); j += nThreads) {
+        MakePairsWith(false, jobs[j].first, jobs[j].second, kFALSE,
+                      fMixingPairCuts[t], fMixingCorrFctns[t]);
+      }
+    }));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+//_________________________
+bool AliFemtoSimpleAnalysis::SetupMixingThreads()
+{
+/// Clones are created once, with empty histograms, and kept until Finish()
+
+  if (fMixingCorrFctns.size() >= fMixingThreads) {
+    return true;
+  }
+
+  // keep the histograms of the clones out of the current directory
+  const Bool_t addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+
+  bool cloned = true;
+  while (fMixingCorrFctns.size() < fMixingThreads) {
+    AliFemtoPairCut *pairCut = fPairCut->Clone();
+    if (!pairCut) {
+      cloned = false;
+      break;
+    }
+    pairCut->SetAnalysis(this);
+
+    AliFemtoCorrFctnCollection *corrFctns = new AliFemtoCorrFctnCollection;
+    for (auto &cf : *fCorrFctnCollection) {
+      AliFemtoCorrFctn *clone = cf->Clone();
+      if (!clone) {
+        cloned = false;
+        break;
+      }
+      clone->SetAnalysis(this);
+      corrFctns->push_back(clone);
+
+      // the clone shares the pair selection cut of the original - give it its own
+      if (AliFemtoPairCut *cfPairCut = cf->GetPairSelectionCut()) {
+        AliFemtoPairCut *cfPairCutClone = cfPairCut->Clone();
+        if (!cfPairCutClone) {
+          clone->SetPairSelectionCut(nullptr);
+          cloned = false;
+          break;
+        }
+        cfPairCutClone->SetAnalysis(this);
+        clone->SetPairSelectionCut(cfPairCutClone);
+        fMixingCorrFctnPairCuts.push_back(cfPairCutClone);
+      }
+
+      // the clone copied the histograms of the original - start empty
+      TList *outputs = clone->GetOutputList();
+      TIter next(outputs);
+      while (TObject *obj = next()) {
+        if (TH1 *hist = dynamic_cast<TH1*>(obj)) {
+          hist->Reset();
+        }
+      }
+      delete outputs;
+    }
+
+    if (!cloned) {
+      for (auto &cf : *corrFctns) {
+        delete cf;
+      }
+      delete corrFctns;
+      delete pairCut;
+      break;
+    }
+
+    fMixingPairCuts.push_back(pairCut);
+    fMixingCorrFctns.push_back(corrFctns);
+  }
+
+  TH1::AddDirectory(addDirectory);
+
+  if (!cloned) {
+    cerr << " WARNING [AliFemtoSimpleAnalysis::SetupMixingThreads] "
+            "pair cut, correlation function or its pair selection cut cannot be cloned"
+            " - mixing in one thread" << endl;
+    MergeMixingThreads();
+    fMixingThreads = 0;
+    return false;
+  }
+
+  return true;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MergeMixingThreads()
+{
+  for (auto &corrFctns : fMixingCorrFctns) {
+    AliFemtoCorrFctnIterator clone = corrFctns->begin();
+    for (auto &cf : *fCorrFctnCollection) {
+      if (clone == corrFctns->end()) {
+        break;
+      }
+
+      TList *outputs = cf->GetOutputList(),
+            *cloneOutputs = (*clone)->GetOutputList();
+      TIter next(outputs),
+            nextClone(cloneOutputs);
+      while (TObject *obj = next()) {
+        TH1 *hist = dynamic_cast<TH1*>(obj),
+            *cloneHist = dynamic_cast<TH1*>(nextClone());
+        if (hist && cloneHist) {
+          hist->Add(cloneHist);
+        }
+      }
+      delete outputs;
+      delete cloneOutputs;
+
+      ++clone;
+    }
+
+    for (auto &cf : *corrFctns) {
+      delete cf;
+    }
+    delete corrFctns;
+  }
+  fMixingCorrFctns.clear();
+
+  for (auto &cut : fMixingPairCuts) {
+    delete cut;
+  }
+  fMixingPairCuts.clear();
+
+  for (auto &cut : fMixingCorrFctnPairCuts) {
+    delete cut;
+  }
+  fMixingCorrFctnPairCuts.clear();
+}
+//_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
 {
   /// Perform initialization operations at the beginning of the event processing
@@ -678,6 +962,18 @@ void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
   for (auto &cf : *fCorrFctnCollection) {
     cf->EventBegin(ev);
   }
+
+  if (fMixingThreads > 1) {
+    SetupMixingThreads();
+  }
+  for (auto &cut : fMixingPairCuts) {
+    cut->EventBegin(ev);
+  }
+  for (auto &cfs : fMixingCorrFctns) {
+    for (auto &cf : *cfs) {
+      cf->EventBegin(ev);
+    }
+  }
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventEnd(const AliFemtoEvent* ev)
@@ -691,12 +987,23 @@ void AliFemtoSimpleAnalysis::EventEnd(const AliFemtoEvent* ev)
   for (auto &cf : *fCorrFctnCollection) {
     cf->EventEnd(ev);
   }
+
+  for (auto &cut : fMixingPairCuts) {
+    cut->EventEnd(ev);
+  }
+  for (auto &cfs : fMixingCorrFctns) {
+    for (auto &cf : *cfs) {
+      cf->EventEnd(ev);
+    }
+  }
 }
 //_________________________
 void AliFemtoSimpleAnalysis::Finish()
 {
   // Perform finishing operations after all events are processed
 
+  MergeMixingThreads();
+
   for (auto &cf : *fCorrFctnCollection) {
     cf->Finish();
   }
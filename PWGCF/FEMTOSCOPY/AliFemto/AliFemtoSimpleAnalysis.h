@@ -16,6 +16,8 @@
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
 
+#include <vector>
+
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
 
@@ -99,6 +101,25 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Build and process pairs in batches (see AliFemtoPairBatch): pair
+  /// kinematics are computed for blocks of pairs at once and pair cut and
+  /// correlation functions receive whole batches. The pair kinematics are
+  /// evaluated with the same operations in the same order as in the
+  /// pair-by-pair mode; results can still differ in the last bit if the
+  /// compiler contracts the vectorized loop differently (e.g. into FMAs).
+  void SetBatchedPairs(Bool_t aBatched);
+  Bool_t BatchedPairs() const;
+
+  /// Make the mixed pairs on several threads. The stored events of the
+  /// mixing buffer are distributed over the threads, each thread using its
+  /// own clones of the pair cut and of the correlation functions. The
+  /// histograms of the clones are added to those of the correlation
+  /// functions in Finish(). Requires that the pair cut and all correlation
+  /// functions implement Clone(); otherwise mixing stays single-threaded.
+  /// Pair-cut statistics of the mixed pairs stay with the clones.
+  void SetMixingThreads(unsigned int aThreads);
+  unsigned int MixingThreads() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -159,6 +180,42 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// MakePairs with an explicit pair cut and set of correlation functions
+  void MakePairsWith(bool isReal,
+                     AliFemtoParticleCollection* ParticlesPassingCut1,
+                     AliFemtoParticleCollection* ParticlesPssingCut2,
+                     Bool_t enablePairMonitors,
+                     AliFemtoPairCut* pairCut,
+                     AliFemtoCorrFctnCollection* corrFctns);
+
+  /// Batched implementation of MakePairs - same pairs, same order
+  void MakeBatchedPairs(bool isReal,
+                        AliFemtoParticleCollection* ParticlesPassingCut1,
+                        AliFemtoParticleCollection* ParticlesPssingCut2,
+                        Bool_t enablePairMonitors,
+                        AliFemtoPairCut* pairCut,
+                        AliFemtoCorrFctnCollection* corrFctns);
+
+  /// Run the pair cut on the batch and give the passing pairs to the CFs
+  void ProcessPairBatch(bool isReal,
+                        AliFemtoPairBatch* batch,
+                        Bool_t enablePairMonitors,
+                        AliFemtoPairCut* pairCut,
+                        AliFemtoCorrFctnCollection* corrFctns);
+
+  /// Mix the particle collections with those of the events in the mixing
+  /// buffer - on fMixingThreads threads if possible
+  void MakeMixedPairs(AliFemtoParticleCollection* ParticlesPassingCut1,
+                      AliFemtoParticleCollection* ParticlesPssingCut2);
+
+  /// Create the per-thread clones of pair cut and correlation functions;
+  /// returns false if they cannot be cloned
+  bool SetupMixingThreads();
+
+  /// Add the histograms of the per-thread correlation functions to the
+  /// correlation functions of the analysis and delete the clones
+  void MergeMixingThreads();
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -177,6 +234,12 @@ protected:
   Bool_t fVerbose;
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
+  Bool_t fBatchedPairs;                              ///< make pairs in batches (MakeBatchedPairs)
+  unsigned int fMixingThreads;                       ///< number of threads making mixed pairs (<2: no threads)
+
+  std::vector<AliFemtoPairCut*> fMixingPairCuts;             //!<! pair cut clone of each mixing thread
+  std::vector<AliFemtoCorrFctnCollection*> fMixingCorrFctns; //!<! correlation function clones of each mixing thread
+  std::vector<AliFemtoPairCut*> fMixingCorrFctnPairCuts;     //!<! pair selection cut clones of the correlation function clones
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -305,4 +368,24 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetBatchedPairs(Bool_t aBatched)
+{
+  fBatchedPairs = aBatched;
+}
+
+inline Bool_t AliFemtoSimpleAnalysis::BatchedPairs() const
+{
+  return fBatchedPairs;
+}
+
+inline void AliFemtoSimpleAnalysis::SetMixingThreads(unsigned int aThreads)
+{
+  fMixingThreads = aThreads;
+}
+
+inline unsigned int AliFemtoSimpleAnalysis::MixingThreads() const
+{
+  return fMixingThreads;
+}
+
 #endif
@@ -7,6 +7,8 @@
 #pragma link off all functions;
 
 #pragma link C++ class AliDielectron+;
+#pragma link C++ class TestAliDielectronPairPool+;
+#pragma link C++ class TestAliDielectronVarContext+;
 #pragma link C++ class AliDielectronPair+;
 #pragma link C++ class AliDielectronHistos+;
 #pragma link C++ class AliDielectronCF+;
@@ -42,6 +42,8 @@ The names are available via the function PairClassName(Int_t i)
 //                                                                       //
 ///////////////////////////////////////////////////////////////////////////
 
+#include <set>
+
 #include <TString.h>
 #include <TList.h>
 #include <TMath.h>
@@ -57,17 +59,21 @@ The names are available via the function PairClassName(Int_t i)
 #include <AliVEvent.h>
 #include <AliVParticle.h>
 #include <AliVTrack.h>
+#include <AliESDtrack.h>
 #include <AliLog.h>
 #include "AliDielectronPair.h"
 #include "AliDielectronHistos.h"
 #include "AliDielectronCF.h"
 #include "AliDielectronMC.h"
 #include "AliDielectronVarManager.h"
+#include "AliDielectronVarContext.h"
 #include "AliDielectronTrackRotator.h"
 #include "AliDielectronDebugTree.h"
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronMixingHandler.h"
 #include "AliDielectronPairLegCuts.h"
+#include "AliDielectronCutGroup.h"
+#include "AliDielectronVarCuts.h"
 #include "AliDielectronV0Cuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
@@ -75,6 +81,7 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectron.h"
 
 ClassImp(AliDielectron)
+ClassImp(TestAliDielectronPairPool)
 
 const char* AliDielectron::fgkTrackClassNames[4] = {
   "ev1+",
@@ -165,7 +172,10 @@ AliDielectron::AliDielectron() :
   fTRDpidCorrectionFilename(""),
   fVZEROCalibrationFilename(""),
   fVZERORecenteringFilename(""),
-  fZDCRecenteringFilename("")
+  fZDCRecenteringFilename(""),
+  fPairPool(),
+  fPreFilterTracks(),
+  fVarContext(0x0)
 
 {
   //
@@ -242,7 +252,10 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fTRDpidCorrectionFilename(""),
   fVZEROCalibrationFilename(""),
   fVZERORecenteringFilename(""),
-  fZDCRecenteringFilename("")
+  fZDCRecenteringFilename(""),
+  fPairPool(),
+  fPreFilterTracks(),
+  fVarContext(0x0)
 {
   //
   // Named constructor
@@ -276,6 +289,7 @@ AliDielectron::~AliDielectron()
   if (fSignalsMC) delete fSignalsMC;
   if (fCfManagerPair) delete fCfManagerPair;
   if (fHistoArray) delete fHistoArray;
+  fPairPool.Delete();
 }
 
 //________________________________________________________________
@@ -339,6 +353,9 @@ void AliDielectron::Init()
     fQAmonitor->Init();
   }
 
+  //cuts and histograms added after SetVarContext
+  if (fVarContext) PropagateVarContext();
+
   if(fHistos) {
     (*fUsedVars)|= (*fHistos->GetUsedVars());
 
@@ -350,6 +367,62 @@ void AliDielectron::Init()
   }
 }
 
+//________________________________________________________________
+void AliDielectron::SetVarContext(AliDielectronVarContext * const ctx)
+{
+  //
+  // Set the variable manager context, also for the histogram manager and the cuts
+  //
+  fVarContext=ctx;
+  PropagateVarContext();
+}
+
+//________________________________________________________________
+void AliDielectron::PropagateVarContext()
+{
+  //
+  // Pass the variable manager context on to the histogram manager and the cuts,
+  // so that they use it also when they are called outside of Process
+  //
+  if (fHistos) fHistos->SetVarContext(fVarContext);
+  PropagateVarContext(fEventFilter, fVarContext);
+  PropagateVarContext(fTrackFilter, fVarContext);
+  PropagateVarContext(fPairPreFilter1, fVarContext);
+  PropagateVarContext(fPairPreFilter2, fVarContext);
+  PropagateVarContext(fPairPreFilterLegs1, fVarContext);
+  PropagateVarContext(fPairPreFilterLegs2, fVarContext);
+  PropagateVarContext(fPairFilter, fVarContext);
+  PropagateVarContext(fEventPlanePreFilter, fVarContext);
+  PropagateVarContext(fEventPlanePOIPreFilter, fVarContext);
+}
+
+//________________________________________________________________
+void AliDielectron::PropagateVarContext(AliAnalysisFilter &filter, AliDielectronVarContext * const ctx)
+{
+  //
+  // Set the context for all cuts of a filter
+  //
+  TIter next(filter.GetCuts());
+  while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(next())) PropagateVarContext(cut, ctx);
+}
+
+//________________________________________________________________
+void AliDielectron::PropagateVarContext(AliAnalysisCuts *cut, AliDielectronVarContext * const ctx)
+{
+  //
+  // Set the context for a cut, descending into cut groups and pair leg cuts
+  //
+  if (AliDielectronVarCuts *varCuts=dynamic_cast<AliDielectronVarCuts*>(cut)){
+    varCuts->SetVarContext(ctx);
+  } else if (AliDielectronCutGroup *group=dynamic_cast<AliDielectronCutGroup*>(cut)){
+    for (Int_t icut=0; icut<group->GetNCuts(); ++icut)
+      PropagateVarContext(const_cast<AliAnalysisCuts*>(group->GetCut(icut)), ctx);
+  } else if (AliDielectronPairLegCuts *legCuts=dynamic_cast<AliDielectronPairLegCuts*>(cut)){
+    PropagateVarContext(legCuts->GetLeg1Filter(), ctx);
+    PropagateVarContext(legCuts->GetLeg2Filter(), ctx);
+  }
+}
+
 //________________________________________________________________
 
 void AliDielectron::Process(TObjArray *arr)
@@ -357,6 +430,7 @@ void AliDielectron::Process(TObjArray *arr)
   //
   // Process the pair array
   //
+  AliDielectronVarContext::Scope varScope(fVarContext);
 
   // set pair arrays
   fPairCandidates = arr;
@@ -380,6 +454,7 @@ Bool_t AliDielectron::Process(AliVEvent *ev1, AliVEvent *ev2)
   //
   // Process the events
   //
+  AliDielectronVarContext::Scope varScope(fVarContext);
 
   //at least first event is needed!
   if (!ev1){
@@ -1402,21 +1477,33 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   // select pairs and fill pair candidate arrays
   //
 
-  TObjArray arrTracks1=fTracks[arr1];
-  TObjArray arrTracks2=fTracks[arr2];
+  //the pre filters remove tracks from the arrays they get, so they have to work on copies;
+  //without pre filter the track arrays are used directly
+  TObjArray *arrTracks1=&fTracks[arr1];
+  TObjArray *arrTracks2=&fTracks[arr2];
+  Bool_t preFilter1=(!fPreFilterAllSigns1) && (!fPreFilterUnlikeOnly1) && (!fPreFilterLikeOnly1) && ( fPairPreFilter1.GetCuts()->GetEntries()>0 );
+  Bool_t preFilter2=(!fPreFilterAllSigns2) && (!fPreFilterUnlikeOnly2) && (!fPreFilterLikeOnly2) && ( fPairPreFilter2.GetCuts()->GetEntries()>0 );
+  if (preFilter1 || preFilter2) {
+    fPreFilterTracks[0]=fTracks[arr1];
+    fPreFilterTracks[1]=fTracks[arr2];
+    arrTracks1=&fPreFilterTracks[0];
+    arrTracks2=&fPreFilterTracks[1];
+  }
 
   //process pre filter if set
-  if ((!fPreFilterAllSigns1) && (!fPreFilterUnlikeOnly1) && (!fPreFilterLikeOnly1) && ( fPairPreFilter1.GetCuts()->GetEntries()>0 ))  PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 1);
+  if (preFilter1)  PairPreFilter(arr1, arr2, *arrTracks1, *arrTracks2, ev, 1);
 
-  if ((!fPreFilterAllSigns2) && (!fPreFilterUnlikeOnly2) && (!fPreFilterLikeOnly2) && ( fPairPreFilter2.GetCuts()->GetEntries()>0 ))  PairPreFilter(arr1, arr2, arrTracks1, arrTracks2, ev, 2);
+  if (preFilter2)  PairPreFilter(arr1, arr2, *arrTracks1, *arrTracks2, ev, 2);
 
   Int_t pairIndex=GetPairIndex(arr1,arr2);
 
-  Int_t ntrack1=arrTracks1.GetEntriesFast();
-  Int_t ntrack2=arrTracks2.GetEntriesFast();
+  Int_t ntrack1=arrTracks1->GetEntriesFast();
+  Int_t ntrack2=arrTracks2->GetEntriesFast();
 
-  AliDielectronPair *candidate=new AliDielectronPair;
-  candidate->SetKFUsage(fUseKF);
+  //without MC event the mother label lookups always give -1
+  Bool_t hasMC=(AliDielectronMC::Instance()->GetMCEvent()!=0x0);
+
+  AliDielectronPair *candidate=NewPairCandidate();
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
@@ -1425,21 +1512,24 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
     if (arr1==arr2) end=itrack1;
     for (Int_t itrack2=0; itrack2<end; ++itrack2){
       //create the pair (direct pointer to the memory by this daughter reference are kept also for ME)
-      candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1))), fPdgLeg1,
-                           &(*static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2))), fPdgLeg2);
+      candidate->SetTracks(&(*static_cast<AliVTrack*>(arrTracks1->UncheckedAt(itrack1))), fPdgLeg1,
+                           &(*static_cast<AliVTrack*>(arrTracks2->UncheckedAt(itrack2))), fPdgLeg2);
       candidate->SetType(pairIndex);
 
-      Int_t label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,fPdgMother);
+      Int_t label=-1;
+      if (hasMC) label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,fPdgMother);
       candidate->SetLabel(label);
       if (label>-1) candidate->SetPdgCode(fPdgMother);
       else candidate->SetPdgCode(0);
 
       // check for gamma kf particle
-      label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,22);
-      if (label>-1 && fUseGammaTracks) {
-        candidate->SetGammaTracks(static_cast<AliVTrack*>(arrTracks1.UncheckedAt(itrack1)), fPdgLeg1,
-                                  static_cast<AliVTrack*>(arrTracks2.UncheckedAt(itrack2)), fPdgLeg2);
-      // should we set the pdgmothercode and the label
+      if (hasMC && fUseGammaTracks) {
+        label=AliDielectronMC::Instance()->GetLabelMotherWithPdg(candidate,22);
+        if (label>-1) {
+          candidate->SetGammaTracks(static_cast<AliVTrack*>(arrTracks1->UncheckedAt(itrack1)), fPdgLeg1,
+                                    static_cast<AliVTrack*>(arrTracks2->UncheckedAt(itrack2)), fPdgLeg2);
+        // should we set the pdgmothercode and the label
+        }
       }
 
       //pair cuts
@@ -1463,12 +1553,50 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       //add the candidate to the candidate array
       PairArray(pairIndex)->Add(candidate);
       //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+      candidate=NewPairCandidate();
     }
   }
-  //delete the surplus candidate
-  delete candidate;
+  //keep the surplus candidate for the next call
+  fPairPool.Add(candidate);
+}
+
+//________________________________________________________________
+void AliDielectron::ClearArrays()
+{
+  //
+  // Reset the Arrays
+  //
+  for (Int_t i=0;i<4;++i){
+    fTracks[i].Clear();
+  }
+  for (Int_t i=0;i<11;++i){
+    TObjArray *arr=PairArray(i);
+    if (!arr) continue;
+    //keep the pair objects for reuse in the next event
+    // the arrays own their objects: take them out before the array is cleared,
+    // otherwise the pooled pairs would be deleted and the others deleted twice
+    Int_t npairs=arr->GetEntriesFast();
+    for (Int_t ipair=0; ipair<npairs; ++ipair){
+      TObject *pair=arr->RemoveAt(ipair);
+      if (!pair) continue;
+      if (pair->IsA()==AliDielectronPair::Class()) fPairPool.Add(pair);
+      else delete pair;
+    }
+    arr->Clear();
+  }
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::NewPairCandidate()
+{
+  //
+  // get a pair candidate object, recycled from the pool if possible
+  //
+  AliDielectronPair *candidate=0x0;
+  if (fPairPool.GetEntriesFast()>0) candidate=static_cast<AliDielectronPair*>(fPairPool.RemoveLast());
+  else candidate=new AliDielectronPair;
+  candidate->SetKFUsage(fUseKF);
+  return candidate;
 }
 
 //________________________________________________________________
@@ -2136,6 +2264,7 @@ void AliDielectron::FillHistogramsFromPairArray(Bool_t pairInfoOnly/*=kFALSE*/)
   //
   // Fill Histogram information for tracks and pairs
   //
+  AliDielectronVarContext::Scope varScope(fVarContext);
 
   TString  className,className2;
   Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
@@ -2220,3 +2349,114 @@ void AliDielectron::FinishEvtVsTrkHistoClass()
 {
   if(fEvtVsTrkHist) fEvtVsTrkHist->CalculateMatchingEfficiency();
 }
+
+//______________________________________________
+Bool_t TestAliDielectronPairPool::RunAllTests() const
+{
+  //
+  // run all tests
+  //
+  return TestEvents();
+}
+
+//______________________________________________
+Bool_t TestAliDielectronPairPool::TestEvents() const
+{
+  //
+  // events with more, then fewer pairs than the pool holds from the previous event
+  //
+  AliKFParticle::SetField(5.);
+
+  TObjArray tracks;
+  tracks.SetOwner();
+  AliDielectron die("testPairPool","pair candidate pool");
+
+  const Int_t nevents=3;
+  const Int_t npos[nevents]={3,5,2};
+  const Int_t nneg[nevents]={3,4,2};
+  Bool_t result=kTRUE;
+  for (Int_t ievent=0; ievent<nevents; ++ievent){
+    FillEvent(die, tracks, npos[ievent], nneg[ievent], ievent);
+    if (!CheckEvent(die, tracks, npos[ievent], nneg[ievent], ievent)) result=kFALSE;
+  }
+  //the pooled pairs are deleted by the destructor of die
+  return result;
+}
+
+//______________________________________________
+void TestAliDielectronPairPool::FillEvent(AliDielectron &die, TObjArray &tracks, Int_t npos, Int_t nneg, Int_t ievent) const
+{
+  //
+  // same sequence as in AliDielectron::Process: recycle the pairs of the previous
+  // event, then pair the new tracks
+  //
+  if (!die.PairArray(0)) die.InitPairCandidateArrays();
+  else die.ClearArrays();
+  tracks.Delete();
+
+  Double_t x[3]={0.,0.,0.};
+  Double_t cov[21]={0.};
+  cov[0]=cov[2]=cov[5]=cov[9]=cov[14]=cov[20]=1e-4;
+  for (Int_t itrack=0; itrack<npos+nneg; ++itrack){
+    Short_t charge=(itrack<npos)?1:-1;
+    Double_t p[3]={0.5+0.1*itrack+0.05*ievent, 0.3-0.07*itrack, 0.2*charge};
+    AliESDtrack *track=new AliESDtrack;
+    track->Set(x, p, cov, charge);
+    tracks.Add(track);
+    die.fTracks[(charge>0)?AliDielectron::kEv1P:AliDielectron::kEv1M].Add(track);
+  }
+
+  die.FillPairArrays(AliDielectron::kEv1P, AliDielectron::kEv1M);
+  die.FillPairArrays(AliDielectron::kEv1P, AliDielectron::kEv1P);
+  die.FillPairArrays(AliDielectron::kEv1M, AliDielectron::kEv1M);
+
+  //an object which is not recycled, it has to be deleted exactly once by ClearArrays
+  die.PairArray(AliDielectron::kEv1PMRot)->Add(new TNamed("rotated","not a pair"));
+}
+
+//______________________________________________
+Bool_t TestAliDielectronPairPool::CheckEvent(AliDielectron &die, const TObjArray &tracks, Int_t npos, Int_t nneg, Int_t ievent) const
+{
+  //
+  // every pair of the event has to be present once, with the legs of the current event,
+  // and no object may be in the pair arrays and in the pool at the same time
+  //
+  Bool_t result=kTRUE;
+  const Int_t pairIndex[3]={AliDielectron::kEv1PM, AliDielectron::kEv1PP, AliDielectron::kEv1MM};
+  const Int_t expected[3]={npos*nneg, npos*(npos-1)/2, nneg*(nneg-1)/2};
+  for (Int_t i=0; i<3; ++i){
+    TObjArray *arr=die.PairArray(pairIndex[i]);
+    if (arr->GetEntriesFast()!=expected[i]){
+      printf("Event %d: %d pairs of type %s, expected %d\n", ievent, arr->GetEntriesFast(),
+             AliDielectron::PairClassName(pairIndex[i]), expected[i]);
+      result=kFALSE;
+    }
+    for (Int_t ipair=0; ipair<arr->GetEntriesFast(); ++ipair){
+      AliDielectronPair *pair=static_cast<AliDielectronPair*>(arr->UncheckedAt(ipair));
+      if (pair->GetType()!=pairIndex[i] ||
+          tracks.IndexOf(pair->GetFirstDaughterP())<0 || tracks.IndexOf(pair->GetSecondDaughterP())<0){
+        printf("Event %d: pair %d of type %s is not a pair of this event\n", ievent, ipair,
+               AliDielectron::PairClassName(pairIndex[i]));
+        result=kFALSE;
+      }
+    }
+  }
+
+  std::set<const TObject*> objects;
+  for (Int_t i=0; i<11; ++i){
+    TObjArray *arr=die.PairArray(i);
+    for (Int_t ipair=0; ipair<arr->GetEntriesFast(); ++ipair){
+      if (!objects.insert(arr->UncheckedAt(ipair)).second){
+        printf("Event %d: pair object handed out twice\n", ievent);
+        result=kFALSE;
+      }
+    }
+  }
+  for (Int_t ipool=0; ipool<die.fPairPool.GetEntriesFast(); ++ipool){
+    if (!objects.insert(die.fPairPool.UncheckedAt(ipool)).second){
+      printf("Event %d: pooled pair object also in use\n", ievent);
+      result=kFALSE;
+    }
+  }
+  return result;
+}
@@ -39,11 +39,13 @@ class AliDielectronTrackRotator;
 class AliDielectronPair;
 class AliDielectronSignalMC;
 class AliDielectronMixingHandler;
+class AliDielectronVarContext;
 
 //________________________________________________________________
 class AliDielectron : public TNamed {
 
   friend class AliDielectronMixingHandler; //mixing as friend class
+  friend class TestAliDielectronPairPool;  //unit test of the pair candidate pool
 
 public:
   enum EPairType { kEv1PP=0, kEv1PM, kEv1MM,
@@ -100,6 +102,8 @@ public:
   const TObjArray * GetQAHistArray() const { return fQAmonitor?fQAmonitor->GetQAHistArray():0x0; }
 
   void SetHistogramManager(AliDielectronHistos * const histos) { fHistos=histos; }
+  void SetVarContext(AliDielectronVarContext * const ctx);
+  AliDielectronVarContext* GetVarContext() const { return fVarContext; }
   AliDielectronHistos* GetHistoManager() const { return fHistos; }
   const THashList * GetHistogramList() const { return fHistos?fHistos->GetHistogramList():0x0; }
 
@@ -279,12 +283,17 @@ private:
   void PairPreFilter(Int_t arr1, Int_t arr2, TObjArray &arrTracks1, TObjArray &arrTracks2, const AliVEvent *ev, Int_t prefilterN);
   void FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev = 0x0);
   void FillPairArrayTR();
+  AliDielectronPair* NewPairCandidate();
 
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
 
   void InitPairCandidateArrays();
   void ClearArrays();
 
+  void PropagateVarContext();
+  static void PropagateVarContext(AliAnalysisFilter &filter, AliDielectronVarContext * const ctx);
+  static void PropagateVarContext(AliAnalysisCuts *cut, AliDielectronVarContext * const ctx);
+
   TObjArray* PairArray(Int_t i);
   TObject* InitEffMap(TString filename, TString generatedname, TString foundname);
 
@@ -298,6 +307,11 @@ private:
   TString fVZERORecenteringFilename;         // file containing VZERO Q-vector recentering averages
   TString fZDCRecenteringFilename;         // file containing ZDCQ-vector recentering averages
 
+  TObjArray fPairPool;            //! pair candidates recycled from previous events, see NewPairCandidate()
+  TObjArray fPreFilterTracks[2];  //! track arrays modified by the pair pre filters in FillPairArrays()
+
+  AliDielectronVarContext *fVarContext; //! variable manager context used while processing (not owned, 0x0: current context)
+
   void ProcessMC(AliVEvent *ev1);
 
   void  FillHistograms(const AliVEvent *ev, Bool_t pairInfoOnly=kFALSE);
@@ -336,17 +350,27 @@ inline TObjArray* AliDielectron::PairArray(Int_t i)
   return static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i));
 }
 
-inline void AliDielectron::ClearArrays()
-{
-  //
-  // Reset the Arrays
-  //
-  for (Int_t i=0;i<4;++i){
-    fTracks[i].Clear();
-  }
-  for (Int_t i=0;i<11;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
-  }
-}
+//________________________________________________________________
+//
+// TestAliDielectronPairPool: unit test of the pair candidate pool.
+// Several events are run through FillPairArrays with the pool active,
+// checking that recycled pairs are neither deleted nor handed out twice,
+// see test/TestAliDielectronPairPool.C
+//
+class TestAliDielectronPairPool : public TObject {
+
+public:
+  TestAliDielectronPairPool() : TObject() {}
+  virtual ~TestAliDielectronPairPool() {}
+
+  Bool_t RunAllTests() const;
+  Bool_t TestEvents() const;
+
+private:
+  void FillEvent(AliDielectron &die, TObjArray &tracks, Int_t npos, Int_t nneg, Int_t ievent) const;
+  Bool_t CheckEvent(AliDielectron &die, const TObjArray &tracks, Int_t npos, Int_t nneg, Int_t ievent) const;
+
+  ClassDef(TestAliDielectronPairPool, 0); // unit test of the pair candidate pool
+};
 
 #endif
@@ -50,6 +50,7 @@
 
 #include "AliDielectronHelper.h"
 #include "AliDielectronVarManager.h"
+#include "AliDielectronVarContext.h"
 #include "AliDielectronHistos.h"
 
 ClassImp(AliDielectronHistos)
@@ -61,7 +62,8 @@ AliDielectronHistos::AliDielectronHistos() :
   fHistoList(),
   fList(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
-  fReservedWords(new TString)
+  fReservedWords(new TString),
+  fVarContext(0x0)
 {
   //
   // Default constructor
@@ -77,7 +79,8 @@ AliDielectronHistos::AliDielectronHistos(const char* name, const char* title) :
   fHistoList(),
   fList(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
-  fReservedWords(new TString)
+  fReservedWords(new TString),
+  fVarContext(0x0)
 {
   //
   // TNamed constructor
@@ -720,6 +723,21 @@ void AliDielectronHistos::FillClass(const char* histClass, Int_t nValues, const
   return;
 }
 
+//_____________________________________________________________________________
+void AliDielectronHistos::FillClass(const char* histClass, const TObject *object)
+{
+  //
+  // Fill class 'histClass' with the variables of 'object'
+  // the variables are filled in the variable context of this manager (if set)
+  //
+  AliDielectronVarContext::Scope varScope(fVarContext);
+
+  Double_t values[AliDielectronVarManager::kNMaxValues]={0.};
+  AliDielectronVarManager::SetFillMap(fUsedVars);
+  AliDielectronVarManager::Fill(object,values);
+  FillClass(histClass, AliDielectronVarManager::kNMaxValues, values);
+}
+
 //_____________________________________________________________________________
 // void AliDielectronHistos::FillClass(const char* histClass, const TVectorD &vals)
 // {
@@ -26,6 +26,7 @@
 class TH1;
 class TString;
 class TList;
+class AliDielectronVarContext;
 // class TVectorT<double>;
 
 class AliDielectronHistos : public TNamed {
@@ -145,6 +146,7 @@ public:
   
 //   void FillClass(const char* histClass, const TVectorD &vals);
   void FillClass(const char* histClass, Int_t nValues, const Double_t *values);
+  void FillClass(const char* histClass, const TObject *object);
   
   TObject* GetHist(const char* histClass, const char* name) const;
   TH1* GetHistogram(const char* histClass, const char* name) const;
@@ -159,6 +161,9 @@ public:
   TList *GetList() const { return fList; }
 	TBits *GetUsedVars() const { return fUsedVars; }
 
+  void SetVarContext(AliDielectronVarContext * const ctx) { fVarContext=ctx; }
+  AliDielectronVarContext* GetVarContext() const { return fVarContext; }
+
   void AddClass(const char* histClass);
 
   void DumpToFile(const char* file="histos.root");
@@ -196,6 +201,7 @@ private:
 	TBits     *fUsedVars;            // list of used variables
 
   TString *fReservedWords;          //! list of reserved words
+  AliDielectronVarContext *fVarContext; //! variable manager context for FillClass(histClass,object), not owned
   void UserHistogramReservedWords(const char* histClass, const TObject *hist, UInt_t valTypes);
   void FillClass(THashTable *classTable, Int_t nValues, Double_t *values);
   
@@ -0,0 +1,241 @@
+/*************************************************************************
+* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////
+//                Dielectron variable context                            //
+//                                                                       //
+/*
+Per-instance state of AliDielectronVarManager: the current event, its KF
+vertex and TPC event plane, the event data array, the variable fill map,
+the efficiency maps and the VZERO / ZDC calibration histograms, which are
+loaded for the run of the current event. The static AliDielectronVarManager functions work
+on the context which is current on the calling thread; by default this is
+one process-wide context, so code using only the static interface behaves
+as before.
+
+An AliDielectron (and the AliDielectronVarCuts / AliDielectronHistos it
+uses) can carry its own context, which is installed for the duration of
+its calls with AliDielectronVarContext::Scope. Instances with different
+contexts do not overwrite each others event data and can be processed on
+different threads.
+
+Configuration which is the same for all instances stays static in
+AliDielectronVarManager and has to be set up before processing: the PID
+response, the estimator / TRD calibration objects, the names of the VZERO /
+ZDC calibration files and the Qn vector normalisation.
+*/
+//                                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+
+#include <TBits.h>
+#include <TNamed.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <AliAODEvent.h>
+#include <AliESDtrack.h>
+#include <AliKFParticle.h>
+#include <AliKFVertex.h>
+
+#include "AliDielectronVarManager.h"
+#include "AliDielectronVarContext.h"
+
+ClassImp(TestAliDielectronVarContext)
+
+//______________________________________________
+AliDielectronVarContext::Scope::Scope(AliDielectronVarContext *ctx) :
+  fPrevious(0x0),
+  fInstalled(kFALSE)
+{
+  //
+  // Make ctx the current context of this thread
+  //
+  if (!ctx) return;
+  fPrevious=AliDielectronVarManager::SetContext(ctx);
+  fInstalled=kTRUE;
+}
+
+//______________________________________________
+AliDielectronVarContext::Scope::~Scope()
+{
+  //
+  // Restore the previous context
+  //
+  if (fInstalled) AliDielectronVarManager::SetContext(fPrevious);
+}
+
+//______________________________________________
+AliDielectronVarContext::AliDielectronVarContext() :
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fLegEffMap(0x0),
+  fPairEffMap(0x0),
+  fFillMap(0x0),
+  fQnEPacRemoval(0x0),
+  fEventPlaneACremoval(kFALSE),
+  fData(new Double_t[AliDielectronVarManager::kNMaxValues]),
+  fCurrentRun(-1)
+{
+  //
+  // Default constructor
+  //
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues; ++i) fData[i]=0.;
+  for (Int_t i=0; i<64; ++i) fVZEROCalib[i]=0x0;
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) fVZERORecentering[i][j]=0x0;
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) fZDCRecentering[i][j]=0x0;
+}
+
+//______________________________________________
+AliDielectronVarContext::~AliDielectronVarContext()
+{
+  //
+  // Destructor
+  //
+  delete fKFVertex;
+  delete [] fData;
+  for (Int_t i=0; i<64; ++i) delete fVZEROCalib[i];
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) delete fVZERORecentering[i][j];
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) delete fZDCRecentering[i][j];
+}
+
+//______________________________________________
+void AliDielectronVarContext::Fill(const TObject* particle, Double_t * const values)
+{
+  //
+  // Fill the variables of particle using this context
+  //
+  Scope scope(this);
+  AliDielectronVarManager::Fill(particle,values);
+}
+
+//______________________________________________
+void AliDielectronVarContext::SetEvent(AliVEvent * const ev)
+{
+  //
+  // Set the current event of this context and fill its event data
+  //
+  Scope scope(this);
+  AliDielectronVarManager::SetEvent(ev);
+}
+
+//______________________________________________
+void AliDielectronVarContext::SetTPCEventPlane(AliEventplane *const evplane)
+{
+  //
+  // Set the TPC event plane of this context
+  //
+  Scope scope(this);
+  AliDielectronVarManager::SetTPCEventPlane(evplane);
+}
+
+//______________________________________________
+Bool_t TestAliDielectronVarContext::RunAllTests() const
+{
+  //
+  // run all tests
+  //
+  return TestThreads();
+}
+
+//______________________________________________
+Bool_t TestAliDielectronVarContext::TestThreads() const
+{
+  //
+  // two threads with their own contexts, while the main thread keeps the default context
+  //
+  AliKFParticle::SetField(5.);
+
+  TBits mainFillMap, fillMap[2];
+  TNamed mainEffMap("mainEffMap","efficiency map of the default context");
+  TNamed effMap[2]={TNamed("effMap0","efficiency map of context 0"), TNamed("effMap1","efficiency map of context 1")};
+  AliAODEvent events[2];
+  AliDielectronVarContext contexts[2];
+
+  AliDielectronVarContext *defaultContext=AliDielectronVarManager::GetContext();
+  AliVEvent *mainEvent=AliDielectronVarManager::GetCurrentEvent();
+  AliDielectronVarManager::SetFillMap(&mainFillMap);
+  AliDielectronVarManager::SetLegEffMap(&mainEffMap);
+
+  Bool_t result[2]={kFALSE,kFALSE};
+  std::thread threads[2];
+  for (Int_t ithread=0; ithread<2; ++ithread){
+    threads[ithread]=std::thread([&, ithread](){
+      result[ithread]=RunThread(&contexts[ithread], &events[ithread], &fillMap[ithread], &effMap[ithread], ithread);
+    });
+  }
+  for (Int_t ithread=0; ithread<2; ++ithread) threads[ithread].join();
+
+  Bool_t ok=result[0] && result[1];
+  AliDielectronVarContext *ctx=AliDielectronVarManager::GetContext();
+  if (ctx!=defaultContext || ctx->fFillMap!=&mainFillMap || ctx->fLegEffMap!=&mainEffMap ||
+      AliDielectronVarManager::GetCurrentEvent()!=mainEvent){
+    printf("The default context was changed by the threads\n");
+    ok=kFALSE;
+  }
+  AliDielectronVarManager::SetFillMap(0x0);
+  AliDielectronVarManager::SetLegEffMap(0x0);
+  return ok;
+}
+
+//______________________________________________
+Bool_t TestAliDielectronVarContext::RunThread(AliDielectronVarContext *ctx, AliVEvent *ev, TBits *fillMap, TObject *effMap, Int_t ithread) const
+{
+  //
+  // install ctx on this thread, then set and read back its state in every iteration
+  //
+  AliDielectronVarContext::Scope scope(ctx);
+
+  Double_t x[3]={0.,0.,0.};
+  Double_t p[3]={0.5+ithread, 0.3, 0.2};
+  Double_t cov[21]={0.};
+  cov[0]=cov[2]=cov[5]=cov[9]=cov[14]=cov[20]=1e-4;
+  AliESDtrack track;
+  track.Set(x, p, cov, 1);
+  AliKFParticle particle(track, 11);
+
+  Double_t data[AliDielectronVarManager::kNMaxValues];
+  Double_t values[AliDielectronVarManager::kNMaxValues];
+  const Int_t niterations=10000;
+  for (Int_t iter=0; iter<niterations; ++iter){
+    // the event is set directly, AliDielectronVarManager::SetEvent would fill the event data from it
+    ctx->fEvent=ev;
+    AliDielectronVarManager::SetFillMap(fillMap);
+    AliDielectronVarManager::SetLegEffMap(effMap);
+    AliDielectronVarManager::SetPairEffMap(effMap);
+    for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues; ++i) data[i]=1000.*ithread+iter+1e-3*i;
+    AliDielectronVarManager::SetEventData(data);
+
+    AliDielectronVarManager::Fill(&particle, values);
+    for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i){
+      if (values[i]!=data[i] || AliDielectronVarManager::GetValue((AliDielectronVarManager::ValueTypes)i)!=data[i]){
+        printf("Thread %d, iteration %d: event data of variable %d is %f, expected %f\n", ithread, iter, i, values[i], data[i]);
+        return kFALSE;
+      }
+    }
+    if (AliDielectronVarManager::GetContext()!=ctx || AliDielectronVarManager::GetCurrentEvent()!=ev ||
+        ctx->fFillMap!=fillMap || ctx->fLegEffMap!=effMap || ctx->fPairEffMap!=effMap){
+      printf("Thread %d, iteration %d: context, event or maps of another thread\n", ithread, iter);
+      return kFALSE;
+    }
+  }
+  return kTRUE;
+}
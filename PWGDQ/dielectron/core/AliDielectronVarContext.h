@@ -0,0 +1,107 @@
+#ifndef ALIDIELECTRONVARCONTEXT_H
+#define ALIDIELECTRONVARCONTEXT_H
+
+/* Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//#############################################################
+//#                                                           #
+//#         Class AliDielectronVarContext                     #
+//#         Per-instance state of AliDielectronVarManager     #
+//#                                                           #
+//#############################################################
+
+#include <TObject.h>
+
+class TBits;
+class TProfile2D;
+class TProfile3D;
+class AliVEvent;
+class AliEventplane;
+class AliKFVertex;
+class AliDielectronQnEPcorrection;
+
+class AliDielectronVarContext {
+public:
+  //
+  // Installs a context as the current one of AliDielectronVarManager on
+  // this thread for the lifetime of the scope object and restores the
+  // previous one afterwards. A null context leaves the current one active.
+  //
+  class Scope {
+  public:
+    explicit Scope(AliDielectronVarContext *ctx);
+    ~Scope();
+  private:
+    Scope(const Scope &s);
+    Scope &operator=(const Scope &s);
+
+    AliDielectronVarContext *fPrevious;  // context active before the scope
+    Bool_t                   fInstalled; // whether the scope changed the context
+  };
+
+  AliDielectronVarContext();
+  virtual ~AliDielectronVarContext();
+
+  void Fill(const TObject* particle, Double_t * const values);
+
+  void SetEvent(AliVEvent * const ev);
+  void SetTPCEventPlane(AliEventplane *const evplane);
+  void SetFillMap(   TBits   *map) { fFillMap=map; }
+  void SetLegEffMap( TObject *map) { fLegEffMap=map; }
+  void SetPairEffMap(TObject *map) { fPairEffMap=map; }
+
+  AliVEvent*         GetCurrentEvent() const { return fEvent; }
+  const AliKFVertex* GetKFVertex()     const { return fKFVertex; }
+  const Double_t*    GetData()         const { return fData; }
+  Double_t GetValue(Int_t var) const           { return fData[var]; }
+  void     SetValue(Int_t var, Double_t val)   { fData[var]=val; }
+
+private:
+  friend class AliDielectronVarManager;
+  friend class TestAliDielectronVarContext;  //unit test of the per-thread contexts
+
+  AliDielectronVarContext(const AliDielectronVarContext &c);
+  AliDielectronVarContext &operator=(const AliDielectronVarContext &c);
+
+  AliVEvent       *fEvent;              // current event pointer
+  AliEventplane   *fTPCEventPlane;      // current event tpc plane pointer
+  AliKFVertex     *fKFVertex;           // kf vertex of the current event (owned)
+  TObject         *fLegEffMap;          // single electron efficiencies
+  TObject         *fPairEffMap;         // pair efficiencies
+  TBits           *fFillMap;            // map for requested variable filling
+  AliDielectronQnEPcorrection *fQnEPacRemoval; // filter for auto correlation removal within Qn Framework
+  Bool_t           fEventPlaneACremoval; // whether the auto correlation removal is active
+  Double_t        *fData;               // event data, AliDielectronVarManager::kNMaxValues entries
+
+  Int_t            fCurrentRun;               // run the calibration histograms were loaded for
+  TProfile2D      *fVZEROCalib[64];           // 1 histogram per VZERO channel (owned)
+  TProfile2D      *fVZERORecentering[2][2];   // 2 VZERO sides x 2 Q-vector components (owned)
+  TProfile3D      *fZDCRecentering[3][2];     // ZDC A, C, A+C x 2 Q-vector components (owned)
+};
+
+//________________________________________________________________
+//
+// TestAliDielectronVarContext: unit test of the per-thread contexts.
+// Two threads each install their own context and repeatedly set and read
+// back the event, the event data and the fill / efficiency maps through
+// the static AliDielectronVarManager interface; neither thread may see the
+// state of the other one, nor may the default context change,
+// see test/TestAliDielectronVarContext.C
+//
+class TestAliDielectronVarContext : public TObject {
+
+public:
+  TestAliDielectronVarContext() : TObject() {}
+  virtual ~TestAliDielectronVarContext() {}
+
+  Bool_t RunAllTests() const;
+  Bool_t TestThreads() const;
+
+private:
+  Bool_t RunThread(AliDielectronVarContext *ctx, AliVEvent *ev, TBits *fillMap, TObject *effMap, Int_t ithread) const;
+
+  ClassDef(TestAliDielectronVarContext, 0); // unit test of the per-thread contexts
+};
+
+#endif
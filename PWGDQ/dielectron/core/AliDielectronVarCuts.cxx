@@ -33,6 +33,7 @@
 
 #include "AliDielectronVarCuts.h"
 #include "AliDielectronMC.h"
+#include "AliDielectronVarContext.h"
 
 ClassImp(AliDielectronVarCuts)
 
@@ -44,7 +45,8 @@ AliDielectronVarCuts::AliDielectronVarCuts() :
   fActiveCutsMask(0),
   fSelectedCutsMask(0),
   fCutOnMCtruth(kFALSE),
-  fCutType(kAll)
+  fCutType(kAll),
+  fVarContext(0x0)
 {
   //
   // Default costructor
@@ -68,7 +70,8 @@ AliDielectronVarCuts::AliDielectronVarCuts(const char* name, const char* title)
   fActiveCutsMask(0),
   fSelectedCutsMask(0),
   fCutOnMCtruth(kFALSE),
-  fCutType(kAll)
+  fCutType(kAll),
+  fVarContext(0x0)
 {
   //
   // Named contructor
@@ -114,6 +117,7 @@ Bool_t AliDielectronVarCuts::IsSelected(TObject* track)
   }
 
   //Fill values
+  AliDielectronVarContext::Scope varScope(fVarContext);
   Double_t values[AliDielectronVarManager::kNMaxValues];
   AliDielectronVarManager::SetFillMap(fUsedVars);
   AliDielectronVarManager::Fill(track,values);
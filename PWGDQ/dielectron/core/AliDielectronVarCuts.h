@@ -28,6 +28,7 @@
 #include "AliDielectronVarManager.h"
 
 class THnBase;
+class AliDielectronVarContext;
 class AliDielectronVarCuts : public AliAnalysisCuts {
 public:
   // Whether all cut criteria have to be fulfilled of just any
@@ -53,10 +54,12 @@ public:
   // setters
   void    SetCutOnMCtruth(Bool_t mc=kTRUE) { fCutOnMCtruth=mc; }
   void    SetCutType(CutType type)         { fCutType=type;    }
+  void    SetVarContext(AliDielectronVarContext * const ctx) { fVarContext=ctx; }
 
   // getters
   Bool_t  GetCutOnMCtruth() const { return fCutOnMCtruth; }
   CutType GetCutType()      const { return fCutType;      }
+  AliDielectronVarContext* GetVarContext() const { return fVarContext; }
 
   Int_t GetNCuts() { return fNActiveCuts; }
 
@@ -99,6 +102,7 @@ public:
   Bool_t fBitCut[AliDielectronVarManager::kNMaxValues];             // bit cut
   THnBase  *fUpperCut[AliDielectronVarManager::kNMaxValues];        // use object as upper cut
   EVarCutsOperation fVarOperation[AliDielectronVarManager::kNMaxValues]; // operation between two vars, attention in principle kNMaxValues could be exceeded by the cut logic use with care
+  AliDielectronVarContext *fVarContext;       //! variable manager context used in IsSelected, not owned
 
   AliDielectronVarCuts(const AliDielectronVarCuts &c);
   AliDielectronVarCuts &operator=(const AliDielectronVarCuts &c);
@@ -653,26 +653,17 @@ const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::k
 };
 
 AliPIDResponse* AliDielectronVarManager::fgPIDResponse      = 0x0;
-AliVEvent*      AliDielectronVarManager::fgEvent            = 0x0;
-AliEventplane*  AliDielectronVarManager::fgTPCEventPlane    = 0x0;
-AliKFVertex*    AliDielectronVarManager::fgKFVertex         = 0x0;
 TProfile*       AliDielectronVarManager::fgMultEstimatorAvg[7][9] = {{0x0}};
 TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
-TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
-TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
-TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
 TString         AliDielectronVarManager::fgZDCRecenteringFile = "";
-TProfile2D*     AliDielectronVarManager::fgVZEROCalib[64] = {0x0};
-TProfile2D*     AliDielectronVarManager::fgVZERORecentering[2][2] = {{0x0,0x0},{0x0,0x0}};
-TProfile3D*     AliDielectronVarManager::fgZDCRecentering[3][2] = {{0x0,0x0},{0x0,0x0},{0x0,0x0}};
-AliDielectronQnEPcorrection* AliDielectronVarManager::fgQnEPacRemoval = 0x0;
-Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
 TString         AliDielectronVarManager::fgQnVectorNorm = "";
-Int_t           AliDielectronVarManager::fgCurrentRun = -1;
-Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
+
+// context used by all threads which did not install their own one
+static AliDielectronVarContext gDefaultVarContext;
+TTHREAD_TLS(AliDielectronVarContext*) AliDielectronVarManager::fgContext = &gDefaultVarContext;
 //________________________________________________________________
 AliDielectronVarManager::AliDielectronVarManager() :
   TNamed("AliDielectronVarManager","AliDielectronVarManager")
@@ -686,12 +677,6 @@ AliDielectronVarManager::AliDielectronVarManager() :
   for(Int_t i=0; i<10; ++i)
     for(Int_t j=0; j<4; ++j)
       fgTRDpidEff[i][j] = 0x0;
-  for(Int_t i=0; i<64; ++i) fgVZEROCalib[i] = 0x0;
-  for(Int_t i=0; i<2; ++i) {
-    for(Int_t j=0; j<2; ++j) fgVZERORecentering[i][j] = 0x0;
-  }
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j) fgZDCRecentering[i][j] = 0x0;
 
   gRandom->SetSeed();
 }
@@ -709,13 +694,6 @@ AliDielectronVarManager::AliDielectronVarManager(const char* name, const char* t
   for(Int_t i=0; i<10; ++i)
     for(Int_t j=0; j<4; ++j)
       fgTRDpidEff[i][j] = 0x0;
-  for(Int_t i=0; i<64; ++i) fgVZEROCalib[i] = 0x0;
-  for(Int_t i=0; i<2; ++i)
-    for(Int_t j=0; j<2; ++j)
-      fgVZERORecentering[i][j] = 0x0;
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j) fgZDCRecentering[i][j] = 0x0;
-
 
   gRandom->SetSeed();
 }
@@ -732,14 +710,6 @@ AliDielectronVarManager::~AliDielectronVarManager()
   for(Int_t i=0; i<10; ++i)
     for(Int_t j=0; j<4; ++j)
       if(fgTRDpidEff[i][j]) delete fgTRDpidEff[i][j];
-  for(Int_t i=0; i<64; ++i)
-    if(fgVZEROCalib[i]) delete fgVZEROCalib[i];
-  for(Int_t i=0; i<2; ++i)
-    for(Int_t j=0; j<2; ++j)
-      if(fgVZERORecentering[i][j]) delete fgVZERORecentering[i][j];
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j)
-      if(fgZDCRecentering[i][j]) delete fgZDCRecentering[i][j];
 
 }
 
@@ -755,3 +725,15 @@ UInt_t AliDielectronVarManager::GetValueType(const char* valname) {
   }
   return -1;
 }
+
+//________________________________________________________________
+AliDielectronVarContext* AliDielectronVarManager::SetContext(AliDielectronVarContext *ctx) {
+  //
+  // Make ctx the context of the static interface on the calling thread,
+  // 0x0 selects the default context; returns the previous context
+  //
+
+  AliDielectronVarContext *previous=fgContext;
+  fgContext=(ctx ? ctx : &gDefaultVarContext);
+  return previous;
+}
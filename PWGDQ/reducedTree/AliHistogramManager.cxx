@@ -48,7 +48,9 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlanLists(),
+  fFillPlan()
 {
   //
   // Constructor
@@ -70,7 +72,9 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlanLists(),
+  fFillPlan()
 {
   //
   // Constructor
@@ -130,6 +134,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  FillPlanIndex(hList);
 }
 
 //_________________________________________________________________
@@ -180,6 +185,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
       if(xLabels[0]!='\0') MakeAxisLabels(h->GetXaxis(), xLabels);
       fUsedVars[varX] = kTRUE;
       hList->Add(h);
+      AddToFillPlan(FillPlanIndex(hList), h);
       h->SetDirectory(0);
       break;
     case 2:
@@ -215,6 +221,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
       fUsedVars[varX] = kTRUE;
       fUsedVars[varY] = kTRUE;
       hList->Add(h);
+      AddToFillPlan(FillPlanIndex(hList), h);
       h->SetDirectory(0);
       break;
     case 3:
@@ -267,6 +274,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
       fUsedVars[varZ] = kTRUE;
       h->SetDirectory(0);
       hList->Add(h);
+      AddToFillPlan(FillPlanIndex(hList), h);
       break;
   }
 }
@@ -321,6 +329,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
       fUsedVars[varX] = kTRUE;
       h->SetDirectory(0);
       hList->Add(h);
+      AddToFillPlan(FillPlanIndex(hList), h);
       break;
     case 2:
       if(isProfile) {
@@ -357,6 +366,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
       fUsedVars[varY] = kTRUE;
       h->SetDirectory(0);
       hList->Add(h);
+      AddToFillPlan(FillPlanIndex(hList), h);
       break;
     case 3:
       if(isProfile) {
@@ -408,6 +418,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
       fUsedVars[varY] = kTRUE;
       fUsedVars[varZ] = kTRUE;
       hList->Add(h);
+      AddToFillPlan(FillPlanIndex(hList), h);
       break;
   }
 }
@@ -458,6 +469,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     fUsedVars[vars[idim]] = kTRUE;
   }
   hList->Add(h);
+  AddToFillPlan(FillPlanIndex(hList), h);
   fBinsAllocated+=bins;
 }
 
@@ -521,6 +533,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     fUsedVars[vars[idim]] = kTRUE;
   }
   hList->Add(h);
+  AddToFillPlan(FillPlanIndex(hList), h);
   fBinsAllocated+=bins;
 }
 
@@ -604,6 +617,129 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 
+//__________________________________________________________________
+Int_t AliHistogramManager::FillPlanIndex(THashList* hList) {
+  //
+  // return the handle of a histogram class list, (re)building the fill plan if it is out of sync
+  // with the main list (e.g. after the manager was read from a file)
+  //
+  if(fFillPlanLists.size()+1==(UInt_t)fMainList.GetEntries() && fMainList.Last()==hList) {
+    // histogram class just added with AddHistClass()
+    hList->SetUniqueID(fFillPlanLists.size());
+    fFillPlanLists.push_back(hList);
+    fFillPlan.push_back(std::vector<FillEntry>());
+    return hList->GetUniqueID();
+  }
+  if(fFillPlanLists.size()!=(UInt_t)fMainList.GetEntries()) BuildFillPlan();
+  
+  UInt_t idx = hList->GetUniqueID();
+  if(idx<fFillPlanLists.size() && fFillPlanLists[idx]==hList) return idx;
+  for(UInt_t i=0; i<fFillPlanLists.size(); ++i) {
+    if(fFillPlanLists[i]==hList) {
+      hList->SetUniqueID(i);
+      return i;
+    }
+  }
+  return -1;
+}
+
+//__________________________________________________________________
+void AliHistogramManager::AddToFillPlan(Int_t classIndex, TObject* h) {
+  //
+  // decode the histogram type and the variables from the unique IDs of the histogram and its axes
+  // (see AddHistogram()) and append the histogram to the fill plan of its class
+  //
+  if(classIndex<0) return;
+  
+  FillEntry entry;
+  entry.fHist = h;
+  entry.fNVars = 0;
+  
+  Int_t uid = h->GetUniqueID();
+  Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+  Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+  Int_t thnDim = 0;
+  if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
+  
+  uid = (uid-(uid%100))/100;
+  Int_t varT = -1;
+  entry.fVarW = -1;
+  if(uid>0) {
+    entry.fVarW = uid%(fNVars+1)-1;
+    if(entry.fVarW==0) entry.fVarW=AliReducedVarManager::kNothing;
+    uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+    if(uid>0) varT = uid - 1;
+  }
+  
+  if(isTHn) {
+    entry.fKind = kFillTHn;
+    entry.fNVars = thnDim;
+    for(Int_t idim=0;idim<thnDim;++idim)
+      entry.fVars[idim] = ((THnF*)h)->GetAxis(idim)->GetUniqueID();
+  }
+  else {
+    TH1* h1 = (TH1*)h;
+    entry.fVars[0] = h1->GetXaxis()->GetUniqueID();
+    entry.fVars[1] = h1->GetYaxis()->GetUniqueID();
+    entry.fVars[2] = h1->GetZaxis()->GetUniqueID();
+    entry.fVars[3] = varT;
+    switch(h1->GetDimension()) {
+      case 1:
+        entry.fKind = (isProfile ? kFillTProfile : kFillTH1);
+        entry.fNVars = (isProfile ? 2 : 1);
+      break;
+      case 2:
+        entry.fKind = (isProfile ? kFillTProfile2D : kFillTH2);
+        entry.fNVars = (isProfile ? 3 : 2);
+      break;
+      case 3:
+        entry.fKind = (isProfile ? kFillTProfile3D : kFillTH3);
+        entry.fNVars = (isProfile ? 4 : 3);
+      break;
+      default:
+        entry.fKind = -1;     // never filled
+      break;
+    }
+  }
+  // a variable outside the variable map makes the histogram unfillable
+  for(Int_t i=0;i<entry.fNVars;++i)
+    if(entry.fVars[i]<0 || entry.fVars[i]>=AliReducedVarManager::kNVars) entry.fKind = -1;
+  if(entry.fVarW>=AliReducedVarManager::kNVars) entry.fKind = -1;
+  
+  fFillPlan[classIndex].push_back(entry);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::BuildFillPlan() {
+  //
+  // build the fill plan of all histogram classes from the main list
+  //
+  fFillPlanLists.clear();
+  fFillPlan.clear();
+  TIter nextList(&fMainList);
+  THashList* hList=0x0;
+  while((hList=(THashList*)nextList())) {
+    Int_t idx = fFillPlanLists.size();
+    hList->SetUniqueID(idx);
+    fFillPlanLists.push_back(hList);
+    fFillPlan.push_back(std::vector<FillEntry>());
+    TIter next(hList);
+    TObject* h=0x0;
+    while((h=next())) AddToFillPlan(idx, h);
+  }
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassIndex(const Char_t* className) {
+  //
+  // return the handle of a histogram class, to be used with FillHistClass(Int_t, Float_t*);
+  // -1 if the class does not exist
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  return FillPlanIndex(hList);
+}
+
 //__________________________________________________________________
 void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
   //
@@ -615,128 +751,93 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
     cout << "         Histogram list not filled" << endl; */
     return;
   }
-  if(!hList) {
-    return;
+  FillHistClass(FillPlanIndex(hList), values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classIndex, Float_t* values) {
+  //
+  //  fill a class of histograms, using the fill plan
+  //
+  FillHistClass(classIndex, values, 0x0, 1);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classIndex, Float_t* values, Float_t* const* columns, Int_t nEntries, 
+                                        const Bool_t* selected /*=0x0*/) {
+  //
+  //  fill a class of histograms for a block of entries (e.g. pairs), using the fill plan:
+  //  the variables having a column (columns[var]!=0x0) are taken from columns[var][entry], the others from values.
+  //  Only the selected entries are filled (all of them if selected is 0x0)
+  //
+  if(classIndex<0 || classIndex>=(Int_t)fFillPlanLists.size()) return;
+  if(fFillPlan[classIndex].size()!=(UInt_t)fFillPlanLists[classIndex]->GetSize()) {
+    // histograms were added to the list from outside AddHistogram()
+    fFillPlan[classIndex].clear();
+    TIter next(fFillPlanLists[classIndex]);
+    TObject* h=0x0;
+    while((h=next())) AddToFillPlan(classIndex, h);
   }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
+  
+  const Int_t nPlanEntries = fFillPlan[classIndex].size();
+  if(!nPlanEntries) return;
+  const FillEntry* entries = &(fFillPlan[classIndex][0]);
   Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
+  const Float_t* src[21];     // fill variables, then the weight
+  Int_t stride[21];           // 1 for a column, 0 for a value
+  for(Int_t ie=0; ie<nPlanEntries; ++ie) {
+    const FillEntry& e = entries[ie];
+    if(e.fKind<0) continue;
     Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
+    for(Int_t iv=0; iv<e.fNVars; ++iv) allVarsGood &= fUsedVars[e.fVars[iv]];
+    if(!allVarsGood) continue;
+    const Bool_t weighted = (e.fVarW>AliReducedVarManager::kNothing);
+    if(weighted && !fUsedVars[e.fVarW]) continue;
+    
+    const Int_t nSrc = (weighted ? e.fNVars+1 : e.fNVars);
+    for(Int_t iv=0; iv<nSrc; ++iv) {
+      Int_t var = (iv<e.fNVars ? e.fVars[iv] : e.fVarW);
+      if(columns && columns[var]) {src[iv] = columns[var]; stride[iv] = 1;}
+      else                        {src[iv] = &values[var]; stride[iv] = 0;}
     }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
-          case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
-          break;
-          case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
-          break;
-          case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
-            if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
-            }
-          break;
-          default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW])
-            ((THnF*)h)->Fill(fillValues,values[varW]);
-        }
-        else
-          ((THnF*)h)->Fill(fillValues);
+    const Float_t* w = (weighted ? src[e.fNVars] : 0x0);
+    const Int_t sw = (weighted ? stride[e.fNVars] : 0);
+    
+    for(Int_t i=0; i<nEntries; ++i) {
+      if(selected && !selected[i]) continue;
+      Float_t x = src[0][i*stride[0]];
+      switch(e.fKind) {
+        case kFillTH1:
+          if(weighted) ((TH1F*)e.fHist)->Fill(x,w[i*sw]);
+          else ((TH1F*)e.fHist)->Fill(x);
+        break;
+        case kFillTProfile:
+          if(weighted) ((TProfile*)e.fHist)->Fill(x,src[1][i*stride[1]],w[i*sw]);
+          else ((TProfile*)e.fHist)->Fill(x,src[1][i*stride[1]]);
+        break;
+        case kFillTH2:
+          if(weighted) ((TH2F*)e.fHist)->Fill(x,src[1][i*stride[1]],w[i*sw]);
+          else ((TH2F*)e.fHist)->Fill(x,src[1][i*stride[1]]);
+        break;
+        case kFillTProfile2D:
+          if(weighted) ((TProfile2D*)e.fHist)->Fill(x,src[1][i*stride[1]],src[2][i*stride[2]],w[i*sw]);
+          else ((TProfile2D*)e.fHist)->Fill(x,src[1][i*stride[1]],src[2][i*stride[2]]);
+        break;
+        case kFillTH3:
+          if(weighted) ((TH3F*)e.fHist)->Fill(x,src[1][i*stride[1]],src[2][i*stride[2]],w[i*sw]);
+          else ((TH3F*)e.fHist)->Fill(x,src[1][i*stride[1]],src[2][i*stride[2]]);
+        break;
+        case kFillTProfile3D:
+          if(weighted) ((TProfile3D*)e.fHist)->Fill(x,src[1][i*stride[1]],src[2][i*stride[2]],src[3][i*stride[3]],w[i*sw]);
+          else ((TProfile3D*)e.fHist)->Fill(x,src[1][i*stride[1]],src[2][i*stride[2]],src[3][i*stride[3]]);
+        break;
+        case kFillTHn:
+          for(Int_t idim=0;idim<e.fNVars;++idim) fillValues[idim] = src[idim][i*stride[idim]];
+          if(weighted) ((THnF*)e.fHist)->Fill(fillValues,w[i*sw]);
+          else ((THnF*)e.fHist)->Fill(fillValues);
+        break;
+        default:
+        break;
       }
     }
   }
@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -65,6 +67,9 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  Int_t GetHistClassIndex(const Char_t* className);        // handle of a histogram class for FillHistClass(Int_t,...); -1 if not found
+  void FillHistClass(Int_t classIndex, Float_t* values);   // fill a class of histograms, without name lookup
+  void FillHistClass(Int_t classIndex, Float_t* values, Float_t* const* columns, Int_t nEntries, const Bool_t* selected=0x0);   // fill a block of entries, see AliReducedVarManager::FillPairInfoME()
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -101,7 +106,25 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // Fill plan: for each histogram class, its histograms with the histogram type and the variables
+  // decoded once from the unique IDs (when the histogram is added), so that filling is a plain loop
+  enum EFillKind {
+    kFillTH1=0, kFillTProfile, kFillTH2, kFillTProfile2D, kFillTH3, kFillTProfile3D, kFillTHn
+  };
+  struct FillEntry {
+    TObject* fHist;       // histogram
+    Int_t    fKind;       // histogram type (EFillKind)
+    Int_t    fNVars;      // number of fill variables
+    Int_t    fVars[20];   // fill variables: axes, then the profiled variable(s) for profiles
+    Int_t    fVarW;       // weight variable, kNothing if not weighted
+  };
+  std::vector<THashList*> fFillPlanLists;              //! histogram class lists, indexed by class handle
+  std::vector<std::vector<FillEntry> > fFillPlan;      //! fill plan of each histogram class
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  Int_t FillPlanIndex(THashList* hList);
+  void AddToFillPlan(Int_t classIndex, TObject* h);
+  void BuildFillPlan();
   
   ClassDef(AliHistogramManager, 3)
 };
@@ -39,13 +39,18 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fPoolSize(),
   fIsInitialized(kFALSE),
   fMixLikeSign(kTRUE),
+  fUseColumnarMixing(kTRUE),
   fVariableLimits(),
   fVariables(),
   fNMixingVariables(0),
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fColumnStorage(),
+  fColumns(),
+  fPairSelected(),
+  fBitSelected()
 {
   // 
   // default constructor
@@ -78,13 +83,18 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fPoolSize(),
   fIsInitialized(kFALSE),
   fMixLikeSign(kTRUE),
+  fUseColumnarMixing(kTRUE),
   fVariableLimits(),
   fVariables(),
   fNMixingVariables(0),
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fColumnStorage(),
+  fColumns(),
+  fPairSelected(),
+  fBitSelected()
 {
   //
   // Named constructor
@@ -400,6 +410,15 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
   
   TObjArray* histClassArr = fHistClassNames.Tokenize(";");
   
+  // for the columnar mixing, set up the columns of the used pair variables and get the histogram class handles
+  Bool_t useColumns = (fUseColumnarMixing && fMixingSetup==kMixResonanceLegs);
+  std::vector<Int_t> histClasses;
+  if(useColumns) {
+    AliReducedVarManager::SetPairColumns(fColumns, fColumnStorage, kPairBlockSize);
+    for(Int_t i=0; i<histClassArr->GetEntries(); ++i)
+      histClasses.push_back(fHistos->GetHistClassIndex(histClassArr->At(i)->GetName()));
+  }
+  
   TIter iterEv1Leg1Pool(leg1Pool);
   TIter iterEv1Leg2Pool(leg2Pool);
   ULong_t testFlags1 = 0;
@@ -416,6 +435,14 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
       TList* ev2Leg2List = (TList*)iterEv2Leg2Pool();
       if(iev1==iev2) continue;
       
+      if(useColumns) {
+        MixTrackLists(ev1Leg1List, ev2Leg2List, mixingMask, 1, type, values, histClasses);   // cross-pairs (leg1 - leg2)
+        if(!fMixLikeSign) continue;
+        MixTrackLists(ev1Leg1List, ev2Leg1List, mixingMask, 0, type, values, histClasses);   // like-pairs (leg1 - leg1)
+        MixTrackLists(ev1Leg2List, ev2Leg2List, mixingMask, 2, type, values, histClasses);   // like-pairs (leg2 - leg2)
+        continue;
+      }
+      
       //loop over the ev1-leg1 list
       TIter iterLeg1(ev1Leg1List);
       AliReducedBaseTrack* ev1Leg1=0x0;
@@ -564,24 +591,97 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
 
 
 //_________________________________________________________________________
-Bool_t AliMixingHandler::IsPairSelected(Float_t* values, Int_t pairType) {
+void AliMixingHandler::MixTrackLists(TList* list1, TList* list2, ULong_t mixingMask, Int_t pairType, Int_t type, 
+                                     Float_t* values, const std::vector<Int_t>& histClasses) {
+  //
+  // Mix the tracks of list1 (first event) with the tracks of list2 (second event) in blocks of pairs:
+  // the pair variables of a block are computed into columns (AliReducedVarManager::FillPairInfoME(Int_t nLegs1,...)), 
+  // then the pair cuts and the histograms are applied to the whole block.
+  // pairType: 0 - leg1 like pairs, 1 - cross pairs, 2 - leg2 like pairs
+  //
+  // keep the tracks which have at least one common bit with the mixing mask
+  std::vector<AliReducedBaseTrack*> legs1, legs2;
+  std::vector<ULong_t> flags1, flags2;
+  TIter iter1(list1);
+  AliReducedBaseTrack* track=0x0;
+  while((track=(AliReducedBaseTrack*)iter1())) {
+    if(!(mixingMask & track->GetFlags())) continue;
+    legs1.push_back(track);
+    flags1.push_back(mixingMask & track->GetFlags());
+  }
+  if(legs1.empty()) return;
+  TIter iter2(list2);
+  while((track=(AliReducedBaseTrack*)iter2())) {
+    if(!(mixingMask & track->GetFlags())) continue;
+    legs2.push_back(track);
+    flags2.push_back(mixingMask & track->GetFlags());
+  }
+  if(legs2.empty()) return;
+  
+  TList* cutList = GetPairCuts(pairType);
+  Int_t nLegs1 = legs1.size();
+  Int_t nLegs2 = legs2.size();
+  Int_t blockLegs2 = TMath::Min(nLegs2, Int_t(kPairBlockSize));
+  Int_t blockLegs1 = TMath::Max(1, Int_t(kPairBlockSize)/blockLegs2);
+  for(Int_t start2=0; start2<nLegs2; start2+=blockLegs2) {
+    Int_t n2 = TMath::Min(blockLegs2, nLegs2-start2);
+    for(Int_t start1=0; start1<nLegs1; start1+=blockLegs1) {
+      Int_t n1 = TMath::Min(blockLegs1, nLegs1-start1);
+      Int_t nPairs = AliReducedVarManager::FillPairInfoME(n1, &legs1[start1], n2, &legs2[start2], type, values, fColumns);
+      
+      // pairs with at least one common bit
+      for(Int_t i1=0; i1<n1; ++i1)
+        for(Int_t i2=0; i2<n2; ++i2)
+          fPairSelected[i1*n2+i2] = ((flags1[start1+i1] & flags2[start2+i2]) ? kTRUE : kFALSE);
+      
+      // pair cuts (logical AND between all of them)
+      for(Int_t i=0; i<cutList->GetEntries(); ++i)
+        ((AliReducedInfoCut*)cutList->At(i))->IsSelectedBlock(values, fColumns, nPairs, fPairSelected);
+      
+      // fill histograms for the enabled bits
+      for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+        Int_t histClass = (ibit*3+pairType<(Int_t)histClasses.size() ? histClasses[ibit*3+pairType] : -1);
+        if(histClass<0) continue;
+        Bool_t found = kFALSE;
+        for(Int_t i1=0; i1<n1; ++i1) {
+          for(Int_t i2=0; i2<n2; ++i2) {
+            Int_t entry = i1*n2+i2;
+            fBitSelected[entry] = (fPairSelected[entry] && (flags1[start1+i1] & flags2[start2+i2] & (ULong_t(1)<<ibit)));
+            found |= fBitSelected[entry];
+          }
+        }
+        if(found) fHistos->FillHistClass(histClass, values, fColumns, nPairs, fBitSelected);
+      }
+    }  // end loop over leg1 blocks
+  }  // end loop over leg2 blocks
+}
+
+
+//_________________________________________________________________________
+TList* AliMixingHandler::GetPairCuts(Int_t pairType) {
    //
-   // apply pair cuts
+   // pair cuts for the given pair type: 0 - leg1 like pairs, 1 - cross pairs, 2 - leg2 like pairs
    //
-   TList* cutList = 0;
    switch(pairType) {
       case 0:
-         cutList = &fLikePairsLeg1Cuts;
-         break;
+         return &fLikePairsLeg1Cuts;
       case 1:
-         cutList = &fCrossPairsCuts;
-         break;
+         return &fCrossPairsCuts;
       case 2:
-         cutList = &fLikePairsLeg2Cuts;
-         break;
+         return &fLikePairsLeg2Cuts;
       default:
          break;
    };
+   return 0x0;
+}
+
+
+//_________________________________________________________________________
+Bool_t AliMixingHandler::IsPairSelected(Float_t* values, Int_t pairType) {
+   //
+   // apply pair cuts
+   //
+   TList* cutList = GetPairCuts(pairType);
    if(!cutList) return kTRUE;
    if(cutList->GetEntries()==0) return kTRUE;
    
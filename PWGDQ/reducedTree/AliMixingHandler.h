@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
@@ -24,7 +26,8 @@ public:
    enum Constants {
       kMixResonanceLegs=0,         // event mixing for resonance inv mass bkg
       kMixCorrelation,                 // event mixing for correlations
-      kNMaxVariables = 10
+      kNMaxVariables = 10,
+      kPairBlockSize = 4096        // maximum number of pairs handled at once in the columnar mixing
    };
 
 public:
@@ -36,6 +39,7 @@ public:
   void AddMixingVariable(AliReducedVarManager::Variables var, Int_t nBins, const Float_t* binLims);
   void SetMixLikeSign(Bool_t flag) {fMixLikeSign = flag;}
   void SetMixLikePairs(Bool_t flag) {SetMixLikeSign(flag);}      // synonim function to SetMixLikeSign
+  void SetUseColumnarMixing(Bool_t flag) {fUseColumnarMixing = flag;}
   void SetPoolDepth(Int_t n) {fPoolDepth = n;}
   void SetMixingThreshold(Float_t fr) {fMixingThreshold = fr;}
   void SetDownscaleEvents(Float_t ds) {fDownscaleEvents = ds;}
@@ -66,6 +70,7 @@ public:
   TString GetHistClassNames() const {return fHistClassNames;};
   Int_t GetNMixingVariables() const {return fNMixingVariables;}
   Int_t GetMixingSetup() const {return fMixingSetup;}
+  Bool_t GetUseColumnarMixing() const {return fUseColumnarMixing;}
   
   void Init();
   Int_t FindEventCategory(Float_t* values);
@@ -96,6 +101,7 @@ private:
   TArrayI fPoolSize;               // counters for the pool sizes
   Bool_t fIsInitialized;           // check if the mixing handler is initialized
   Bool_t fMixLikeSign;             // mix or not like-sign tracks (default is true)
+  Bool_t fUseColumnarMixing;       // compute, select and histogram the resonance leg pairs in blocks (default is true)
   
   TArrayF fVariableLimits[kNMaxVariables];
   AliReducedVarManager::Variables fVariables[kNMaxVariables];
@@ -107,11 +113,20 @@ private:
   TList fLikePairsLeg1Cuts;    // cut object for LEG1 like pairs
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
+  // columnar mixing work space
+  std::vector<Float_t> fColumnStorage;                   //! storage of the pair variable columns
+  Float_t* fColumns[AliReducedVarManager::kNVars];       //! pair variable columns, 0x0 for variables taken from the values array
+  Bool_t fPairSelected[kPairBlockSize];                  //! pairs passing the mixing mask and the pair cuts
+  Bool_t fBitSelected[kPairBlockSize];                   //! selected pairs for a given cut bit
+  
+  TList* GetPairCuts(Int_t pairType);
+  void MixTrackLists(TList* list1, TList* list2, ULong_t mixingMask, Int_t pairType, Int_t type, Float_t* values, 
+                     const std::vector<Int_t>& histClasses);
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,3);
+  ClassDef(AliMixingHandler,4);
 };
 
 #endif
@@ -44,7 +44,11 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fJpsiCandidates()
+  fJpsiCandidates(),
+  fTrackHistClassName(""),
+  fTrackHistClasses(),
+  fPairHistClassName(""),
+  fPairHistClasses()
 {
   //
   // default constructor
@@ -73,7 +77,11 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fNegTracks(),
   fPrefilterPosTracks(),
   fPrefilterNegTracks(),
-  fJpsiCandidates()
+  fJpsiCandidates(),
+  fTrackHistClassName(""),
+  fTrackHistClasses(),
+  fPairHistClassName(""),
+  fPairHistClasses()
 {
   //
   // named constructor
@@ -340,24 +348,30 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedTrackInfo* track,
    // fill track level histograms
    //
    Bool_t isMCTruth = fOptionRunOverMC && IsMCTruth(track);
+   const Int_t* histClasses = GetTrackHistClasses(trackClass);
    for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
       if(track->TestFlag(icut)) {
-         fHistosManager->FillHistClass(Form("%s_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-         if(isMCTruth) fHistosManager->FillHistClass(Form("%s_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         const Int_t* h = histClasses + 2*kNTrackHistClasses*icut;
+         const Int_t* hMC = h + kNTrackHistClasses;
+         fHistosManager->FillHistClass(h[kTrack], fValues);
+         if(isMCTruth) fHistosManager->FillHistClass(hMC[kTrack], fValues);
+         Int_t hStatus = h[kTrackStatusFlags], hStatusMC = hMC[kTrackStatusFlags];
+         Int_t hITS = h[kTrackITSclusterMap], hITSMC = hMC[kTrackITSclusterMap];
+         Int_t hTPC = h[kTrackTPCclusterMap], hTPCMC = hMC[kTrackTPCclusterMap];
          for(UInt_t iflag=0; iflag<AliReducedVarManager::kNTrackingFlags; ++iflag) {
             AliReducedVarManager::FillTrackingFlag(track, iflag, fValues);
-            fHistosManager->FillHistClass(Form("%sStatusFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-            if(isMCTruth) fHistosManager->FillHistClass(Form("%sStatusFlags_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(hStatus, fValues);
+            if(isMCTruth) fHistosManager->FillHistClass(hStatusMC, fValues);
          }
          for(Int_t iLayer=0; iLayer<6; ++iLayer) {
             AliReducedVarManager::FillITSlayerFlag(track, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sITSclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-            if(isMCTruth) fHistosManager->FillHistClass(Form("%sITSclusterMap_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(hITS, fValues);
+            if(isMCTruth) fHistosManager->FillHistClass(hITSMC, fValues);
          }
          for(Int_t iLayer=0; iLayer<8; ++iLayer) {
             AliReducedVarManager::FillTPCclusterBitFlag(track, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sTPCclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
-            if(isMCTruth) fHistosManager->FillHistClass(Form("%sTPCclusterMap_%s_MCTruth", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(hTPC, fValues);
+            if(isMCTruth) fHistosManager->FillHistClass(hTPCMC, fValues);
          }
       } // end if(track->TestFlag(icut))
    }  // end loop over cuts
@@ -369,16 +383,62 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t mask, Int_t pairType,
    //
    // fill pair level histograms
    // NOTE: pairType can be 0,1 or 2 corresponding to ++, +- or -- pairs
-   TString typeStr[3] = {"PP", "PM", "MM"};
+   const Int_t* histClasses = GetPairHistClasses(pairClass);
    for(Int_t icut=0; icut<fTrackCuts.GetEntries(); ++icut) {
       if(mask & (ULong_t(1)<<icut)) {
-         fHistosManager->FillHistClass(Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(icut)->GetName()), fValues);
-         if(isMCTruth && pairType==1) fHistosManager->FillHistClass(Form("%s%s_%s_MCTruth", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(icut)->GetName()), fValues);
+         const Int_t* h = histClasses + kNPairHistClasses*icut;
+         fHistosManager->FillHistClass(h[kPairPP+pairType], fValues);
+         if(isMCTruth && pairType==1) fHistosManager->FillHistClass(h[kPairPMMCTruth], fValues);
       }
    }  // end loop over cuts
 }
 
 
+//___________________________________________________________________________
+const Int_t* AliReducedAnalysisJpsi2ee::GetTrackHistClasses(const TString& trackClass) {
+   //
+   // handles of the track histogram classes of all track cuts, resolved by name only when the track class
+   // (or the number of cuts) changes
+   //
+   Int_t nCuts = fTrackCuts.GetEntries();
+   if(trackClass!=fTrackHistClassName || fTrackHistClasses.size()!=(UInt_t)(2*kNTrackHistClasses*nCuts)) {
+      const Char_t* typeStr[kNTrackHistClasses] = {"", "StatusFlags", "ITSclusterMap", "TPCclusterMap"};
+      fTrackHistClassName = trackClass;
+      fTrackHistClasses.clear();
+      for(Int_t icut=0; icut<nCuts; ++icut) {
+         const Char_t* cutName = fTrackCuts.At(icut)->GetName();
+         for(Int_t i=0; i<kNTrackHistClasses; ++i)
+            fTrackHistClasses.push_back(fHistosManager->GetHistClassIndex(Form("%s%s_%s", trackClass.Data(), typeStr[i], cutName)));
+         for(Int_t i=0; i<kNTrackHistClasses; ++i)
+            fTrackHistClasses.push_back(fHistosManager->GetHistClassIndex(Form("%s%s_%s_MCTruth", trackClass.Data(), typeStr[i], cutName)));
+      }
+   }
+   return fTrackHistClasses.data();
+}
+
+
+//___________________________________________________________________________
+const Int_t* AliReducedAnalysisJpsi2ee::GetPairHistClasses(const TString& pairClass) {
+   //
+   // handles of the pair histogram classes of all track cuts, resolved by name only when the pair class
+   // (or the number of cuts) changes
+   //
+   Int_t nCuts = fTrackCuts.GetEntries();
+   if(pairClass!=fPairHistClassName || fPairHistClasses.size()!=(UInt_t)(kNPairHistClasses*nCuts)) {
+      const Char_t* typeStr[3] = {"PP", "PM", "MM"};
+      fPairHistClassName = pairClass;
+      fPairHistClasses.clear();
+      for(Int_t icut=0; icut<nCuts; ++icut) {
+         const Char_t* cutName = fTrackCuts.At(icut)->GetName();
+         for(Int_t i=0; i<3; ++i)
+            fPairHistClasses.push_back(fHistosManager->GetHistClassIndex(Form("%s%s_%s", pairClass.Data(), typeStr[i], cutName)));
+         fPairHistClasses.push_back(fHistosManager->GetHistClassIndex(Form("%sPM_%s_MCTruth", pairClass.Data(), cutName)));
+      }
+   }
+   return fPairHistClasses.data();
+}
+
+
 //___________________________________________________________________________
 void AliReducedAnalysisJpsi2ee::RunTrackSelection() {
    //
@@ -5,7 +5,10 @@
 #ifndef ALIREDUCEDANALYSISJPSI2EE_H
 #define ALIREDUCEDANALYSISJPSI2EE_H
 
+#include <vector>
+
 #include <TList.h>
+#include <TString.h>
 
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
@@ -85,6 +88,14 @@ protected:
    TList fPrefilterNegTracks; // list of prefilter selected negative tracks in the current event
    TList fJpsiCandidates;       // list of Jpsi candidates --> to be used in analyses inheriting from this 
    
+   // histogram class handles (see AliHistogramManager::GetHistClassIndex()), resolved once per track/pair class name
+   enum TrackHistClasses {kTrack=0, kTrackStatusFlags, kTrackITSclusterMap, kTrackTPCclusterMap, kNTrackHistClasses};
+   enum PairHistClasses {kPairPP=0, kPairPM, kPairMM, kPairPMMCTruth, kNPairHistClasses};
+   TString fTrackHistClassName;              //! track class the track handles were resolved for
+   std::vector<Int_t> fTrackHistClasses;     //! per track cut: kNTrackHistClasses handles, followed by the same for MC truth
+   TString fPairHistClassName;               //! pair class the pair handles were resolved for
+   std::vector<Int_t> fPairHistClasses;      //! per track cut: kNPairHistClasses handles
+   
   Bool_t IsEventSelected(AliReducedBaseEvent* event, Float_t* values=0x0);
   Bool_t IsTrackSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
   Bool_t IsTrackPrefilterSelected(AliReducedBaseTrack* track, Float_t* values=0x0);
@@ -102,6 +113,8 @@ protected:
   void FillTrackHistograms(AliReducedTrackInfo* track, TString trackClass = "Track");
   void FillPairHistograms(ULong_t mask, Int_t pairType, TString pairClass = "PairSE", Bool_t isMCTruth = kFALSE);
   void FillMCTruthHistograms();
+  const Int_t* GetTrackHistClasses(const TString& trackClass);
+  const Int_t* GetPairHistClasses(const TString& pairClass);
   
   ClassDef(AliReducedAnalysisJpsi2ee,4);
 };
@@ -10,6 +10,8 @@
 #include "AliReducedInfoCut.h"
 #endif
 
+#include "AliReducedVarManager.h"
+
 ClassImp(AliReducedInfoCut)
 
 //____________________________________________________________________________
@@ -36,3 +38,16 @@ AliReducedInfoCut::~AliReducedInfoCut() {
   // destructor
   //
 }
+
+
+//____________________________________________________________________________
+void AliReducedInfoCut::IsSelectedBlock(Float_t* values, Float_t* const* columns, Int_t nEntries, Bool_t* selected) {
+  //
+  // apply the cut entry by entry, with the column values of each entry copied to values
+  //
+  for(Int_t i=0; i<nEntries; ++i) {
+    if(!selected[i]) continue;
+    AliReducedVarManager::GetColumnsEntry(columns, i, values);
+    selected[i] = IsSelected(values);
+  }
+}
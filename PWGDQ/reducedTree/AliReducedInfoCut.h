@@ -18,6 +18,9 @@ class AliReducedInfoCut : public TNamed {
   virtual Bool_t IsSelected(TObject* obj) {return kTRUE;};
   virtual Bool_t IsSelected(TObject* obj, Float_t* values) {return kTRUE;};
   virtual Bool_t IsSelected(Float_t* values) {return kTRUE;};
+  // apply the cut to a block of entries, see AliReducedVarManager::FillPairInfoME(Int_t nLegs1,...)
+  // NOTE: only entries with selected[i]==kTRUE are checked and rejected ones are set to kFALSE
+  virtual void IsSelectedBlock(Float_t* values, Float_t* const* columns, Int_t nEntries, Bool_t* selected);
   
  protected: 
    
@@ -249,3 +249,38 @@ Bool_t AliReducedVarCut::IsSelected(Float_t* values) {
    
    return kTRUE;
 }
+
+
+//____________________________________________________________________________
+void AliReducedVarCut::IsSelectedBlock(Float_t* values, Float_t* const* columns, Int_t nEntries, Bool_t* selected) {
+   //
+   // apply cuts to a block of entries, cut by cut; the variables having a column are taken from columns[var][entry]
+   // NOTE: same selection as IsSelected(Float_t* values) applied to each entry
+   //
+   for(Int_t i=0; i<fNCuts; ++i) {
+      const Float_t* val = (columns[fCutVariables[i]] ? columns[fCutVariables[i]] : &values[fCutVariables[i]]);
+      const Int_t stride = (columns[fCutVariables[i]] ? 1 : 0);
+      const Float_t* depVal = 0x0;
+      Int_t depStride = 0;
+      if(fCutHasDependentVariable[i] || fFuncCutLow[i] || fFuncCutHigh[i]) {
+         depVal = (columns[fDependentVariable[i]] ? columns[fDependentVariable[i]] : &values[fDependentVariable[i]]);
+         depStride = (columns[fDependentVariable[i]] ? 1 : 0);
+      }
+      for(Int_t ie=0; ie<nEntries; ++ie) {
+         if(!selected[ie]) continue;
+         if(fCutHasDependentVariable[i]) {
+            Float_t dep = depVal[ie*depStride];
+            Bool_t inRangeDep = (dep>=fDependentVariableCutLow[i] && dep<=fDependentVariableCutHigh[i]);
+            // do not apply this cut if outside of the applicability range
+            if(!inRangeDep && !fDependentVariableExclude[i]) continue;
+            if(inRangeDep && fDependentVariableExclude[i]) continue;
+         }
+         if(fFuncCutLow[i]) fCutLow[i] = fFuncCutLow[i]->Eval(depVal[ie*depStride]);
+         if(fFuncCutHigh[i]) fCutHigh[i] = fFuncCutHigh[i]->Eval(depVal[ie*depStride]);
+         Float_t x = val[ie*stride];
+         Bool_t inRange = (x>=fCutLow[i] && x<=fCutHigh[i]);
+         if(!inRange && !fCutExclude[i]) selected[ie] = kFALSE;
+         if(inRange && fCutExclude[i]) selected[ie] = kFALSE;
+      }
+   }
+}
@@ -38,6 +38,7 @@ class AliReducedVarCut : public AliReducedInfoCut {
   virtual Bool_t IsSelected(TObject* obj);
   virtual Bool_t IsSelected(Float_t* values);
   virtual Bool_t IsSelected(TObject* obj, Float_t* values);
+  virtual void IsSelectedBlock(Float_t* values, Float_t* const* columns, Int_t nEntries, Bool_t* selected);
   
  protected: 
   
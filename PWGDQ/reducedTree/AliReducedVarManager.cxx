@@ -135,6 +135,9 @@ TString AliReducedVarManager::fgVariableUnits[AliReducedVarManager::kNVars] = {"
 AliReducedBaseEvent* AliReducedVarManager::fgEvent = 0x0;
 AliReducedEventPlaneInfo* AliReducedVarManager::fgEventPlane = 0x0;
 Bool_t AliReducedVarManager::fgUsedVars[AliReducedVarManager::kNVars] = {kFALSE};
+const Int_t AliReducedVarManager::fgkPairColumnVars[AliReducedVarManager::fgkNPairColumnVars] = {
+  kPairType, kMass, kPx, kPy, kPz, kPt, kPtSquared, kP, kEta, kRap, kPhi, kTheta, kPairEff, kOneOverPairEff, kOneOverPairEffSq
+};
 TH2F* AliReducedVarManager::fgTPCelectronCentroidMap = 0x0;
 TH2F* AliReducedVarManager::fgTPCelectronWidthMap = 0x0;
 AliReducedVarManager::Variables AliReducedVarManager::fgVarDependencyX = kNothing;
@@ -1839,6 +1842,161 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
 }
 
 
+//_________________________________________________________________
+Int_t AliReducedVarManager::SetPairColumns(Float_t** columns, std::vector<Float_t>& storage, Int_t capacity) {
+  //
+  // Set up the columns for FillPairInfoME(Int_t nLegs1, ...): columns[var] points to an array of "capacity" entries
+  // in storage for each used pair variable, and is 0x0 for all other variables. 
+  // Returns the number of columns
+  //
+  for(Int_t i=0; i<kNVars; ++i) columns[i] = 0x0;
+  
+  Bool_t useColumn[fgkNPairColumnVars];
+  Int_t nColumns = 0;
+  for(Int_t ic=0; ic<fgkNPairColumnVars; ++ic) {
+    Int_t var = fgkPairColumnVars[ic];
+    useColumn[ic] = fgUsedVars[var];
+    // kPt is needed for kPtSquared; the pair efficiency variables are computed together
+    if(var==kPt && fgUsedVars[kPtSquared]) useColumn[ic] = kTRUE;
+    if((var==kPairEff || var==kOneOverPairEff || var==kOneOverPairEffSq) && 
+       (fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq])) useColumn[ic] = kTRUE;
+    if(useColumn[ic]) ++nColumns;
+  }
+  
+  storage.resize(nColumns*capacity);
+  Int_t offset = 0;
+  for(Int_t ic=0; ic<fgkNPairColumnVars; ++ic) {
+    if(!useColumn[ic]) continue;
+    columns[fgkPairColumnVars[ic]] = &storage[offset];
+    offset += capacity;
+  }
+  return nColumns;
+}
+
+
+//_________________________________________________________________
+Int_t AliReducedVarManager::FillPairInfoME(Int_t nLegs1, BASETRACK** legs1, Int_t nLegs2, BASETRACK** legs2, 
+                                           Int_t type, Float_t* values, Float_t** columns) {
+  //
+  // Columnar version of FillPairInfoME(t1, t2, type, values) for all leg1 x leg2 combinations of two arrays of tracks.
+  // The pair variables are written to columns[var][i1*nLegs2+i2], only for the columns set up with SetPairColumns(),
+  // i.e. for the used variables. The variables which are the same for all pairs (kCandidateId, kPairChisquare) are
+  // written to values, which also provides all non-pair variables.
+  // The leg quantities are computed once per leg, instead of once per pair.
+  // Returns the number of entries, nLegs1*nLegs2
+  //
+  values[kCandidateId] = type;
+  values[kPairChisquare] = -999.;
+  if(nLegs1<=0 || nLegs2<=0) return 0;
+  
+  Float_t m1 = 0.0; Float_t m2 = 0.0;
+  GetLegMassAssumption(type,m1,m2); 
+  
+  Float_t* colPairType = columns[kPairType];
+  Float_t* colMass = columns[kMass];
+  Float_t* colPx = columns[kPx];
+  Float_t* colPy = columns[kPy];
+  Float_t* colPz = columns[kPz];
+  Float_t* colPt = columns[kPt];
+  Float_t* colPtSquared = columns[kPtSquared];
+  Float_t* colP = columns[kP];
+  Float_t* colEta = columns[kEta];
+  Float_t* colRap = columns[kRap];
+  Float_t* colPhi = columns[kPhi];
+  Float_t* colTheta = columns[kTheta];
+  Bool_t usePairEff = (fgPairEffMap && columns[kPairEff]);
+  
+  // leg2 quantities
+  std::vector<Float_t> px2(nLegs2), py2(nLegs2), pz2(nLegs2), p2(nLegs2);
+  std::vector<Double_t> e2(nLegs2);
+  std::vector<Int_t> charge2(nLegs2);
+  for(Int_t i2=0; i2<nLegs2; ++i2) {
+    BASETRACK* t2 = legs2[i2];
+    px2[i2] = t2->Px(); py2[i2] = t2->Py(); pz2[i2] = t2->Pz(); p2[i2] = t2->P();
+    e2[i2] = TMath::Sqrt(m2*m2+p2[i2]*p2[i2]);
+    charge2[i2] = t2->Charge();
+  }
+  
+  PAIR p;
+  p.CandidateId(type);
+  for(Int_t i1=0; i1<nLegs1; ++i1) {
+    BASETRACK* t1 = legs1[i1];
+    Float_t px1 = t1->Px(); Float_t py1 = t1->Py(); Float_t pz1 = t1->Pz(); Float_t p1 = t1->P();
+    Double_t e1 = TMath::Sqrt(m1*m1+p1*p1);
+    Int_t charge1 = t1->Charge();
+    
+    for(Int_t i2=0; i2<nLegs2; ++i2) {
+      Int_t entry = i1*nLegs2+i2;
+      p.PxPyPz(px1+px2[i2], py1+py2[i2], pz1+pz2[i2]);
+      
+      if(colPairType) {
+        if(charge1*charge2[i2]<0) colPairType[entry] = 1;
+        else if(charge1>0)        colPairType[entry] = 0;
+        else                      colPairType[entry] = 2;
+      }
+      if(colMass) {
+        Float_t mass2 = m1*m1+m2*m2 + 2.0*(e1*e2[i2] - px1*px2[i2] - py1*py2[i2] - pz1*pz2[i2]);
+        if(mass2<0.0) {
+          cout << "FillPairInfoME(legs, legs, type, values, columns): Warning: Very small squared mass found. "
+               << "   Could be negative due to resolution of Float_t so it will be set to a small positive value." << endl; 
+          cout << "   mass2: " << mass2 << endl;
+          cout << "p1(p,x,y,z): " << p1 << ", " << px1 << ", " << py1 << ", " << pz1 << endl;
+          cout << "p2(p,x,y,z): " << p2[i2] << ", " << px2[i2] << ", " << py2[i2] << ", " << pz2[i2] << endl;
+          colMass[entry] = 0.0;
+        }
+        else
+          colMass[entry] = TMath::Sqrt(mass2);
+        p.SetMass(colMass[entry]);
+      }
+      
+      if(colPx) colPx[entry] = p.Px();
+      if(colPy) colPy[entry] = p.Py();
+      if(colPz) colPz[entry] = p.Pz();
+      if(colPt) {
+        colPt[entry] = p.Pt();
+        if(colPtSquared) colPtSquared[entry] = colPt[entry]*colPt[entry];
+      }
+      if(colP) colP[entry] = p.P();
+      if(colEta) colEta[entry] = p.Eta();
+      if(colRap) colRap[entry] = p.Rapidity();
+      if(colPhi) colPhi[entry] = p.Phi();
+      if(colTheta) colTheta[entry] = p.Theta();
+      
+      if(usePairEff) {
+        Float_t valX = (columns[fgEffMapVarDependencyX] ? columns[fgEffMapVarDependencyX][entry] : values[fgEffMapVarDependencyX]);
+        Float_t valY = (columns[fgEffMapVarDependencyY] ? columns[fgEffMapVarDependencyY][entry] : values[fgEffMapVarDependencyY]);
+        Int_t binX = fgPairEffMap->GetXaxis()->FindBin(valX);
+        if(binX==0) binX = 1;
+        if(binX==fgPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
+        Int_t binY = fgPairEffMap->GetYaxis()->FindBin(valY);
+        if(binY==0) binY=1;
+        if(binY==fgPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
+        Float_t pairEff = fgPairEffMap->GetBinContent(binX, binY);
+        Float_t oneOverPairEff = 1;
+        if (pairEff > 1.0e-6) oneOverPairEff = 1/pairEff;
+        columns[kPairEff][entry] = pairEff;
+        columns[kOneOverPairEff][entry] = oneOverPairEff;
+        columns[kOneOverPairEffSq][entry] = oneOverPairEff*oneOverPairEff;
+      }
+    }  // end loop over leg2
+  }  // end loop over leg1
+  
+  return nLegs1*nLegs2;
+}
+
+
+//_________________________________________________________________
+void AliReducedVarManager::GetColumnsEntry(Float_t* const* columns, Int_t entry, Float_t* values) {
+  //
+  // copy the pair variables of one entry of the columns filled by FillPairInfoME(Int_t nLegs1, ...) to values
+  //
+  for(Int_t ic=0; ic<fgkNPairColumnVars; ++ic) {
+    Int_t var = fgkPairColumnVars[ic];
+    if(columns[var]) values[var] = columns[var][entry];
+  }
+}
+
+
 //_________________________________________________________________
 void AliReducedVarManager::FillPairInfo(PAIR* t1, BASETRACK* t2, Int_t type, Float_t* values) {
   //
@@ -14,6 +14,8 @@
 #include <TH2F.h>
 #include <TProfile2D.h>
 
+#include <vector>
+
 #include <AliReducedPairInfo.h>
 
 class AliReducedBaseEvent;
@@ -606,6 +608,11 @@ class AliReducedVarManager : public TObject {
   static void FillPairInfo(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
   static void FillPairInfo(AliReducedPairInfo* leg1, AliReducedBaseTrack* leg2, Int_t type, Float_t* values);
   static void FillPairInfoME(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
+  // columnar pair filling for blocks of leg1 x leg2 combinations (see FillPairInfoME(Int_t nLegs1,...))
+  static Int_t SetPairColumns(Float_t** columns, std::vector<Float_t>& storage, Int_t capacity);
+  static Int_t FillPairInfoME(Int_t nLegs1, AliReducedBaseTrack** legs1, Int_t nLegs2, AliReducedBaseTrack** legs2, 
+                              Int_t type, Float_t* values, Float_t** columns);
+  static void GetColumnsEntry(Float_t* const* columns, Int_t entry, Float_t* values);
   static void FillCorrelationInfo(AliReducedBaseTrack* p, AliReducedBaseTrack* t, Float_t* values);
   static void FillCorrelationInfo(AliReducedBaseTrack* t, Float_t* values);
   static void FillCaloClusterInfo(AliReducedCaloClusterInfo* cl, Float_t* values);
@@ -644,6 +651,8 @@ class AliReducedVarManager : public TObject {
   static Bool_t fgUsedVars[kNVars];              // array of flags toggled when the corresponding variable is required (e.g., in the histogram manager, in cuts, mixing handler, etc.) 
                                                  //   when a variable is used
   static void SetVariableDependencies();       // toggle those variables on which other used variables might depend 
+  static const Int_t fgkNPairColumnVars = 15;
+  static const Int_t fgkPairColumnVars[fgkNPairColumnVars];   // pair variables which can be filled in columns by FillPairInfoME(Int_t nLegs1,...)
   
 
   static Double_t DeltaPhi(Double_t phi1, Double_t phi2);  
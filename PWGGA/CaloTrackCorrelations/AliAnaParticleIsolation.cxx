@@ -14,6 +14,7 @@
  **************************************************************************/
 
 // --- ROOT system ---
+#include <vector>
 #include <TClonesArray.h>
 #include <TList.h>
 #include <TObjString.h>
@@ -7936,21 +7937,80 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
     } // bit loop
   } // decay histograms
   
+  //If too small or too large pt, skip
+  if(ptC < GetMinPt() || ptC > GetMaxPt() ) return ;
+  
   // Get vertex for photon momentum calculation
   Double_t vertex[] = {0,0,0} ; //vertex ;
   if(GetReader()->GetDataType() != AliCaloTrackReader::kMC)
     GetReader()->GetVertex(vertex);
   
-  // Loop on cone sizes
-  for(Int_t icone = 0; icone<fNCones; icone++)
+  // Recover reference arrays with clusters and tracks
+  TObjArray * refclusters = ph->GetObjArray(GetAODObjArrayName()+"Clusters");
+  TObjArray * reftracks   = ph->GetObjArray(GetAODObjArrayName()+"Tracks");
+  
+  // Distances and pT of the particles needed in the cone loop, calculated once for all cones.
+  // Tracks distance to the two perpendicular cones
+  TObjArray * trackList = GetCTSTracks() ;
+  std::vector<Double_t> perpRad1, perpRad2, perpPt, perpPtTrack;
+  perpRad1   .reserve(trackList->GetEntriesFast());
+  perpRad2   .reserve(trackList->GetEntriesFast());
+  perpPt     .reserve(trackList->GetEntriesFast());
+  perpPtTrack.reserve(trackList->GetEntriesFast());
+  for(Int_t itrack=0; itrack < trackList->GetEntriesFast(); itrack++)
   {
-    // Recover reference arrays with clusters and tracks
-    TObjArray * refclusters = ph->GetObjArray(GetAODObjArrayName()+"Clusters");
-    TObjArray * reftracks   = ph->GetObjArray(GetAODObjArrayName()+"Tracks");
+    AliVTrack* track = (AliVTrack *) trackList->At(itrack);
+    //fill the histograms at forward range
+    if(!track)
+    {
+      AliDebug(1,"Track not available?");
+      continue;
+    }
     
-    //If too small or too large pt, skip
-    if(ptC < GetMinPt() || ptC > GetMaxPt() ) continue ;
+    Double_t dPhi = phiC - track->Phi() + TMath::PiOver2();
+    Double_t dEta = etaC - track->Eta();
+    perpRad1.push_back(TMath::Sqrt(dPhi*dPhi + dEta*dEta));
     
+    dPhi = phiC - track->Phi() - TMath::PiOver2();
+    perpRad2.push_back(TMath::Sqrt(dPhi*dPhi + dEta*dEta));
+    
+    perpPt     .push_back(TMath::Sqrt(track->Px()*track->Px()+track->Py()*track->Py()));
+    perpPtTrack.push_back(track->Pt());
+  }
+  
+  // Reference tracks and clusters distance to the candidate
+  std::vector<Float_t> refRad, refPt;
+  if(reftracks && GetIsolationCut()->GetParticleTypeInCone()!= AliIsolationCut::kOnlyNeutral)
+  {
+    for(Int_t itrack=0; itrack < reftracks->GetEntriesFast(); itrack++)
+    {
+      AliVTrack* track = (AliVTrack *) reftracks->At(itrack);
+      
+      refRad.push_back(GetIsolationCut()->Radius(etaC, phiC, track->Eta(), track->Phi()));
+      refPt .push_back(track->Pt());
+    }
+  }
+  
+  if(refclusters && GetIsolationCut()->GetParticleTypeInCone()!= AliIsolationCut::kOnlyCharged)
+  {
+    for(Int_t icalo=0; icalo < refclusters->GetEntriesFast(); icalo++)
+    {
+      AliVCluster* calo = (AliVCluster *) refclusters->At(icalo);
+      
+      calo->GetMomentum(fMomentum,vertex) ;//Assume that come from vertex in straight line
+      
+      refRad.push_back(GetIsolationCut()->Radius(etaC, phiC, fMomentum.Eta(), fMomentum.Phi()));
+      refPt .push_back(fMomentum.Pt());
+    }
+  }
+  
+  // Particles around the candidate, for the isolation decision of all cones and thresholds
+  GetIsolationCut()->FillConeProfile(reftracks, refclusters,
+                                     GetReader(), GetCaloPID(), ph);
+  
+  // Loop on cone sizes
+  for(Int_t icone = 0; icone<fNCones; icone++)
+  {
     //In case a more strict IC is needed in the produced AOD
     
     isolated = kFALSE; coneptsum = 0; coneptlead = 0;
@@ -7966,71 +8026,30 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
     
     // Tracks in perpendicular cones
     Double_t sumptPerp = 0. ;
-    TObjArray * trackList   = GetCTSTracks() ;
-    for(Int_t itrack=0; itrack < trackList->GetEntriesFast(); itrack++)
+    for(UInt_t itrack=0; itrack < perpPt.size(); itrack++)
     {
-      AliVTrack* track = (AliVTrack *) trackList->At(itrack);
-      //fill the histograms at forward range
-      if(!track)
+      if(perpRad1[itrack] < fConeSizes[icone])
       {
-        AliDebug(1,"Track not available?");
-        continue;
+        fhPerpPtLeadingPt[icone]->Fill(ptC, perpPt[itrack], GetEventWeight());
+        sumptPerp+=perpPtTrack[itrack];
       }
       
-      Double_t dPhi = phiC - track->Phi() + TMath::PiOver2();
-      Double_t dEta = etaC - track->Eta();
-      Double_t arg  = dPhi*dPhi + dEta*dEta;
-      Double_t pTrack = TMath::Sqrt(track->Px()*track->Px()+track->Py()*track->Py());
-        
-      if(TMath::Sqrt(arg) < fConeSizes[icone])
+      if(perpRad2[itrack] < fConeSizes[icone])
       {
-        fhPerpPtLeadingPt[icone]->Fill(ptC, pTrack, GetEventWeight());
-        sumptPerp+=track->Pt();
-      }
-      
-      dPhi = phiC - track->Phi() - TMath::PiOver2();
-      arg  = dPhi*dPhi + dEta*dEta;
-      if(TMath::Sqrt(arg) < fConeSizes[icone])
-      {
-        fhPerpPtLeadingPt[icone]->Fill(ptC, pTrack, GetEventWeight());
-        sumptPerp+=track->Pt();
+        fhPerpPtLeadingPt[icone]->Fill(ptC, perpPt[itrack], GetEventWeight());
+        sumptPerp+=perpPtTrack[itrack];
       }
     }
     
     fhPerpSumPtLeadingPt[icone]->Fill(ptC, sumptPerp, GetEventWeight());
     
-    // Tracks in isolation cone, pT distribution and sum
-    if(reftracks && GetIsolationCut()->GetParticleTypeInCone()!= AliIsolationCut::kOnlyNeutral)
-    {
-      for(Int_t itrack=0; itrack < reftracks->GetEntriesFast(); itrack++)
-      {
-        AliVTrack* track = (AliVTrack *) reftracks->At(itrack);
-        
-        Float_t rad = GetIsolationCut()->Radius(etaC, phiC, track->Eta(), track->Phi());
-        
-        if(rad > fConeSizes[icone]) continue ;
-        
-        fhPtLeadingPt[icone]->Fill(ptC, track->Pt(), GetEventWeight());
-        coneptsum += track->Pt();
-      }
-    }
-    
-    // Clusters in isolation cone, pT distribution and sum
-    if(refclusters && GetIsolationCut()->GetParticleTypeInCone()!= AliIsolationCut::kOnlyCharged)
+    // Tracks and clusters in isolation cone, pT distribution and sum
+    for(UInt_t iref=0; iref < refPt.size(); iref++)
     {
-      for(Int_t icalo=0; icalo < refclusters->GetEntriesFast(); icalo++)
-      {
-        AliVCluster* calo = (AliVCluster *) refclusters->At(icalo);
-        
-        calo->GetMomentum(fMomentum,vertex) ;//Assume that come from vertex in straight line
-        
-        Float_t rad = GetIsolationCut()->Radius(etaC, phiC, fMomentum.Eta(), fMomentum.Phi());
-        
-        if(rad > fConeSizes[icone]) continue ;
-        
-        fhPtLeadingPt[icone]->Fill(ptC, fMomentum.Pt(), GetEventWeight());
-        coneptsum += fMomentum.Pt();
-      }
+      if(refRad[iref] > fConeSizes[icone]) continue ;
+      
+      fhPtLeadingPt[icone]->Fill(ptC, refPt[iref], GetEventWeight());
+      coneptsum += refPt[iref];
     }
     
     fhSumPtLeadingPt[icone]->Fill(ptC, coneptsum, GetEventWeight());
@@ -8051,6 +8070,9 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
     
     ///////////////////
     
+    // Cell density only depends on the cone size
+    Float_t cellDensity = GetIsolationCut()->GetCellDensity( ph, GetReader());
+    
     //Loop on pt thresholds
     for(Int_t ipt = 0; ipt < fNPtThresFrac ; ipt++)
     {
@@ -8060,11 +8082,9 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
       GetIsolationCut()->SetPtFraction(fPtFractions[ipt]) ;
       GetIsolationCut()->SetSumPtThreshold(fSumPtThresholds[ipt]);
       
-      GetIsolationCut()->MakeIsolationCut(reftracks, refclusters,
-                                          GetReader(), GetCaloPID(),
-                                          kFALSE, ph, "",
-                                          n[icone][ipt],nfrac[icone][ipt],
-                                          coneptsum, coneptlead, isolated);
+      GetIsolationCut()->MakeIsolationCutFromConeProfile(GetReader(), ph,
+                                                         n[icone][ipt],nfrac[icone][ipt],
+                                                         coneptsum, coneptlead, isolated);
       
       // Normal pT threshold cut
       
@@ -8191,7 +8211,6 @@ void  AliAnaParticleIsolation::MakeSeveralICAnalysis(AliCaloTrackParticleCorrela
       }
       
       // density method
-      Float_t cellDensity = GetIsolationCut()->GetCellDensity( ph, GetReader());
       if(coneptsum < fSumPtThresholds[ipt]*cellDensity)
       {
         AliDebug(1,"Filling density loop");
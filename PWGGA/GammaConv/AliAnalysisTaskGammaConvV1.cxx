@@ -250,6 +250,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fnCuts(0),
   fiCut(0),
   fMoveParticleAccordingToVertex(kTRUE),
+  fBGPhotonPoolMode(0),
+  fBGEventCounter(0),
   fIsHeavyIon(0),
   fDoMesonAnalysis(kTRUE),
   fDoMesonQA(0),
@@ -460,6 +462,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fnCuts(0),
   fiCut(0),
   fMoveParticleAccordingToVertex(kTRUE),
+  fBGPhotonPoolMode(0),
+  fBGEventCounter(0),
   fIsHeavyIon(0),
   fDoMesonAnalysis(kTRUE),
   fDoMesonQA(0),
@@ -576,6 +580,19 @@ void AliAnalysisTaskGammaConvV1::InitBack(){
                                   ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity(),
                                   0,8,5);
         fBGHandlerRP[iCut] = NULL;
+        if(fBGPhotonPoolMode > 0) fBGHandler[iCut]->UsePhotonPool();
+        if(fBGPhotonPoolMode > 1 && !((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseMCPSmearing()){
+          // cuts storing the same photons share one pool
+          for(Int_t jCut = 0; jCut<iCut; jCut++){
+            if (!((AliConversionMesonCuts*)fMesonCutArray->At(jCut))->DoBGCalculation()) continue;
+            if (((AliConversionMesonCuts*)fMesonCutArray->At(jCut))->BackgroundHandlerType() != 0) continue;
+            if (((AliConversionMesonCuts*)fMesonCutArray->At(jCut))->UseMCPSmearing()) continue;
+            if (((AliConversionMesonCuts*)fMesonCutArray->At(jCut))->UseTrackMultiplicity() != ((AliConversionMesonCuts*)fMesonCutArray->At(iCut))->UseTrackMultiplicity()) continue;
+            if (cutstringEvent.CompareTo(((AliConvEventCuts*)fEventCutArray->At(jCut))->GetCutNumber()) != 0) continue;
+            if (cutstringPhoton.CompareTo(((AliConversionPhotonCuts*)fCutArray->At(jCut))->GetCutNumber()) != 0) continue;
+            if (fBGHandler[iCut]->SharePhotonPool(fBGHandler[jCut])) break;
+          }
+        }
       } else {
         fBGHandlerRP[iCut] = new AliConversionAODBGHandlerRP(
                                   ((AliConvEventCuts*)fEventCutArray->At(fiCut))->IsHeavyIon(),
@@ -1635,6 +1652,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   // Called for each event
   //
   fInputEvent = InputEvent();
+  fBGEventCounter++;
 
   // Set MC events
   if(fIsMC>0) fMCEvent = MCEvent();
@@ -3473,6 +3491,7 @@ void AliAnalysisTaskGammaConvV1::ProcessTrueMesonCandidatesAOD(AliAODConversionM
 //________________________________________________________________________
 void AliAnalysisTaskGammaConvV1::CalculateBackground(){
 
+  fBGHandler[fiCut]->SetCurrentEventID(fBGEventCounter);
   Int_t zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
   Int_t mbin = 0;
 
@@ -71,6 +71,8 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     
     // BG HandlerSettings
     void SetMoveParticleAccordingToVertex(Bool_t flag)            {fMoveParticleAccordingToVertex = flag;}
+    // 0: deep copies of photons, 1: photon pool per cut, 2: photon pool shared by cuts with same event and photon cut
+    void SetBGPhotonPoolMode(Int_t mode)                          {fBGPhotonPoolMode = mode;}
     void FillPhotonCombinatorialBackgroundHist(AliAODConversionPhoton *TruePhotonCandidate, Int_t pdgCode[], Double_t PhiParticle[]);
     void FillPhotonCombinatorialMothersHistESD(TParticle *daughter,TParticle *mother);
     void FillPhotonCombinatorialMothersHistAOD(AliAODMCParticle *daughter, AliAODMCParticle* motherCombPart);
@@ -287,6 +289,8 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     Int_t                             fnCuts;                                     //
     Int_t                             fiCut;                                      //
     Bool_t                            fMoveParticleAccordingToVertex;             //
+    Int_t                             fBGPhotonPoolMode;                          // storage of bg photons (see SetBGPhotonPoolMode)
+    Long64_t                          fBGEventCounter;                            //! number of events seen by this task, event ID for the bg photon pool
     Int_t                             fIsHeavyIon;                                //
     Bool_t                            fDoMesonAnalysis;                           //
     Int_t                             fDoMesonQA;                                 //
@@ -307,7 +311,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 42);
+    ClassDef(AliAnalysisTaskGammaConvV1, 45);
 };
 
 #endif
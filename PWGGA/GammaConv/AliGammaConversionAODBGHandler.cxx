@@ -24,6 +24,7 @@
 #include "AliKFParticle.h"
 #include "AliAODConversionPhoton.h"
 #include "AliAODConversionMother.h"
+#include "TMath.h"
 
 using namespace std;
 
@@ -45,7 +46,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(),
 	fBGEventsENeg(),
-	fBGEventsMeson()
+	fBGEventsMeson(),
+	fPhotonPool(NULL),
+	fPoolPhotons(),
+	fPoolPhotonsView()
 {
 	// constructor
 }
@@ -66,7 +70,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fPhotonPool(NULL),
+	fPoolPhotons(),
+	fPoolPhotonsView()
 {
 	// constructor
 }
@@ -89,7 +96,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fPhotonPool(NULL),
+	fPoolPhotons(),
+	fPoolPhotonsView()
 {
 	// constructor
     if(fNBinsZ>8) fNBinsZ = 8;
@@ -361,9 +371,13 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBinLimitsArrayMultiplicity(original.fBinLimitsArrayMultiplicity),
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
-	fBGEventsMeson(original.fBGEventsMeson)
+	fBGEventsMeson(original.fBGEventsMeson),
+	fPhotonPool(original.fPhotonPool),
+	fPoolPhotons(),
+	fPoolPhotonsView()
 {
 	//copy constructor	
+	if(fPhotonPool) fPhotonPool->Attach();
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -425,6 +439,12 @@ AliGammaConversionAODBGHandler::~AliGammaConversionAODBGHandler(){
 	if(fBinLimitsArrayMultiplicity){
 		delete[] fBinLimitsArrayMultiplicity;
 	}
+
+	ReleasePhotonPool();
+	for(UInt_t i=0;i<fPoolPhotons.size();i++){
+		delete fPoolPhotons[i];
+	}
+	fPoolPhotons.clear();
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -573,6 +593,12 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	Int_t z = GetZBinIndex(zvalue);
 	Int_t m = GetMultiplicityBinIndex(multiplicity);
 
+	if(fPhotonPool){
+		GammaConversionVertex vertex = {xvalue,yvalue,zvalue,epvalue};
+		fPhotonPool->AddEvent(z*fNBinsMultiplicity+m,eventGammas,vertex);
+		return;
+	}
+
 	if(fBGEventCounter[z][m] >= fNEvents){
 		fBGEventCounter[z][m]=0;
 	}
@@ -703,9 +729,68 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event){
 	//see headerfile for documentation
+	if(fPhotonPool){
+		// restore the pool photons into reused photon objects
+		Int_t nPhotons = 0;
+		const GammaConversionPhoton *photons = fPhotonPool->GetPhotons(zbin*fNBinsMultiplicity+mbin,event,nPhotons);
+		while((Int_t)fPoolPhotons.size() < nPhotons){
+			fPoolPhotons.push_back(new AliAODConversionPhoton());
+		}
+		for(Int_t i=0;i<nPhotons;i++){
+			photons[i].Get(*(fPoolPhotons[i]));
+		}
+		fPoolPhotonsView.assign(fPoolPhotons.begin(),fPoolPhotons.begin()+nPhotons);
+		return &fPoolPhotonsView;
+	}
 	return &(fBGEvents[zbin][mbin][event]);
 }
 
+//_____________________________________________________________________________________________________________________________
+const AliGammaConversionAODBGHandler::GammaConversionPhoton* AliGammaConversionAODBGHandler::GetBGPhotons(Int_t zbin, Int_t mbin, Int_t event, Int_t &nPhotons){
+	// compact BG photons, only available with photon pool
+	nPhotons = 0;
+	if(!fPhotonPool) return NULL;
+	return fPhotonPool->GetPhotons(zbin*fNBinsMultiplicity+mbin,event,nPhotons);
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::UsePhotonPool(Int_t photonsPerEvent){
+	//see headerfile for documentation
+	if(fPhotonPool) return;
+	fPhotonPool = new GammaConversionPhotonPool(fNBinsZ*fNBinsMultiplicity,fNEvents,photonsPerEvent);
+}
+
+//_____________________________________________________________________________________________________________________________
+Bool_t AliGammaConversionAODBGHandler::SharePhotonPool(AliGammaConversionAODBGHandler *handler){
+	//see headerfile for documentation
+	if(!handler || handler == this) return kFALSE;
+	if(handler->fNBinsZ != fNBinsZ || handler->fNBinsMultiplicity != fNBinsMultiplicity || handler->fNEvents != fNEvents) return kFALSE;
+	if((fBinLimitsArrayZ == NULL) != (handler->fBinLimitsArrayZ == NULL)) return kFALSE;
+	if((fBinLimitsArrayMultiplicity == NULL) != (handler->fBinLimitsArrayMultiplicity == NULL)) return kFALSE;
+	for(Int_t z=0;fBinLimitsArrayZ && z<fNBinsZ;z++){
+		if(fBinLimitsArrayZ[z] != handler->fBinLimitsArrayZ[z]) return kFALSE;
+	}
+	for(Int_t m=0;fBinLimitsArrayMultiplicity && m<fNBinsMultiplicity;m++){
+		if(fBinLimitsArrayMultiplicity[m] != handler->fBinLimitsArrayMultiplicity[m]) return kFALSE;
+	}
+
+	handler->UsePhotonPool();
+	if(fPhotonPool == handler->fPhotonPool) return kTRUE;
+	ReleasePhotonPool();
+	fPhotonPool = handler->fPhotonPool;
+	fPhotonPool->Attach();
+	return kTRUE;
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::ReleasePhotonPool(){
+	// detach from photon pool, the last user deletes it
+	if(fPhotonPool && fPhotonPool->Detach() == 0){
+		delete fPhotonPool;
+	}
+	fPhotonPool = NULL;
+}
+
 //_____________________________________________________________________________________________________________________________
 AliGammaConversionMotherAODVector* AliGammaConversionAODBGHandler::GetBGGoodMesons(Int_t zbin, Int_t mbin, Int_t event){
 	//see headerfile for documentation
@@ -728,6 +813,19 @@ AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodENeg(Int_t
 //_____________________________________________________________________________________________________________________________
 void AliGammaConversionAODBGHandler::PrintBGArray(){
 	//see headerfile for documentation
+	if(fPhotonPool){
+		for(Int_t z=0;z<fNBinsZ;z++){
+			for(Int_t multiplicity=0;multiplicity<fNBinsMultiplicity;multiplicity++){
+				for(Int_t event=0;event<fNEvents;event++){
+					Int_t nPhotons = fPhotonPool->GetNPhotons(z*fNBinsMultiplicity+multiplicity,event);
+					if(nPhotons>0){
+						cout<<"Z: "<<z<<", M: "<<multiplicity<<", Event: "<<event<<" has: "<<nPhotons<<endl;
+					}
+				}
+			}
+		}
+		return;
+	}
 	for(Int_t z=0;z<fNBinsZ;z++){
 		if(z==2){
 			cout<<"Getting the data for z bin: "<<z<<endl;
@@ -744,3 +842,128 @@ void AliGammaConversionAODBGHandler::PrintBGArray(){
 		}
 	}
 }
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::GammaConversionPhoton::Set(AliAODConversionPhoton &photon){
+	// keep the photon properties used in event mixing
+	fPx = photon.Px();
+	fPy = photon.Py();
+	fPz = photon.Pz();
+	fE = photon.E();
+	fConversionPoint[0] = photon.GetConversionX();
+	fConversionPoint[1] = photon.GetConversionY();
+	fConversionPoint[2] = photon.GetConversionZ();
+	fLabel[0] = photon.GetTrackLabelPositive();
+	fLabel[1] = photon.GetTrackLabelNegative();
+	fMCLabel[0] = photon.GetMCLabelPositive();
+	fMCLabel[1] = photon.GetMCLabelNegative();
+	fV0Index = photon.GetV0Index();
+	fCaloClusterRef = photon.GetCaloClusterRef();
+	fChi2perNDF = photon.GetChi2perNDF();
+	fIMass = photon.AliConversionPhotonBase::GetMass();
+	fPsiPair = photon.GetPsiPair();
+	fInvMassPair = photon.GetInvMassPair();
+	fDCArPrimVtx = photon.GetDCArToPrimVtx();
+	fDCAzPrimVtx = photon.GetDCAzToPrimVtx();
+	fQuality = photon.GetPhotonQuality();
+	fCaloPhoton = photon.GetIsCaloPhoton();
+	fTagged = photon.IsTagged();
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::GammaConversionPhoton::Get(AliAODConversionPhoton &photon) const{
+	// restore the kept photon properties
+	photon.SetPxPyPzE(fPx,fPy,fPz,fE);
+	Double_t conversionPoint[3] = {fConversionPoint[0],fConversionPoint[1],fConversionPoint[2]};
+	photon.SetConversionPoint(conversionPoint);
+	photon.SetTrackLabels(fLabel[0],fLabel[1]);
+	photon.SetMCLabelPositive(fMCLabel[0]);
+	photon.SetMCLabelNegative(fMCLabel[1]);
+	photon.SetV0Index(fV0Index);
+	photon.SetCaloClusterRef(fCaloClusterRef);
+	photon.SetChi2perNDF(fChi2perNDF);
+	photon.AliConversionPhotonBase::SetMass(fIMass);
+	photon.SetPsiPair(fPsiPair);
+	photon.SetInvMassPair(fInvMassPair);
+	photon.fDCArPrimVtx = fDCArPrimVtx;
+	photon.fDCAzPrimVtx = fDCAzPrimVtx;
+	photon.SetPhotonQuality(fQuality);
+	photon.fCaloPhoton = fCaloPhoton;
+	photon.SetTag(fTagged);
+}
+
+//_____________________________________________________________________________________________________________________________
+AliGammaConversionAODBGHandler::GammaConversionPhotonPool::GammaConversionPhotonPool(Int_t nBins, Int_t nEvents, Int_t photonsPerEvent) :
+	fNUsers(1),
+	fNBins(nBins),
+	fDepth(nEvents+1),
+	fCapacity(photonsPerEvent > 0 ? photonsPerEvent : 1),
+	fCurrentEventID(-1),
+	fPhotons(),
+	fNPhotons(nBins*(nEvents+1),0),
+	fEventID(nBins*(nEvents+1),-1),
+	fVertex(nBins*(nEvents+1)),
+	fNext(nBins,0)
+{
+	// one slot more than bg events per bin, so the current event can be stored
+	// while handlers sharing the pool still see all previous events
+	fPhotons.resize((size_t)fNBins*fDepth*fCapacity);
+}
+
+//_____________________________________________________________________________________________________________________________
+Bool_t AliGammaConversionAODBGHandler::GammaConversionPhotonPool::AddEvent(Int_t bin, TList* const eventGammas, const GammaConversionVertex &vertex){
+	// store photons of current event in the next slot of bin, overwriting the
+	// oldest event; returns kFALSE if the current event is already stored
+	Int_t last = bin*fDepth + (fNext[bin]+fDepth-1)%fDepth;
+	if(fCurrentEventID >= 0 && fEventID[last] == fCurrentEventID) return kFALSE;
+
+	Int_t nPhotons = eventGammas->GetEntries();
+	if(nPhotons > fCapacity) Grow(nPhotons);
+
+	Int_t slot = bin*fDepth + fNext[bin];
+	GammaConversionPhoton *photons = &fPhotons[(size_t)slot*fCapacity];
+	for(Int_t i=0;i<nPhotons;i++){
+		photons[i].Set(*(AliAODConversionPhoton*)(eventGammas->At(i)));
+	}
+	fNPhotons[slot] = nPhotons;
+	fEventID[slot] = fCurrentEventID;
+	fVertex[slot] = vertex;
+	fNext[bin] = (fNext[bin]+1)%fDepth;
+	return kTRUE;
+}
+
+//_____________________________________________________________________________________________________________________________
+Int_t AliGammaConversionAODBGHandler::GammaConversionPhotonPool::GetSlot(Int_t bin, Int_t event) const{
+	// slot of bg event in bin, skipping the slot which holds (or will hold) the current event
+	Int_t last = (fNext[bin]+fDepth-1)%fDepth;
+	Int_t current = (fCurrentEventID >= 0 && fEventID[bin*fDepth+last] == fCurrentEventID) ? last : fNext[bin];
+	return bin*fDepth + (event < current ? event : event+1);
+}
+
+//_____________________________________________________________________________________________________________________________
+const AliGammaConversionAODBGHandler::GammaConversionPhoton* AliGammaConversionAODBGHandler::GammaConversionPhotonPool::GetPhotons(Int_t bin, Int_t event, Int_t &nPhotons) const{
+	// photons of bg event in bin
+	Int_t slot = GetSlot(bin,event);
+	nPhotons = fNPhotons[slot];
+	return &fPhotons[(size_t)slot*fCapacity];
+}
+
+//_____________________________________________________________________________________________________________________________
+AliGammaConversionAODBGHandler::GammaConversionVertex* AliGammaConversionAODBGHandler::GammaConversionPhotonPool::GetVertex(Int_t bin, Int_t event){
+	// vertex of bg event in bin
+	return &fVertex[GetSlot(bin,event)];
+}
+
+//_____________________________________________________________________________________________________________________________
+void AliGammaConversionAODBGHandler::GammaConversionPhotonPool::Grow(Int_t photonsPerEvent){
+	// increase the number of photons per slot, keeping the stored events
+	Int_t capacity = TMath::Max(photonsPerEvent,2*fCapacity);
+	std::vector<GammaConversionPhoton> photons((size_t)fNBins*fDepth*capacity);
+	for(Int_t slot=0;slot<fNBins*fDepth;slot++){
+		for(Int_t i=0;i<fNPhotons[slot];i++){
+			photons[(size_t)slot*capacity+i] = fPhotons[(size_t)slot*fCapacity+i];
+		}
+	}
+	fPhotons.swap(photons);
+	fCapacity = capacity;
+}
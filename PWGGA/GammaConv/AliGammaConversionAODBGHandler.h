@@ -36,6 +36,68 @@ class AliGammaConversionAODBGHandler : public TObject {
 	
 	typedef struct GammaConversionVertex GammaConversionVertex; 																//!
 
+	// compact copy of AliAODConversionPhoton as stored in the photon pool
+	// (calo MC labels are not kept, they are not needed for mixed events)
+	struct GammaConversionPhoton{
+		Double_t fPx;
+		Double_t fPy;
+		Double_t fPz;
+		Double_t fE;
+		Double_t fConversionPoint[3];
+		Int_t fLabel[2];
+		Int_t fMCLabel[2];
+		Int_t fV0Index;
+		Long_t fCaloClusterRef;
+		Float_t fChi2perNDF;
+		Float_t fIMass;
+		Float_t fPsiPair;
+		Float_t fInvMassPair;
+		Float_t fDCArPrimVtx;
+		Float_t fDCAzPrimVtx;
+		UChar_t fQuality;
+		Bool_t fCaloPhoton;
+		Bool_t fTagged;
+
+		void Set(AliAODConversionPhoton &photon);
+		void Get(AliAODConversionPhoton &photon) const;
+	};
+
+	// preallocated ring buffer of photon events for all z/multiplicity bins:
+	// photons are stored by value in one flat array with a fixed capacity per
+	// event slot, slots are reused when the ring wraps around. The pool can be
+	// shared by several handlers with identical binning which are filled with
+	// the same photons, every event is then stored only once (see SharePhotonPool)
+	class GammaConversionPhotonPool{
+		public:
+		GammaConversionPhotonPool(Int_t nBins, Int_t nEvents, Int_t photonsPerEvent);
+
+		Bool_t AddEvent(Int_t bin, TList* const eventGammas, const GammaConversionVertex &vertex);
+		const GammaConversionPhoton* GetPhotons(Int_t bin, Int_t event, Int_t &nPhotons) const;
+		GammaConversionVertex* GetVertex(Int_t bin, Int_t event);
+		Int_t GetNPhotons(Int_t bin, Int_t event) const {return fNPhotons[GetSlot(bin,event)];}
+		Int_t GetCapacity() const {return fCapacity;}
+
+		void SetCurrentEventID(Long64_t id) {fCurrentEventID = id;}
+
+		void Attach() {fNUsers++;}
+		Int_t Detach() {return --fNUsers;}
+
+		private:
+		Int_t GetSlot(Int_t bin, Int_t event) const;
+		void Grow(Int_t photonsPerEvent);
+
+		Int_t 								fNUsers;						// number of handlers using the pool
+		Int_t 								fNBins;							// number of z/multiplicity bins
+		Int_t 								fDepth;							// event slots per bin (bg events + current event)
+		Int_t 								fCapacity;						// photons per event slot
+		Long64_t 							fCurrentEventID;				// id of event being processed (-1 = not set)
+		std::vector<GammaConversionPhoton>	fPhotons;						// photons of all slots
+		std::vector<Int_t> 					fNPhotons;						// number of photons per slot
+		std::vector<Long64_t> 				fEventID;						// event id per slot
+		std::vector<GammaConversionVertex> 	fVertex;						// event vertex per slot
+		std::vector<Int_t> 					fNext;							// next slot to fill per bin
+	};
+
 	typedef std::vector<AliGammaConversionAODVector> AliGammaConversionBGEventVector;
 	typedef std::vector<AliGammaConversionBGEventVector> AliGammaConversionMultipicityVector;
 	typedef std::vector<AliGammaConversionMultipicityVector> AliGammaConversionBGVector;
@@ -67,8 +129,17 @@ class AliGammaConversionAODBGHandler : public TObject {
 
 	Int_t GetNBGEvents()const {return fNEvents;}
 
-	// Get BG photons
+	// Store photons in a preallocated photon pool instead of deep copies
+	void UsePhotonPool(Int_t photonsPerEvent = 16);
+	// Use the photon pool of another handler with identical binning; both handlers
+	// have to be filled with the same photons and SetCurrentEventID has to be called every event
+	Bool_t SharePhotonPool(AliGammaConversionAODBGHandler *handler);
+	Bool_t UsesPhotonPool() const {return fPhotonPool != NULL;}
+	void SetCurrentEventID(Long64_t id) {if(fPhotonPool) fPhotonPool->SetCurrentEventID(id);}
+
+	// Get BG photons (with photon pool: valid until next call)
 	AliGammaConversionAODVector* GetBGGoodV0s(Int_t zbin, Int_t mbin, Int_t event);
+	const GammaConversionPhoton* GetBGPhotons(Int_t zbin, Int_t mbin, Int_t event, Int_t &nPhotons);
 	
 	// Get BG mesons
 	AliGammaConversionMotherAODVector* GetBGGoodMesons(Int_t zbin, Int_t mbin, Int_t event);
@@ -78,12 +149,17 @@ class AliGammaConversionAODBGHandler : public TObject {
 	
 	void PrintBGArray();
 
-	GammaConversionVertex * GetBGEventVertex(Int_t zbin, Int_t mbin, Int_t event){return &fBGEventVertex[zbin][mbin][event];}
+	GammaConversionVertex * GetBGEventVertex(Int_t zbin, Int_t mbin, Int_t event){
+		if(fPhotonPool) return fPhotonPool->GetVertex(zbin*fNBinsMultiplicity+mbin,event);
+		return &fBGEventVertex[zbin][mbin][event];
+	}
 
 	Double_t GetBGProb(Int_t z, Int_t m){return fBGProbability[z][m];}
 
 	private:
 
+		void ReleasePhotonPool();
+
 		Int_t 								fNEvents; 						// number of events
 		Int_t ** 							fBGEventCounter;				//! bg counter
 		Int_t ** 							fBGEventENegCounter;			//! bg electron counter
@@ -98,6 +174,9 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEvents; 						// photon background events
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector 	fBGEventsMeson; 				// neutral meson background events
+		GammaConversionPhotonPool *			fPhotonPool;					//! photon pool (optional, may be shared)
+		AliGammaConversionAODVector 		fPoolPhotons;					//! photons of pool event returned by GetBGGoodV0s (owned)
+		AliGammaConversionAODVector 		fPoolPhotonsView;				//! view on fPoolPhotons with size of pool event
 		
 	ClassDef(AliGammaConversionAODBGHandler,6)
 };
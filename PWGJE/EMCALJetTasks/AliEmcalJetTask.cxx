@@ -79,7 +79,10 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fIsEmcPart(0),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fExtraJetAlgos(),
+  fExtraRadii(),
   fJets(0),
+  fExtraJets(),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
@@ -115,7 +118,10 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fIsEmcPart(0),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fExtraJetAlgos(),
+  fExtraRadii(),
   fJets(0),
+  fExtraJets(),
   fFastJetWrapper(name,name),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap()
@@ -146,6 +152,32 @@ AliEmcalJetUtility* AliEmcalJetTask::AddUtility(AliEmcalJetUtility* utility)
   return utility;
 }
 
+/**
+ * Add a jet definition which is clustered from the same input vectors as the main one.
+ * The jets are written to a separate branch (see ExecOnce()); all other settings
+ * (jet type, recombination scheme, ghost area, jet acceptance) are the same as for the main definition.
+ * @param algo Jet algorithm
+ * @param radius Jet radius
+ */
+void AliEmcalJetTask::AddJetDefinition(EJetAlgo_t algo, Double_t radius)
+{
+  if (IsLocked()) return;
+  fExtraJetAlgos.push_back(algo);
+  fExtraRadii.push_back(radius);
+}
+
+/**
+ * Get the jet collection of a jet definition.
+ * @param idef Index of the jet definition (0 is the main jet definition, 1... the ones added via AddJetDefinition())
+ * @return Jet collection (0 if not available)
+ */
+TClonesArray* AliEmcalJetTask::GetJets(Int_t idef)
+{
+  if (idef == 0) return fJets;
+  if (idef < 0 || idef > (Int_t)fExtraJets.size()) return 0;
+  return fExtraJets[idef-1];
+}
+
 /**
  * This method is called once before analyzing the first event. It executes
  * the Init() method of all utilities (if any).
@@ -210,11 +242,15 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (UInt_t idef = 0; idef < fExtraJets.size(); idef++) {
+    if (fExtraJets[idef]) fExtraJets[idef]->Delete();
+  }
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
+  FindExtraJets();
 
   return kTRUE;
 }
@@ -284,6 +320,28 @@ Int_t AliEmcalJetTask::FindJets()
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * This method runs the jet finder for the additional jet definitions on the input vectors
+ * of the main jet definition and fills their jet branches. The settings of the FastJet
+ * wrapper are restored afterwards.
+ */
+void AliEmcalJetTask::FindExtraJets()
+{
+  if (fExtraJets.empty()) return;
+
+  for (UInt_t idef = 0; idef < fExtraJets.size(); idef++) {
+    if (!fExtraJets[idef]) continue;
+    fFastJetWrapper.ClearMemory();
+    fFastJetWrapper.SetR(fExtraRadii[idef]);
+    fFastJetWrapper.SetAlgorithm(ConvertToFJAlgo(static_cast<EJetAlgo_t>(fExtraJetAlgos[idef])));
+    if (fFastJetWrapper.Run() < 0) continue;
+    FillJetBranch(fExtraJets[idef], fExtraRadii[idef], kFALSE);
+  }
+
+  fFastJetWrapper.SetR(fRadius);
+  fFastJetWrapper.SetAlgorithm(ConvertToFJAlgo(fJetAlgo));
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -291,7 +349,18 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fJets, fRadius, kTRUE);
+}
+
+/**
+ * This method fills a jet output branch with the jets found by the FastJet wrapper.
+ * @param jets Jet branch to be filled
+ * @param radius Jet radius used by the FastJet wrapper
+ * @param doUtilities If kTRUE the utilities are executed
+ */
+void AliEmcalJetTask::FillJetBranch(TClonesArray *jets, Double_t radius, Bool_t doUtilities)
+{
+  if (doUtilities) PrepareUtilities();
 
   // loop over fastjet jets
   std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
@@ -310,7 +379,7 @@ void AliEmcalJetTask::FillJetBranch()
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
@@ -319,7 +388,7 @@ void AliEmcalJetTask::FillJetBranch()
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
     std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
@@ -333,13 +402,13 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (doUtilities) ExecuteUtilities(jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  if (doUtilities) TerminateUtilities();
 }
 
 /**
@@ -403,6 +472,23 @@ void AliEmcalJetTask::ExecOnce()
     return;
   }
 
+  // add jets of the additional jet definitions
+  fExtraJets.clear();
+  for (UInt_t idef = 0; idef < fExtraJetAlgos.size(); idef++) {
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, static_cast<EJetAlgo_t>(fExtraJetAlgos[idef]), fRecombScheme, fExtraRadii[idef], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+    TClonesArray *jets = 0;
+    if (!(InputEvent()->FindListObject(jetsName))) {
+      jets = new TClonesArray("AliEmcalJet");
+      jets->SetName(jetsName);
+      ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+      InputEvent()->AddObject(jets);
+    }
+    else {
+      AliError(Form("%s: Object with name %s already in event! Skipping this jet definition", GetName(), jetsName.Data()));
+    }
+    fExtraJets.push_back(jets);
+  }
+
   // setup fj wrapper
   fFastJetWrapper.SetAreaType(fastjet::active_area_explicit_ghosts);
   fFastJetWrapper.SetGhostArea(fGhostArea);
@@ -4,6 +4,8 @@
 /* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
  * See cxx source for full Copyright notice                               */
 
+#include <vector>
+
 class TClonesArray;
 class TObjArray;
 class AliVEvent;
@@ -44,6 +46,11 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (algorithm and radius) can be added via AddJetDefinition(EJetAlgo_t, Double_t).
+ * They are clustered from the same input vectors, which are built only once per event, and each of them
+ * is written to its own jet branch, named as if it was produced by a separate jet finder task with the
+ * same jet type, recombination scheme and constituents. Utilities are executed only for the main jet definition.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -87,6 +94,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetPhiRange(Double_t pmi, Double_t pma);
 
   AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility);
+  void                   AddJetDefinition(EJetAlgo_t algo, Double_t radius);
 
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
@@ -107,6 +115,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  Int_t                  GetNJetDefinitions() const       { return fExtraJetAlgos.size() + 1; }
+  TClonesArray*          GetJets(Int_t idef);
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
@@ -153,6 +163,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   FillJetBranch(TClonesArray *jets, Double_t radius, Bool_t doUtilities);
+  void                   FindExtraJets();
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -190,8 +202,11 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fIsEmcPart;              //!<!=true if emcal particles are given as input (for clusters)
   Bool_t                 fLegacyMode;             //!<!=true to enable FJ 2.x behavior
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
+  std::vector<Int_t>     fExtraJetAlgos;          ///< jet algorithms of the additional jet definitions
+  std::vector<Double_t>  fExtraRadii;             ///< jet radii of the additional jet definitions
 
   TClonesArray          *fJets;                   //!<!jet collection
+  std::vector<TClonesArray*> fExtraJets;          //!<!jet collections of the additional jet definitions
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
 
   static const Int_t     fgkConstIndexShift;      //!<!contituent index shift
@@ -207,7 +222,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 26);
+  ClassDef(AliEmcalJetTask, 27);
   /// \endcond
 };
 #endif
@@ -14,12 +14,20 @@
 //
 
 #include <Riostream.h>
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <map>
+#include <thread>
 
 #include <TH1.h>
+#include <THnSparse.h>
 #include <TList.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TStopwatch.h>
 #include "TRandom.h"
+#include "TRandom3.h"
 
 #include "AliLog.h"
 #include "AliEventplane.h"
@@ -50,6 +58,7 @@
 
 
 ClassImp(AliRsnMiniAnalysisTask)
+ClassImp(TestAliRsnMiniAnalysisTask)
 
 //__________________________________________________________________________________________________
 AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
@@ -71,6 +80,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fMaxDiffMult(10),
    fMaxDiffVz(1.0),
    fMaxDiffAngle(1E20),
+   fMixInMemory(kFALSE),
+   fMixNThreads(1),
    fOutput(0x0),
    fHistograms("AliRsnMiniOutput", 0),
    fValues("AliRsnMiniValue", 0),
@@ -128,6 +139,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC,Bo
    fMaxDiffMult(10),
    fMaxDiffVz(1.0),
    fMaxDiffAngle(1E20),
+   fMixInMemory(kFALSE),
+   fMixNThreads(1),
    fOutput(0x0),
    fHistograms("AliRsnMiniOutput", 0),
    fValues("AliRsnMiniValue", 0),
@@ -191,6 +204,8 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fMaxDiffMult(copy.fMaxDiffMult),
    fMaxDiffVz(copy.fMaxDiffVz),
    fMaxDiffAngle(copy.fMaxDiffAngle),
+   fMixInMemory(copy.fMixInMemory),
+   fMixNThreads(copy.fMixNThreads),
    fOutput(0x0),
    fHistograms(copy.fHistograms),
    fValues(copy.fValues),
@@ -259,6 +274,8 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fMaxDiffMult = copy.fMaxDiffMult;
    fMaxDiffVz = copy.fMaxDiffVz;
    fMaxDiffAngle = copy.fMaxDiffAngle;
+   fMixInMemory = copy.fMixInMemory;
+   fMixNThreads = copy.fMixNThreads;
    fHistograms = copy.fHistograms;
    fValues = copy.fValues;
    fHEventStat = copy.fHEventStat;
@@ -505,6 +522,11 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       else printNum = 0;
    }
 
+   // mini-events kept in memory for the mixing
+   std::vector<AliRsnMiniEvent *> events;
+   Bool_t keepEvents = (fMixInMemory && fNMix > 0);
+   if (keepEvents) events.reserve(nEvents);
+
    // loop on events, and for each one fill all outputs
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
@@ -513,6 +535,8 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      BuildSelections(fMiniEvent);
+      if (keepEvents) events.push_back(new AliRsnMiniEvent(*fMiniEvent));
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -562,6 +586,27 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
+   // in-memory mixing: partners are searched in bins and
+   // the pairs are filled without reading the buffer again
+   if (fMixInMemory) {
+      AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
+      timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
+
+      std::vector< std::vector<Int_t> > matched(nEvents);
+      FindMixPartners(events, matched);
+      AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
+      timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
+
+      FillMixedPairs(events, matched);
+      for (ievt = 0; ievt < nEvents; ievt++) delete events[ievt];
+      AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
+      timer.Stop(); timer.Print(); fflush(stdout);
+
+      PostData(1, fOutput);
+      if (fRsnTreeInFile) PostData(2, fEvBuffer);
+      return;
+   }
+
    // initialize mixing counter
    Int_t    nmatched[nEvents];
    TString *smatched = new TString[nEvents];
@@ -617,12 +662,14 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       }
       ifill = 0;
       fEvBuffer->GetEntry(ievt);
+      BuildSelections(fMiniEvent);
       AliRsnMiniEvent evMain(*fMiniEvent);
       list = smatched[ievt].Tokenize("|");
       TObjArrayIter next(list);
       while ( (os = (TObjString *)next()) ) {
          imix = os->GetString().Atoi();
          fEvBuffer->GetEntry(imix);
+         BuildSelections(fMiniEvent);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
             if (!def) continue;
@@ -1489,6 +1536,254 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::BuildSelections(AliRsnMiniEvent *event)
+{
+//
+// Precompute in the event the list of particles selected by each daughter
+// definition (charge and cut ID) of the pair outputs, so that it is built
+// once per event and shared by all outputs using the same definition
+// instead of being rebuilt by each of them in AliRsnMiniOutput::FillPair().
+//
+
+   if (!event) return;
+   Int_t idef, nDefs = fHistograms.GetEntries();
+   AliRsnMiniOutput *def = 0x0;
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def) continue;
+      switch (def->GetComputation()) {
+         case AliRsnMiniOutput::kTrackPair:
+         case AliRsnMiniOutput::kTrackPairMix:
+         case AliRsnMiniOutput::kTrackPairRotated1:
+         case AliRsnMiniOutput::kTrackPairRotated2:
+         case AliRsnMiniOutput::kTruePair:
+            event->BuildSelection((Char_t)def->GetCharge(0), def->GetCutID(0));
+            event->BuildSelection((Char_t)def->GetCharge(1), def->GetCutID(1));
+            break;
+         default:
+            break;
+      }
+   }
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FindMixPartners(std::vector<AliRsnMiniEvent *> &events, std::vector< std::vector<Int_t> > &matched)
+{
+//
+// Search the mixing partners of the mini-events kept in memory.
+// The events are grouped in cells of size fMaxDiffVz, fMaxDiffMult and fMaxDiffAngle,
+// so that only the events up to two cells away (continuous mixing) or in the
+// same cell (binned mixing) are checked with EventsMatch(). Candidates are visited
+// in the same wrap-around order as in the scan over the buffer, and events which
+// are already mixed enough times are skipped, so the matches are the same.
+//
+
+   Int_t ievt, nEvents = (Int_t)events.size();
+   Double_t size[3] = {fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle};
+
+   // assign each event to a cell
+   std::map<std::array<Long64_t, 3>, Int_t> cellID;
+   std::vector< std::vector<Int_t> > cells;         // event indices in each cell (ordered)
+   std::vector< std::vector<Int_t> > next;          // next event not yet mixed enough times in each cell
+   std::vector<Int_t> evCell(nEvents), evPos(nEvents);
+   std::vector< std::array<Long64_t, 3> > evKey(nEvents);
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      AliRsnMiniEvent *ev = events[ievt];
+      Double_t value[3] = {ev->Vz(), ev->Mult(), ev->Angle()};
+      for (Int_t k = 0; k < 3; k++) {
+         // a single cell along this axis if no meaningful size is given
+         Double_t x = (size[k] > 0.0) ? value[k] / size[k] : 0.0;
+         if (!(TMath::Abs(x) < 1E15)) x = 0.0;
+         evKey[ievt][k] = (Long64_t)(fContinuousMix ? TMath::Floor(x) : x);
+      }
+      std::map<std::array<Long64_t, 3>, Int_t>::iterator it = cellID.find(evKey[ievt]);
+      if (it == cellID.end()) {
+         it = cellID.insert(std::make_pair(evKey[ievt], (Int_t)cells.size())).first;
+         cells.push_back(std::vector<Int_t>());
+      }
+      evCell[ievt] = it->second;
+      evPos[ievt] = (Int_t)cells[it->second].size();
+      cells[it->second].push_back(ievt);
+   }
+   next.resize(cells.size());
+   for (UInt_t c = 0; c < cells.size(); c++) {
+      next[c].resize(cells[c].size() + 1);
+      for (UInt_t i = 0; i < next[c].size(); i++) next[c][i] = i;
+   }
+
+   // first position >= pos in cell c of an event which can still be mixed
+   struct Cursor { Int_t cell, pos, start; Bool_t wrapped; };
+   auto findNext = [&next](Int_t c, Int_t pos) {
+      std::vector<Int_t> &n = next[c];
+      Int_t root = pos;
+      while (n[root] != root) root = n[root];
+      while (n[pos] != root) { Int_t tmp = n[pos]; n[pos] = root; pos = tmp; }
+      return root;
+   };
+   std::vector<Int_t> nmatched(nEvents, 0);
+   auto addMatch = [&](Int_t ev) {
+      if (++nmatched[ev] >= fNMix) next[evCell[ev]][evPos[ev]] = evPos[ev] + 1;
+   };
+
+   std::vector<Cursor> cursors;
+   Int_t printNum = fMixPrintRefresh;
+   if (printNum < 0) printNum = (nEvents > 1e5) ? nEvents / 100 : ((nEvents > 1e4) ? nEvents / 10 : 0);
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      if (printNum && (ievt % printNum == 0)) AliInfo(Form("[%s] EventMixing searching %d/%d", GetName(), ievt, nEvents));
+      if (nmatched[ievt] >= fNMix) continue;
+
+      // cursors on the candidate cells, starting after the main event;
+      // a difference of exactly the cell size, as accepted by EventsMatch(),
+      // can end up two cells away after rounding of the float event variables
+      cursors.clear();
+      Int_t range = fContinuousMix ? 2 : 0;
+      std::array<Long64_t, 3> key;
+      for (Int_t d0 = -range; d0 <= range; d0++) {
+         for (Int_t d1 = -range; d1 <= range; d1++) {
+            for (Int_t d2 = -range; d2 <= range; d2++) {
+               key[0] = evKey[ievt][0] + d0;
+               key[1] = evKey[ievt][1] + d1;
+               key[2] = evKey[ievt][2] + d2;
+               std::map<std::array<Long64_t, 3>, Int_t>::iterator it = cellID.find(key);
+               if (it == cellID.end()) continue;
+               const std::vector<Int_t> &cell = cells[it->second];
+               Cursor cur;
+               cur.cell = it->second;
+               cur.start = (Int_t)(std::upper_bound(cell.begin(), cell.end(), ievt) - cell.begin());
+               cur.pos = cur.start;
+               cur.wrapped = kFALSE;
+               cursors.push_back(cur);
+            }
+         }
+      }
+
+      AliRsnMiniEvent *evMain = events[ievt];
+      while (nmatched[ievt] < fNMix) {
+         // pick the candidate following the main event most closely, with wrap-around
+         Int_t best = -1, bestDist = nEvents, imix = -1;
+         for (UInt_t ic = 0; ic < cursors.size(); ic++) {
+            Cursor &cur = cursors[ic];
+            const std::vector<Int_t> &cell = cells[cur.cell];
+            cur.pos = findNext(cur.cell, cur.pos);
+            if (!cur.wrapped && cur.pos >= (Int_t)cell.size()) {
+               cur.wrapped = kTRUE;
+               cur.pos = findNext(cur.cell, 0);
+            }
+            if (cur.wrapped && cur.pos >= cur.start) continue;
+            Int_t dist = (cell[cur.pos] - ievt + nEvents) % nEvents;
+            if (dist < bestDist) {
+               bestDist = dist;
+               best = ic;
+               imix = cell[cur.pos];
+            }
+         }
+         if (best < 0) break;
+         cursors[best].pos++;
+         if (imix == ievt) continue;
+         // skip if events are not matched
+         if (!EventsMatch(evMain, events[imix])) continue;
+         // check that the array of good matches for mixed does not already contain main event
+         if (std::find(matched[imix].begin(), matched[imix].end(), ievt) != matched[imix].end()) continue;
+         // add new mixing candidate
+         matched[ievt].push_back(imix);
+         addMatch(ievt);
+         addMatch(imix);
+      }
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", evMain->ID(), nmatched[ievt]));
+   }
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FillMixedPairs(std::vector<AliRsnMiniEvent *> &events, const std::vector< std::vector<Int_t> > &matched)
+{
+//
+// Fill the mixing outputs for the matches found by FindMixPartners().
+// With fMixNThreads > 1 the main events are shared among threads, each filling
+// its own copy of the outputs and of the values, which are added to the task
+// outputs at the end. Pair cuts are not thread safe: if any mixing output uses
+// them, one thread is used.
+//
+
+   Int_t idef, nDefs = fHistograms.GetEntries(), nEvents = (Int_t)events.size();
+   std::vector<AliRsnMiniOutput *> mixDefs;
+   Int_t nThreads = fMixNThreads;
+   for (idef = 0; idef < nDefs; idef++) {
+      AliRsnMiniOutput *def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def || !def->IsTrackPairMix()) continue;
+      mixDefs.push_back(def);
+      if (def->GetPairCuts() && nThreads > 1) {
+         AliWarning(Form("[%s] Output '%s' uses pair cuts: mixing is done in one thread", GetName(), def->GetName()));
+         nThreads = 1;
+      }
+   }
+   Int_t nMixDefs = (Int_t)mixDefs.size();
+   if (nThreads < 1) nThreads = 1;
+   if (nThreads > nEvents) nThreads = TMath::Max(nEvents, 1);
+
+   // fill the mixing of main events ievt = first, first + step, ...
+   auto fill = [&events, &matched, nEvents](std::vector<AliRsnMiniOutput *> &defs, TClonesArray *values, Int_t first, Int_t step) {
+      for (Int_t ievt = first; ievt < nEvents; ievt += step) {
+         AliRsnMiniEvent *evMain = events[ievt];
+         for (UInt_t im = 0; im < matched[ievt].size(); im++) {
+            AliRsnMiniEvent *evMix = events[matched[ievt][im]];
+            for (UInt_t id = 0; id < defs.size(); id++) {
+               defs[id]->FillPair(evMain, evMix, values, kTRUE);
+               if (!defs[id]->IsSymmetric()) defs[id]->FillPair(evMix, evMain, values, kFALSE);
+            }
+         }
+      }
+   };
+
+   if (nThreads == 1) {
+      fill(mixDefs, &fValues, 0, 1);
+      return;
+   }
+
+   // copies of the outputs and values for each thread, created here and not
+   // attached to any directory, since the threads only fill them
+   std::vector< std::vector<AliRsnMiniOutput *> > threadDefs(nThreads);
+   std::vector<TList *> threadLists(nThreads);
+   std::vector<TClonesArray *> threadValues(nThreads);
+   Bool_t addStatus = TH1::AddDirectoryStatus();
+   TH1::AddDirectory(kFALSE);
+   for (Int_t t = 0; t < nThreads; t++) {
+      threadValues[t] = (TClonesArray *)fValues.Clone();
+      threadLists[t] = new TList();
+      threadLists[t]->SetOwner();
+      for (idef = 0; idef < nMixDefs; idef++) {
+         TObject *obj = mixDefs[idef]->GetOutput()->Clone();
+         if (obj->InheritsFrom(TH1::Class())) ((TH1 *)obj)->Reset();
+         else if (obj->InheritsFrom(THnSparse::Class())) ((THnSparse *)obj)->Reset();
+         threadLists[t]->Add(obj);
+         AliRsnMiniOutput *def = new AliRsnMiniOutput(*mixDefs[idef]);
+         def->SetOutput(threadLists[t], idef);
+         threadDefs[t].push_back(def);
+      }
+   }
+   TH1::AddDirectory(addStatus);
+
+   // the threads still use ROOT internals (type checks and lookups in FillHistogram)
+   ROOT::EnableThreadSafety();
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < nThreads; t++)
+      threads.push_back(std::thread(fill, std::ref(threadDefs[t]), threadValues[t], t, nThreads));
+   for (Int_t t = 0; t < nThreads; t++) threads[t].join();
+
+   // add the outputs of all threads
+   for (Int_t t = 0; t < nThreads; t++) {
+      for (idef = 0; idef < nMixDefs; idef++) {
+         TObject *out = mixDefs[idef]->GetOutput();
+         TObject *obj = threadLists[t]->At(idef);
+         if (out->InheritsFrom(TH1::Class())) ((TH1 *)out)->Add((TH1 *)obj);
+         else if (out->InheritsFrom(THnSparse::Class())) ((THnSparse *)out)->Add((THnSparse *)obj);
+         delete threadDefs[t][idef];
+      }
+      delete threadLists[t];
+      delete threadValues[t];
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
@@ -1739,3 +2034,184 @@ AliQnCorrectionsQnVector *AliRsnMiniAnalysisTask::GetQnVectorFromList(
   }
   return theQnVector;
 }
+
+//__________________________________________________________________________________________________
+Bool_t TestAliRsnMiniAnalysisTask::RunAllTests() const
+{
+//
+// Run the mixing test for continuous and binned mixing
+//
+
+   Bool_t ok = kTRUE;
+   if (!TestMixing(kTRUE)) ok = kFALSE;
+   if (!TestMixing(kFALSE)) ok = kFALSE;
+   return ok;
+}
+
+//__________________________________________________________________________________________________
+Bool_t TestAliRsnMiniAnalysisTask::TestMixing(Bool_t continuous) const
+{
+//
+// Fill the mixed-event outputs of the same mini-events with the mixing reading
+// the buffer tree and with the in-memory mixing in one and in four threads,
+// and compare the outputs bin by bin
+//
+
+   // the task destructor needs an analysis manager
+   if (!AliAnalysisManager::GetAnalysisManager()) new AliAnalysisManager("TestRsnMiniMixing");
+
+   AliRsnMiniAnalysisTask *reference = CreateTask("testMixTree", continuous, kFALSE, 1);
+   reference->FinishTaskOutput();
+
+   Bool_t ok = kTRUE;
+   const Int_t nThreads[2] = {1, 4};
+   for (Int_t i = 0; i < 2; i++) {
+      AliRsnMiniAnalysisTask *test = CreateTask(Form("testMixMemory%d", nThreads[i]), continuous, kTRUE, nThreads[i]);
+      test->FinishTaskOutput();
+      if (!CompareOutputs(reference, test)) {
+         printf("%s mixing in memory with %d thread(s) differs from the mixing reading the buffer tree\n", continuous ? "Continuous" : "Binned", nThreads[i]);
+         ok = kFALSE;
+      }
+      DeleteTask(test);
+   }
+   DeleteTask(reference);
+   return ok;
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniAnalysisTask *TestAliRsnMiniAnalysisTask::CreateTask(const char *name, Bool_t continuous, Bool_t inMemory, Int_t nThreads) const
+{
+//
+// Create a task with two mixing outputs (unlike-sign histogram, filled in both
+// orders, and like-sign sparse histogram) and fill its buffer tree with the same
+// random mini-events for all tasks. Vz and multiplicity are multiples of the
+// maximum differences, so that many pairs of events differ by exactly the
+// maximum difference, i.e. lie on the cell edges of the partner search.
+//
+
+   AliRsnMiniAnalysisTask *task = new AliRsnMiniAnalysisTask(name);
+   task->SetNMix(5);
+   if (continuous) task->UseContinuousMix(); else task->UseBinnedMix();
+   task->SetMaxDiffVz(0.1);
+   task->SetMaxDiffMult(5.0);
+   task->SetMaxDiffAngle(0.5);
+   task->SetMixInMemory(inMemory);
+   task->SetMixNThreads(nThreads);
+   task->SetMixPrintRefresh(0);
+
+   Int_t imID = task->CreateValue(AliRsnMiniValue::kInvMass, kFALSE);
+   Int_t ptID = task->CreateValue(AliRsnMiniValue::kPt, kFALSE);
+   AliRsnMiniOutput *out = task->CreateOutput("mixPM", "HIST", "MIX");
+   out->SetCutID(0, 0);
+   out->SetCutID(1, 0);
+   out->SetDaughter(0, AliRsnDaughter::kPion);
+   out->SetDaughter(1, AliRsnDaughter::kPion);
+   out->SetCharge(0, '+');
+   out->SetCharge(1, '-');
+   out->AddAxis(imID, 100, 0.0, 2.0);
+   out = task->CreateOutput("mixPP", "SPARSE", "MIX");
+   out->SetCutID(0, 0);
+   out->SetCutID(1, 0);
+   out->SetDaughter(0, AliRsnDaughter::kPion);
+   out->SetDaughter(1, AliRsnDaughter::kPion);
+   out->SetCharge(0, '+');
+   out->SetCharge(1, '+');
+   out->AddAxis(imID, 100, 0.0, 2.0);
+   out->AddAxis(ptID, 20, 0.0, 4.0);
+
+   // outputs and buffer as created in UserCreateOutputObjects
+   Bool_t addStatus = TH1::AddDirectoryStatus();
+   TH1::AddDirectory(kFALSE);
+   task->fOutput = new TList();
+   task->fOutput->SetOwner();
+   for (Int_t idef = 0; idef < task->fHistograms.GetEntries(); idef++)
+      ((AliRsnMiniOutput *)task->fHistograms[idef])->Init(task->GetName(), task->fOutput);
+   TH1::AddDirectory(addStatus);
+   task->fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");
+   task->fEvBuffer->SetDirectory(0);
+   task->fMiniEvent = new AliRsnMiniEvent();
+   task->fEvBuffer->Branch("events", "AliRsnMiniEvent", &task->fMiniEvent);
+
+   TRandom3 rnd(1234);
+   const Int_t nEvents = 500;
+   AliRsnMiniParticle part;
+   for (Int_t ievt = 0; ievt < nEvents; ievt++) {
+      AliRsnMiniEvent *ev = task->fMiniEvent;
+      ev->Clear();
+      ev->ID() = ievt;
+      ev->Vz() = 0.1 * rnd.Integer(20) - 1.0;
+      ev->Mult() = 5.0 * rnd.Integer(10);
+      ev->Angle() = rnd.Uniform(0.0, TMath::Pi());
+      Int_t nPart = 2 + rnd.Integer(8);
+      for (Int_t ip = 0; ip < nPart; ip++) {
+         part.Index() = ip;
+         part.Charge() = (rnd.Rndm() < 0.5) ? '+' : '-';
+         part.PrecX() = rnd.Gaus(0.0, 0.5);
+         part.PrecY() = rnd.Gaus(0.0, 0.5);
+         part.PrecZ() = rnd.Gaus(0.0, 0.5);
+         part.PsimX() = part.PrecX();
+         part.PsimY() = part.PrecY();
+         part.PsimZ() = part.PrecZ();
+         part.CutBits() = 0;
+         part.SetCutBit(0);
+         ev->AddParticle(part);
+      }
+      task->fEvBuffer->Fill();
+   }
+   return task;
+}
+
+//__________________________________________________________________________________________________
+Bool_t TestAliRsnMiniAnalysisTask::CompareOutputs(AliRsnMiniAnalysisTask *reference, AliRsnMiniAnalysisTask *test) const
+{
+//
+// Compare the mixing outputs of the two tasks bin by bin
+//
+
+   Bool_t ok = kTRUE;
+   for (Int_t idef = 0; idef < reference->fHistograms.GetEntries(); idef++) {
+      AliRsnMiniOutput *refDef = (AliRsnMiniOutput *)reference->fHistograms[idef];
+      AliRsnMiniOutput *testDef = (AliRsnMiniOutput *)test->fHistograms[idef];
+      TObject *refOut = refDef->GetOutput(), *testOut = testDef->GetOutput();
+      if (refOut->InheritsFrom(TH1::Class())) {
+         TH1 *refHist = (TH1 *)refOut, *testHist = (TH1 *)testOut;
+         if (refHist->GetEntries() < 1) {
+            printf("Output '%s': no mixed pairs filled\n", refDef->GetName());
+            ok = kFALSE;
+         }
+         for (Int_t ibin = 0; ibin < refHist->GetNcells(); ibin++) {
+            if (refHist->GetBinContent(ibin) != testHist->GetBinContent(ibin)) {
+               printf("Output '%s', bin %d: %f (tree) != %f (memory)\n", refDef->GetName(), ibin, refHist->GetBinContent(ibin), testHist->GetBinContent(ibin));
+               ok = kFALSE;
+            }
+         }
+      } else {
+         THnSparse *refHist = (THnSparse *)refOut, *testHist = (THnSparse *)testOut;
+         if (refHist->GetNbins() < 1 || refHist->GetNbins() != testHist->GetNbins()) {
+            printf("Output '%s': %lld filled bins (tree), %lld (memory)\n", refDef->GetName(), refHist->GetNbins(), testHist->GetNbins());
+            ok = kFALSE;
+         }
+         Int_t coord[2];
+         for (Long64_t ibin = 0; ibin < refHist->GetNbins(); ibin++) {
+            Double_t content = refHist->GetBinContent(ibin, coord);
+            if (content != testHist->GetBinContent(coord)) {
+               printf("Output '%s', bin (%d,%d): %f (tree) != %f (memory)\n", refDef->GetName(), coord[0], coord[1], content, testHist->GetBinContent(coord));
+               ok = kFALSE;
+            }
+         }
+      }
+   }
+   return ok;
+}
+
+//__________________________________________________________________________________________________
+void TestAliRsnMiniAnalysisTask::DeleteTask(AliRsnMiniAnalysisTask *task) const
+{
+//
+// Delete the task with its outputs, buffer and mini-event
+//
+
+   AliRsnMiniEvent *ev = task->fMiniEvent;
+   delete task;
+   delete ev;
+}
@@ -12,6 +12,8 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <vector>
+
 #include <TString.h>
 #include <TClonesArray.h>
 
@@ -57,6 +59,8 @@ public:
    void                SetMaxDiffMult (Double_t val)      {fMaxDiffMult  = val;}
    void                SetMaxDiffVz   (Double_t val)      {fMaxDiffVz    = val;}
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
+   void                SetMixInMemory(Bool_t yn = kTRUE)  {fMixInMemory = yn;}
+   void                SetMixNThreads(Int_t n)            {fMixNThreads = n;}
    void                SetEventCuts(AliRsnCutSet *cuts)   {fEventCuts    = cuts;}
    void                SetMixPrintRefresh(Int_t n)        {fMixPrintRefresh = n;}
    void                SetCheckDecay(Bool_t checkDecay = kTRUE) {fCheckDecay = checkDecay;}
@@ -88,6 +92,8 @@ public:
 
 private:
 
+   friend class TestAliRsnMiniAnalysisTask;
+
    Char_t   CheckCurrentEvent();
    void     FillMiniEvent(Char_t evType);
    Double_t ComputeAngle();
@@ -101,6 +107,9 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   void     BuildSelections(AliRsnMiniEvent *event);
+   void     FindMixPartners(std::vector<AliRsnMiniEvent *> &events, std::vector< std::vector<Int_t> > &matched);
+   void     FillMixedPairs(std::vector<AliRsnMiniEvent *> &events, const std::vector< std::vector<Int_t> > &matched);
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -123,6 +132,8 @@ private:
    Double_t             fMaxDiffMult;     //  mixing --> max difference in multiplicity
    Double_t             fMaxDiffVz;       //  mixing --> max difference in Vz of prim vert
    Double_t             fMaxDiffAngle;    //  mixing --> max difference in reaction plane angle
+   Bool_t               fMixInMemory;     //  mixing --> keep mini-events in memory and search partners in bins of vz, mult and angle
+   Int_t                fMixNThreads;     //  mixing --> number of threads filling the mixed pairs (in-memory mixing only)
 
    TList               *fOutput;          //  output list
    TClonesArray         fHistograms;      //  list of histogram definitions
@@ -158,7 +169,32 @@ private:
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
    Bool_t               fRsnTreeInFile;  // flag rsn tree should be saved in file instead of memory
 
-   ClassDef(AliRsnMiniAnalysisTask, 15);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 16);   // AliRsnMiniAnalysisTask
+};
+
+//
+// Unit test of the in-memory event mixing: the mixed-event outputs filled
+// with SetMixInMemory() (in one and in several threads) have to be identical
+// to the ones of the mixing reading the buffer tree, for continuous and
+// binned mixing, with event variables on the cell edges of the partner search.
+//
+class TestAliRsnMiniAnalysisTask : public TObject {
+
+public:
+
+   TestAliRsnMiniAnalysisTask() : TObject() {}
+   virtual ~TestAliRsnMiniAnalysisTask() {}
+
+   Bool_t RunAllTests() const;
+   Bool_t TestMixing(Bool_t continuous) const;
+
+private:
+
+   AliRsnMiniAnalysisTask *CreateTask(const char *name, Bool_t continuous, Bool_t inMemory, Int_t nThreads) const;
+   Bool_t                  CompareOutputs(AliRsnMiniAnalysisTask *reference, AliRsnMiniAnalysisTask *test) const;
+   void                    DeleteTask(AliRsnMiniAnalysisTask *task) const;
+
+   ClassDef(TestAliRsnMiniAnalysisTask, 0);   // unit test of the in-memory event mixing
 };
 
 
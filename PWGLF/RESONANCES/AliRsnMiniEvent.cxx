@@ -26,7 +26,12 @@ AliRsnMiniEvent::AliRsnMiniEvent(const AliRsnMiniEvent &copy) :
    fLeading(copy.fLeading),
    fParticles(copy.fParticles),
    fRef(copy.fRef),
-   fRefMC(copy.fRefMC)
+   fRefMC(copy.fRefMC),
+   fSelID(copy.fSelID),
+   fSelCharge(copy.fSelCharge),
+   fSelCutID(copy.fSelCutID),
+   fSelStart(copy.fSelStart),
+   fSelIndex(copy.fSelIndex)
 {
 //
 // Copy constructor.
@@ -58,6 +63,11 @@ AliRsnMiniEvent &AliRsnMiniEvent::operator=(const AliRsnMiniEvent &copy)
    fParticles = copy.fParticles;
    fRef = copy.fRef;
    fRefMC = copy.fRefMC;
+   fSelID = copy.fSelID;
+   fSelCharge = copy.fSelCharge;
+   fSelCutID = copy.fSelCutID;
+   fSelStart = copy.fSelStart;
+   fSelIndex = copy.fSelIndex;
    return (*this);
 }
 
@@ -79,6 +89,7 @@ void AliRsnMiniEvent::Clear(Option_t *)
     fRefMC = 0;
 
     fParticles.Clear("C");
+    ClearSelections();
 }
 
 //__________________________________________________________________________________________________
@@ -114,7 +125,7 @@ AliRsnMiniParticle *AliRsnMiniEvent::GetParticle(Int_t i)
 
    if (i < 0 || i > fParticles.GetEntriesFast()) return 0x0;
 
-   return (AliRsnMiniParticle *)fParticles[i];
+   return (AliRsnMiniParticle *)fParticles.At(i);
 }
 
 //__________________________________________________________________________________________________
@@ -146,7 +157,7 @@ Int_t AliRsnMiniEvent::CountParticles(TArrayI &found, Char_t charge, Int_t cutID
    found.Set(npart);
 
    for (i = 0; i < npart; i++) {
-      part = (AliRsnMiniParticle *)fParticles[i];
+      part = (AliRsnMiniParticle *)fParticles.UncheckedAt(i);
       if (charge == '+' || charge == '-' || charge == '0') {
          if (part->Charge() != charge) continue;
       }
@@ -160,3 +171,76 @@ Int_t AliRsnMiniEvent::CountParticles(TArrayI &found, Char_t charge, Int_t cutID
    found.Set(count);
    return count;
 }
+
+//__________________________________________________________________________________________________
+void AliRsnMiniEvent::ClearSelections()
+{
+//
+// Removes all precomputed selections
+//
+
+   fSelID = -1;
+   fSelCharge.clear();
+   fSelCutID.clear();
+   fSelStart.clear();
+   fSelIndex.clear();
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniEvent::BuildSelection(Char_t charge, Int_t cutID)
+{
+//
+// Stores the indexes of the particles with the specified charge and cut bit
+// (same criteria as CountParticles()), so that all outputs using them
+// can share the list through GetSelection().
+// Selections are bound to the event ID: when the object is filled with
+// another event (e.g. reading the mini-event tree), they are rebuilt.
+//
+
+   if (fSelID != fID) {
+      ClearSelections();
+      fSelID = fID;
+   }
+   if (charge != '+' && charge != '-' && charge != '0') charge = 0;
+   if (cutID < 0) cutID = -1;
+   for (UInt_t is = 0; is < fSelCharge.size(); is++) {
+      if (fSelCharge[is] == charge && fSelCutID[is] == cutID) return;
+   }
+
+   if (fSelStart.empty()) fSelStart.push_back(0);
+   Int_t i, npart = fParticles.GetEntriesFast();
+   AliRsnMiniParticle *part = 0x0;
+   for (i = 0; i < npart; i++) {
+      part = (AliRsnMiniParticle *)fParticles.UncheckedAt(i);
+      if (charge && part->Charge() != charge) continue;
+      if (cutID >= 0 && !part->HasCutBit(cutID)) continue;
+      fSelIndex.push_back(i);
+   }
+   fSelCharge.push_back(charge);
+   fSelCutID.push_back(cutID);
+   fSelStart.push_back((Int_t)fSelIndex.size());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniEvent::GetSelection(Char_t charge, Int_t cutID, const Int_t *&sel, Int_t &n) const
+{
+//
+// Points 'sel' to the indexes of the particles with the specified charge
+// and cut bit stored by BuildSelection() and sets their number in 'n'.
+// Returns kFALSE if that selection was not built for the current event.
+// Does not modify the object, so it can be called concurrently.
+//
+
+   sel = 0x0;
+   n = 0;
+   if (fSelID != fID) return kFALSE;
+   if (charge != '+' && charge != '-' && charge != '0') charge = 0;
+   if (cutID < 0) cutID = -1;
+   for (UInt_t is = 0; is < fSelCharge.size(); is++) {
+      if (fSelCharge[is] != charge || fSelCutID[is] != cutID) continue;
+      n = fSelStart[is + 1] - fSelStart[is];
+      if (n > 0) sel = &fSelIndex[fSelStart[is]];
+      return kTRUE;
+   }
+   return kFALSE;
+}
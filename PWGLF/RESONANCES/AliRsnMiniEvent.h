@@ -8,6 +8,8 @@
 // when doing analysis w.r. to multiplicity or event plane, for example.
 //
 
+#include <vector>
+
 #include <TArrayI.h>
 #include <TClonesArray.h>
 #include "AliVEvent.h"
@@ -18,7 +20,7 @@ class AliQnCorrectionsQnVector;
 class AliRsnMiniEvent : public TObject {
 public:
 
- AliRsnMiniEvent() : fID(-1), fVz(0.0), fMult(0.0), fRefMult(0.0),  fTracklets(0.0), fAngle(0.0), fQnVector(0), fLeading(-1), fParticles("AliRsnMiniParticle", 0), fRef(0x0), fRefMC(0x0) {}
+ AliRsnMiniEvent() : fID(-1), fVz(0.0), fMult(0.0), fRefMult(0.0),  fTracklets(0.0), fAngle(0.0), fQnVector(0), fLeading(-1), fParticles("AliRsnMiniParticle", 0), fRef(0x0), fRefMC(0x0), fSelID(-1), fSelCharge(), fSelCutID(), fSelStart(), fSelIndex() {}
    ~AliRsnMiniEvent() {fParticles.Delete();}
    AliRsnMiniEvent(const AliRsnMiniEvent &copy);
    AliRsnMiniEvent &operator=(const AliRsnMiniEvent &copy);
@@ -34,6 +36,9 @@ public:
    void                Clear(Option_t *opt="");
 
    Int_t               CountParticles(TArrayI &found, Char_t charge = 0, Int_t cutID = -1);
+   void                BuildSelection(Char_t charge, Int_t cutID);
+   Bool_t              GetSelection(Char_t charge, Int_t cutID, const Int_t *&sel, Int_t &n) const;
+   void                ClearSelections();
    AliRsnMiniParticle *GetParticle(Int_t i);
    AliRsnMiniParticle *LeadingParticle();
    void                AddParticle(AliRsnMiniParticle copy);
@@ -62,6 +67,12 @@ private:
    AliVEvent    *fRef;        //!  pointer to input event
    AliVEvent    *fRefMC;      //!  pointer to reference MC event (if any)
 
+   Int_t               fSelID;      //!  ID of the event the selections were built for
+   std::vector<Char_t> fSelCharge;  //!  charge of each precomputed selection
+   std::vector<Int_t>  fSelCutID;   //!  cut ID of each precomputed selection
+   std::vector<Int_t>  fSelStart;   //!  first entry of each selection in fSelIndex (plus end marker)
+   std::vector<Int_t>  fSelIndex;   //!  indexes of the selected particles of all selections
+
    ClassDef(AliRsnMiniEvent, 8)
 };
 
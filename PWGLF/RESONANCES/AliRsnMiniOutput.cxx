@@ -404,6 +404,17 @@ void AliRsnMiniOutput::CreateHistogramSparse(const char *name)
    }
 }
 
+//________________________________________________________________________________________
+TObject *AliRsnMiniOutput::GetOutput() const
+{
+//
+// Return the output object filled by this definition
+//
+
+   if (!fList) return 0x0;
+   return fList->At(fOutputID);
+}
+
 //________________________________________________________________________________________
 Bool_t AliRsnMiniOutput::FillEvent(AliRsnMiniEvent *event, TClonesArray *valueList)
 {
@@ -505,14 +516,26 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
    Bool_t sameCriteria = ((fCharge[0] == fCharge[1]) && (fDaughter[0] == fDaughter[1]));
    Bool_t sameEvent = (event1->ID() == event2->ID());
 
-   TString selList1  = "";
-   TString selList2  = "";
-   Int_t   n1 = event1->CountParticles(fSel1, fCharge[0], fCutID[0]);
-   Int_t   n2 = event2->CountParticles(fSel2, fCharge[1], fCutID[1]);
-   for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", fSel1[i1]));
-   for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", fSel2[i2]));
-   AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
-   AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   // use the selections precomputed in the events (shared by all outputs
+   // with the same criteria), if available, otherwise select here
+   Int_t n1, n2;
+   const Int_t *sel1, *sel2;
+   if (!event1->GetSelection(fCharge[0], fCutID[0], sel1, n1)) {
+      n1 = event1->CountParticles(fSel1, fCharge[0], fCutID[0]);
+      sel1 = fSel1.GetArray();
+   }
+   if (!event2->GetSelection(fCharge[1], fCutID[1], sel2, n2)) {
+      n2 = event2->CountParticles(fSel2, fCharge[1], fCutID[1]);
+      sel2 = fSel2.GetArray();
+   }
+   if (AliDebugLevelClass() >= 1) {
+      TString selList1  = "";
+      TString selList2  = "";
+      for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", sel1[i1]));
+      for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", sel2[i2]));
+      AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
+      AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   }
    if (!n1 || !n2) {
       AliDebugClass(1, "No pairs to mix");
       return 0;
@@ -520,7 +543,7 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
 
    // external loop
    for (i1 = 0; i1 < n1; i1++) {
-      p1 = event1->GetParticle(fSel1[i1]);
+      p1 = event1->GetParticle(sel1[i1]);
       //p1 = event1->GetParticle(i1);
       //if (p1->Charge() != fCharge[0]) continue;
       //if (!p1->HasCutBit(fCutID[0])) continue;
@@ -533,7 +556,7 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
       AliDebugClass(2, Form("Start point = %d", start));
       // internal loop
       for (i2 = start; i2 < n2; i2++) {
-         p2 = event2->GetParticle(fSel2[i2]);
+         p2 = event2->GetParticle(sel2[i2]);
          //p2 = event2->GetParticle(i2);
          //if (p2->Charge() != fCharge[1]) continue;
          //if (!p2->HasCutBit(fCutID[1])) continue;
@@ -86,6 +86,7 @@ public:
    void            SetMotherPDG(Int_t pdg)            {fMotherPDG = pdg;}
    void            SetMotherMass(Double_t mass)       {fMotherMass = mass;}
    void            SetPairCuts(AliRsnCutSet *set)     {fPairCuts = set;}
+   AliRsnCutSet   *GetPairCuts()       const {return fPairCuts;}
    void            SetFillHistogramOnlyInRange(Bool_t fillInRangeOnly) { fCheckHistRange = fillInRangeOnly; }
    void            SetMaxNSisters(Short_t n)          {fMaxNSisters = n;}
    void            SetCheckMomentumConservation(Bool_t checkP) {fCheckP = checkP;}
@@ -100,6 +101,8 @@ public:
    Double_t       *GetAllComputed()  {return fComputed.GetArray();}
 
    AliRsnMiniPair &Pair() {return fPair;}
+   TObject        *GetOutput()         const;
+   void            SetOutput(TList *list, Int_t id)   {fList = list; fOutputID = id;}
    Bool_t          Init(const char *prefix, TList *list);
    Bool_t          FillMother(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillMotherInAcceptance(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
@@ -70,6 +70,7 @@
 #pragma link C++ class AliRsnMiniValue+;
 #pragma link C++ class AliRsnMiniMonitor+;
 #pragma link C++ class AliRsnMiniAnalysisTask+;
+#pragma link C++ class TestAliRsnMiniAnalysisTask+;
 #pragma link C++ class AliRsnMiniMonitorTask+;
 #pragma link C++ class AliRsnTrainManager+;
 #endif
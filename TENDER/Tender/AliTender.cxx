@@ -23,11 +23,13 @@
 #include "AliAnalysisManager.h"
 #include "AliCDBManager.h"
 #include "AliESDEvent.h"
+#include "AliESDtrack.h"
 #include "AliESDInputHandler.h"
 #include "AliLog.h"
 
 
 ClassImp(AliTender)
+ClassImp(TestAliTender)
 
 //______________________________________________________________________________
 AliTender::AliTender():
@@ -41,7 +43,9 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fFuseTrackLoops(kFALSE),
+           fTrackLoopSupplies(NULL)
 {
 // Dummy constructor
 }
@@ -58,7 +62,9 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fFuseTrackLoops(kFALSE),
+           fTrackLoopSupplies(NULL)
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -72,6 +78,7 @@ AliTender::~AliTender()
     fSupplies->Delete();
     delete fSupplies;
   }
+  delete fTrackLoopSupplies;
 }
 
 //______________________________________________________________________________
@@ -170,9 +177,13 @@ void AliTender::UserExec(Option_t* option)
       fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
     } 
   }
-  TIter next(fSupplies);
-  AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  if (fFuseTrackLoops) {
+    ProcessSuppliesFused();
+  } else {
+    TIter next(fSupplies);
+    AliTenderSupply *supply;
+    while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  }
   fRunChanged = kFALSE;
 
   if (TObject::TestBit(kCheckEventSelection)) fESDhandler->CheckSelectionMask();
@@ -181,9 +192,169 @@ void AliTender::UserExec(Option_t* option)
   if (!opt.Contains("NoPost")) PostData(1, fESD);
 }
 
+//______________________________________________________________________________
+void AliTender::ProcessSuppliesFused()
+{
+// Process the supplies in the order they were added, running the per-track
+// part of consecutive supplies with AliTenderSupply::HasTrackLoop in one loop
+// over the tracks. The common loop is run before any supply which has no
+// track loop or whose per-event part reads the tracks, so every supply sees
+// the tracks as in the sequential processing. When the run changed, the
+// per-event parts reload the calibration, which can change objects used by
+// the per-track part of other supplies (e.g. the AliESDpid shared via the
+// ESD input handler), so the common loop is also run before each of them.
+  if (!fTrackLoopSupplies) fTrackLoopSupplies = new TObjArray();
+  fTrackLoopSupplies->Clear();
+  TIter next(fSupplies);
+  AliTenderSupply *supply;
+  while ((supply=(AliTenderSupply*)next())) {
+    if (!supply->HasTrackLoop()) {
+      ProcessTrackLoop();
+      supply->ProcessEvent();
+      continue;
+    }
+    if (fRunChanged || supply->BeginEventReadsTracks()) ProcessTrackLoop();
+    if (supply->BeginEvent()) fTrackLoopSupplies->Add(supply);
+  }
+  ProcessTrackLoop();
+}
+
+//______________________________________________________________________________
+void AliTender::ProcessTrackLoop()
+{
+// Run the per-track part of the pending supplies in one loop over the tracks.
+  Int_t nsupplies = fTrackLoopSupplies->GetEntriesFast();
+  if (!nsupplies) return;
+  Int_t ntracks = fESD->GetNumberOfTracks();
+  for (Int_t itrack=0; itrack<ntracks; itrack++) {
+    AliESDtrack *track = fESD->GetTrack(itrack);
+    for (Int_t isupply=0; isupply<nsupplies; isupply++)
+      ((AliTenderSupply*)fTrackLoopSupplies->UncheckedAt(isupply))->ProcessTrack(track);
+  }
+  fTrackLoopSupplies->Clear();
+}
+
 //______________________________________________________________________________
 void AliTender::SetDefaultCDBStorage(const char *dbString)
 {
 // Set default CDB storage
    fDefaultStorage = dbString;
 }
+
+//==============================================================================
+//   Supplies used by TestAliTender: the first one applies a response shared
+//   with the second one to the TPC signal of each track, the second one, like
+//   the TPC supply, reloads this response in BeginEvent when the run changed.
+//==============================================================================
+namespace {
+const Int_t kTestNEvents = 5;
+const Int_t kTestNTracks = 4;
+const Int_t kTestRuns[kTestNEvents] = {1000, 1000, 1001, 1001, 1002};
+
+class AliTenderTestSupply : public AliTenderSupply {
+public:
+  AliTenderTestSupply(const char *name, Double_t *response) : AliTenderSupply(name), fResponse(response) {}
+  virtual void              Init() {}
+  virtual void              ProcessEvent() {
+    if (!BeginEvent()) return;
+    AliESDEvent *event=fTender->GetEvent();
+    for (Int_t itrack=0; itrack<event->GetNumberOfTracks(); itrack++) ProcessTrack(event->GetTrack(itrack));
+  }
+  virtual Bool_t            HasTrackLoop()          const {return kTRUE;}
+  virtual Bool_t            BeginEventReadsTracks() const {return kFALSE;}
+protected:
+  Double_t                 *fResponse;       // Response shared between the supplies
+};
+
+class AliTenderTestPIDSupply : public AliTenderTestSupply {
+public:
+  AliTenderTestPIDSupply(Double_t *response) : AliTenderTestSupply("TestPID", response) {}
+  virtual Bool_t            BeginEvent() {return kTRUE;}
+  virtual void              ProcessTrack(AliESDtrack *track) {
+    track->SetTPCsignal(track->GetTPCsignal()*(*fResponse), track->GetTPCsignalSigma(), track->GetTPCsignalN());
+  }
+};
+
+class AliTenderTestCalibSupply : public AliTenderTestSupply {
+public:
+  AliTenderTestCalibSupply(Double_t *response) : AliTenderTestSupply("TestCalib", response) {}
+  virtual Bool_t            BeginEvent() {
+    if (fTender->RunChanged()) *fResponse = 1. + 0.25*(fTender->GetRun()-kTestRuns[0]);
+    return kTRUE;
+  }
+  virtual void              ProcessTrack(AliESDtrack *track) {
+    track->SetTPCsignal(track->GetTPCsignal()+1., track->GetTPCsignalSigma(), track->GetTPCsignalN());
+  }
+};
+}
+
+//______________________________________________________________________________
+Bool_t TestAliTender::RunAllTests() const
+{
+// Run all tests
+  return TestFusedTrackLoops();
+}
+
+//______________________________________________________________________________
+Bool_t TestAliTender::TestFusedTrackLoops() const
+{
+// Corrected TPC signals with and without fused track loops, for events
+// with and without run change, have to be identical.
+  Double_t sequential[kTestNEvents*kTestNTracks], fused[kTestNEvents*kTestNTracks];
+  ProcessEvents(kFALSE, sequential);
+  ProcessEvents(kTRUE, fused);
+  Bool_t result = kTRUE;
+  for (Int_t ievent=0; ievent<kTestNEvents; ievent++) {
+    for (Int_t itrack=0; itrack<kTestNTracks; itrack++) {
+      Int_t index = ievent*kTestNTracks+itrack;
+      if (fused[index] != sequential[index]) {
+        Printf("Event %d (run %d), track %d: TPC signal %f with fused track loops, %f without",
+               ievent, kTestRuns[ievent], itrack, fused[index], sequential[index]);
+        result = kFALSE;
+      }
+    }
+  }
+  return result;
+}
+
+//______________________________________________________________________________
+void TestAliTender::ProcessEvents(Bool_t fuse, Double_t *signals) const
+{
+// Run the test supplies on the test events, in the same way as
+// AliTender::UserExec, and store the corrected TPC signals.
+  Double_t response = 1.;
+  AliTender tender("TestTender");
+  tender.SetFuseTrackLoops(fuse);
+  tender.AddSupply(new AliTenderTestPIDSupply(&response));
+  tender.AddSupply(new AliTenderTestCalibSupply(&response));
+
+  AliESDEvent esd;
+  esd.CreateStdContent();
+  tender.fESD = &esd;
+  for (Int_t ievent=0; ievent<kTestNEvents; ievent++) {
+    esd.Reset();
+    esd.SetRunNumber(kTestRuns[ievent]);
+    for (Int_t itrack=0; itrack<kTestNTracks; itrack++) {
+      AliESDtrack track;
+      track.SetTPCsignal(50.+10.*itrack+ievent, 1., 100);
+      esd.AddTrack(&track);
+    }
+
+    if (tender.fRun != esd.GetRunNumber()) {
+      tender.fRunChanged = kTRUE;
+      tender.fRun = esd.GetRunNumber();
+    }
+    if (tender.fFuseTrackLoops) {
+      tender.ProcessSuppliesFused();
+    } else {
+      TIter next(tender.fSupplies);
+      AliTenderSupply *supply;
+      while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+    }
+    tender.fRunChanged = kFALSE;
+
+    for (Int_t itrack=0; itrack<kTestNTracks; itrack++)
+      signals[ievent*kTestNTracks+itrack] = esd.GetTrack(itrack)->GetTPCsignal();
+  }
+  tender.fESD = NULL;
+}
@@ -26,6 +26,7 @@ class AliESDInputHandler;
 class AliTenderSupply;
 
 class AliTender : public AliAnalysisTaskSE {
+  friend class TestAliTender;  // unit test of the fused track loops
 
 public:
 enum ETenderFlags {
@@ -43,6 +44,11 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  Bool_t                    fFuseTrackLoops; // Run the track loops of the supplies together
+  TObjArray                *fTrackLoopSupplies; //! Supplies waiting for the common track loop
+  
+  void                      ProcessSuppliesFused();
+  void                      ProcessTrackLoop();
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
@@ -68,6 +74,13 @@ public:
    */
   void 			    SetHandleOCDB(Bool_t doHandle) { fHandleCDB = doHandle; }
   void SetESDhandler(AliESDInputHandler*esdH) {fESDhandler = esdH;}
+  /**
+   * Run the per-track corrections of consecutive supplies implementing
+   * AliTenderSupply::HasTrackLoop in one loop over the ESD tracks (default: false)
+   * @param[in] fuse If true, the track loops are fused
+   */
+  void                      SetFuseTrackLoops(Bool_t fuse=kTRUE) {fFuseTrackLoops = fuse;}
+  Bool_t                    GetFuseTrackLoops() const {return fFuseTrackLoops;}
 
   // Run control
   virtual void              ConnectInputData(Option_t *option = "");
@@ -75,6 +88,25 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,5)  // Class describing the tender car for ESD analysis
+};
+
+//==============================================================================
+//   TestAliTender - Unit test checking that fused track loops give the same
+//      corrected ESD as the sequential processing of the supplies.
+//==============================================================================
+class TestAliTender : public TObject {
+
+public:
+  TestAliTender() : TObject() {}
+  virtual ~TestAliTender() {}
+
+  Bool_t                    RunAllTests() const;
+  Bool_t                    TestFusedTrackLoops() const;
+
+private:
+  void                      ProcessEvents(Bool_t fuse, Double_t *signals) const;
+
+  ClassDef(TestAliTender,0)  // Unit test of the fused track loops
 };
 #endif
@@ -15,6 +15,7 @@
 #endif
 
 class AliTender;
+class AliESDtrack;
 
 class AliTenderSupply : public TNamed {
 
@@ -31,6 +32,19 @@ public:
   // Run control
   virtual void              Init() = 0;
   virtual void              ProcessEvent() = 0;
+
+  // Optional split of ProcessEvent into a per-event and a per-track part, used by
+  // AliTender to run the track corrections of several supplies in one loop
+  // (see AliTender::SetFuseTrackLoops). BeginEvent returns kFALSE if the tracks
+  // of this event are not to be processed. BeginEventReadsTracks has to return
+  // kTRUE if BeginEvent reads or modifies tracks, or changes objects used by the
+  // ProcessTrack of other supplies, such that it sees the tracks corrected by the
+  // preceding supplies. Changes done only on a run change (AliTender::RunChanged)
+  // need not be covered, the tender always runs the pending track loop before.
+  virtual Bool_t            HasTrackLoop()          const {return kFALSE;}
+  virtual Bool_t            BeginEventReadsTracks() const {return kTRUE;}
+  virtual Bool_t            BeginEvent()                  {return kFALSE;}
+  virtual void              ProcessTrack(AliESDtrack * /*track*/) {}
   
   void                      SetTender(const AliTender *tender) {fTender = tender;}
     
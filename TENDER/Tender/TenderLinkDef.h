@@ -6,5 +6,6 @@
 
 #pragma link C++ class  AliTender+;
 #pragma link C++ class  AliTenderSupply+;
+#pragma link C++ class  TestAliTender+;
 
 #endif
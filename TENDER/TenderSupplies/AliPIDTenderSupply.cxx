@@ -33,7 +33,8 @@ ClassImp(AliPIDTenderSupply)
 
 AliPIDTenderSupply::AliPIDTenderSupply() :
   AliTenderSupply(),
-  fCachePID(kFALSE)
+  fCachePID(kFALSE),
+  fESDpid(0x0)
 {
   //
   // default ctor
@@ -43,7 +44,8 @@ AliPIDTenderSupply::AliPIDTenderSupply() :
 //_____________________________________________________
 AliPIDTenderSupply::AliPIDTenderSupply(const char *name, const AliTender *tender) :
   AliTenderSupply(name,tender),
-  fCachePID(kFALSE)
+  fCachePID(kFALSE),
+  fESDpid(0x0)
 {
   //
   // named ctor
@@ -57,21 +59,43 @@ void AliPIDTenderSupply::ProcessEvent()
   // Combine PID information
   //
 
-  AliESDEvent *event=fTender->GetEvent();
-  if (!event) return;
-
-  AliESDpid *pid=fTender->GetESDhandler()->GetESDpid();
-  if (!pid) return;
-  // chache pid if requested
-  if (fCachePID) {
-    pid->FillTrackDetectorPID();
-  }
+  if (!BeginEvent()) return;
   
   //
   // recalculate combined PID probabilities
   //
+  AliESDEvent *event=fTender->GetEvent();
   Int_t ntracks=event->GetNumberOfTracks();
   for(Int_t itrack = 0; itrack < ntracks; itrack++)
-    pid->CombinePID(event->GetTrack(itrack));
+    ProcessTrack(event->GetTrack(itrack));
   
 }
+
+//_____________________________________________________
+Bool_t AliPIDTenderSupply::BeginEvent()
+{
+  //
+  // Per event part of ProcessEvent: get the pid object and cache the
+  // detector PID if requested
+  //
+
+  AliESDEvent *event=fTender->GetEvent();
+  if (!event) return kFALSE;
+
+  fESDpid=fTender->GetESDhandler()->GetESDpid();
+  if (!fESDpid) return kFALSE;
+  // chache pid if requested
+  if (fCachePID) {
+    fESDpid->FillTrackDetectorPID();
+  }
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliPIDTenderSupply::ProcessTrack(AliESDtrack *track)
+{
+  //
+  // Recalculate the combined PID probabilities of track
+  //
+  fESDpid->CombinePID(track);
+}
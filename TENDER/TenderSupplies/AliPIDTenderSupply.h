@@ -14,6 +14,8 @@
 
 #include <AliTenderSupply.h>
 
+class AliESDpid;
+
 class AliPIDTenderSupply: public AliTenderSupply {
   
 public:
@@ -25,9 +27,16 @@ public:
   virtual void              Init(){;}
   virtual void              ProcessEvent();
 
+  // BeginEvent reads the tracks if the PID is cached
+  virtual Bool_t            HasTrackLoop()          const {return kTRUE;}
+  virtual Bool_t            BeginEventReadsTracks() const {return fCachePID;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+
   void SetCachePID(Bool_t cachePID) { fCachePID=cachePID; }
 private:
   Bool_t fCachePID;                    // Cache PID values in transient object
+  AliESDpid *fESDpid;                  //! pid object of current event
   
   AliPIDTenderSupply(const AliPIDTenderSupply&c);
   AliPIDTenderSupply& operator= (const AliPIDTenderSupply&c);
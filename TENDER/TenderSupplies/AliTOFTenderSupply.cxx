@@ -307,8 +307,28 @@ void AliTOFTenderSupply::ProcessEvent()
 
   if (fDebugLevel > 1) AliInfo("process event");
 
+  if (!BeginEvent()) return;
+
+  // recalculate PID probabilities
+  // this is for safety, especially if the user doesn't attach a PID tender after TOF tender  
+  AliESDEvent *event=fTender->GetEvent();
+  Int_t ntracks=event->GetNumberOfTracks();
+  for(Int_t itrack = 0; itrack < ntracks; itrack++){
+    ProcessTrack(event->GetTrack(itrack));
+  }
+}
+
+//_____________________________________________________
+Bool_t AliTOFTenderSupply::BeginEvent()
+{
+  //
+  // Per event part of ProcessEvent: calibration of the TOF signals, patches
+  // for reconstruction bugs, T0 treatment and event time; returns kFALSE
+  // if the tender has no action on this event
+  //
+
   AliESDEvent *event=fTender->GetEvent();
-  if (!event) return;
+  if (!event) return kFALSE;
   if (fDebugLevel > 1) AliInfo("event read");
 
 
@@ -317,7 +337,7 @@ void AliTOFTenderSupply::ProcessEvent()
 
     Init();
 
-    if (fTenderNoAction) return;            
+    if (fTenderNoAction) return kFALSE;            
     Int_t versionNumber = GetOCDBVersion(fTender->GetRun());
     fTOFCalib->SetRunParamsSpecificVersion(versionNumber);
     fTOFCalib->Init(fTender->GetRun());
@@ -346,7 +366,7 @@ void AliTOFTenderSupply::ProcessEvent()
     }
   }
 
-  if (fTenderNoAction) return;
+  if (fTenderNoAction) return kFALSE;
 
   fTOFCalib->CalibrateESD(event);   //recalculate TOF signal (no harm for MC, see settings inside init)
 
@@ -434,19 +454,16 @@ void AliTOFTenderSupply::ProcessEvent()
   //  set preferred startTime: this is now done via AliPIDResponseTask
   fESDpid->SetTOFResponse(event, (AliESDpid::EStartTimeType_t)fTOFPIDParams->GetStartTimeMethod());
 
-  // recalculate PID probabilities
-  // this is for safety, especially if the user doesn't attach a PID tender after TOF tender  
-  Int_t ntracks=event->GetNumberOfTracks();
-  //  AliESDtrack *track = NULL;
-  //  Float_t tzeroTrack = 0;
-  for(Int_t itrack = 0; itrack < ntracks; itrack++){
-    //    track = event->GetTrack(itrack);
-    //    tzeroTrack = fESDpid->GetTOFResponse().GetStartTime(track->P());
-    //    Printf("================> Track # %d mom: %f tzeroTrack %f",itrack,track->P(),tzeroTrack);
-    fESDpid->MakeTOFPID(event->GetTrack(itrack),0);   
-  }
-  
-  
+  return kTRUE;
+}
+
+//_____________________________________________________
+void AliTOFTenderSupply::ProcessTrack(AliESDtrack *track)
+{
+  //
+  // Recalculate the TOF PID probabilities of track
+  //
+  fESDpid->MakeTOFPID(track,0);
 }
 
 
@@ -30,6 +30,12 @@ public:
   virtual void              Init();
   virtual void              ProcessEvent();
 
+  // BeginEvent modifies the tracks (TOF calibration, T0-TOF)
+  virtual Bool_t            HasTrackLoop()          const {return kTRUE;}
+  virtual Bool_t            BeginEventReadsTracks() const {return kTRUE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
+
   // TOF tender methods
   void SetIsMC(Bool_t flag=kFALSE){fIsMC=flag;}
   void SetCorrectExpTimes(Bool_t flag=kTRUE){fCorrectExpTimes=flag;}
@@ -42,6 +42,12 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+
+  // BeginEvent only changes shared objects (splines, AliESDpid) on a run change
+  virtual Bool_t            HasTrackLoop()          const {return kTRUE;}
+  virtual Bool_t            BeginEventReadsTracks() const {return kFALSE;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
   
 private:
   AliESDpid          *fESDpid;         //! ESD pid object
@@ -69,6 +75,10 @@ private:
   TString fMCperiod;                 //! corresponding MC period to use for the splines
   Int_t   fRecoPass;                 //! reconstruction pass
 
+  Double_t fCorrFactor;              //! gain correction factor of current event
+  Double_t fCorrAttachSlope;         //! attachment correction slope of current event
+  Double_t fCorrGainMultiplicityPbPb;//! multiplicity gain correction of current event
+
   void SetSplines();
   Double_t GetGainCorrection();
 
@@ -177,6 +177,24 @@ void AliTRDTenderSupply::ProcessEvent()
   //
   // Reapply pid information
   //
+  if (!BeginEvent()) return;
+
+  //
+  // recalculate PID probabilities
+  //
+  Int_t ntracks=fESD->GetNumberOfTracks();
+  for(Int_t itrack = 0; itrack < ntracks; itrack++){
+    ProcessTrack(fESD->GetTrack(itrack));
+  }
+}
+
+//_____________________________________________________
+Bool_t AliTRDTenderSupply::BeginEvent()
+{
+  //
+  // Per event part of ProcessEvent: update calibration if the run changed,
+  // normalisation factor and online track matching
+  //
   if (fTender->RunChanged()){
     AliDebug(0, Form("AliTPCTenderSupply::ProcessEvent - Run Changed (%d)\n",fTender->GetRun()));
     if (fGainCorrection) SetChamberGain();
@@ -194,9 +212,8 @@ void AliTRDTenderSupply::ProcessEvent()
 
 
   fESD = fTender->GetEvent();
-  if (!fESD) return;
+  if (!fESD) return kFALSE;
   if(fNormalizationFactorArray) fNormalizationFactor = GetNormalizationFactor(fESD->GetRunNumber());
-  Int_t ntracks=fESD->GetNumberOfTracks();
 
 
 
@@ -206,48 +223,49 @@ void AliTRDTenderSupply::ProcessEvent()
       } 
   }
 
+  return kTRUE;
+}
 
-
+//_____________________________________________________
+void AliTRDTenderSupply::ProcessTrack(AliESDtrack *track)
+{
   //
-  // recalculate PID probabilities
+  // Apply the TRD corrections to track and recalculate its PID probabilities
   //
   Int_t detectors[kNPlanes];
-  for(Int_t itrack = 0; itrack < ntracks; itrack++){
-    for(Int_t idet = 0; idet < 5; idet++) detectors[idet] = -1;
-    AliESDtrack *track=fESD->GetTrack(itrack);
-    // Recalculate likelihoods
-    if(!(track->GetStatus() & AliESDtrack::kTRDout)) continue;
-    AliDebug(2, Form("TRD track found, gain correction: %s, Number of bad chambers: %d\n", fGainCorrection ? "Yes" : "No", fNBadChambers));
-    if(GetTRDchamberID(track, detectors)){
-      if(fGainCorrection && fHasNewCalibration) ApplyGainCorrection(track, detectors);
-      if(fNBadChambers) MaskChambers(track, detectors);
-    }
-    if(fRunByRunCorrection) ApplyRunByRunCorrection(track);
-    if(fNormalizationFactor != 1.){
-      //printf("Gain Factor: %f\n", fNormalizationFactor);
-      // Renormalize charge
-      Double_t qslice = -1;
-      for(Int_t ily = 0; ily < 6; ily++){
-        for(Int_t is = 0; is < track->GetNumberOfTRDslices(); is++){
-          qslice = track->GetTRDslice(ily, is);
-          //printf("Doing layer %d slice %d, value %f\n", ily, is, qslice);
-          if(qslice >0){
-            qslice *= fNormalizationFactor;
-            //printf("qslice new: %f\n", qslice);
-            track->SetTRDslice(qslice, ily, is);
-          }
+  for(Int_t idet = 0; idet < 5; idet++) detectors[idet] = -1;
+  // Recalculate likelihoods
+  if(!(track->GetStatus() & AliESDtrack::kTRDout)) return;
+  AliDebug(2, Form("TRD track found, gain correction: %s, Number of bad chambers: %d\n", fGainCorrection ? "Yes" : "No", fNBadChambers));
+  if(GetTRDchamberID(track, detectors)){
+    if(fGainCorrection && fHasNewCalibration) ApplyGainCorrection(track, detectors);
+    if(fNBadChambers) MaskChambers(track, detectors);
+  }
+  if(fRunByRunCorrection) ApplyRunByRunCorrection(track);
+  if(fNormalizationFactor != 1.){
+    //printf("Gain Factor: %f\n", fNormalizationFactor);
+    // Renormalize charge
+    Double_t qslice = -1;
+    for(Int_t ily = 0; ily < 6; ily++){
+      for(Int_t is = 0; is < track->GetNumberOfTRDslices(); is++){
+        qslice = track->GetTRDslice(ily, is);
+        //printf("Doing layer %d slice %d, value %f\n", ily, is, qslice);
+        if(qslice >0){
+          qslice *= fNormalizationFactor;
+          //printf("qslice new: %f\n", qslice);
+          track->SetTRDslice(qslice, ily, is);
         }
       }
     }
-    switch(fPIDmethod){
-      case kNNpid:
-        break;
-      case k1DLQpid:
-        fESDpid->MakeTRDPID(fESD->GetTrack(itrack));
-        break;
-      default:
-        AliError("PID Method not implemented (yet)");
-    }
+  }
+  switch(fPIDmethod){
+    case kNNpid:
+      break;
+    case k1DLQpid:
+      fESDpid->MakeTRDPID(track);
+      break;
+    default:
+      AliError("PID Method not implemented (yet)");
   }
 }
 
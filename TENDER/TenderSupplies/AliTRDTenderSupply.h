@@ -45,6 +45,12 @@ public:
 
   virtual void              Init();
   virtual void              ProcessEvent();
+
+  // BeginEvent reads the tracks if the TRD online track matching is redone
+  virtual Bool_t            HasTrackLoop()          const {return kTRUE;}
+  virtual Bool_t            BeginEventReadsTracks() const {return fRedoTrdMatching;}
+  virtual Bool_t            BeginEvent();
+  virtual void              ProcessTrack(AliESDtrack *track);
   
   void SwitchOnGainCorrection() { fGainCorrection = kTRUE; }
   void SwitchOffGainCorrection() { fGainCorrection = kFALSE; }
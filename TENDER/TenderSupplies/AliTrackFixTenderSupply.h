@@ -33,6 +33,11 @@ public:
   virtual  void ProcessEvent();
   virtual  void Init() {}
   //
+  virtual  Bool_t HasTrackLoop()          const {return kTRUE;}
+  virtual  Bool_t BeginEventReadsTracks() const {return kFALSE;}
+  virtual  Bool_t BeginEvent();
+  virtual  void   ProcessTrack(AliESDtrack *trc);
+  //
   Double_t GetSideAFraction(const AliESDtrack* track) const;
   void     CorrectTrackPtInv(AliExternalTrackParam* trc, int mode, double sideAfraction, double phi) const;
   Bool_t   GetRunCorrections(int run);
@@ -57,6 +62,8 @@ private:
   TString           fOADBObjPath;            // path of file with parameters to use, starting from OADB dir
   TString           fOADBObjName;            // name of the corrections object in the OADB container
   AliOADBContainer* fOADBCont;               // OADB container with parameters collection
+  const AliESDVertex* fVtx;                  //! vertex for RelateToVertex in current event
+  const AliESDVertex* fVtxTPC;               //! vertex for RelateToVertexTPC in current event
   //
   ClassDef(AliTrackFixTenderSupply, 1);  // track fixing tender task 
 };